@@ -58,8 +58,20 @@ SOURCE_GROUP("Core"
 	${MATH_HEADER_DIR}/epsilon.h
 	${MATH_SOURCE_DIR}/quat.cpp
 	${MATH_HEADER_DIR}/quat.h
+	${MATH_HEADER_DIR}/soa.h
 	${MATH_HEADER_DIR}/xmath.hpp
 )
+SOURCE_GROUP("Culling"
+	FILES
+	${MATH_SOURCE_DIR}/clipping.cpp
+	${MATH_HEADER_DIR}/clipping.h
+	${MATH_SOURCE_DIR}/multi_frustum.cpp
+	${MATH_HEADER_DIR}/multi_frustum.h
+	${MATH_SOURCE_DIR}/occlusion_buffer.cpp
+	${MATH_HEADER_DIR}/occlusion_buffer.h
+	${MATH_SOURCE_DIR}/projected_bounds.cpp
+	${MATH_HEADER_DIR}/projected_bounds.h
+)
 SOURCE_GROUP("Documentation"
 	FILES
 	    ${MATH_DOCUMENTATION_FILES}
@@ -82,6 +94,27 @@ SOURCE_GROUP("Resource"
 		${CMAKE_SOURCE_DIR}/xMath/config/version.h
 		${CMAKE_SOURCE_DIR}/xMath/config/xMath.rc
 )
+SOURCE_GROUP("Spatial"
+	FILES
+	${MATH_SOURCE_DIR}/bvh.cpp
+	${MATH_HEADER_DIR}/bvh.h
+	${MATH_SOURCE_DIR}/kd_tree.cpp
+	${MATH_HEADER_DIR}/kd_tree.h
+	${MATH_SOURCE_DIR}/octree.cpp
+	${MATH_HEADER_DIR}/octree.h
+	${MATH_SOURCE_DIR}/packed_rtree.cpp
+	${MATH_HEADER_DIR}/packed_rtree.h
+	${MATH_SOURCE_DIR}/quadtree.cpp
+	${MATH_HEADER_DIR}/quadtree.h
+	${MATH_SOURCE_DIR}/ray.cpp
+	${MATH_HEADER_DIR}/ray.h
+	${MATH_SOURCE_DIR}/spatial_hash_grid.cpp
+	${MATH_HEADER_DIR}/spatial_hash_grid.h
+	${MATH_SOURCE_DIR}/sweep_and_prune.cpp
+	${MATH_HEADER_DIR}/sweep_and_prune.h
+	${MATH_SOURCE_DIR}/voxelizer.cpp
+	${MATH_HEADER_DIR}/voxelizer.h
+)
 SOURCE_GROUP("Transforms"
 	FILES
 	${MATH_SOURCE_DIR}/frustum.cpp
@@ -92,6 +125,8 @@ SOURCE_GROUP("Transforms"
 	${MATH_HEADER_DIR}/rotation.h
 	${MATH_SOURCE_DIR}/scale.cpp
 	${MATH_HEADER_DIR}/scale.h
+	${MATH_SOURCE_DIR}/shadow_cascades.cpp
+	${MATH_HEADER_DIR}/shadow_cascades.h
 	${MATH_SOURCE_DIR}/transforms.cpp
 	${MATH_HEADER_DIR}/transforms.h
 	${MATH_SOURCE_DIR}/translate.cpp
@@ -99,6 +134,14 @@ SOURCE_GROUP("Transforms"
 )
 SOURCE_GROUP("Shapes"
 	FILES
+	${MATH_SOURCE_DIR}/closest_point.cpp
+	${MATH_HEADER_DIR}/closest_point.h
+	${MATH_SOURCE_DIR}/convex_hull.cpp
+	${MATH_HEADER_DIR}/convex_hull.h
+	${MATH_SOURCE_DIR}/gjk.cpp
+	${MATH_HEADER_DIR}/gjk.h
+	${MATH_SOURCE_DIR}/oriented_bounding_box.cpp
+	${MATH_HEADER_DIR}/oriented_bounding_box.h
 	${MATH_SOURCE_DIR}/plane.cpp
 	${MATH_HEADER_DIR}/plane.h
 	${MATH_SOURCE_DIR}/rectangle.cpp
@@ -108,8 +151,13 @@ SOURCE_GROUP("Shapes"
 )
 SOURCE_GROUP("Utilities"
 	FILES
+	${MATH_SOURCE_DIR}/atlas_packer.cpp
+	${MATH_HEADER_DIR}/atlas_packer.h
+	${MATH_SOURCE_DIR}/dirty_region.cpp
+	${MATH_HEADER_DIR}/dirty_region.h
 	${MATH_SOURCE_DIR}/math_utils.cpp
 	${MATH_HEADER_DIR}/math_utils.h
+	${MATH_SOURCE_DIR}/parallel_for.h
 )
 SOURCE_GROUP("Vectors"
 	FILES
@@ -141,6 +189,10 @@ TARGET_INCLUDE_DIRECTORIES(xMath
 		${Stb_INCLUDE_DIR}
 )
 
+# The BVH builder runs large subtrees on worker threads
+FIND_PACKAGE(Threads REQUIRED)
+TARGET_LINK_LIBRARIES(xMath PRIVATE Threads::Threads)
+
 # Ensure consistent UTF-8 source decoding on MSVC (prevents fmt / Unicode warnings)
 IF (MSVC)
 	TARGET_COMPILE_OPTIONS(xMath PRIVATE /utf-8)
@@ -0,0 +1,134 @@
+/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* RandomGeometry.h
+* -------------------------------------------------------
+* Random point and box factories, and the reference box overlap test, shared by the math tests
+* -------------------------------------------------------
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <xmath.hpp>
+
+namespace TestUtils
+{
+    /**
+     * @brief Draws the three components of a vector from a distribution.
+     *
+     * The components are drawn in x, y, z order. Several draws inside one expression (constructor or
+     * function arguments, operands) are evaluated in an unspecified order, so the values a seed gives
+     * would depend on the compiler; build vectors through this or draw into named locals first.
+     */
+    template <typename Distribution>
+    inline xMath::Vec3 RandomVector(std::mt19937 &rng, Distribution &distribution)
+    {
+        const float x = distribution(rng);
+        const float y = distribution(rng);
+        const float z = distribution(rng);
+        return {x, y, z};
+    }
+
+    /**
+     * @brief Draws a point uniformly from the cube [-range, range]^3.
+     */
+    inline xMath::Vec3 RandomPoint(std::mt19937 &rng, float range)
+    {
+        std::uniform_real_distribution<float> position(-range, range);
+        return RandomVector(rng, position);
+    }
+
+    /**
+     * @brief Draws points uniformly from the cube [-range, range]^3.
+     */
+    inline std::vector<xMath::Vec3> MakeRandomPoints(std::mt19937 &rng, size_t count, float range)
+    {
+        std::vector<xMath::Vec3> points;
+        points.reserve(count);
+        for (size_t i = 0; i < count; i++)
+            points.push_back(RandomPoint(rng, range));
+        return points;
+    }
+
+    inline std::vector<xMath::Vec3> MakeRandomPoints(size_t count, uint32_t seed, float range)
+    {
+        std::mt19937 rng(seed);
+        return MakeRandomPoints(rng, count, range);
+    }
+
+    /**
+     * @brief Brute-force reference for box overlap; boxes that touch count as overlapping.
+     */
+    inline bool Overlaps(const xMath::BoundingBox &a, const xMath::BoundingBox &b)
+    {
+        return a.GetMin().x <= b.GetMax().x && a.GetMax().x >= b.GetMin().x &&
+               a.GetMin().y <= b.GetMax().y && a.GetMax().y >= b.GetMin().y &&
+               a.GetMin().z <= b.GetMax().z && a.GetMax().z >= b.GetMin().z;
+    }
+
+    /**
+     * @brief Makes boxes with their minimum corner in [-range, range]^3 and sides in [min_size, max_size].
+     */
+    inline std::vector<xMath::BoundingBox> MakeRandomBoxes(size_t count, uint32_t seed, float range = 100.0f, float min_size = 0.1f, float max_size = 3.0f)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> size(min_size, max_size);
+
+        std::vector<xMath::BoundingBox> boxes;
+        boxes.reserve(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            const xMath::Vec3 min = RandomPoint(rng, range);
+            const float x = size(rng);
+            const float y = size(rng);
+            const float z = size(rng);
+            boxes.emplace_back(min, min + xMath::Vec3(x, y, z));
+        }
+        return boxes;
+    }
+
+    /**
+     * @brief Makes an axis-aligned box with its center in [-range, range]^3 and half-sizes in [min_size, max_size].
+     */
+    inline xMath::BoundingBox MakeRandomAABB(std::mt19937 &rng, float range, float min_size = 0.2f, float max_size = 2.0f)
+    {
+        std::uniform_real_distribution<float> size(min_size, max_size);
+        const xMath::Vec3 center = RandomPoint(rng, range);
+        const xMath::Vec3 half = RandomVector(rng, size);
+        return {center - half, center + half};
+    }
+
+    /**
+     * @brief Makes a box with its center in [-range, range]^3, a random rotation and half-sizes in [min_size, max_size].
+     */
+    inline xMath::OrientedBoundingBox MakeRandomOBB(std::mt19937 &rng, float range, float min_size = 0.2f, float max_size = 2.0f)
+    {
+        std::uniform_real_distribution<float> size(min_size, max_size), angle(-180.0f, 180.0f);
+        const xMath::Vec3 center = RandomPoint(rng, range);
+        const xMath::Vec3 angles = RandomVector(rng, angle);
+        const xMath::Vec3 extents = RandomVector(rng, size);
+        const xMath::Mat4 transform = xMath::Mat4::Translate(center) * xMath::Mat4::RotationDegrees(angles);
+        return xMath::OrientedBoundingBox(xMath::BoundingBox(-extents, extents), transform);
+    }
+}
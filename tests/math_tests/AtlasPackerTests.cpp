@@ -0,0 +1,115 @@
+﻿#include <random>
+#include <vector>
+#include <xmath.hpp>
+#include <catch2/catch_all.hpp>
+
+using namespace xMath;
+
+namespace
+{
+    // Placements lie inside the atlas and no two overlap (padding included)
+    void RequireValidPacking(const std::vector<Rectangle> &placements, uint32_t width, uint32_t height, uint32_t padding)
+    {
+        for (size_t i = 0; i < placements.size(); i++)
+        {
+            const Rectangle &a = placements[i];
+            REQUIRE(a.x >= 0.0f);
+            REQUIRE(a.y >= 0.0f);
+            REQUIRE(a.x + a.width <= static_cast<float>(width));
+            REQUIRE(a.y + a.height <= static_cast<float>(height));
+
+            for (size_t j = i + 1; j < placements.size(); j++)
+            {
+                const Rectangle &b = placements[j];
+                const float pad = static_cast<float>(padding);
+                const bool separate = a.x + a.width + pad <= b.x || b.x + b.width + pad <= a.x ||
+                                      a.y + a.height + pad <= b.y || b.y + b.height + pad <= a.y;
+                REQUIRE(separate);
+            }
+        }
+    }
+}
+
+TEST_CASE("AtlasPacker places items without overlap", "[math][atlas]")
+{
+    const AtlasHeuristic heuristic = GENERATE(AtlasHeuristic::Skyline, AtlasHeuristic::MaxRects);
+    const uint32_t padding = GENERATE(0u, 2u);
+
+    std::mt19937 rng(12);
+    std::uniform_int_distribution<uint32_t> size(4, 40);
+
+    AtlasPacker packer(512, 512, heuristic, padding);
+    std::vector<Rectangle> placements;
+    for (int i = 0; i < 300; i++)
+    {
+        Rectangle placement;
+        const uint32_t w = size(rng), h = size(rng);
+        if (!packer.Insert(w, h, placement))
+            break;
+        REQUIRE(placement.width == static_cast<float>(w));
+        REQUIRE(placement.height == static_cast<float>(h));
+        placements.push_back(placement);
+    }
+
+    REQUIRE(placements.size() > 100);
+    RequireValidPacking(placements, 512, 512, padding);
+    REQUIRE(packer.GetOccupancy() > 0.0f);
+
+    packer.Clear();
+    REQUIRE(packer.GetOccupancy() == 0.0f);
+}
+
+TEST_CASE("AtlasPacker fills exactly when items tile the atlas", "[math][atlas]")
+{
+    const AtlasHeuristic heuristic = GENERATE(AtlasHeuristic::Skyline, AtlasHeuristic::MaxRects);
+    AtlasPacker packer(64, 64, heuristic);
+
+    std::vector<Rectangle> placements;
+    for (int i = 0; i < 16; i++)
+    {
+        Rectangle placement;
+        REQUIRE(packer.Insert(16, 16, placement));
+        placements.push_back(placement);
+    }
+    RequireValidPacking(placements, 64, 64, 0);
+    REQUIRE(packer.GetOccupancy() == Catch::Approx(1.0f));
+
+    Rectangle placement;
+    REQUIRE_FALSE(packer.Insert(1, 1, placement));
+    REQUIRE_FALSE(AtlasPacker(64, 64, heuristic).Insert(65, 8, placement));
+}
+
+TEST_CASE("AtlasPacker bulk insertion sorts for density", "[math][atlas]")
+{
+    const AtlasHeuristic heuristic = GENERATE(AtlasHeuristic::Skyline, AtlasHeuristic::MaxRects);
+
+    std::mt19937 rng(4);
+    std::uniform_int_distribution<uint32_t> size(6, 48);
+    std::vector<Rectangle> rects;
+    for (int i = 0; i < 2000; i++)
+    {
+        const uint32_t w = size(rng), h = size(rng);
+        rects.emplace_back(0.0f, 0.0f, static_cast<float>(w), static_cast<float>(h));
+    }
+
+    // More items than fit: bulk insertion covers more of the atlas than insertion in the given order
+    AtlasPacker incremental(1024, 1024, heuristic, 1);
+    for (const Rectangle &rect : rects)
+    {
+        Rectangle placement;
+        (void)incremental.Insert(static_cast<uint32_t>(rect.width), static_cast<uint32_t>(rect.height), placement);
+    }
+
+    AtlasPacker bulk(1024, 1024, heuristic, 1);
+    std::vector<Rectangle> placed = rects;
+    const size_t bulk_count = bulk.InsertBatch(placed.data(), placed.size());
+    REQUIRE(bulk_count < rects.size());
+    REQUIRE(bulk.GetOccupancy() > incremental.GetOccupancy());
+
+    std::vector<Rectangle> valid;
+    for (const Rectangle &rect : placed)
+        if (rect.x >= 0.0f)
+            valid.push_back(rect);
+    REQUIRE(valid.size() == bulk_count);
+    RequireValidPacking(valid, 1024, 1024, 1);
+}
@@ -0,0 +1,495 @@
+﻿#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <xmath.hpp>
+#include <catch2/catch_all.hpp>
+#include "RandomGeometry.h"
+
+using namespace xMath;
+using TestUtils::MakeRandomBoxes;
+using TestUtils::Overlaps;
+using TestUtils::RandomVector;
+
+namespace
+{
+    float BoxDistance(const BoundingBox &box, const Vec3 &point)
+    {
+        return Distance(box.GetClosestPoint(point), point);
+    }
+
+    // Brute-force slab test, returns the entry distance or -1
+    float RayBox(const BoundingBox &box, const Vec3 &origin, const Vec3 &direction, float max_distance)
+    {
+        float t_enter = 0.0f, t_exit = max_distance;
+        const float o[3] = { origin.x, origin.y, origin.z }, d[3] = { direction.x, direction.y, direction.z };
+        const float mn[3] = { box.GetMin().x, box.GetMin().y, box.GetMin().z }, mx[3] = { box.GetMax().x, box.GetMax().y, box.GetMax().z };
+        for (int a = 0; a < 3; a++)
+        {
+            const float t0 = (mn[a] - o[a]) / d[a], t1 = (mx[a] - o[a]) / d[a];
+            t_enter = std::max(t_enter, std::min(t0, t1));
+            t_exit = std::min(t_exit, std::max(t0, t1));
+        }
+        return t_enter <= t_exit ? t_enter : -1.0f;
+    }
+
+    std::vector<uint32_t> Sorted(std::vector<uint32_t> values)
+    {
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+}
+
+TEST_CASE("BVH build produces a valid hierarchy", "[math][bvh]")
+{
+    const std::vector<BoundingBox> boxes = MakeRandomBoxes(5000, 1);
+
+    BVHBuildSettings settings;
+    settings.parallel_threshold = 256; // exercise the threaded path
+    settings.thread_count = 4;
+
+    BVH bvh;
+    bvh.Build(boxes.data(), boxes.size(), settings);
+    REQUIRE(bvh.GetPrimitiveCount() == boxes.size());
+    REQUIRE(bvh.GetNodeCount() < boxes.size());
+
+    // Every primitive appears exactly once in the leaf order
+    std::vector<uint32_t> leaves = Sorted(bvh.GetLeafIndices());
+    for (uint32_t i = 0; i < leaves.size(); i++)
+        REQUIRE(leaves[i] == i);
+
+    // Child bounds contain their primitives, and the first inner child follows its parent
+    const std::vector<BVHNode> &nodes = bvh.GetNodes();
+    for (size_t n = 0; n < nodes.size(); n++)
+    {
+        const BVHNode &node = nodes[n];
+        if (!node.IsLeaf(0))
+            REQUIRE(node.child[0] == n + 1);
+
+        for (uint32_t c = 0; c < 2; c++)
+        {
+            if (!node.IsLeaf(c))
+                continue;
+
+            const BoundingBox child_bounds(Vec3(node.min_x[c], node.min_y[c], node.min_z[c]), Vec3(node.max_x[c], node.max_y[c], node.max_z[c]));
+            for (uint32_t i = node.child[c]; i < node.child[c] + node.count[c]; i++)
+            {
+                const BoundingBox &box = boxes[bvh.GetLeafIndices()[i]];
+                REQUIRE(child_bounds.Contains(box.GetMin()));
+                REQUIRE(child_bounds.Contains(box.GetMax()));
+            }
+        }
+    }
+
+    const BoundingBox bounds = bvh.GetBounds();
+    for (const BoundingBox &box : boxes)
+        REQUIRE(bounds.Contains(box.GetCenter()));
+}
+
+TEST_CASE("BVH linear build produces a valid hierarchy", "[math][bvh]")
+{
+    const std::vector<BoundingBox> boxes = MakeRandomBoxes(20000, 3);
+
+    BVHBuildSettings settings;
+    settings.method = BVHBuildMethod::Linear;
+    settings.max_leaf_size = GENERATE(1u, 4u);
+    settings.parallel_threshold = 256;
+    settings.thread_count = 4;
+
+    BVH bvh;
+    bvh.Build(boxes.data(), boxes.size(), settings);
+    REQUIRE(bvh.GetPrimitiveCount() == boxes.size());
+    REQUIRE(bvh.GetNodeCount() < boxes.size());
+
+    std::vector<uint32_t> leaves = Sorted(bvh.GetLeafIndices());
+    for (uint32_t i = 0; i < leaves.size(); i++)
+        REQUIRE(leaves[i] == i);
+
+    // Child bounds are the exact union of their contents, and every primitive sits in one leaf
+    const std::vector<BVHNode> &nodes = bvh.GetNodes();
+    std::vector<uint32_t> leaf_count(boxes.size(), 0);
+    const auto child_bounds = [&](const BVHNode &node, uint32_t c)
+    {
+        return BoundingBox(Vec3(node.min_x[c], node.min_y[c], node.min_z[c]), Vec3(node.max_x[c], node.max_y[c], node.max_z[c]));
+    };
+    for (const BVHNode &node : nodes)
+    {
+        for (uint32_t c = 0; c < 2; c++)
+        {
+            const BoundingBox bounds = child_bounds(node, c);
+            if (node.IsLeaf(c))
+            {
+                REQUIRE(node.count[c] <= settings.max_leaf_size);
+                for (uint32_t i = node.child[c]; i < node.child[c] + node.count[c]; i++)
+                {
+                    const BoundingBox &box = boxes[bvh.GetLeafIndices()[i]];
+                    REQUIRE(bounds.Contains(box.GetMin()));
+                    REQUIRE(bounds.Contains(box.GetMax()));
+                    leaf_count[bvh.GetLeafIndices()[i]]++;
+                }
+                continue;
+            }
+
+            const BVHNode &child = nodes[node.child[c]];
+            for (uint32_t g = 0; g < 2; g++)
+            {
+                const BoundingBox grandchild = child_bounds(child, g);
+                REQUIRE(bounds.Contains(grandchild.GetMin()));
+                REQUIRE(bounds.Contains(grandchild.GetMax()));
+            }
+        }
+    }
+    REQUIRE(std::all_of(leaf_count.begin(), leaf_count.end(), [](uint32_t count) { return count == 1; }));
+
+    // Coincident centers all get the same Morton code and are split by position
+    const std::vector<BoundingBox> same(1000, BoundingBox(Vec3(1.0f), Vec3(2.0f)));
+    bvh.Build(same.data(), same.size(), settings);
+    std::vector<uint32_t> results;
+    bvh.QueryOverlap(BoundingBox(Vec3(0.0f), Vec3(1.5f)), results);
+    REQUIRE(results.size() == 1000);
+}
+
+TEST_CASE("BVH queries match brute force", "[math][bvh]")
+{
+    const std::vector<BoundingBox> boxes = MakeRandomBoxes(2000, 7);
+    BVHBuildSettings settings;
+    settings.method = GENERATE(BVHBuildMethod::BinnedSAH, BVHBuildMethod::Linear);
+    BVH bvh;
+    bvh.Build(boxes.data(), boxes.size(), settings);
+
+    SECTION("Overlap")
+    {
+        const BoundingBox query(Vec3(-20.0f, -10.0f, -30.0f), Vec3(15.0f, 25.0f, 5.0f));
+        std::vector<uint32_t> expected;
+        for (uint32_t i = 0; i < boxes.size(); i++)
+            if (Overlaps(boxes[i], query))
+                expected.push_back(i);
+
+        std::vector<uint32_t> results;
+        bvh.QueryOverlap(query, results);
+        REQUIRE(Sorted(results) == expected);
+    }
+
+    SECTION("Frustum")
+    {
+        const Mat4 view = LookAt(Vec3(0.0f, 0.0f, 0.0f), Vec3(0.3f, 0.1f, -1.0f), Vec3(0.0f, 1.0f, 0.0f));
+        const Frustum frustum(Perspective(PI * 0.4f, 1.5f, 1.0f, 80.0f) * view, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE);
+
+        std::vector<uint32_t> expected;
+        for (uint32_t i = 0; i < boxes.size(); i++)
+            if (frustum.IsVisible(boxes[i].GetCenter(), boxes[i].GetExtents(), false))
+                expected.push_back(i);
+
+        std::vector<uint32_t> results;
+        bvh.QueryFrustum(frustum, results);
+        REQUIRE(!expected.empty());
+        REQUIRE(Sorted(results) == expected);
+    }
+
+    SECTION("Ray")
+    {
+        // Aim through one of the boxes so the segment is guaranteed to hit something
+        const Vec3 origin(-120.0f, 3.0f, 2.0f);
+        const Vec3 direction = Normalize(boxes[42].GetCenter() - origin);
+
+        std::vector<uint32_t> expected;
+        float nearest = 1e30f;
+        uint32_t nearest_index = 0;
+        for (uint32_t i = 0; i < boxes.size(); i++)
+        {
+            const float t = RayBox(boxes[i], origin, direction, 500.0f);
+            if (t < 0.0f)
+                continue;
+            expected.push_back(i);
+            if (t < nearest)
+            {
+                nearest = t;
+                nearest_index = i;
+            }
+        }
+
+        std::vector<uint32_t> results;
+        bvh.QueryRay(origin, direction, 500.0f, results);
+        REQUIRE(!expected.empty());
+        REQUIRE(Sorted(results) == expected);
+
+        uint32_t primitive = 0;
+        float distance = 0.0f;
+        REQUIRE(bvh.RaycastBounds(origin, direction, 500.0f, primitive, distance));
+        REQUIRE(primitive == nearest_index);
+        REQUIRE(distance == Catch::Approx(nearest));
+
+        REQUIRE_FALSE(bvh.RaycastBounds(origin, direction, 5.0f, primitive, distance));
+    }
+
+    SECTION("Closest")
+    {
+        const Vec3 points[3] = { Vec3(0.0f, 0.0f, 0.0f), Vec3(150.0f, -20.0f, 40.0f), Vec3(-33.0f, 71.0f, 12.0f) };
+        for (const Vec3 &point : points)
+        {
+            float expected = 1e30f;
+            for (const BoundingBox &box : boxes)
+                expected = std::min(expected, BoxDistance(box, point));
+
+            uint32_t primitive = 0;
+            float distance = 0.0f;
+            REQUIRE(bvh.QueryClosest(point, primitive, distance));
+            REQUIRE(distance == Catch::Approx(expected).margin(1e-4));
+            REQUIRE(BoxDistance(boxes[primitive], point) == Catch::Approx(expected).margin(1e-4));
+        }
+    }
+}
+
+TEST_CASE("BVH handles tiny and degenerate inputs", "[math][bvh]")
+{
+    BVH bvh;
+    bvh.Build(nullptr, 0);
+    REQUIRE(bvh.IsEmpty());
+
+    std::vector<uint32_t> results;
+    bvh.QueryOverlap(BoundingBox(Vec3(-1.0f), Vec3(1.0f)), results);
+    REQUIRE(results.empty());
+
+    // A single primitive becomes a root with one leaf slot
+    const BoundingBox single(Vec3(0.0f), Vec3(1.0f));
+    bvh.Build(&single, 1);
+    REQUIRE(bvh.GetNodeCount() == 1);
+    bvh.QueryOverlap(BoundingBox(Vec3(0.5f), Vec3(2.0f)), results);
+    REQUIRE(results == std::vector<uint32_t>{0});
+
+    // Identical boxes cannot be split by the SAH and fall back to a median split
+    const std::vector<BoundingBox> same(100, BoundingBox(Vec3(1.0f), Vec3(2.0f)));
+    bvh.Build(same.data(), same.size());
+    results.clear();
+    bvh.QueryOverlap(BoundingBox(Vec3(0.0f), Vec3(1.5f)), results);
+    REQUIRE(results.size() == 100);
+}
+
+TEST_CASE("BVH refit tracks moving primitives", "[math][bvh]")
+{
+    std::vector<BoundingBox> boxes = MakeRandomBoxes(3000, 11);
+    BVH bvh;
+    bvh.Build(boxes.data(), boxes.size());
+
+    // Nothing dirty, nothing to visit
+    REQUIRE(bvh.Refit() == 0);
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<uint32_t> pick(0, static_cast<uint32_t>(boxes.size() - 1));
+    std::uniform_real_distribution<float> offset(-4.0f, 4.0f);
+
+    const BoundingBox query(Vec3(-30.0f, -30.0f, -30.0f), Vec3(30.0f, 30.0f, 30.0f));
+    for (int frame = 0; frame < 10; frame++)
+    {
+        for (int i = 0; i < 50; i++)
+        {
+            const uint32_t index = pick(rng);
+            const Vec3 delta = RandomVector(rng, offset);
+            boxes[index] = BoundingBox(boxes[index].GetMin() + delta, boxes[index].GetMax() + delta);
+            bvh.UpdatePrimitive(index, boxes[index]);
+        }
+
+        const size_t visited = bvh.Refit();
+        REQUIRE(visited > 0);
+        REQUIRE(visited < bvh.GetNodeCount());
+
+        // Rotations on alternate frames must leave the queries intact
+        if (frame % 2 == 1)
+            bvh.Optimize();
+
+        std::vector<uint32_t> expected;
+        for (uint32_t i = 0; i < boxes.size(); i++)
+            if (Overlaps(boxes[i], query))
+                expected.push_back(i);
+
+        std::vector<uint32_t> results;
+        bvh.QueryOverlap(query, results);
+        REQUIRE(Sorted(results) == expected);
+
+        const BoundingBox bounds = bvh.GetBounds();
+        for (const BoundingBox &box : boxes)
+            REQUIRE(bounds.Contains(box.GetCenter()));
+    }
+}
+
+TEST_CASE("BVH rotations reduce surface area after large moves", "[math][bvh]")
+{
+    std::vector<BoundingBox> boxes = MakeRandomBoxes(1000, 3);
+    BVH bvh;
+    bvh.Build(boxes.data(), boxes.size());
+
+    const auto total_area = [&bvh]()
+    {
+        float area = 0.0f;
+        for (const BVHNode &node : bvh.GetNodes())
+            for (uint32_t c = 0; c < 2; c++)
+                if (!node.IsEmpty(c))
+                {
+                    const float dx = node.max_x[c] - node.min_x[c], dy = node.max_y[c] - node.min_y[c], dz = node.max_z[c] - node.min_z[c];
+                    area += dx * dy + dy * dz + dz * dx;
+                }
+        return area;
+    };
+
+    // Scatter a block of primitives so the original topology becomes poor
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    for (uint32_t i = 0; i < 300; i++)
+    {
+        const Vec3 min = RandomVector(rng, position);
+        boxes[i] = BoundingBox(min, min + Vec3(1.0f));
+        bvh.UpdatePrimitive(i, boxes[i]);
+    }
+    bvh.Refit();
+
+    const float before = total_area();
+    REQUIRE(bvh.Optimize() > 0);
+    bvh.Refit();
+    REQUIRE(total_area() < before);
+
+    std::vector<uint32_t> results;
+    bvh.QueryOverlap(BoundingBox(Vec3(-200.0f), Vec3(200.0f)), results);
+    REQUIRE(results.size() == boxes.size());
+}
+
+TEST_CASE("BVH rotations keep the depth bounded", "[math][bvh]")
+{
+    std::vector<BoundingBox> boxes = MakeRandomBoxes(2000, 21);
+    BVH bvh;
+    bvh.Build(boxes.data(), boxes.size());
+
+    const auto tree_depth = [&bvh]()
+    {
+        const std::vector<BVHNode> &nodes = bvh.GetNodes();
+        uint32_t deepest = 0;
+        std::vector<std::pair<uint32_t, uint32_t>> stack = { { 0u, 1u } };
+        while (!stack.empty())
+        {
+            const auto [index, depth] = stack.back();
+            stack.pop_back();
+            deepest = std::max(deepest, depth);
+            for (uint32_t c = 0; c < 2; c++)
+                if (!nodes[index].IsLeaf(c) && !nodes[index].IsEmpty(c))
+                    stack.emplace_back(nodes[index].child[c], depth + 1);
+        }
+        return deepest;
+    };
+
+    // Peel primitives off one at a time onto a geometric progression; the best SAH tree over such
+    // points is a chain, so rotations keep pushing the tree deeper
+    for (uint32_t i = 0; i < 150; i++)
+    {
+        const Vec3 min(1000.0f * std::pow(1.6f, static_cast<float>(i)), 0.0f, 0.0f);
+        boxes[i] = BoundingBox(min, min + Vec3(1.0f));
+        bvh.UpdatePrimitive(i, boxes[i]);
+        bvh.Refit();
+        bvh.Optimize();
+        REQUIRE(tree_depth() <= 60);
+    }
+
+    std::vector<uint32_t> results;
+    bvh.QueryOverlap(BoundingBox(Vec3(-200.0f), Vec3(FLT_MAX)), results);
+    REQUIRE(results.size() == boxes.size());
+}
+
+TEST_CASE("BVH refit vs rebuild", "[.][benchmark][bvh]")
+{
+    std::vector<BoundingBox> boxes = MakeRandomBoxes(100000, 21);
+    BVH bvh;
+    bvh.Build(boxes.data(), boxes.size());
+
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<uint32_t> pick(0, static_cast<uint32_t>(boxes.size() - 1));
+    std::uniform_real_distribution<float> offset(-0.5f, 0.5f);
+
+    // Five percent of the scene moves every frame
+    const auto move = [&]()
+    {
+        for (int i = 0; i < 5000; i++)
+        {
+            const uint32_t index = pick(rng);
+            const Vec3 delta = RandomVector(rng, offset);
+            boxes[index] = BoundingBox(boxes[index].GetMin() + delta, boxes[index].GetMax() + delta);
+            bvh.UpdatePrimitive(index, boxes[index]);
+        }
+    };
+
+    BENCHMARK("Refit")
+    {
+        move();
+        return bvh.Refit();
+    };
+
+    BENCHMARK("Refit + Optimize")
+    {
+        move();
+        bvh.Refit();
+        return bvh.Optimize();
+    };
+
+    BENCHMARK("Rebuild")
+    {
+        move();
+        bvh.Build(boxes.data(), boxes.size());
+        return bvh.GetNodeCount();
+    };
+}
+
+TEST_CASE("BVH packet traversal matches single rays", "[math][bvh][ray]")
+{
+    const std::vector<BoundingBox> boxes = MakeRandomBoxes(3000, 13);
+    BVH bvh;
+    bvh.Build(boxes.data(), boxes.size());
+
+    // A coherent fan of rays, as used for picking or line-of-sight checks; two lanes miss everything
+    Ray rays[RayPacket8::LANES];
+    const Vec3 origin(-120.0f, 0.0f, 0.0f);
+    for (uint32_t lane = 0; lane < 6; lane++)
+        rays[lane] = Ray(origin, Normalize(boxes[lane * 100].GetCenter() - origin), 400.0f);
+    rays[6] = Ray(origin, Vec3(-1.0f, 0.0f, 0.0f), 400.0f);
+    rays[7] = Ray(origin, Normalize(boxes[700].GetCenter() - origin), 1.0f);
+
+    const RayPacket8 packet(rays, RayPacket8::LANES);
+    uint32_t primitives[RayPacket8::LANES];
+    float distances[RayPacket8::LANES];
+    const uint8_t hits = bvh.RaycastBounds(packet, primitives, distances);
+    REQUIRE(bvh.TestOcclusion(packet) == hits);
+
+    for (uint32_t lane = 0; lane < RayPacket8::LANES; lane++)
+    {
+        uint32_t primitive = 0;
+        float distance = 0.0f;
+        const bool hit = bvh.RaycastBounds(rays[lane].origin, rays[lane].direction, rays[lane].max_distance, primitive, distance);
+        REQUIRE(hit == ((hits >> lane) & 1u));
+        if (hit)
+            REQUIRE(distances[lane] == Catch::Approx(distance));
+    }
+    REQUIRE((hits & 0x3F) == 0x3F);
+    REQUIRE((hits & 0xC0) == 0);
+
+    // Inactive lanes are never traced
+    RayPacket8 partial = packet;
+    partial.active = 0x05;
+    REQUIRE(bvh.RaycastBounds(partial, primitives, distances) == 0x05);
+    REQUIRE(bvh.TestOcclusion(partial) == 0x05);
+}
+
+TEST_CASE("BVH linear vs SAH build", "[.][benchmark][bvh]")
+{
+    const std::vector<BoundingBox> boxes = MakeRandomBoxes(1000000, 23);
+    BVH bvh;
+
+    BENCHMARK("Binned SAH, 1M boxes")
+    {
+        bvh.Build(boxes.data(), boxes.size());
+        return bvh.GetNodeCount();
+    };
+
+    BVHBuildSettings settings;
+    settings.method = BVHBuildMethod::Linear;
+    BENCHMARK("Linear, 1M boxes")
+    {
+        bvh.Build(boxes.data(), boxes.size(), settings);
+        return bvh.GetNodeCount();
+    };
+}
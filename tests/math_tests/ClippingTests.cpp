@@ -0,0 +1,276 @@
+﻿#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <xmath.hpp>
+#include <catch2/catch_all.hpp>
+#include "RandomGeometry.h"
+
+using namespace xMath;
+using TestUtils::RandomVector;
+
+namespace
+{
+    float PolygonArea(const Vec3 *polygon, uint32_t count)
+    {
+        Vec3 sum(0.0f);
+        for (uint32_t i = 1; i + 1 < count; i++)
+            sum += Cross(polygon[i] - polygon[0], polygon[i + 1] - polygon[0]);
+        return 0.5f * Length(sum);
+    }
+
+    bool InsidePolygon(const Vec3 *polygon, uint32_t count, const Vec3 &normal, const Vec3 &point, float margin)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const Vec3 edge = polygon[(i + 1) % count] - polygon[i];
+            const Vec3 inward = Normalize(Cross(normal, edge));
+            if (Dot(inward, point - polygon[i]) < margin)
+                return false;
+        }
+        return true;
+    }
+
+    // Regular polygon in a random plane
+    std::vector<Vec3> MakeRandomPolygon(std::mt19937 &rng, uint32_t sides, float radius, Vec3 &normal)
+    {
+        std::normal_distribution<float> gaussian;
+        std::uniform_real_distribution<float> position(-1.0f, 1.0f);
+        normal = Normalize(RandomVector(rng, gaussian));
+        const Vec3 u = Normalize(Cross(normal, std::abs(normal.x) < 0.6f ? Vec3(1.0f, 0.0f, 0.0f) : Vec3(0.0f, 1.0f, 0.0f)));
+        const Vec3 v = Cross(normal, u);
+        const Vec3 center = RandomVector(rng, position);
+        std::vector<Vec3> polygon;
+        for (uint32_t i = 0; i < sides; i++)
+        {
+            const float angle = 2.0f * PI * static_cast<float>(i) / static_cast<float>(sides);
+            polygon.push_back(center + u * (std::cos(angle) * radius) + v * (std::sin(angle) * radius));
+        }
+        return polygon;
+    }
+
+    // Planes of a box, facing inward
+    std::vector<Plane> MakeBoxPlanes(const Vec3 &min, const Vec3 &max)
+    {
+        return { Plane(Vec3(1.0f, 0.0f, 0.0f), -min.x), Plane(Vec3(-1.0f, 0.0f, 0.0f), max.x),
+                 Plane(Vec3(0.0f, 1.0f, 0.0f), -min.y), Plane(Vec3(0.0f, -1.0f, 0.0f), max.y),
+                 Plane(Vec3(0.0f, 0.0f, 1.0f), -min.z), Plane(Vec3(0.0f, 0.0f, -1.0f), max.z) };
+    }
+
+    std::vector<Vec3> MakeSphereMesh(float radius, int slices, int stacks)
+    {
+        std::vector<Vec3> triangles;
+        const auto point = [&](int i, int j)
+        {
+            const float theta = PI * static_cast<float>(j) / static_cast<float>(stacks);
+            const float phi = 2.0f * PI * static_cast<float>(i) / static_cast<float>(slices);
+            return Vec3(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)) * radius;
+        };
+        for (int j = 0; j < stacks; j++)
+        {
+            for (int i = 0; i < slices; i++)
+            {
+                triangles.insert(triangles.end(), { point(i, j), point(i + 1, j), point(i + 1, j + 1) });
+                triangles.insert(triangles.end(), { point(i, j), point(i + 1, j + 1), point(i, j + 1) });
+            }
+        }
+        return triangles;
+    }
+}
+
+TEST_CASE("Clipping a polygon against one plane", "[math][clipping]")
+{
+    const Vec3 square[4] = { Vec3(0.0f, 0.0f, 0.0f), Vec3(2.0f, 0.0f, 0.0f), Vec3(2.0f, 2.0f, 0.0f), Vec3(0.0f, 2.0f, 0.0f) };
+    Vec3 output[5];
+
+    // Keeps x >= 0.5
+    uint32_t count = ClipPolygon(square, 4, Plane(Vec3(1.0f, 0.0f, 0.0f), -0.5f), output, 0.0f);
+    REQUIRE(count == 4);
+    REQUIRE(PolygonArea(output, count) == Catch::Approx(3.0f));
+    for (uint32_t i = 0; i < count; i++)
+        REQUIRE(output[i].x >= 0.5f);
+
+    // Cutting a corner adds a vertex
+    count = ClipPolygon(square, 4, Plane(Normalize(Vec3(-1.0f, -1.0f, 0.0f)), Vec3(1.5f, 1.5f, 0.0f)), output, 0.0f);
+    REQUIRE(count == 5);
+    REQUIRE(PolygonArea(output, count) == Catch::Approx(3.5f));
+
+    // Fully in front, fully behind, and a vertex within epsilon of the plane is not split
+    REQUIRE(ClipPolygon(square, 4, Plane(Vec3(0.0f, 0.0f, 1.0f), 1.0f), output, 0.0f) == 4);
+    REQUIRE(ClipPolygon(square, 4, Plane(Vec3(0.0f, 0.0f, 1.0f), -1.0f), output, 0.0f) == 0);
+    count = ClipPolygon(square, 4, Plane(Normalize(Vec3(-1.0f, -1.0f, 0.0f)), Vec3(2.0f, 2.0f, 0.0f) - Normalize(Vec3(1.0f, 1.0f, 0.0f)) * 1e-5f), output, 1e-4f);
+    REQUIRE(count == 4);
+
+    // Triangles sharing an edge get bit-identical points on it
+    const Vec3 a(0.0f, 0.0f, 0.0f), b(3.1f, 0.2f, 0.7f), c(0.4f, 2.9f, -0.3f), d(3.3f, 3.0f, 1.1f);
+    const Vec3 first[3] = { a, b, c }, second[3] = { c, b, d };
+    const Plane plane(Normalize(Vec3(1.0f, 0.7f, 0.3f)), -2.0f);
+    Vec3 first_out[4], second_out[4];
+    const uint32_t first_count = ClipPolygon(first, 3, plane, first_out, 0.0f);
+    const uint32_t second_count = ClipPolygon(second, 3, plane, second_out, 0.0f);
+    size_t shared = 0;
+    for (uint32_t i = 0; i < first_count; i++)
+        for (uint32_t j = 0; j < second_count; j++)
+            shared += first_out[i].x == second_out[j].x && first_out[i].y == second_out[j].y && first_out[i].z == second_out[j].z;
+    REQUIRE(shared == 2);
+}
+
+TEST_CASE("Clipping polygons against plane sets matches point sampling", "[math][clipping]")
+{
+    std::mt19937 rng(49);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    const Mat4 view = LookAt(Vec3(0.0f, 0.0f, 3.0f), Vec3(0.1f, -0.2f, 0.0f), Vec3(0.0f, 1.0f, 0.0f));
+    const Frustum frustum(Perspective(PI * 0.3f, 1.3f, 1.5f, 4.0f) * view, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE);
+    std::vector<Plane> frustum_planes;
+    for (uint32_t i = 0; i < 6; i++)
+        frustum_planes.push_back(frustum.GetPlane(i));
+    const std::vector<Plane> box_planes = MakeBoxPlanes(Vec3(-0.6f, -0.5f, -0.4f), Vec3(0.5f, 0.7f, 0.6f));
+
+    Vec3 output[8 + 6], scratch[8 + 6];
+    size_t clipped = 0, culled = 0;
+    for (int trial = 0; trial < 300; trial++)
+    {
+        const std::vector<Plane> &planes = trial % 2 == 0 ? frustum_planes : box_planes;
+        Vec3 normal;
+        const std::vector<Vec3> polygon = MakeRandomPolygon(rng, 3 + trial % 6, 0.8f, normal);
+        const uint32_t count = ClipPolygon(polygon.data(), static_cast<uint32_t>(polygon.size()), planes.data(), 6, output, scratch, 0.0f);
+        clipped += count > 0 && count != polygon.size();
+        culled += count == 0;
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            for (const Plane &plane : planes)
+                REQUIRE(plane.Dot(output[i]) >= -1e-4f);
+            REQUIRE(std::abs(Dot(normal, output[i] - polygon[0])) < 1e-4f);
+        }
+        if (count > 0)
+            REQUIRE(Dot(Cross(output[1] - output[0], output[2] - output[0]), normal) >= -1e-6f);
+
+        // Points of the polygon are in the result exactly when they are in front of every plane
+        for (int sample = 0; sample < 50; sample++)
+        {
+            const uint32_t i = static_cast<uint32_t>(unit(rng) * static_cast<float>(polygon.size() - 2)) + 1;
+            float s = unit(rng), t = unit(rng);
+            if (s + t > 1.0f)
+            {
+                s = 1.0f - s;
+                t = 1.0f - t;
+            }
+            const Vec3 point = polygon[0] + (polygon[i] - polygon[0]) * s + (polygon[i + 1] - polygon[0]) * t;
+
+            float margin = 1e30f;
+            for (const Plane &plane : planes)
+                margin = std::min(margin, plane.Dot(point));
+            if (margin > 1e-3f)
+                REQUIRE(InsidePolygon(output, count, normal, point, -1e-4f));
+            else if (margin < -1e-3f && count > 0)
+                REQUIRE_FALSE(InsidePolygon(output, count, normal, point, 1e-4f));
+        }
+    }
+    REQUIRE(clipped > 50);
+    REQUIRE(culled > 10);
+
+    // Outcodes
+    std::vector<Vec3> points;
+    for (int i = 0; i < 100; i++)
+        points.push_back(RandomVector(rng, unit) * 2.0f - Vec3(1.0f));
+    std::vector<uint32_t> codes(points.size());
+    const ClipCodes result = ClassifyPoints(box_planes.data(), 6, points.data(), points.size(), codes.data());
+    uint32_t any = 0, all = 0x3F;
+    for (size_t p = 0; p < points.size(); p++)
+    {
+        uint32_t expected = 0;
+        for (uint32_t i = 0; i < 6; i++)
+            expected |= box_planes[i].Dot(points[p]) < 0.0f ? 1u << i : 0u;
+        REQUIRE(codes[p] == expected);
+        any |= expected;
+        all &= expected;
+    }
+    REQUIRE(result.any_outside == any);
+    REQUIRE(result.all_outside == all);
+}
+
+TEST_CASE("Clipping triangle lists", "[math][clipping]")
+{
+    const std::vector<Vec3> mesh = MakeSphereMesh(1.0f, 24, 16);
+    const size_t triangle_count = mesh.size() / 3;
+    const std::vector<Plane> planes = MakeBoxPlanes(Vec3(-0.3f, -2.0f, -0.7f), Vec3(2.0f, 0.4f, 0.5f));
+
+    std::vector<Vec3> output(triangle_count * 7 * 3);
+    std::vector<uint32_t> sources(triangle_count * 7);
+    const size_t count = ClipTriangles(mesh.data(), nullptr, triangle_count, planes.data(), 6, output.data(), triangle_count * 7, sources.data(), 0.0f);
+    REQUIRE(count > 0);
+
+    // Same area per source triangle as clipping each polygon on its own
+    std::vector<float> clipped_area(triangle_count, 0.0f);
+    for (size_t t = 0; t < count; t++)
+    {
+        REQUIRE(sources[t] < triangle_count);
+        clipped_area[sources[t]] += PolygonArea(&output[t * 3], 3);
+        for (int corner = 0; corner < 3; corner++)
+            for (const Plane &plane : planes)
+                REQUIRE(plane.Dot(output[t * 3 + corner]) >= -1e-5f);
+    }
+    Vec3 polygon[9], scratch[9];
+    size_t kept = 0;
+    for (size_t t = 0; t < triangle_count; t++)
+    {
+        const uint32_t n = ClipPolygon(&mesh[t * 3], 3, planes.data(), 6, polygon, scratch, 0.0f);
+        kept += n > 0;
+        REQUIRE(clipped_area[t] == Catch::Approx(PolygonArea(polygon, n)).margin(1e-6f));
+    }
+    REQUIRE(kept < triangle_count);
+
+    // Indexed input gives the same triangles
+    std::vector<uint32_t> indices(mesh.size());
+    for (size_t i = 0; i < indices.size(); i++)
+        indices[i] = static_cast<uint32_t>(indices.size() - 1 - i);
+    std::vector<Vec3> reversed(mesh.rbegin(), mesh.rend());
+    std::vector<Vec3> indexed_output(output.size());
+    const size_t indexed_count = ClipTriangles(reversed.data(), indices.data(), triangle_count, planes.data(), 6, indexed_output.data(), triangle_count * 7, nullptr, 0.0f);
+    REQUIRE(indexed_count == count);
+    for (size_t i = 0; i < count * 3; i++)
+        REQUIRE(Distance(indexed_output[i], output[i]) == 0.0f);
+
+    // The output stops when full, and no planes keeps everything
+    REQUIRE(ClipTriangles(mesh.data(), nullptr, triangle_count, planes.data(), 6, output.data(), 10, nullptr, 0.0f) == 10);
+    REQUIRE(ClipTriangles(mesh.data(), nullptr, triangle_count, planes.data(), 0, output.data(), triangle_count, nullptr, 0.0f) == triangle_count);
+}
+
+TEST_CASE("Clipping benchmark", "[.][benchmark][clipping]")
+{
+    const std::vector<Vec3> mesh = MakeSphereMesh(1.0f, 512, 256);
+    const size_t triangle_count = mesh.size() / 3;
+    const Mat4 view = LookAt(Vec3(0.0f, 0.0f, 2.5f), Vec3(0.4f, 0.0f, 0.0f), Vec3(0.0f, 1.0f, 0.0f));
+    const Frustum frustum(Perspective(PI * 0.25f, 1.5f, 1.0f, 3.0f) * view, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE);
+    Plane planes[6];
+    for (uint32_t i = 0; i < 6; i++)
+        planes[i] = frustum.GetPlane(i);
+    std::vector<Vec3> output(triangle_count * 7 * 3);
+
+    auto start = std::chrono::steady_clock::now();
+    const size_t count = ClipTriangles(mesh.data(), nullptr, triangle_count, planes, 6, output.data(), triangle_count * 7);
+    const double batched_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // Plane by plane, as before
+    start = std::chrono::steady_clock::now();
+    size_t naive_count = 0;
+    Vec3 a[9], b[9];
+    for (size_t t = 0; t < triangle_count; t++)
+    {
+        uint32_t n = 3;
+        std::copy(&mesh[t * 3], &mesh[t * 3] + 3, a);
+        for (uint32_t p = 0; p < 6 && n >= 3; p++)
+        {
+            n = ClipPolygon(a, n, planes[p], b);
+            std::copy(b, b + n, a);
+        }
+        naive_count += n >= 3 ? n - 2 : 0;
+    }
+    const double naive_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%zu triangles against 6 frustum planes: batched %.2f ms, plane by plane %.2f ms, %zu output triangles\n", triangle_count, batched_ms, naive_ms, count);
+    REQUIRE(count == naive_count);
+}
@@ -0,0 +1,232 @@
+﻿#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <xmath.hpp>
+#include <catch2/catch_all.hpp>
+#include "RandomGeometry.h"
+
+using namespace xMath;
+using TestUtils::RandomPoint;
+
+namespace
+{
+    float DistanceSquared(const Vec3 &a, const Vec3 &b)
+    {
+        return Dot(a - b, a - b);
+    }
+
+    // Points of a triangle on a barycentric grid
+    std::vector<Vec3> SampleTriangle(const Vec3 &a, const Vec3 &b, const Vec3 &c, int steps)
+    {
+        std::vector<Vec3> samples;
+        for (int i = 0; i <= steps; i++)
+        {
+            for (int j = 0; i + j <= steps; j++)
+            {
+                const float u = static_cast<float>(i) / static_cast<float>(steps);
+                const float v = static_cast<float>(j) / static_cast<float>(steps);
+                samples.push_back(a + (b - a) * u + (c - a) * v);
+            }
+        }
+        return samples;
+    }
+
+    bool OnTriangle(const Vec3 &point, const Vec3 &a, const Vec3 &b, const Vec3 &c, float tolerance)
+    {
+        const Vec3 normal = Normalize(Cross(b - a, c - a));
+        if (std::abs(Dot(normal, point - a)) > tolerance)
+            return false;
+        return Dot(Cross(b - a, point - a), normal) >= -tolerance * Length(b - a) && Dot(Cross(c - b, point - b), normal) >= -tolerance * Length(c - b) &&
+               Dot(Cross(a - c, point - c), normal) >= -tolerance * Length(a - c);
+    }
+}
+
+TEST_CASE("Point-segment and point-triangle closest points", "[math][closest_point]")
+{
+    std::mt19937 rng(50);
+    Vec3SoA points, a, b, c;
+    for (int trial = 0; trial < 300; trial++)
+    {
+        const Vec3 p = RandomPoint(rng, 3.0f), v0 = RandomPoint(rng, 2.0f), v1 = RandomPoint(rng, 2.0f), v2 = RandomPoint(rng, 2.0f);
+        points.Add(p);
+        a.Add(v0);
+        b.Add(v1);
+        c.Add(v2);
+
+        // Segment: no sample along it is closer, and the offset is perpendicular unless clamped
+        const Vec3 on_segment = ClosestPointOnSegment(p, v0, v1);
+        for (int i = 0; i <= 100; i++)
+            REQUIRE(DistanceSquared(p, on_segment) <= DistanceSquared(p, v0 + (v1 - v0) * (static_cast<float>(i) / 100.0f)) + 1e-4f);
+
+        // Triangle: on the triangle, and no grid sample is closer
+        const Vec3 on_triangle = ClosestPointOnTriangle(p, v0, v1, v2);
+        REQUIRE(OnTriangle(on_triangle, v0, v1, v2, 1e-4f));
+        for (const Vec3 &sample : SampleTriangle(v0, v1, v2, 20))
+            REQUIRE(DistanceSquared(p, on_triangle) <= DistanceSquared(p, sample) + 1e-4f);
+    }
+
+    // Degenerate primitives
+    REQUIRE(Distance(ClosestPointOnSegment(Vec3(1.0f, 2.0f, 3.0f), Vec3(1.0f), Vec3(1.0f)), Vec3(1.0f)) == 0.0f);
+    const Vec3 collinear = ClosestPointOnTriangle(Vec3(1.0f, 1.0f, 0.0f), Vec3(0.0f), Vec3(1.0f, 0.0f, 0.0f), Vec3(2.0f, 0.0f, 0.0f));
+    REQUIRE(Distance(collinear, Vec3(1.0f, 0.0f, 0.0f)) == Catch::Approx(0.0f).margin(1e-6f));
+
+    // Batches match the scalar queries
+    std::vector<float> distances(points.Size());
+    Vec3SoA closest;
+    ClosestPointsOnSegments(points, a, b, distances.data(), &closest);
+    for (size_t i = 0; i < points.Size(); i++)
+    {
+        const Vec3 expected = ClosestPointOnSegment(points.Get(i), a.Get(i), b.Get(i));
+        REQUIRE(Distance(closest.Get(i), expected) < 1e-5f);
+        REQUIRE(distances[i] == Catch::Approx(DistanceSquared(points.Get(i), expected)).margin(1e-5f));
+    }
+
+    ClosestPointsOnTriangles(points, a, b, c, distances.data(), &closest);
+    for (size_t i = 0; i < points.Size(); i++)
+    {
+        const Vec3 expected = ClosestPointOnTriangle(points.Get(i), a.Get(i), b.Get(i), c.Get(i));
+        REQUIRE(Distance(closest.Get(i), expected) < 1e-3f);
+        REQUIRE(distances[i] == Catch::Approx(DistanceSquared(points.Get(i), expected)).margin(1e-4f));
+    }
+    std::vector<float> distances_only(points.Size());
+    ClosestPointsOnTriangles(points, a, b, c, distances_only.data());
+    REQUIRE(distances_only == distances);
+}
+
+TEST_CASE("Segment-segment closest points", "[math][closest_point]")
+{
+    std::mt19937 rng(51);
+    Vec3SoA a0, a1, b0, b1;
+    for (int trial = 0; trial < 200; trial++)
+    {
+        const Vec3 p0 = RandomPoint(rng, 2.0f), p1 = RandomPoint(rng, 2.0f), q0 = RandomPoint(rng, 2.0f), q1 = RandomPoint(rng, 2.0f);
+        a0.Add(p0);
+        a1.Add(p1);
+        b0.Add(q0);
+        b1.Add(q1);
+
+        Vec3 on_a, on_b;
+        const float distance = ClosestPointsSegmentSegment(p0, p1, q0, q1, on_a, on_b);
+        REQUIRE(distance == Catch::Approx(DistanceSquared(on_a, on_b)).margin(1e-6f));
+        REQUIRE(Distance(ClosestPointOnSegment(on_a, p0, p1), on_a) < 1e-5f);
+        REQUIRE(Distance(ClosestPointOnSegment(on_b, q0, q1), on_b) < 1e-5f);
+
+        float sampled = 1e30f;
+        for (int i = 0; i <= 60; i++)
+            for (int j = 0; j <= 60; j++)
+                sampled = std::min(sampled, DistanceSquared(p0 + (p1 - p0) * (static_cast<float>(i) / 60.0f), q0 + (q1 - q0) * (static_cast<float>(j) / 60.0f)));
+        REQUIRE(distance <= sampled + 1e-5f);
+        REQUIRE(std::sqrt(distance) >= std::sqrt(sampled) - 0.1f);
+    }
+
+    // Parallel, crossing, and point-like segments
+    Vec3 on_a, on_b;
+    REQUIRE(ClosestPointsSegmentSegment(Vec3(0.0f), Vec3(4.0f, 0.0f, 0.0f), Vec3(1.0f, 2.0f, 0.0f), Vec3(3.0f, 2.0f, 0.0f), on_a, on_b) == Catch::Approx(4.0f));
+    REQUIRE(on_a.x >= 0.0f);
+    REQUIRE(on_a.x <= 4.0f);
+    REQUIRE(ClosestPointsSegmentSegment(Vec3(-1.0f, 0.0f, 0.0f), Vec3(1.0f, 0.0f, 0.0f), Vec3(0.0f, -1.0f, 0.0f), Vec3(0.0f, 1.0f, 0.0f), on_a, on_b) == Catch::Approx(0.0f));
+    REQUIRE(ClosestPointsSegmentSegment(Vec3(0.0f, 3.0f, 0.0f), Vec3(0.0f, 3.0f, 0.0f), Vec3(-1.0f, 0.0f, 0.0f), Vec3(1.0f, 0.0f, 0.0f), on_a, on_b) == Catch::Approx(9.0f));
+    REQUIRE(Distance(on_b, Vec3(0.0f)) < 1e-6f);
+    REQUIRE(ClosestPointsSegmentSegment(Vec3(-1.0f, 0.0f, 0.0f), Vec3(1.0f, 0.0f, 0.0f), Vec3(2.0f, 1.0f, 0.0f), Vec3(2.0f, 1.0f, 0.0f), on_a, on_b) == Catch::Approx(2.0f));
+    REQUIRE(ClosestPointsSegmentSegment(Vec3(1.0f), Vec3(1.0f), Vec3(1.0f, 1.0f, 4.0f), Vec3(1.0f, 1.0f, 4.0f), on_a, on_b) == Catch::Approx(9.0f));
+
+    // The batch uses the same kernel
+    std::vector<float> distances(a0.Size());
+    Vec3SoA closest_a, closest_b;
+    ClosestPointsSegmentsSegments(a0, a1, b0, b1, distances.data(), &closest_a, &closest_b);
+    for (size_t i = 0; i < a0.Size(); i++)
+    {
+        REQUIRE(distances[i] == Catch::Approx(ClosestPointsSegmentSegment(a0.Get(i), a1.Get(i), b0.Get(i), b1.Get(i), on_a, on_b)).margin(1e-6f));
+        REQUIRE(Distance(closest_a.Get(i), on_a) < 1e-5f);
+        REQUIRE(Distance(closest_b.Get(i), on_b) < 1e-5f);
+    }
+}
+
+TEST_CASE("Point-OBB and triangle-triangle closest points", "[math][closest_point]")
+{
+    std::mt19937 rng(52);
+    const OrientedBoundingBox box(BoundingBox(Vec3(-1.0f, -0.5f, -2.0f), Vec3(1.0f, 0.5f, 2.0f)), Mat4::Translate(Vec3(0.5f, 1.0f, -1.0f)) * Mat4::RotationDegrees(Vec3(30.0f, 45.0f, -10.0f)));
+    Vec3SoA points;
+    for (int i = 0; i < 500; i++)
+        points.Add(RandomPoint(rng, 4.0f));
+    std::vector<float> distances(points.Size());
+    Vec3SoA closest;
+    ClosestPointsOnOBB(box, points, distances.data(), &closest);
+    size_t inside = 0;
+    for (size_t i = 0; i < points.Size(); i++)
+    {
+        const Vec3 expected = box.GetClosestPoint(points.Get(i));
+        REQUIRE(Distance(closest.Get(i), expected) < 1e-5f);
+        REQUIRE(distances[i] == Catch::Approx(DistanceSquared(points.Get(i), expected)).margin(1e-4f));
+        inside += distances[i] == 0.0f;
+    }
+    REQUIRE(inside > 0);
+
+    // Triangle pairs against grid sampling of both triangles
+    size_t intersecting = 0;
+    for (int trial = 0; trial < 60; trial++)
+    {
+        const Vec3 offset = RandomPoint(rng, 1.5f);
+        const Vec3 a0 = RandomPoint(rng, 1.0f), a1 = RandomPoint(rng, 1.0f), a2 = RandomPoint(rng, 1.0f);
+        const Vec3 b0 = RandomPoint(rng, 1.0f) + offset, b1 = RandomPoint(rng, 1.0f) + offset, b2 = RandomPoint(rng, 1.0f) + offset;
+
+        Vec3 on_a, on_b;
+        const float distance = ClosestPointsTriangleTriangle(a0, a1, a2, b0, b1, b2, on_a, on_b);
+        REQUIRE(OnTriangle(on_a, a0, a1, a2, 1e-4f));
+        REQUIRE(OnTriangle(on_b, b0, b1, b2, 1e-4f));
+        REQUIRE(distance == Catch::Approx(DistanceSquared(on_a, on_b)).margin(1e-6f));
+
+        const std::vector<Vec3> samples_a = SampleTriangle(a0, a1, a2, 16), samples_b = SampleTriangle(b0, b1, b2, 16);
+        float sampled = 1e30f;
+        for (const Vec3 &sample_a : samples_a)
+            for (const Vec3 &sample_b : samples_b)
+                sampled = std::min(sampled, DistanceSquared(sample_a, sample_b));
+        REQUIRE(distance <= sampled + 1e-5f);
+        REQUIRE(std::sqrt(distance) >= std::sqrt(sampled) - 0.2f);
+        intersecting += distance == 0.0f;
+    }
+    REQUIRE(intersecting > 0);
+
+    // Parallel triangles one unit apart, and a triangle piercing another
+    Vec3 on_a, on_b;
+    REQUIRE(ClosestPointsTriangleTriangle(Vec3(0.0f), Vec3(2.0f, 0.0f, 0.0f), Vec3(0.0f, 2.0f, 0.0f), Vec3(0.2f, 0.2f, 1.0f), Vec3(1.0f, 0.2f, 1.0f),
+                                          Vec3(0.2f, 1.0f, 1.0f), on_a, on_b) == Catch::Approx(1.0f));
+    REQUIRE(ClosestPointsTriangleTriangle(Vec3(0.0f), Vec3(2.0f, 0.0f, 0.0f), Vec3(0.0f, 2.0f, 0.0f), Vec3(0.5f, 0.5f, -1.0f), Vec3(0.5f, 0.5f, 1.0f),
+                                          Vec3(0.6f, 0.4f, 1.0f), on_a, on_b) == 0.0f);
+    REQUIRE(std::abs(on_a.z) < 1e-6f);
+}
+
+TEST_CASE("Closest point benchmark", "[.][benchmark][closest_point]")
+{
+    std::mt19937 rng(53);
+    constexpr size_t count = 1 << 20;
+    Vec3SoA points, a, b, c;
+    for (size_t i = 0; i < count; i++)
+    {
+        points.Add(RandomPoint(rng, 3.0f));
+        a.Add(RandomPoint(rng, 2.0f));
+        b.Add(RandomPoint(rng, 2.0f));
+        c.Add(RandomPoint(rng, 2.0f));
+    }
+    std::vector<float> distances(count);
+
+    auto start = std::chrono::steady_clock::now();
+    ClosestPointsOnTriangles(points, a, b, c, distances.data());
+    const double batch_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    double scalar_sum = 0.0;
+    for (size_t i = 0; i < count; i++)
+        scalar_sum += DistanceSquared(points.Get(i), ClosestPointOnTriangle(points.Get(i), a.Get(i), b.Get(i), c.Get(i)));
+    const double scalar_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    ClosestPointsSegmentsSegments(points, a, b, c, distances.data());
+    const double segments_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%zu point-triangle queries: batch %.2f ms, scalar %.2f ms (sum %.1f); %zu segment pairs: %.2f ms\n", count, batch_ms, scalar_ms, scalar_sum, count, segments_ms);
+    REQUIRE(batch_ms > 0.0);
+}
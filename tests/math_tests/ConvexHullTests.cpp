@@ -0,0 +1,237 @@
+﻿#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+#include <xmath.hpp>
+#include <catch2/catch_all.hpp>
+#include "RandomGeometry.h"
+
+using namespace xMath;
+using TestUtils::MakeRandomPoints;
+using TestUtils::RandomVector;
+
+namespace
+{
+    std::vector<Vec3> MakeSpherePoints(std::mt19937 &rng, size_t count, float radius)
+    {
+        std::normal_distribution<float> gaussian;
+        std::vector<Vec3> points(count);
+        for (Vec3 &point : points)
+            point = Normalize(RandomVector(rng, gaussian)) * radius;
+        return points;
+    }
+
+    // Input points that span a supporting plane with two other points
+    std::set<uint32_t> BruteForceHullVertices(const std::vector<Vec3> &points)
+    {
+        std::set<uint32_t> result;
+        const auto n = static_cast<uint32_t>(points.size());
+        for (uint32_t i = 0; i < n; i++)
+        {
+            for (uint32_t j = i + 1; j < n; j++)
+            {
+                for (uint32_t k = j + 1; k < n; k++)
+                {
+                    const Vec3 normal = Cross(points[j] - points[i], points[k] - points[i]);
+                    bool front = false, back = false;
+                    for (uint32_t m = 0; m < n && !(front && back); m++)
+                    {
+                        if (m == i || m == j || m == k)
+                            continue;
+                        const float side = Dot(normal, points[m] - points[i]);
+                        front |= side > 0.0f;
+                        back |= side < 0.0f;
+                    }
+                    if (!front || !back)
+                        result.insert({ i, j, k });
+                }
+            }
+        }
+        return result;
+    }
+
+    // Containment, vertices on their faces, convex counter-clockwise faces, closed manifold
+    // edges, symmetric adjacency and Euler's formula
+    void RequireValidHull(const ConvexHull &hull, const std::vector<Vec3> &points, float tolerance)
+    {
+        REQUIRE_FALSE(hull.IsEmpty());
+        const std::vector<Vec3> &vertices = hull.GetVertices();
+        REQUIRE(hull.GetSourceIndices().size() == vertices.size());
+        for (size_t v = 0; v < vertices.size(); v++)
+            REQUIRE(Distance(vertices[v], points[hull.GetSourceIndices()[v]]) == 0.0f);
+
+        for (const Vec3 &point : points)
+            REQUIRE(hull.Contains(point, tolerance));
+
+        size_t corner_count = 0;
+        for (size_t face = 0; face < hull.GetFaceCount(); face++)
+        {
+            const Plane &plane = hull.GetPlanes()[face];
+            uint32_t count;
+            const uint32_t *face_vertices = hull.GetFaceVertices(face, count);
+            REQUIRE(count >= 3);
+            corner_count += count;
+            for (uint32_t i = 0; i < count; i++)
+            {
+                const Vec3 &a = vertices[face_vertices[i]];
+                const Vec3 &b = vertices[face_vertices[(i + 1) % count]];
+                const Vec3 &c = vertices[face_vertices[(i + 2) % count]];
+                REQUIRE(std::abs(plane.Dot(a)) <= tolerance);
+                REQUIRE(Dot(Cross(b - a, c - b), plane.normal) > 0.0f);
+            }
+        }
+
+        const auto &edges = hull.GetEdges();
+        REQUIRE(edges.size() * 2 == corner_count);
+        for (const ConvexHull::Edge &edge : edges)
+        {
+            REQUIRE(edge.faces[0] != ConvexHull::INVALID_INDEX);
+            REQUIRE(edge.faces[1] != ConvexHull::INVALID_INDEX);
+            REQUIRE(edge.faces[0] != edge.faces[1]);
+        }
+        REQUIRE(vertices.size() + hull.GetFaceCount() == edges.size() + 2);
+
+        for (uint32_t v = 0; v < vertices.size(); v++)
+        {
+            uint32_t count;
+            const uint32_t *neighbors = hull.GetVertexNeighbors(v, count);
+            REQUIRE(count >= 2);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                uint32_t back_count;
+                const uint32_t *back = hull.GetVertexNeighbors(neighbors[i], back_count);
+                REQUIRE(std::find(back, back + back_count, v) != back + back_count);
+            }
+        }
+    }
+}
+
+TEST_CASE("Convex hull of random points matches a brute force reference", "[math][convex_hull]")
+{
+    std::mt19937 rng(48);
+    ConvexHull hull;
+    for (int trial = 0; trial < 20; trial++)
+    {
+        const std::vector<Vec3> points = MakeRandomPoints(rng, 60, 10.0f);
+        REQUIRE(hull.Build(points.data(), points.size()));
+        RequireValidHull(hull, points, 1e-4f);
+
+        const std::set<uint32_t> expected = BruteForceHullVertices(points);
+        const std::set<uint32_t> actual(hull.GetSourceIndices().begin(), hull.GetSourceIndices().end());
+        REQUIRE(actual == expected);
+    }
+
+    // Points on a sphere are all hull vertices, joined by triangles
+    const std::vector<Vec3> points = MakeSpherePoints(rng, 500, 5.0f);
+    REQUIRE(hull.Build(points.data(), points.size()));
+    RequireValidHull(hull, points, 1e-4f);
+    REQUIRE(hull.GetVertices().size() == points.size());
+    REQUIRE(hull.GetFaceCount() == points.size() * 2 - 4);
+
+    // Support by hill climbing matches the brute force maximum
+    for (int i = 0; i < 200; i++)
+    {
+        const Vec3 direction = MakeSpherePoints(rng, 1, 1.0f)[0];
+        float best = -1e30f;
+        for (const Vec3 &point : points)
+            best = std::max(best, Dot(point, direction));
+        REQUIRE(Dot(hull.Support(direction), direction) == Catch::Approx(best).margin(1e-5f));
+    }
+}
+
+TEST_CASE("Convex hull merges coplanar faces and handles degenerate input", "[math][convex_hull]")
+{
+    // Grid of a cube: interior, edge and face points are dropped, faces become quads
+    std::vector<Vec3> points;
+    for (int x = 0; x <= 10; x++)
+        for (int y = 0; y <= 10; y++)
+            for (int z = 0; z <= 10; z++)
+                points.emplace_back(static_cast<float>(x) * 0.3f - 1.0f, static_cast<float>(y) * 0.3f, static_cast<float>(z) * 0.3f + 2.0f);
+
+    ConvexHull hull;
+    REQUIRE(hull.Build(points.data(), points.size()));
+    RequireValidHull(hull, points, 1e-4f);
+    REQUIRE(hull.GetVertices().size() == 8);
+    REQUIRE(hull.GetFaceCount() == 6);
+    REQUIRE(hull.GetEdges().size() == 12);
+    for (size_t face = 0; face < 6; face++)
+    {
+        uint32_t count;
+        REQUIRE(hull.GetFaceVertices(face, count) != nullptr);
+        REQUIRE(count == 4);
+    }
+    REQUIRE(hull.Contains(Vec3(0.5f, 1.5f, 3.5f)));
+    REQUIRE_FALSE(hull.Contains(Vec3(0.5f, 1.5f, 5.5f)));
+
+    // Flat input gives two opposite faces
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    const Vec3 u = Normalize(Vec3(1.0f, 2.0f, 0.5f)), v = Normalize(Cross(u, Vec3(0.0f, 0.0f, 1.0f)));
+    std::vector<Vec3> flat;
+    for (int i = 0; i < 200; i++)
+    {
+        const float s = unit(rng), t = unit(rng);
+        flat.push_back(Vec3(1.0f, -2.0f, 3.0f) + u * s * 4.0f + v * t * 2.0f);
+    }
+    REQUIRE(hull.Build(flat.data(), flat.size()));
+    REQUIRE(hull.GetFaceCount() == 2);
+    REQUIRE(Dot(hull.GetPlanes()[0].normal, hull.GetPlanes()[1].normal) == Catch::Approx(-1.0f));
+    REQUIRE(hull.GetEdges().size() == hull.GetVertices().size());
+    for (const Vec3 &point : flat)
+        REQUIRE(hull.Contains(point, 1e-4f));
+
+    // Collinear and coincident input has no hull
+    std::vector<Vec3> line;
+    for (int i = 0; i < 10; i++)
+        line.push_back(Vec3(1.0f, 2.0f, 3.0f) * static_cast<float>(i));
+    REQUIRE_FALSE(hull.Build(line.data(), line.size()));
+    REQUIRE(hull.IsEmpty());
+    const std::vector<Vec3> same(5, Vec3(1.0f));
+    REQUIRE_FALSE(hull.Build(same.data(), same.size()));
+    REQUIRE_FALSE(hull.Build(points.data(), 2));
+}
+
+TEST_CASE("Convex hull simplification keeps the input inside", "[math][convex_hull]")
+{
+    std::mt19937 rng(9);
+    ConvexHull hull;
+    for (const uint32_t max_faces : { 8u, 12u, 20u, 32u })
+    {
+        const std::vector<Vec3> points = MakeSpherePoints(rng, 400, 3.0f);
+        REQUIRE(hull.Build(points.data(), points.size()));
+        const size_t original_faces = hull.GetFaceCount();
+
+        REQUIRE(hull.Simplify(max_faces));
+        REQUIRE(hull.GetFaceCount() < original_faces);
+        REQUIRE(hull.GetFaceCount() <= max_faces);
+        REQUIRE(hull.GetEdges().size() + 2 == hull.GetVertices().size() + hull.GetFaceCount());
+        REQUIRE(hull.GetSourceIndices().front() == ConvexHull::INVALID_INDEX);
+        for (const Vec3 &point : points)
+            REQUIRE(hull.Contains(point, 1e-3f));
+
+        // Already small enough
+        REQUIRE_FALSE(hull.Simplify(max_faces));
+    }
+}
+
+TEST_CASE("Convex hull benchmark", "[.][benchmark][convex_hull]")
+{
+    std::mt19937 rng(100);
+    ConvexHull hull;
+    for (const bool sphere : { false, true })
+    {
+        const std::vector<Vec3> points = sphere ? MakeSpherePoints(rng, 100000, 10.0f) : MakeRandomPoints(rng, 100000, 10.0f);
+        double best_ms = 1e30;
+        for (int run = 0; run < 5; run++)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            REQUIRE(hull.Build(points.data(), points.size()));
+            best_ms = std::min(best_ms, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        std::printf("100000 %s points: %.2f ms, %zu vertices, %zu faces\n", sphere ? "sphere" : "cube", best_ms, hull.GetVertices().size(), hull.GetFaceCount());
+    }
+}
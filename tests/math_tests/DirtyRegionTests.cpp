@@ -0,0 +1,120 @@
+﻿#include <random>
+#include <vector>
+#include <xmath.hpp>
+#include <catch2/catch_all.hpp>
+
+using namespace xMath;
+
+namespace
+{
+    // Tolerance covers the rounding of x + width after merges
+    bool Covers(const std::vector<Rectangle> &rects, float x, float y)
+    {
+        constexpr float tolerance = 1e-3f;
+        for (const Rectangle &rect : rects)
+            if (x >= rect.x - tolerance && x <= rect.x + rect.width + tolerance &&
+                y >= rect.y - tolerance && y <= rect.y + rect.height + tolerance)
+                return true;
+        return false;
+    }
+}
+
+TEST_CASE("DirtyRegion clips and ignores empty rectangles", "[math][dirty]")
+{
+    DirtyRegion dirty(Rectangle(0.0f, 0.0f, 100.0f, 100.0f));
+    dirty.Add(Rectangle(200.0f, 200.0f, 10.0f, 10.0f));
+    dirty.Add(Rectangle(10.0f, 10.0f, 0.0f, 5.0f));
+    REQUIRE(dirty.IsEmpty());
+
+    dirty.Add(Rectangle(-10.0f, 90.0f, 20.0f, 20.0f));
+    REQUIRE(dirty.GetRects().size() == 1);
+    const Rectangle &rect = dirty.GetRects()[0];
+    REQUIRE(rect.x == Catch::Approx(0.0f));
+    REQUIRE(rect.y == Catch::Approx(90.0f));
+    REQUIRE(rect.width == Catch::Approx(10.0f));
+    REQUIRE(rect.height == Catch::Approx(10.0f));
+
+    dirty.AddAll();
+    REQUIRE(dirty.GetRects().size() == 1);
+    REQUIRE(dirty.GetCoverage() == Catch::Approx(1.0f));
+    dirty.Clear();
+    REQUIRE(dirty.IsEmpty());
+}
+
+TEST_CASE("DirtyRegion merges only cheap pairs", "[math][dirty]")
+{
+    DirtyRegion dirty(Rectangle(0.0f, 0.0f, 1000.0f, 1000.0f), 8, 0.25f);
+
+    // Adjacent: merging wastes nothing
+    dirty.Add(Rectangle(0.0f, 0.0f, 10.0f, 10.0f));
+    dirty.Add(Rectangle(10.0f, 0.0f, 10.0f, 10.0f));
+    REQUIRE(dirty.GetRects().size() == 1);
+    REQUIRE(dirty.GetArea() == Catch::Approx(200.0f));
+
+    // Contained: absorbed
+    dirty.Add(Rectangle(2.0f, 2.0f, 3.0f, 3.0f));
+    REQUIRE(dirty.GetRects().size() == 1);
+
+    // Far apart: kept separate
+    dirty.Add(Rectangle(500.0f, 500.0f, 10.0f, 10.0f));
+    REQUIRE(dirty.GetRects().size() == 2);
+    REQUIRE(dirty.GetArea() == Catch::Approx(300.0f));
+
+    const Rectangle bounds = dirty.GetBounds();
+    REQUIRE(bounds.x == Catch::Approx(0.0f));
+    REQUIRE(bounds.width == Catch::Approx(510.0f));
+}
+
+TEST_CASE("DirtyRegion respects the cap and covers every input", "[math][dirty]")
+{
+    const uint32_t max_rects = GENERATE(1u, 4u, 16u);
+    DirtyRegion dirty(Rectangle(0.0f, 0.0f, 1920.0f, 1080.0f), max_rects);
+
+    std::mt19937 rng(41);
+    std::uniform_real_distribution<float> pos_x(-50.0f, 1900.0f), pos_y(-50.0f, 1060.0f), size(1.0f, 80.0f);
+    std::vector<Rectangle> added;
+    for (int i = 0; i < 500; i++)
+    {
+        const float x = pos_x(rng), y = pos_y(rng), w = size(rng), h = size(rng);
+        const Rectangle rect(x, y, w, h);
+        added.push_back(rect);
+        dirty.Add(rect);
+        REQUIRE(dirty.GetRects().size() <= max_rects);
+    }
+
+    // Every corner of every on-screen input stays covered
+    for (const Rectangle &rect : added)
+    {
+        const float min_x = std::max(rect.x, 0.0f), min_y = std::max(rect.y, 0.0f);
+        const float max_x = std::min(rect.x + rect.width, 1920.0f), max_y = std::min(rect.y + rect.height, 1080.0f);
+        if (max_x <= min_x || max_y <= min_y)
+            continue;
+
+        REQUIRE(Covers(dirty.GetRects(), min_x, min_y));
+        REQUIRE(Covers(dirty.GetRects(), max_x, max_y));
+        REQUIRE(Covers(dirty.GetRects(), (min_x + max_x) * 0.5f, (min_y + max_y) * 0.5f));
+    }
+
+    for (const Rectangle &rect : dirty.GetRects())
+    {
+        REQUIRE(rect.x >= 0.0f);
+        REQUIRE(rect.y >= 0.0f);
+        REQUIRE(rect.x + rect.width <= Catch::Approx(1920.0f));
+        REQUIRE(rect.y + rect.height <= Catch::Approx(1080.0f));
+    }
+}
+
+TEST_CASE("DirtyRegion keeps clustered updates tight", "[math][dirty]")
+{
+    // Two clusters of small widgets should become two rects, not one full-screen one
+    DirtyRegion dirty(Rectangle(0.0f, 0.0f, 1920.0f, 1080.0f), 4);
+    for (int i = 0; i < 100; i++)
+    {
+        const float offset = static_cast<float>(i % 10) * 8.0f;
+        dirty.Add(Rectangle(20.0f + offset, 20.0f + static_cast<float>(i / 10) * 8.0f, 8.0f, 8.0f));
+        dirty.Add(Rectangle(1800.0f + offset * 0.5f, 1000.0f + static_cast<float>(i / 10) * 4.0f, 4.0f, 4.0f));
+    }
+
+    REQUIRE(dirty.GetRects().size() == 2);
+    REQUIRE(dirty.GetCoverage() < 0.01f);
+}
@@ -0,0 +1,189 @@
+﻿#include <cmath>
+#include <vector>
+#include <xmath.hpp>
+#include <catch2/catch_all.hpp>
+
+using namespace xMath;
+
+static Frustum MakeTestFrustum()
+{
+    // Camera at the origin looking down +Z, 90 degree vertical FOV, near 1, far 100.
+    Matrix view;
+    Matrix projection = Matrix().CreatePerspectiveFieldOfViewLH(PI * 0.5f, 1.0f, 1.0f, 100.0f);
+    return Frustum(view, projection);
+}
+
+TEST_CASE("Frustum masked cube test clears containing planes", "[math][frustum]")
+{
+    const Frustum frustum = MakeTestFrustum();
+
+    uint8_t mask = Frustum::PLANE_MASK_ALL;
+    REQUIRE(frustum.CheckCubeMasked(Vec3(0.0f, 0.0f, 50.0f), Vec3(1.0f), mask) == Intersection::Inside);
+    REQUIRE(mask == 0);
+
+    // Straddles the left and right planes only.
+    mask = Frustum::PLANE_MASK_ALL;
+    REQUIRE(frustum.CheckCubeMasked(Vec3(0.0f, 0.0f, 10.0f), Vec3(20.0f, 1.0f, 1.0f), mask) == Intersection::Intersects);
+    REQUIRE(mask == ((1 << 2) | (1 << 3)));
+
+    // Rejected: mask is left untouched.
+    mask = Frustum::PLANE_MASK_ALL;
+    REQUIRE(frustum.CheckCubeMasked(Vec3(0.0f, 0.0f, -50.0f), Vec3(1.0f), mask) == Intersection::Outside);
+    REQUIRE(mask == Frustum::PLANE_MASK_ALL);
+}
+
+TEST_CASE("Frustum masked tests skip inherited planes", "[math][frustum]")
+{
+    const Frustum frustum = MakeTestFrustum();
+
+    // With an empty mask nothing is tested, even for a box behind the camera.
+    uint8_t mask = 0;
+    REQUIRE(frustum.CheckCubeMasked(Vec3(0.0f, 0.0f, -50.0f), Vec3(1.0f), mask) == Intersection::Inside);
+
+    // Depth planes disabled: a box beyond the far plane is accepted.
+    mask = Frustum::PLANE_MASK_NO_DEPTH;
+    REQUIRE(frustum.CheckSphereMasked(Vec3(0.0f, 0.0f, 500.0f), 1.0f, mask) == Intersection::Inside);
+
+    mask = Frustum::PLANE_MASK_ALL;
+    REQUIRE(frustum.CheckSphereMasked(Vec3(0.0f, 0.0f, 500.0f), 1.0f, mask) == Intersection::Outside);
+
+    mask = Frustum::PLANE_MASK_ALL;
+    REQUIRE(frustum.CheckSphereMasked(Vec3(0.0f, 0.0f, 50.0f), 1.0f, mask) == Intersection::Inside);
+    REQUIRE(mask == 0);
+}
+
+TEST_CASE("Frustum coherent test caches the rejecting plane", "[math][frustum]")
+{
+    const Frustum frustum = MakeTestFrustum();
+
+    uint8_t last_plane = Frustum::PLANE_NONE;
+    REQUIRE_FALSE(frustum.IsVisibleCoherent(Vec3(0.0f, 0.0f, -50.0f), Vec3(1.0f), last_plane));
+    REQUIRE(last_plane < 6);
+
+    // Same object next frame is rejected by the cached plane again.
+    const uint8_t cached = last_plane;
+    REQUIRE_FALSE(frustum.IsVisibleCoherent(Vec3(0.0f, 0.0f, -50.0f), Vec3(1.0f), last_plane));
+    REQUIRE(last_plane == cached);
+
+    // Once it becomes visible the cache is reset.
+    REQUIRE(frustum.IsVisibleCoherent(Vec3(0.0f, 0.0f, 50.0f), Vec3(1.0f), last_plane));
+    REQUIRE(last_plane == Frustum::PLANE_NONE);
+}
+
+TEST_CASE("Frustum batch culling matches per-object tests", "[math][frustum]")
+{
+    const Frustum frustum = MakeTestFrustum();
+
+    BoundingBoxSoA bounds;
+    bounds.Add(Vec3(0.0f, 0.0f, 50.0f), Vec3(1.0f));   // inside
+    bounds.Add(Vec3(0.0f, 0.0f, -50.0f), Vec3(1.0f));  // behind
+    bounds.Add(Vec3(200.0f, 0.0f, 50.0f), Vec3(1.0f)); // right of the view
+    bounds.Add(Vec3(0.0f, 0.0f, 100.0f), Vec3(5.0f));  // straddles the far plane
+
+    uint8_t visible[4] = {};
+    REQUIRE(frustum.CullBatch(bounds, visible) == 2);
+    REQUIRE(visible[0] == 1);
+    REQUIRE(visible[1] == 0);
+    REQUIRE(visible[2] == 0);
+    REQUIRE(visible[3] == 1);
+
+    uint8_t last_plane[4] = {Frustum::PLANE_NONE, Frustum::PLANE_NONE, Frustum::PLANE_NONE, Frustum::PLANE_NONE};
+    for (int frame = 0; frame < 2; ++frame)
+    {
+        uint8_t coherent[4] = {};
+        REQUIRE(frustum.CullBatch(bounds, coherent, last_plane) == 2);
+        for (int i = 0; i < 4; ++i)
+            REQUIRE(coherent[i] == visible[i]);
+    }
+    REQUIRE(last_plane[0] == Frustum::PLANE_NONE);
+    REQUIRE(last_plane[1] != Frustum::PLANE_NONE);
+}
+
+static Mat4 MakeReverseZPerspective(float fovy, float n, float f, bool infinite)
+{
+    // Right-handed, clip z in [0, w], near -> 1, far -> 0
+    const float s = 1.0f / std::tan(fovy * 0.5f);
+    const float a = infinite ? 0.0f : n / (f - n);
+    const float b = infinite ? n : f * n / (f - n);
+    return Mat4({
+        { s,    0.0f, 0.0f,  0.0f },
+        { 0.0f, s,    0.0f,  0.0f },
+        { 0.0f, 0.0f, a,     b    },
+        { 0.0f, 0.0f, -1.0f, 0.0f }
+    });
+}
+
+TEST_CASE("Frustum from Mat4 view-projection", "[math][frustum]")
+{
+    const Mat4 view = LookAt(Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 0.0f, -1.0f), Vec3(0.0f, 1.0f, 0.0f));
+    const Mat4 projection = Perspective(PI * 0.5f, 1.0f, 1.0f, 100.0f);
+    const Frustum frustum(projection * view, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE);
+
+    REQUIRE(frustum.IsVisible(Vec3(0.0f, 0.0f, -50.0f), Vec3(1.0f), false));
+    REQUIRE_FALSE(frustum.IsVisible(Vec3(0.0f, 0.0f, 50.0f), Vec3(1.0f), false));
+    REQUIRE_FALSE(frustum.IsVisible(Vec3(0.0f, 0.0f, -500.0f), Vec3(1.0f), false));
+    REQUIRE_FALSE(frustum.IsVisible(Vec3(80.0f, 0.0f, -50.0f), Vec3(1.0f), false));
+
+    // Near plane sits at distance 1 in the OpenGL convention.
+    uint8_t mask = 1 << 0;
+    REQUIRE(frustum.CheckSphereMasked(Vec3(0.0f, 0.0f, -1.0f), 0.5f, mask) == Intersection::Intersects);
+}
+
+TEST_CASE("Frustum from reverse-Z and infinite projections", "[math][frustum]")
+{
+    const Mat4 view = LookAt(Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 0.0f, -1.0f), Vec3(0.0f, 1.0f, 0.0f));
+
+    const Frustum reversed(MakeReverseZPerspective(PI * 0.5f, 1.0f, 100.0f, false) * view, Frustum::DEPTH_REVERSED);
+    REQUIRE(reversed.IsVisible(Vec3(0.0f, 0.0f, -50.0f), Vec3(1.0f), false));
+    REQUIRE_FALSE(reversed.IsVisible(Vec3(0.0f, 0.0f, 50.0f), Vec3(1.0f), false));
+    REQUIRE_FALSE(reversed.IsVisible(Vec3(0.0f, 0.0f, -500.0f), Vec3(1.0f), false));
+
+    uint8_t near_mask = 1 << 0;
+    REQUIRE(reversed.CheckSphereMasked(Vec3(0.0f, 0.0f, -1.0f), 0.5f, near_mask) == Intersection::Intersects);
+
+    const Frustum infinite(MakeReverseZPerspective(PI * 0.5f, 1.0f, 0.0f, true) * view, Frustum::DEPTH_REVERSED | Frustum::DEPTH_INFINITE_FAR);
+    REQUIRE(infinite.IsVisible(Vec3(0.0f, 0.0f, -50.0f), Vec3(1.0f), false));
+    REQUIRE(infinite.IsVisible(Vec3(0.0f, 0.0f, -1.0e6f), Vec3(1.0f), false));
+    REQUIRE_FALSE(infinite.IsVisible(Vec3(0.0f, 0.0f, 50.0f), Vec3(1.0f), false));
+
+    // The far plane never rejects and is dropped from the mask straight away.
+    uint8_t far_mask = 1 << 1;
+    REQUIRE(infinite.CheckCubeMasked(Vec3(0.0f, 0.0f, -1.0e6f), Vec3(1.0f), far_mask) == Intersection::Inside);
+    REQUIRE(far_mask == 0);
+}
+
+TEST_CASE("MultiFrustum culls all views in one pass", "[math][frustum]")
+{
+    const Mat4 projection = Perspective(PI * 0.5f, 1.0f, 1.0f, 100.0f);
+    const Vec3 origin(0.0f, 0.0f, 0.0f), up(0.0f, 1.0f, 0.0f);
+
+    // Four views looking down -Z, +Z, -X and +X
+    MultiFrustum views;
+    REQUIRE(views.Add(Frustum(projection * LookAt(origin, Vec3(0.0f, 0.0f, -1.0f), up), Frustum::DEPTH_NEGATIVE_ONE_TO_ONE)) == 0);
+    REQUIRE(views.Add(Frustum(projection * LookAt(origin, Vec3(0.0f, 0.0f, 1.0f), up), Frustum::DEPTH_NEGATIVE_ONE_TO_ONE)) == 1);
+    REQUIRE(views.Add(Frustum(projection * LookAt(origin, Vec3(-1.0f, 0.0f, 0.0f), up), Frustum::DEPTH_NEGATIVE_ONE_TO_ONE)) == 2);
+    REQUIRE(views.Add(Frustum(projection * LookAt(origin, Vec3(1.0f, 0.0f, 0.0f), up), Frustum::DEPTH_NEGATIVE_ONE_TO_ONE)) == 3);
+    REQUIRE(views.GetCount() == 4);
+    REQUIRE(views.GetAllMask() == 0xFu);
+
+    BoundingBoxSoA bounds;
+    bounds.Add(Vec3(0.0f, 0.0f, -50.0f), Vec3(1.0f));  // view 0
+    bounds.Add(Vec3(0.0f, 0.0f, 50.0f), Vec3(1.0f));   // view 1
+    bounds.Add(Vec3(-30.0f, 0.0f, -30.0f), Vec3(2.0f)); // on the diagonal between views 0 and 2
+    bounds.Add(Vec3(0.0f, 500.0f, 0.0f), Vec3(1.0f));  // nowhere
+
+    std::vector<uint32_t> masks(bounds.Size());
+    REQUIRE(views.CullBatch(bounds, masks.data()) == 3);
+    REQUIRE(masks[0] == 0x1u);
+    REQUIRE(masks[1] == 0x2u);
+    REQUIRE(masks[2] == 0x5u);
+    REQUIRE(masks[3] == 0x0u);
+
+    // Matches the per-frustum tests
+    const Frustum right(projection * LookAt(origin, Vec3(1.0f, 0.0f, 0.0f), up), Frustum::DEPTH_NEGATIVE_ONE_TO_ONE);
+    REQUIRE(((views.Cull(Vec3(40.0f, 3.0f, 2.0f), Vec3(1.0f)) >> 3) & 1u) == static_cast<uint32_t>(right.IsVisible(Vec3(40.0f, 3.0f, 2.0f), Vec3(1.0f), false)));
+
+    views.Clear();
+    REQUIRE(views.GetCount() == 0);
+    REQUIRE(views.Cull(Vec3(0.0f, 0.0f, -50.0f), Vec3(1.0f)) == 0u);
+}
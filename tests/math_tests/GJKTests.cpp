@@ -0,0 +1,248 @@
+﻿#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <xmath.hpp>
+#include <catch2/catch_all.hpp>
+#include "RandomGeometry.h"
+
+using namespace xMath;
+using TestUtils::MakeRandomAABB;
+using TestUtils::MakeRandomOBB;
+using TestUtils::RandomVector;
+
+namespace
+{
+    // Per-axis gaps: positive when apart along that axis
+    Vec3 GetGaps(const BoundingBox &a, const BoundingBox &b)
+    {
+        return { std::max(a.GetMin().x - b.GetMax().x, b.GetMin().x - a.GetMax().x),
+                 std::max(a.GetMin().y - b.GetMax().y, b.GetMin().y - a.GetMax().y),
+                 std::max(a.GetMin().z - b.GetMax().z, b.GetMin().z - a.GetMax().z) };
+    }
+
+    float BoxDistance(const BoundingBox &a, const BoundingBox &b)
+    {
+        const Vec3 gaps = GetGaps(a, b);
+        const Vec3 outside(std::max(gaps.x, 0.0f), std::max(gaps.y, 0.0f), std::max(gaps.z, 0.0f));
+        return std::sqrt(Dot(outside, outside));
+    }
+
+    // Smallest translation of b along an axis that separates overlapping boxes
+    float BoxPenetration(const BoundingBox &a, const BoundingBox &b, Vec3 &normal)
+    {
+        float depth = FLT_MAX;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            const float positive = a.GetMax()[axis] - b.GetMin()[axis];
+            const float negative = b.GetMax()[axis] - a.GetMin()[axis];
+            Vec3 direction(0.0f);
+            direction[axis] = positive < negative ? 1.0f : -1.0f;
+            if (std::min(positive, negative) < depth)
+            {
+                depth = std::min(positive, negative);
+                normal = direction;
+            }
+        }
+        return depth;
+    }
+
+    std::array<Vec3, 8> GetCorners(const BoundingBox &box)
+    {
+        std::array<Vec3, 8> corners;
+        for (int i = 0; i < 8; i++)
+            corners[i] = Vec3((i & 1) ? box.GetMax().x : box.GetMin().x, (i & 2) ? box.GetMax().y : box.GetMin().y, (i & 4) ? box.GetMax().z : box.GetMin().z);
+        return corners;
+    }
+
+    // Custom shape through the generic constructor: a segment with a radius
+    struct Capsule
+    {
+        Vec3 a, b;
+        float radius;
+    };
+
+    Vec3 SupportCapsule(const void *data, size_t, const Vec3 &direction)
+    {
+        const auto &capsule = *static_cast<const Capsule *>(data);
+        const Vec3 end = Dot(capsule.a, direction) > Dot(capsule.b, direction) ? capsule.a : capsule.b;
+        return end + Normalize(direction) * capsule.radius;
+    }
+}
+
+TEST_CASE("GJK and EPA on spheres match the analytic result", "[math][gjk]")
+{
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> position(-4.0f, 4.0f), radius(0.3f, 2.5f);
+    size_t apart = 0, overlapping = 0;
+    for (int i = 0; i < 500; i++)
+    {
+        const Vec3 center_a = RandomVector(rng, position);
+        const Sphere a(center_a, radius(rng));
+        const Vec3 center_b = RandomVector(rng, position);
+        const Sphere b(center_b, radius(rng));
+        const float gap = Distance(a.center, b.center) - a.radius - b.radius;
+        if (std::abs(gap) < 1e-2f)
+            continue;
+
+        const GJKResult result = GJKDistance(ConvexShape(a), ConvexShape(b));
+        REQUIRE(GJKIntersects(ConvexShape(a), ConvexShape(b)) == (gap < 0.0f));
+        REQUIRE(result.intersecting == (gap < 0.0f));
+        if (gap > 0.0f)
+        {
+            apart++;
+            REQUIRE(result.distance == Catch::Approx(gap).margin(1e-3));
+            REQUIRE(Distance(result.point_a, a.center) == Catch::Approx(a.radius).margin(1e-3));
+            REQUIRE(Distance(result.point_b, b.center) == Catch::Approx(b.radius).margin(1e-3));
+            REQUIRE(Distance(result.point_a, result.point_b) == Catch::Approx(result.distance).margin(1e-4));
+            continue;
+        }
+
+        overlapping++;
+        const EPAResult contact = EPAPenetration(ConvexShape(a), ConvexShape(b));
+        REQUIRE(contact.intersecting);
+        REQUIRE(contact.depth == Catch::Approx(-gap).margin(2e-2));
+        // Deep overlaps are ill-conditioned in direction, so check the penetration along the normal found
+        REQUIRE(a.radius + b.radius - Dot(b.center - a.center, contact.normal) == Catch::Approx(contact.depth).margin(2e-2));
+        const Vec3 offset = contact.point_a - contact.point_b - contact.normal * contact.depth;
+        REQUIRE(Length(offset) < 1e-3f);
+    }
+    REQUIRE(apart > 100);
+    REQUIRE(overlapping > 50);
+}
+
+TEST_CASE("GJK and EPA on boxes match the analytic result", "[math][gjk]")
+{
+    std::mt19937 rng(5);
+    size_t apart = 0, overlapping = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        const BoundingBox a = MakeRandomAABB(rng, 3.0f);
+        const BoundingBox b = MakeRandomAABB(rng, 3.0f);
+        const Vec3 gaps = GetGaps(a, b);
+        const float largest_gap = std::max({ gaps.x, gaps.y, gaps.z });
+        if (std::abs(largest_gap) < 1e-3f)
+            continue;
+
+        // Box views and corner clouds describe the same shapes
+        const std::array<Vec3, 8> corners_a = GetCorners(a);
+        const std::array<Vec3, 8> corners_b = GetCorners(b);
+        const ConvexShape shape_a(a), shape_b(b);
+        const ConvexShape cloud_a(corners_a.data(), corners_a.size()), cloud_b(corners_b.data(), corners_b.size());
+
+        const GJKResult result = GJKDistance(shape_a, shape_b);
+        const GJKResult cloud_result = GJKDistance(cloud_a, cloud_b);
+        REQUIRE(result.intersecting == (largest_gap < 0.0f));
+        REQUIRE(cloud_result.intersecting == result.intersecting);
+        REQUIRE(GJKIntersects(shape_a, shape_b) == result.intersecting);
+        if (largest_gap > 0.0f)
+        {
+            apart++;
+            REQUIRE(result.distance == Catch::Approx(BoxDistance(a, b)).margin(1e-4));
+            REQUIRE(cloud_result.distance == Catch::Approx(BoxDistance(a, b)).margin(1e-4));
+            REQUIRE(Distance(a.GetClosestPoint(result.point_a), result.point_a) < 1e-4f);
+            continue;
+        }
+
+        overlapping++;
+        Vec3 expected_normal;
+        const float expected_depth = BoxPenetration(a, b, expected_normal);
+        const EPAResult contact = EPAPenetration(shape_a, shape_b);
+        REQUIRE(contact.intersecting);
+        REQUIRE(contact.depth == Catch::Approx(expected_depth).margin(1e-3));
+
+        // Ties between axes allow either normal; otherwise it is the analytic one
+        const Vec3 translated_min = b.GetMin() + contact.normal * contact.depth, translated_max = b.GetMax() + contact.normal * contact.depth;
+        REQUIRE(BoxDistance(a, BoundingBox(translated_min, translated_max)) < 1e-3f);
+        const Vec3 further = contact.normal * (contact.depth + 1e-2f);
+        REQUIRE(BoxDistance(a, BoundingBox(b.GetMin() + further, b.GetMax() + further)) > 0.0f);
+        (void)expected_normal;
+
+        const EPAResult cloud_contact = EPAPenetration(cloud_a, cloud_b);
+        REQUIRE(cloud_contact.depth == Catch::Approx(expected_depth).margin(1e-3));
+    }
+    REQUIRE(apart > 100);
+    REQUIRE(overlapping > 100);
+}
+
+TEST_CASE("GJK on oriented boxes agrees with the SAT test", "[math][gjk]")
+{
+    std::mt19937 rng(9);
+    size_t overlapping = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        const OrientedBoundingBox a = MakeRandomOBB(rng, 2.5f);
+        const OrientedBoundingBox b = MakeRandomOBB(rng, 2.5f);
+        const ConvexShape shape_a(a), shape_b(b);
+
+        const GJKResult result = GJKDistance(shape_a, shape_b);
+        const bool intersecting = GJKIntersects(shape_a, shape_b);
+        REQUIRE(intersecting == result.intersecting);
+        if (!result.intersecting)
+        {
+            // Apart: the closest points lie on the boxes, and the SAT agrees unless they barely miss
+            REQUIRE(Distance(result.point_a, result.point_b) == Catch::Approx(result.distance).margin(1e-4));
+            REQUIRE(Distance(a.GetClosestPoint(result.point_a), result.point_a) < 1e-4f);
+            REQUIRE(Distance(b.GetClosestPoint(result.point_b), result.point_b) < 1e-4f);
+            if (result.distance > 1e-3f)
+                REQUIRE_FALSE(a.Intersects(b));
+            continue;
+        }
+
+        overlapping++;
+        const EPAResult contact = EPAPenetration(shape_a, shape_b);
+        REQUIRE(contact.intersecting);
+        if (contact.depth < 1e-3f)
+            continue;
+        REQUIRE(a.Intersects(b));
+
+        // Moving b along the normal by the depth makes them touch, a little further separates them
+        const auto moved = [&b, &contact](float amount) { return OrientedBoundingBox(b.GetCenter() + contact.normal * amount, b.GetBasis(), b.GetExtents()); };
+        REQUIRE(GJKDistance(shape_a, ConvexShape(moved(contact.depth + 1e-2f))).distance > 0.0f);
+        REQUIRE(GJKDistance(shape_a, ConvexShape(moved(contact.depth + 1e-2f))).distance < 2e-2f);
+        if (contact.depth > 2e-2f)
+            REQUIRE(GJKIntersects(shape_a, ConvexShape(moved(contact.depth - 1e-2f))));
+    }
+    REQUIRE(overlapping > 100);
+}
+
+TEST_CASE("GJK warm start and custom support functions", "[math][gjk]")
+{
+    const Capsule capsule{ Vec3(-1.0f, 0.0f, 0.0f), Vec3(1.0f, 0.0f, 0.0f), 0.5f };
+    const ConvexShape capsule_shape(&capsule, 1, SupportCapsule);
+    const OrientedBoundingBox box(BoundingBox(Vec3(-0.5f, -0.5f, -0.5f), Vec3(0.5f, 0.5f, 0.5f)), Mat4::RotationDegrees(Vec3(20.0f, 35.0f, 10.0f)));
+
+    // The capsule sits above a box that slides past and then through it
+    GJKCache cache;
+    uint32_t cold_iterations = 0, warm_iterations = 0;
+    for (int frame = 0; frame < 200; frame++)
+    {
+        const float t = static_cast<float>(frame) / 199.0f;
+        const OrientedBoundingBox moving(Vec3(-3.0f + 6.0f * t, 1.8f - 1.6f * t, 0.3f), box.GetBasis(), box.GetExtents());
+        const ConvexShape moving_shape(moving);
+
+        const GJKResult cold = GJKDistance(capsule_shape, moving_shape);
+        const GJKResult warm = GJKDistance(capsule_shape, moving_shape, &cache);
+        REQUIRE(warm.intersecting == cold.intersecting);
+        REQUIRE(warm.distance == Catch::Approx(cold.distance).margin(1e-4));
+        cold_iterations += cold.iterations;
+        warm_iterations += warm.iterations;
+
+        if (cold.intersecting)
+        {
+            const EPAResult cold_contact = EPAPenetration(capsule_shape, moving_shape);
+            GJKCache copy = cache;
+            const EPAResult warm_contact = EPAPenetration(capsule_shape, moving_shape, &copy);
+            REQUIRE(warm_contact.depth == Catch::Approx(cold_contact.depth).margin(1e-3));
+        }
+    }
+    REQUIRE(warm_iterations < cold_iterations);
+
+    // Touching shapes count as intersecting with zero depth
+    const Sphere unit(Vec3(0.0f), 1.0f);
+    const BoundingBox touching(Vec3(1.0f, -1.0f, -1.0f), Vec3(3.0f, 1.0f, 1.0f));
+    REQUIRE(GJKIntersects(ConvexShape(unit), ConvexShape(touching)));
+    REQUIRE(EPAPenetration(ConvexShape(unit), ConvexShape(touching)).depth == Catch::Approx(0.0f).margin(1e-4));
+    REQUIRE(EPAPenetration(ConvexShape(unit), ConvexShape(touching)).normal.x == Catch::Approx(1.0f).margin(1e-3));
+}
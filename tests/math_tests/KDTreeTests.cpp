@@ -0,0 +1,173 @@
+﻿#include <algorithm>
+#include <random>
+#include <vector>
+#include <xmath.hpp>
+#include <catch2/catch_all.hpp>
+#include "RandomGeometry.h"
+
+using namespace xMath;
+using TestUtils::MakeRandomPoints;
+
+namespace
+{
+    std::vector<float> SortedDistances(const std::vector<Vec3> &points, const Vec3 &query)
+    {
+        std::vector<float> distances;
+        for (const Vec3 &point : points)
+            distances.push_back(Distance(point, query));
+        std::sort(distances.begin(), distances.end());
+        return distances;
+    }
+}
+
+TEST_CASE("KDTree implicit layout", "[math][kdtree]")
+{
+    const std::vector<Vec3> points = MakeRandomPoints(1000, 1, 10.0f);
+    KDTree tree;
+    tree.Build(points.data(), points.size());
+    REQUIRE(tree.GetPointCount() == points.size());
+
+    std::vector<uint32_t> indices = tree.GetSortedIndices();
+    std::sort(indices.begin(), indices.end());
+    for (uint32_t i = 0; i < indices.size(); i++)
+        REQUIRE(indices[i] == i);
+
+    tree.Clear();
+    REQUIRE(tree.GetPointCount() == 0);
+    REQUIRE(tree.QueryNearest(Vec3(0.0f)) == KDTree::INVALID_INDEX);
+}
+
+TEST_CASE("KDTree nearest and k-nearest match brute force", "[math][kdtree]")
+{
+    const std::vector<Vec3> points = MakeRandomPoints(5000, 3, 50.0f);
+
+    KDTreeBuildSettings settings;
+    settings.leaf_size = GENERATE(1u, 8u, 32u);
+    settings.parallel_threshold = 256;
+    KDTree tree;
+    tree.Build(points.data(), points.size(), settings);
+
+    const std::vector<Vec3> queries = MakeRandomPoints(100, 5, 70.0f);
+    for (const Vec3 &query : queries)
+    {
+        const std::vector<float> expected = SortedDistances(points, query);
+
+        float distance = 0.0f;
+        const uint32_t nearest = tree.QueryNearest(query, &distance);
+        REQUIRE(distance == Catch::Approx(expected[0]));
+        REQUIRE(Distance(points[nearest], query) == Catch::Approx(expected[0]));
+
+        uint32_t indices[16];
+        float distances[16];
+        REQUIRE(tree.QueryKNearest(query, 16, indices, distances) == 16);
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            REQUIRE(distances[i] == Catch::Approx(expected[i]));
+            REQUIRE(Distance(points[indices[i]], query) == Catch::Approx(distances[i]));
+        }
+    }
+
+    // Asking for more neighbors than points returns them all
+    const std::vector<Vec3> few = MakeRandomPoints(5, 7, 1.0f);
+    tree.Build(few.data(), few.size(), settings);
+    uint32_t indices[8];
+    float distances[8];
+    REQUIRE(tree.QueryKNearest(Vec3(0.0f), 8, indices, distances) == 5);
+}
+
+TEST_CASE("KDTree radius queries match brute force", "[math][kdtree]")
+{
+    const std::vector<Vec3> points = MakeRandomPoints(5000, 9, 50.0f);
+    KDTree tree;
+    tree.Build(points.data(), points.size());
+
+    const std::vector<Vec3> centers = MakeRandomPoints(50, 11, 60.0f);
+    for (const float radius : { 0.0f, 4.0f, 15.0f, 500.0f })
+    {
+        for (const Vec3 &center : centers)
+        {
+            std::vector<uint32_t> results;
+            tree.QueryRadius(center, radius, results);
+            std::sort(results.begin(), results.end());
+
+            std::vector<uint32_t> expected;
+            for (uint32_t i = 0; i < points.size(); i++)
+            {
+                const Vec3 offset = points[i] - center;
+                if (offset.x * offset.x + offset.y * offset.y + offset.z * offset.z <= radius * radius)
+                    expected.push_back(i);
+            }
+            REQUIRE(results == expected);
+        }
+    }
+}
+
+TEST_CASE("KDTree batch queries match single queries", "[math][kdtree]")
+{
+    const std::vector<Vec3> points = MakeRandomPoints(20000, 13, 100.0f);
+
+    KDTreeBuildSettings settings;
+    settings.thread_count = 4;
+    settings.parallel_threshold = 512;
+    KDTree tree;
+    tree.Build(points.data(), points.size(), settings);
+
+    const std::vector<Vec3> queries = MakeRandomPoints(3000, 15, 110.0f);
+    const uint32_t k = 4;
+
+    std::vector<uint32_t> nearest(queries.size());
+    std::vector<float> nearest_distances(queries.size());
+    tree.QueryNearestBatch(queries.data(), queries.size(), nearest.data(), nearest_distances.data());
+
+    std::vector<uint32_t> indices(queries.size() * k), found(queries.size());
+    std::vector<float> distances(queries.size() * k);
+    tree.QueryKNearestBatch(queries.data(), queries.size(), k, indices.data(), distances.data(), found.data());
+
+    std::vector<uint32_t> neighbors, offsets;
+    const size_t total = tree.QueryRadiusBatch(queries.data(), queries.size(), 5.0f, neighbors, offsets);
+    REQUIRE(offsets.size() == queries.size() + 1);
+    REQUIRE(offsets.back() == total);
+
+    for (size_t i = 0; i < queries.size(); i++)
+    {
+        float distance = 0.0f;
+        REQUIRE(tree.QueryNearest(queries[i], &distance) == nearest[i]);
+        REQUIRE(nearest_distances[i] == distance);
+
+        uint32_t single_indices[k];
+        float single_distances[k];
+        REQUIRE(tree.QueryKNearest(queries[i], k, single_indices, single_distances) == found[i]);
+        for (uint32_t j = 0; j < k; j++)
+            REQUIRE(indices[i * k + j] == single_indices[j]);
+
+        std::vector<uint32_t> single;
+        tree.QueryRadius(queries[i], 5.0f, single);
+        REQUIRE(std::equal(single.begin(), single.end(), neighbors.begin() + offsets[i], neighbors.begin() + offsets[i + 1]));
+        REQUIRE(single.size() == offsets[i + 1] - offsets[i]);
+    }
+
+    // Empty batches leave a single zero offset
+    REQUIRE(tree.QueryRadiusBatch(queries.data(), 0, 5.0f, neighbors, offsets) == 0);
+    REQUIRE(offsets.size() == 1);
+}
+
+TEST_CASE("KDTree benchmark", "[.][benchmark][kdtree]")
+{
+    const std::vector<Vec3> points = MakeRandomPoints(1000000, 17, 500.0f);
+    const std::vector<Vec3> queries = MakeRandomPoints(100000, 19, 500.0f);
+    KDTree tree;
+    std::vector<uint32_t> nearest(queries.size());
+
+    BENCHMARK("Build 1M points")
+    {
+        tree.Build(points.data(), points.size());
+        return tree.GetPointCount();
+    };
+
+    tree.Build(points.data(), points.size());
+    BENCHMARK("Nearest batch 100k queries")
+    {
+        tree.QueryNearestBatch(queries.data(), queries.size(), nearest.data());
+        return nearest[0];
+    };
+}
@@ -80,3 +80,22 @@ TEST_CASE("ToFloat32 half conversion basic", "[math][utils][half]")
     bits.f = -0.0f;
     REQUIRE(ToFloat32(0x8000u) == bits.f);
 }
+
+TEST_CASE("TransformPoint matches the named Mat4 elements", "[math][utils][mat4]")
+{
+    // TransformPoint and Mat4::Translate are compiled in the library; the element reads below are
+    // compiled here. Both sides only agree when every translation unit uses the same matrix layout.
+    const Mat4 translate = Mat4::Translate(Vec3(1.0f, 2.0f, 3.0f));
+    REQUIRE(translate.m03 == Catch::Approx(1.0f));
+    REQUIRE(translate.m13 == Catch::Approx(2.0f));
+    REQUIRE(translate.m23 == Catch::Approx(3.0f));
+
+    Mat4 m(1.0f);
+    m.m30 = 0.5f;
+    m.m33 = 2.0f;
+    m.m01 = 3.0f;
+    const Vec3 p = TransformPoint(m, Vec3(2.0f, 1.0f, 4.0f));
+    REQUIRE(p.x == Catch::Approx((2.0f + 3.0f) / 3.0f));
+    REQUIRE(p.y == Catch::Approx(1.0f / 3.0f));
+    REQUIRE(p.z == Catch::Approx(4.0f / 3.0f));
+}
@@ -0,0 +1,114 @@
+﻿#include <vector>
+#include <xmath.hpp>
+#include <catch2/catch_all.hpp>
+
+using namespace xMath;
+
+namespace
+{
+    // Camera at the origin looking down -Z, OpenGL depth range
+    OcclusionBuffer MakeBuffer()
+    {
+        OcclusionBuffer buffer(64, 32, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE);
+        const Mat4 view = LookAt(Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 0.0f, -1.0f), Vec3(0.0f, 1.0f, 0.0f));
+        buffer.SetViewProjection(Perspective(PI * 0.5f, 2.0f, 1.0f, 100.0f) * view);
+        return buffer;
+    }
+
+    // Square wall facing the camera at depth z
+    void AddWall(OcclusionBuffer &buffer, float half_size, float z)
+    {
+        const Vec3 vertices[4] = {
+            Vec3(-half_size, -half_size, z), Vec3(half_size, -half_size, z),
+            Vec3(half_size, half_size, z), Vec3(-half_size, half_size, z)
+        };
+        const uint32_t indices[6] = { 0, 1, 2, 0, 2, 3 };
+        buffer.RasterizeTriangles(vertices, indices, 2);
+    }
+}
+
+TEST_CASE("Occlusion buffer rasterizes occluders", "[math][occlusion]")
+{
+    OcclusionBuffer buffer = MakeBuffer();
+    REQUIRE(buffer.GetWidth() == 64);
+    REQUIRE(buffer.GetHeight() == 32);
+    REQUIRE(buffer.GetDepth(32, 16) == Catch::Approx(1.0f));
+
+    AddWall(buffer, 5.0f, -10.0f);
+
+    // Center pixel is covered and closer than the far plane; corner pixel is untouched
+    REQUIRE(buffer.GetDepth(32, 16) < 1.0f);
+    REQUIRE(buffer.GetDepth(0, 0) == Catch::Approx(1.0f));
+
+    // Tile depth is the farthest pixel of the tile
+    REQUIRE(buffer.GetTileDepth(32, 16) == Catch::Approx(buffer.GetDepth(32, 16)));
+    REQUIRE(buffer.GetTileDepth(0, 0) == Catch::Approx(1.0f));
+
+    buffer.Clear();
+    REQUIRE(buffer.GetDepth(32, 16) == Catch::Approx(1.0f));
+}
+
+TEST_CASE("Occlusion buffer hides boxes behind occluders", "[math][occlusion]")
+{
+    OcclusionBuffer buffer = MakeBuffer();
+    AddWall(buffer, 5.0f, -10.0f);
+
+    // Behind the wall
+    REQUIRE_FALSE(buffer.IsVisible(Vec3(0.0f, 0.0f, -30.0f), Vec3(1.0f)));
+    REQUIRE_FALSE(buffer.IsVisible(BoundingBox(Vec3(-2.0f, -2.0f, -50.0f), Vec3(2.0f, 2.0f, -40.0f))));
+
+    // In front of the wall, or beside it
+    REQUIRE(buffer.IsVisible(Vec3(0.0f, 0.0f, -5.0f), Vec3(1.0f)));
+    REQUIRE(buffer.IsVisible(Vec3(20.0f, 0.0f, -30.0f), Vec3(1.0f)));
+
+    // Larger than the wall's silhouette
+    REQUIRE(buffer.IsVisible(Vec3(0.0f, 0.0f, -30.0f), Vec3(20.0f, 1.0f, 1.0f)));
+
+    // Crossing the near plane is always visible
+    REQUIRE(buffer.IsVisible(Vec3(0.0f, 0.0f, 0.0f), Vec3(1.0f)));
+}
+
+TEST_CASE("Occlusion buffer batch test matches single tests", "[math][occlusion]")
+{
+    OcclusionBuffer buffer = MakeBuffer();
+    AddWall(buffer, 5.0f, -10.0f);
+
+    BoundingBoxSoA bounds;
+    bounds.Add(Vec3(0.0f, 0.0f, -30.0f), Vec3(1.0f));
+    bounds.Add(Vec3(0.0f, 0.0f, -5.0f), Vec3(1.0f));
+    bounds.Add(Vec3(20.0f, 0.0f, -30.0f), Vec3(1.0f));
+    bounds.Add(Vec3(1.0f, 1.0f, -60.0f), Vec3(2.0f));
+
+    std::vector<uint8_t> visible(bounds.Size());
+    REQUIRE(buffer.TestBatch(bounds, visible.data()) == 2);
+
+    for (size_t i = 0; i < bounds.Size(); i++)
+    {
+        const bool single = buffer.IsVisible(Vec3(bounds.center_x[i], bounds.center_y[i], bounds.center_z[i]),
+                                             Vec3(bounds.extent_x[i], bounds.extent_y[i], bounds.extent_z[i]));
+        REQUIRE((visible[i] != 0) == single);
+    }
+}
+
+TEST_CASE("Occlusion buffer with reverse-Z", "[math][occlusion]")
+{
+    // Right-handed reverse-Z projection, clip depth in [0, w]
+    const float n = 1.0f, f = 100.0f;
+    const Mat4 projection({
+        { 0.5f, 0.0f, 0.0f,          0.0f },
+        { 0.0f, 1.0f, 0.0f,          0.0f },
+        { 0.0f, 0.0f, n / (f - n),   f * n / (f - n) },
+        { 0.0f, 0.0f, -1.0f,         0.0f }
+    });
+
+    // SetViewProjection reads the rows back through the named elements
+    REQUIRE(projection.m23 == Catch::Approx(f * n / (f - n)));
+    REQUIRE(projection.m32 == Catch::Approx(-1.0f));
+
+    OcclusionBuffer buffer(64, 32, Frustum::DEPTH_REVERSED);
+    buffer.SetViewProjection(projection);
+    AddWall(buffer, 5.0f, -10.0f);
+
+    REQUIRE_FALSE(buffer.IsVisible(Vec3(0.0f, 0.0f, -30.0f), Vec3(1.0f)));
+    REQUIRE(buffer.IsVisible(Vec3(0.0f, 0.0f, -5.0f), Vec3(1.0f)));
+}
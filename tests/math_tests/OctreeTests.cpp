@@ -0,0 +1,126 @@
+﻿#include <algorithm>
+#include <random>
+#include <vector>
+#include <xmath.hpp>
+#include <catch2/catch_all.hpp>
+#include "RandomGeometry.h"
+
+using namespace xMath;
+using TestUtils::MakeRandomBoxes;
+using TestUtils::Overlaps;
+using TestUtils::RandomVector;
+
+namespace
+{
+    std::vector<uint32_t> Sorted(std::vector<uint32_t> values)
+    {
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+}
+
+TEST_CASE("LooseOctree selects the level from the object size", "[math][octree]")
+{
+    LooseOctree octree(BoundingBox(Vec3(-64.0f), Vec3(64.0f)), 6);
+
+    // Cell half size at depth d is 64 / 2^d; an object fits when its extent is no larger
+    octree.Insert(0, BoundingBox(Vec3(-40.0f), Vec3(40.0f)));
+    octree.Insert(1, BoundingBox(Vec3(10.0f), Vec3(26.0f)));     // extent 8 -> depth 3
+    octree.Insert(2, BoundingBox(Vec3(10.0f), Vec3(10.01f)));    // tiny -> max depth
+    octree.Insert(3, BoundingBox(Vec3(200.0f), Vec3(201.0f)));   // outside the world -> root
+    REQUIRE(octree.GetObjectDepth(0) == 0);
+    REQUIRE(octree.GetObjectDepth(1) == 3);
+    REQUIRE(octree.GetObjectDepth(2) == 6);
+    REQUIRE(octree.GetObjectDepth(3) == 0);
+    REQUIRE(octree.GetObjectCount() == 4);
+
+    // Moving within the cell keeps the node, growing moves the object up
+    octree.Update(1, BoundingBox(Vec3(10.5f), Vec3(26.5f)));
+    REQUIRE(octree.GetObjectDepth(1) == 3);
+    octree.Update(1, BoundingBox(Vec3(0.0f), Vec3(30.0f)));
+    REQUIRE(octree.GetObjectDepth(1) == 2);
+
+    // Empty nodes are returned to the pool
+    octree.Remove(2);
+    octree.Remove(1);
+    REQUIRE(octree.GetNodeCount() == 1);
+    REQUIRE_FALSE(octree.Contains(1));
+
+    std::vector<uint32_t> results;
+    octree.QueryOverlap(BoundingBox(Vec3(199.0f), Vec3(199.5f)), results);
+    REQUIRE(results.empty());
+    octree.QueryOverlap(BoundingBox(Vec3(199.0f), Vec3(200.5f)), results);
+    REQUIRE(results == std::vector<uint32_t>{3});
+}
+
+TEST_CASE("LooseOctree queries match brute force while objects move", "[math][octree]")
+{
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> step(-3.0f, 3.0f);
+
+    // Some boxes start outside the octree bounds on purpose
+    LooseOctree octree(BoundingBox(Vec3(-100.0f), Vec3(100.0f)));
+    std::vector<BoundingBox> boxes = MakeRandomBoxes(3000, 18, 110.0f, 0.05f, 6.0f);
+    std::vector<bool> present(boxes.size(), true);
+    for (uint32_t i = 0; i < boxes.size(); i++)
+        octree.Insert(i, boxes[i]);
+
+    const Mat4 view = LookAt(Vec3(0.0f, 10.0f, 0.0f), Vec3(1.0f, 0.0f, -1.0f), Vec3(0.0f, 1.0f, 0.0f));
+    const Frustum frustum(Perspective(PI * 0.35f, 1.6f, 0.5f, 120.0f) * view, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE);
+    const Sphere sphere(Vec3(20.0f, -15.0f, 5.0f), 35.0f);
+    const BoundingBox query(Vec3(-50.0f, -20.0f, -10.0f), Vec3(10.0f, 40.0f, 60.0f));
+
+    for (int frame = 0; frame < 5; frame++)
+    {
+        for (uint32_t i = 0; i < boxes.size(); i++)
+        {
+            if (i % 7 == static_cast<uint32_t>(frame))
+            {
+                // Churn: remove and re-add a few objects
+                if (present[i])
+                    octree.Remove(i);
+                else
+                    octree.Insert(i, boxes[i]);
+                present[i] = !present[i];
+                continue;
+            }
+
+            if (!present[i])
+                continue;
+
+            const Vec3 delta = RandomVector(rng, step);
+            boxes[i] = BoundingBox(boxes[i].GetMin() + delta, boxes[i].GetMax() + delta);
+            octree.Update(i, boxes[i]);
+        }
+
+        std::vector<uint32_t> expected_frustum, expected_sphere, expected_box;
+        for (uint32_t i = 0; i < boxes.size(); i++)
+        {
+            if (!present[i])
+                continue;
+            if (frustum.IsVisible(boxes[i].GetCenter(), boxes[i].GetExtents(), false))
+                expected_frustum.push_back(i);
+            if (Distance(boxes[i].GetClosestPoint(sphere.center), sphere.center) <= sphere.radius)
+                expected_sphere.push_back(i);
+            if (Overlaps(boxes[i], query))
+                expected_box.push_back(i);
+        }
+
+        std::vector<uint32_t> results;
+        octree.QueryFrustum(frustum, results);
+        REQUIRE(!expected_frustum.empty());
+        REQUIRE(Sorted(results) == expected_frustum);
+
+        results.clear();
+        octree.QuerySphere(sphere, results);
+        REQUIRE(Sorted(results) == expected_sphere);
+
+        results.clear();
+        octree.QueryOverlap(query, results);
+        REQUIRE(Sorted(results) == expected_box);
+    }
+
+    octree.Clear();
+    REQUIRE(octree.GetObjectCount() == 0);
+    REQUIRE(octree.GetNodeCount() == 1);
+}
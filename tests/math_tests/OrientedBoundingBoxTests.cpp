@@ -0,0 +1,242 @@
+﻿#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <xmath.hpp>
+#include <catch2/catch_all.hpp>
+#include "RandomGeometry.h"
+
+using namespace xMath;
+using TestUtils::MakeRandomOBB;
+using TestUtils::RandomVector;
+
+namespace
+{
+    bool ContainsApprox(const OrientedBoundingBox &box, const Vec3 &point)
+    {
+        const Vec3 offset = point - box.GetCenter();
+        for (int a = 0; a < 3; a++)
+        {
+            if (std::abs(Dot(offset, box.GetAxis(a))) > box.GetExtents()[a] * 1.0001f + 1e-4f)
+                return false;
+        }
+        return true;
+    }
+
+    float Volume(const Vec3 &extents)
+    {
+        return 8.0f * extents.x * extents.y * extents.z;
+    }
+
+    // Reference SAT on corner projections: separated if the corners of the two boxes do not overlap on a candidate axis
+    bool OverlapByCorners(const OrientedBoundingBox &a, const OrientedBoundingBox &b)
+    {
+        std::array<Vec3, 8> corners_a, corners_b;
+        a.GetCorners(&corners_a);
+        b.GetCorners(&corners_b);
+
+        std::vector<Vec3> candidates;
+        for (int i = 0; i < 3; i++)
+        {
+            candidates.push_back(a.GetAxis(i));
+            candidates.push_back(b.GetAxis(i));
+            for (int j = 0; j < 3; j++)
+            {
+                const Vec3 axis = Cross(a.GetAxis(i), b.GetAxis(j));
+                if (Dot(axis, axis) > 1e-8f)
+                    candidates.push_back(axis);
+            }
+        }
+
+        for (const Vec3 &axis : candidates)
+        {
+            float min_a = 1e30f, max_a = -1e30f, min_b = 1e30f, max_b = -1e30f;
+            for (int c = 0; c < 8; c++)
+            {
+                min_a = std::min(min_a, Dot(corners_a[c], axis)); max_a = std::max(max_a, Dot(corners_a[c], axis));
+                min_b = std::min(min_b, Dot(corners_b[c], axis)); max_b = std::max(max_b, Dot(corners_b[c], axis));
+            }
+            if (max_a < min_b || max_b < min_a)
+                return false;
+        }
+        return true;
+    }
+}
+
+TEST_CASE("OrientedBoundingBox from a transformed BoundingBox", "[math][obb]")
+{
+    // A long thin box rotated 45 degrees: the OBB stays exact while the transformed AABB balloons
+    const BoundingBox local(Vec3(-10.0f, -0.5f, -0.5f), Vec3(10.0f, 0.5f, 0.5f));
+    const Mat4 transform = Mat4::Translate(Vec3(3.0f, 1.0f, -2.0f)) * Mat4::RotationDegrees(Vec3(0.0f, 45.0f, 30.0f)) * Mat4::Scale(Vec3(1.0f, 2.0f, 3.0f));
+    const OrientedBoundingBox box(local, transform);
+
+    REQUIRE(box.GetExtents().x == Catch::Approx(10.0f));
+    REQUIRE(box.GetExtents().y == Catch::Approx(1.0f));
+    REQUIRE(box.GetExtents().z == Catch::Approx(1.5f));
+    REQUIRE(Distance(box.GetCenter(), Vec3(3.0f, 1.0f, -2.0f)) < 1e-4f);
+
+    std::array<Vec3, 8> corners;
+    local.GetCorners(&corners);
+    for (const Vec3 &corner : corners)
+        REQUIRE(ContainsApprox(box, TransformPoint(transform, corner)));
+
+    const BoundingBox aabb = box.GetBoundingBox();
+    REQUIRE(Volume(aabb.GetExtents()) > Volume(box.GetExtents()) * 4.0f);
+    for (const Vec3 &corner : corners)
+    {
+        const Vec3 world = TransformPoint(transform, corner);
+        REQUIRE(aabb.GetClosestPoint(world).x == Catch::Approx(world.x).margin(1e-3));
+    }
+
+    REQUIRE(box.Contains(box.GetCenter()));
+    const Vec3 far_point = box.GetCenter() + box.GetAxis(1) * 5.0f;
+    REQUIRE_FALSE(box.Contains(far_point));
+    REQUIRE(Distance(box.GetClosestPoint(far_point), box.GetCenter() + box.GetAxis(1) * 1.0f) < 1e-4f);
+}
+
+TEST_CASE("OrientedBoundingBox from a transform with zero scale", "[math][obb]")
+{
+    const BoundingBox local(Vec3(-1.0f, -2.0f, -3.0f), Vec3(1.0f, 2.0f, 3.0f));
+    const Mat4 rotation = Mat4::RotationDegrees(Vec3(20.0f, 35.0f, -50.0f));
+
+    // Each zero column drops one extent; the basis stays orthonormal and the others stay tight
+    const Vec3 scales[] = { Vec3(0.0f, 1.0f, 1.0f), Vec3(1.0f, 0.0f, 1.0f), Vec3(0.0f, 0.0f, 2.0f), Vec3(0.0f) };
+    for (const Vec3 &scale : scales)
+    {
+        const Mat4 transform = rotation * Mat4::Scale(scale);
+        const OrientedBoundingBox box(local, transform);
+
+        for (int a = 0; a < 3; a++)
+        {
+            REQUIRE(Length(box.GetAxis(a)) == Catch::Approx(1.0f));
+            REQUIRE(std::abs(Dot(box.GetAxis(a), box.GetAxis((a + 1) % 3))) < 1e-5f);
+        }
+
+        const Vec3 extents = box.GetExtents();
+        REQUIRE(extents.x + extents.y + extents.z == Catch::Approx(scale.x * 1.0f + scale.y * 2.0f + scale.z * 3.0f).margin(1e-4));
+
+        std::array<Vec3, 8> corners;
+        local.GetCorners(&corners);
+        for (const Vec3 &corner : corners)
+            REQUIRE(ContainsApprox(box, TransformPoint(transform, corner)));
+    }
+}
+
+TEST_CASE("OrientedBoundingBox PCA fit", "[math][obb]")
+{
+    // Points filling a rotated 12 x 2 x 1 box, corners included
+    const Mat4 transform = Mat4::Translate(Vec3(-4.0f, 2.0f, 9.0f)) * Mat4::RotationDegrees(Vec3(20.0f, -35.0f, 60.0f));
+    const Vec3 half(6.0f, 1.0f, 0.5f);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<Vec3> points;
+    for (int i = 0; i < 8; i++)
+        points.push_back(TransformPoint(transform, Vec3(i & 1 ? half.x : -half.x, i & 2 ? half.y : -half.y, i & 4 ? half.z : -half.z)));
+    for (int i = 0; i < 2000; i++)
+    {
+        const Vec3 t = RandomVector(rng, unit);
+        points.push_back(TransformPoint(transform, Vec3(t.x * half.x, t.y * half.y, t.z * half.z)));
+    }
+
+    const OrientedBoundingBox box = OrientedBoundingBox::FromPoints(points.data(), points.size());
+    for (const Vec3 &point : points)
+        REQUIRE(ContainsApprox(box, point));
+
+    REQUIRE(Volume(box.GetExtents()) <= Volume(half) * 1.1f);
+    REQUIRE(Volume(box.GetExtents()) < Volume(BoundingBox(points.data(), static_cast<uint32_t>(points.size())).GetExtents()) * 0.5f);
+
+    // The basis is orthonormal and right-handed
+    const Mat3 &basis = box.GetBasis();
+    REQUIRE(basis.Determinant() == Catch::Approx(1.0f).epsilon(1e-4));
+    REQUIRE(Dot(box.GetAxis(0), box.GetAxis(1)) == Catch::Approx(0.0f).margin(1e-5));
+
+    // Degenerate inputs
+    const std::vector<Vec3> same(5, Vec3(1.0f, 2.0f, 3.0f));
+    const OrientedBoundingBox point = OrientedBoundingBox::FromPoints(same.data(), same.size());
+    REQUIRE(Distance(point.GetCenter(), Vec3(1.0f, 2.0f, 3.0f)) < 1e-5f);
+    REQUIRE(Volume(point.GetExtents()) == Catch::Approx(0.0f).margin(1e-6));
+    REQUIRE(OrientedBoundingBox::FromPoints(nullptr, 0).GetExtents().x == 0.0f);
+}
+
+TEST_CASE("OrientedBoundingBox separating axis tests", "[math][obb]")
+{
+    std::mt19937 rng(13);
+    std::vector<OrientedBoundingBox> boxes;
+    for (int i = 0; i < 400; i++)
+        boxes.push_back(MakeRandomOBB(rng, 10.0f, 0.2f, 4.0f));
+
+    std::vector<uint8_t> results(boxes.size());
+    size_t overlaps = 0;
+    for (size_t i = 0; i < 40; i++)
+    {
+        const size_t hits = IntersectOrientedBoxes(boxes[i], boxes.data(), boxes.size(), results.data());
+        size_t expected = 0;
+        for (size_t j = 0; j < boxes.size(); j++)
+        {
+            const bool overlap = OverlapByCorners(boxes[i], boxes[j]);
+            REQUIRE(boxes[i].Intersects(boxes[j]) == overlap);
+            REQUIRE(results[j] == (overlap ? 1 : 0));
+            expected += overlap ? 1 : 0;
+        }
+        REQUIRE(hits == expected);
+        overlaps += expected;
+    }
+    REQUIRE(overlaps > 40);
+
+    // Against axis-aligned boxes, and a diagonal box that only an edge axis separates
+    const BoundingBox aabb(Vec3(-1.0f), Vec3(1.0f));
+    REQUIRE(OrientedBoundingBox(BoundingBox(Vec3(-1.0f), Vec3(1.0f)), Mat4::Translate(Vec3(1.9f, 0.0f, 0.0f))).Intersects(aabb));
+    REQUIRE_FALSE(OrientedBoundingBox(BoundingBox(Vec3(-1.0f), Vec3(1.0f)), Mat4::Translate(Vec3(2.1f, 0.0f, 0.0f))).Intersects(aabb));
+
+    const OrientedBoundingBox diagonal(BoundingBox(Vec3(-0.1f, -0.1f, -5.0f), Vec3(0.1f, 0.1f, 5.0f)),
+                                       Mat4::Translate(Vec3(1.5f, 1.5f, 0.0f)) * Mat4::RotationDegrees(Vec3(0.0f, 90.0f, 45.0f)));
+    const OrientedBoundingBox cube(BoundingBox(Vec3(-1.0f), Vec3(1.0f)), Mat4::RotationDegrees(Vec3(0.0f, 0.0f, 0.0f)));
+    REQUIRE(diagonal.Intersects(cube) == OverlapByCorners(diagonal, cube));
+}
+
+TEST_CASE("OrientedBoundingBox frustum test", "[math][obb]")
+{
+    const Mat4 view = LookAt(Vec3(0.0f, 0.0f, 0.0f), Vec3(0.2f, -0.1f, -1.0f), Vec3(0.0f, 1.0f, 0.0f));
+    const Frustum frustum(Perspective(PI * 0.35f, 1.6f, 0.5f, 60.0f) * view, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE);
+
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<float> position(-40.0f, 40.0f), depth(-70.0f, 5.0f);
+    size_t counts[3] = {};
+    for (int i = 0; i < 2000; i++)
+    {
+        OrientedBoundingBox box = MakeRandomOBB(rng, 10.0f, 0.2f, 4.0f);
+        const float x = position(rng), y = position(rng), z = depth(rng);
+        box = OrientedBoundingBox(Vec3(x, y, z), box.GetBasis(), box.GetExtents());
+
+        // Reference: outside if all corners are behind one plane, inside if all are in front of every plane
+        std::array<Vec3, 8> corners;
+        box.GetCorners(&corners);
+        bool outside = false, inside = true;
+        for (uint32_t p = 0; p < 6; p++)
+        {
+            const Plane &plane = frustum.GetPlane(p);
+            int behind = 0;
+            for (const Vec3 &corner : corners)
+                behind += Dot(plane.normal, corner) + plane.d < 0.0f ? 1 : 0;
+            outside |= behind == 8;
+            inside &= behind == 0;
+        }
+
+        const Intersection expected = outside ? Intersection::Outside : (inside ? Intersection::Inside : Intersection::Intersects);
+        const Intersection result = box.Intersects(frustum);
+        REQUIRE(result == expected);
+        counts[static_cast<int>(result)]++;
+
+        // Never rejects what the AABB test keeps only when it is truly outside
+        if (result != Intersection::Outside)
+        {
+            const BoundingBox aabb = box.GetBoundingBox();
+            REQUIRE(frustum.IsVisible(aabb.GetCenter(), aabb.GetExtents(), false));
+        }
+    }
+    REQUIRE(counts[0] > 0);
+    REQUIRE(counts[1] > 0);
+    REQUIRE(counts[2] > 0);
+}
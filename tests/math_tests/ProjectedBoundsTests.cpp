@@ -0,0 +1,136 @@
+﻿#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <xmath.hpp>
+#include <catch2/catch_all.hpp>
+
+using namespace xMath;
+
+namespace
+{
+    const Rectangle VIEWPORT(0.0f, 0.0f, 100.0f, 100.0f);
+
+    Mat4 MakeView()
+    {
+        return LookAt(Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 0.0f, -1.0f), Vec3(0.0f, 1.0f, 0.0f));
+    }
+
+    Mat4 MakeProjection()
+    {
+        return Perspective(PI * 0.5f, 1.0f, 1.0f, 100.0f);
+    }
+
+    // Brute-force screen rectangle of the sphere surface points in front of the near plane
+    Rectangle SampleSphereRect(const Sphere &sphere)
+    {
+        const Mat4 view_projection = MakeProjection() * MakeView();
+        float min_x = 1e9f, min_y = 1e9f, max_x = -1e9f, max_y = -1e9f;
+        for (int i = 0; i <= 64; i++)
+        {
+            const float theta = PI * static_cast<float>(i) / 64.0f;
+            for (int j = 0; j < 128; j++)
+            {
+                const float phi = 2.0f * PI * static_cast<float>(j) / 128.0f;
+                const Vec3 p = sphere.center + Vec3(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)) * sphere.radius;
+                if (p.z > -1.0f)
+                    continue;
+
+                const Vec4 clip = view_projection * Vec4(p.x, p.y, p.z, 1.0f);
+                const float sx = (clip.x / clip.w * 0.5f + 0.5f) * 100.0f;
+                const float sy = (0.5f - clip.y / clip.w * 0.5f) * 100.0f;
+                min_x = std::min(min_x, sx); max_x = std::max(max_x, sx);
+                min_y = std::min(min_y, sy); max_y = std::max(max_y, sy);
+            }
+        }
+        return Rectangle(min_x, min_y, max_x - min_x, max_y - min_y);
+    }
+}
+
+TEST_CASE("Projected bounds of boxes", "[math][projected_bounds]")
+{
+    const Mat4 view_projection = MakeProjection() * MakeView();
+    Rectangle rect;
+    float depth = 0.0f;
+
+    // Nearest face at z = -9 spans x in [-1, 1], i.e. +-1/9 in NDC
+    REQUIRE(ProjectBoundingBox(view_projection, Vec3(0.0f, 0.0f, -10.0f), Vec3(1.0f), VIEWPORT, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE, rect, depth));
+    REQUIRE(rect.width == Catch::Approx(100.0f / 9.0f));
+    REQUIRE(rect.x == Catch::Approx(50.0f - 50.0f / 9.0f));
+    REQUIRE(depth > 0.0f);
+    REQUIRE(depth < 1.0f);
+
+    // A farther box is smaller and deeper
+    Rectangle far_rect;
+    float far_depth = 0.0f;
+    REQUIRE(ProjectBoundingBox(view_projection, Vec3(0.0f, 0.0f, -20.0f), Vec3(1.0f), VIEWPORT, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE, far_rect, far_depth));
+    REQUIRE(far_rect.width < rect.width);
+    REQUIRE(far_depth > depth);
+
+    // Around the camera: clipped at the near plane, covers the viewport at depth 0
+    REQUIRE(ProjectBoundingBox(view_projection, Vec3(0.0f, 0.0f, 0.0f), Vec3(1.0f), VIEWPORT, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE, rect, depth));
+    REQUIRE(rect.width == Catch::Approx(100.0f));
+    REQUIRE(rect.height == Catch::Approx(100.0f));
+    REQUIRE(depth == Catch::Approx(0.0f));
+
+    // Behind the camera or off screen
+    REQUIRE_FALSE(ProjectBoundingBox(view_projection, Vec3(0.0f, 0.0f, 10.0f), Vec3(1.0f), VIEWPORT, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE, rect, depth));
+    REQUIRE_FALSE(ProjectBoundingBox(view_projection, Vec3(50.0f, 0.0f, -10.0f), Vec3(1.0f), VIEWPORT, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE, rect, depth));
+    REQUIRE(rect.width == 0.0f);
+}
+
+TEST_CASE("Projected bounds of spheres are exact", "[math][projected_bounds]")
+{
+    const Mat4 view = MakeView();
+    const Mat4 projection = MakeProjection();
+    Rectangle rect;
+    float depth = 0.0f;
+
+    // On axis: the tangent cone has tan = 1 / sqrt(d^2 - r^2)
+    REQUIRE(ProjectSphere(view, projection, Sphere(Vec3(0.0f, 0.0f, -10.0f), 1.0f), VIEWPORT, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE, rect, depth));
+    REQUIRE(rect.width == Catch::Approx(100.0f / std::sqrt(99.0f)));
+    REQUIRE(rect.height == Catch::Approx(rect.width));
+
+    // Off axis and crossing the near plane: matches a dense sampling of the surface
+    const Sphere spheres[2] = { Sphere(Vec3(5.0f, -3.0f, -10.0f), 2.0f), Sphere(Vec3(0.3f, 0.2f, -1.2f), 0.5f) };
+    for (const Sphere &sphere : spheres)
+    {
+        REQUIRE(ProjectSphere(view, projection, sphere, VIEWPORT, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE, rect, depth));
+        const Rectangle sampled = SampleSphereRect(sphere);
+        const float left = std::max(sampled.x, 0.0f), right = std::min(sampled.x + sampled.width, 100.0f);
+        const float top = std::max(sampled.y, 0.0f), bottom = std::min(sampled.y + sampled.height, 100.0f);
+        REQUIRE(rect.x == Catch::Approx(left).margin(0.2));
+        REQUIRE(rect.x + rect.width == Catch::Approx(right).margin(0.2));
+        REQUIRE(rect.y == Catch::Approx(top).margin(0.2));
+        REQUIRE(rect.y + rect.height == Catch::Approx(bottom).margin(0.2));
+    }
+    REQUIRE(depth == Catch::Approx(0.0f));
+
+    REQUIRE_FALSE(ProjectSphere(view, projection, Sphere(Vec3(0.0f, 0.0f, 5.0f), 1.0f), VIEWPORT, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE, rect, depth));
+}
+
+TEST_CASE("Batch projected bounds match single projections", "[math][projected_bounds]")
+{
+    const Mat4 view = MakeView();
+    const Mat4 projection = MakeProjection();
+
+    BoundingBoxSoA bounds;
+    bounds.Add(Vec3(0.0f, 0.0f, -10.0f), Vec3(1.0f));
+    bounds.Add(Vec3(0.0f, 0.0f, 10.0f), Vec3(1.0f));
+    bounds.Add(Vec3(3.0f, 2.0f, -30.0f), Vec3(4.0f, 1.0f, 2.0f));
+
+    std::vector<Rectangle> rects(bounds.Size());
+    std::vector<float> depths(bounds.Size());
+    REQUIRE(ProjectBoundingBoxes(projection * view, bounds, VIEWPORT, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE, rects.data(), depths.data()) == 2);
+
+    Rectangle rect;
+    float depth = 0.0f;
+    ProjectBoundingBox(projection * view, Vec3(3.0f, 2.0f, -30.0f), Vec3(4.0f, 1.0f, 2.0f), VIEWPORT, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE, rect, depth);
+    REQUIRE(rects[2] == rect);
+    REQUIRE(depths[2] == depth);
+
+    const Sphere spheres[3] = { Sphere(Vec3(0.0f, 0.0f, -10.0f), 1.0f), Sphere(Vec3(0.0f, 0.0f, 10.0f), 1.0f), Sphere(Vec3(2.0f, 0.0f, -5.0f), 1.0f) };
+    std::vector<Rectangle> sphere_rects(3);
+    std::vector<float> sphere_depths(3);
+    REQUIRE(ProjectSpheres(view, projection, spheres, 3, VIEWPORT, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE, sphere_rects.data(), sphere_depths.data()) == 2);
+    REQUIRE(sphere_rects[1].width == 0.0f);
+}
@@ -0,0 +1,147 @@
+﻿#include <cfloat>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <xmath.hpp>
+#include <catch2/catch_all.hpp>
+#include "RandomGeometry.h"
+
+using namespace xMath;
+using TestUtils::RandomVector;
+
+TEST_CASE("Ray precomputes the inverse direction", "[math][ray]")
+{
+    const Ray ray(Vec3(1.0f, 2.0f, 3.0f), Vec3(2.0f, -4.0f, 0.0f), 10.0f);
+    REQUIRE(ray.inv_direction.x == Catch::Approx(0.5f));
+    REQUIRE(ray.inv_direction.y == Catch::Approx(-0.25f));
+    REQUIRE(std::isinf(ray.inv_direction.z));
+
+    const Vec3 p = ray.GetPoint(1.5f);
+    REQUIRE(p.x == Catch::Approx(4.0f));
+    REQUIRE(p.y == Catch::Approx(-4.0f));
+    REQUIRE(p.z == Catch::Approx(3.0f));
+}
+
+TEST_CASE("Ray-box slab test", "[math][ray]")
+{
+    const Vec3 center(0.0f, 0.0f, -10.0f), extent(1.0f, 1.0f, 1.0f);
+    float distance = 0.0f;
+
+    REQUIRE(IntersectRayBox(Ray(Vec3(0.0f), Vec3(0.0f, 0.0f, -1.0f)), center, extent, distance));
+    REQUIRE(distance == Catch::Approx(9.0f));
+
+    // Axis-parallel ray outside the slab, segment too short, and origin inside
+    REQUIRE_FALSE(IntersectRayBox(Ray(Vec3(2.0f, 0.0f, 0.0f), Vec3(0.0f, 0.0f, -1.0f)), center, extent, distance));
+    REQUIRE_FALSE(IntersectRayBox(Ray(Vec3(0.0f), Vec3(0.0f, 0.0f, -1.0f), 5.0f), center, extent, distance));
+    REQUIRE(IntersectRayBox(Ray(center, Vec3(1.0f, 0.0f, 0.0f)), center, extent, distance));
+    REQUIRE(distance == Catch::Approx(0.0f));
+
+    // Batch versions agree with the single test
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> position(-20.0f, 20.0f), size(0.5f, 2.0f);
+    BoundingBoxSoA boxes;
+    for (int i = 0; i < 500; i++)
+    {
+        const Vec3 center = RandomVector(rng, position);
+        boxes.Add(center, RandomVector(rng, size));
+    }
+
+    const Ray ray(Vec3(-25.0f, 1.0f, 2.0f), Normalize(Vec3(1.0f, 0.05f, -0.1f)), 60.0f);
+    std::vector<float> distances(boxes.Size());
+    const size_t hits = IntersectRayBoxes(ray, boxes, distances.data());
+
+    size_t expected_hits = 0;
+    float nearest = 1e30f;
+    uint32_t nearest_index = 0;
+    for (uint32_t i = 0; i < boxes.Size(); i++)
+    {
+        const BoundingBox box = boxes.Get(i);
+        float t = 0.0f;
+        const bool hit = IntersectRayBox(ray, box.GetCenter(), box.GetExtents(), t);
+        REQUIRE(hit == (distances[i] >= 0.0f));
+        if (!hit)
+            continue;
+
+        REQUIRE(distances[i] == Catch::Approx(t));
+        expected_hits++;
+        if (t < nearest)
+        {
+            nearest = t;
+            nearest_index = i;
+        }
+    }
+    REQUIRE(hits == expected_hits);
+    REQUIRE(hits > 0);
+
+    uint32_t index = 0;
+    REQUIRE(RaycastBoxes(ray, boxes, index, distance));
+    REQUIRE(index == nearest_index);
+    REQUIRE(distance == Catch::Approx(nearest));
+}
+
+TEST_CASE("RayPacket8 matches single rays", "[math][ray]")
+{
+    Ray rays[6];
+    for (int i = 0; i < 6; i++)
+        rays[i] = Ray(Vec3(0.0f), Normalize(Vec3(-0.3f + 0.1f * static_cast<float>(i), 0.02f, -1.0f)), 50.0f);
+
+    const RayPacket8 packet(rays, 6);
+    REQUIRE(packet.active == 0x3F);
+
+    const Ray back = packet.Get(2);
+    REQUIRE(back.direction.x == Catch::Approx(rays[2].direction.x));
+    REQUIRE(back.max_distance == Catch::Approx(50.0f));
+
+    const Vec3 center(0.0f, 0.0f, -20.0f), extent(3.0f, 1.0f, 1.0f);
+    float t[RayPacket8::LANES];
+    const uint8_t mask = packet.IntersectBox(center.x - extent.x, center.y - extent.y, center.z - extent.z, center.x + extent.x, center.y + extent.y, center.z + extent.z, t);
+    for (uint32_t lane = 0; lane < 6; lane++)
+    {
+        float distance = 0.0f;
+        const bool hit = IntersectRayBox(rays[lane], center, extent, distance);
+        REQUIRE(hit == ((mask >> lane) & 1u));
+        if (hit)
+            REQUIRE(t[lane] == Catch::Approx(distance));
+    }
+    REQUIRE((mask & 0xC0) == 0);
+}
+
+TEST_CASE("Ray::FromScreen unprojects picking rays", "[math][ray]")
+{
+    const Vec3 eye(3.0f, 2.0f, 10.0f);
+    const Mat4 view = LookAt(eye, Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 1.0f, 0.0f));
+    const Mat4 projection = Perspective(PI / 3.0f, 16.0f / 9.0f, 0.5f, 100.0f);
+    const Mat4 view_projection = projection * view;
+    const Rectangle viewport(0.0f, 0.0f, 1600.0f, 900.0f);
+
+    // The center pixel looks straight at the target
+    const Ray center = Ray::FromScreen(view_projection.GetInverse(), Vec2(800.0f, 450.0f), viewport, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE);
+    const Vec3 forward = Normalize(-eye);
+    REQUIRE(center.direction.x == Catch::Approx(forward.x).margin(1e-4));
+    REQUIRE(center.direction.y == Catch::Approx(forward.y).margin(1e-4));
+    REQUIRE(center.direction.z == Catch::Approx(forward.z).margin(1e-4));
+    REQUIRE(Distance(center.origin, eye) == Catch::Approx(0.5f).epsilon(1e-3));
+    REQUIRE(center.max_distance == Catch::Approx(99.5f).epsilon(1e-3));
+
+    // A ray through the projection of a point passes through that point
+    const Vec3 target(1.5f, -0.7f, 2.0f);
+    const Vec4 clip = view_projection * Vec4(target.x, target.y, target.z, 1.0f);
+    const Vec2 pixel((clip.x / clip.w * 0.5f + 0.5f) * viewport.width, (0.5f - clip.y / clip.w * 0.5f) * viewport.height);
+    const Ray ray = Ray::FromScreen(view_projection.GetInverse(), pixel, viewport, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE);
+
+    const float t = Dot(target - ray.origin, ray.direction);
+    REQUIRE(Distance(ray.GetPoint(t), target) == Catch::Approx(0.0f).margin(1e-3));
+
+    // Reversed-Z with an infinite far plane (depth = near / -z) leaves the segment unbounded
+    Mat4 reversed(0.0f);
+    reversed.m00 = projection.m00;
+    reversed.m11 = projection.m11;
+    reversed.m23 = 0.5f;
+    reversed.m32 = -1.0f;
+    const uint8_t flags = Frustum::DEPTH_ZERO_TO_ONE | Frustum::DEPTH_REVERSED | Frustum::DEPTH_INFINITE_FAR;
+    const Ray unbounded = Ray::FromScreen((reversed * view).GetInverse(), Vec2(800.0f, 450.0f), viewport, flags);
+    REQUIRE(unbounded.max_distance == FLT_MAX);
+    REQUIRE(unbounded.direction.x == Catch::Approx(forward.x).margin(1e-4));
+    REQUIRE(unbounded.direction.z == Catch::Approx(forward.z).margin(1e-4));
+    REQUIRE(Distance(unbounded.origin, eye) == Catch::Approx(0.5f).epsilon(1e-3));
+}
@@ -0,0 +1,92 @@
+﻿#include <cmath>
+#include <xmath.hpp>
+#include <catch2/catch_all.hpp>
+
+using namespace xMath;
+
+TEST_CASE("Cascade split schemes", "[math][cascades]")
+{
+    float splits[5];
+
+    ComputeCascadeSplits(1.0f, 101.0f, 4, CascadeSplitScheme::Uniform, 0.0f, splits);
+    REQUIRE(splits[0] == Catch::Approx(1.0f));
+    REQUIRE(splits[1] == Catch::Approx(26.0f));
+    REQUIRE(splits[2] == Catch::Approx(51.0f));
+    REQUIRE(splits[4] == Catch::Approx(101.0f));
+
+    ComputeCascadeSplits(1.0f, 10000.0f, 4, CascadeSplitScheme::Logarithmic, 0.0f, splits);
+    REQUIRE(splits[1] == Catch::Approx(10.0f));
+    REQUIRE(splits[2] == Catch::Approx(100.0f));
+    REQUIRE(splits[3] == Catch::Approx(1000.0f));
+
+    // lambda = 0 and lambda = 1 reduce to the pure schemes
+    float practical[5];
+    ComputeCascadeSplits(1.0f, 10000.0f, 4, CascadeSplitScheme::Practical, 1.0f, practical);
+    REQUIRE(practical[2] == Catch::Approx(splits[2]));
+
+    ComputeCascadeSplits(1.0f, 10000.0f, 4, CascadeSplitScheme::Practical, 0.5f, practical);
+    for (int i = 1; i < 5; i++)
+        REQUIRE(practical[i] > practical[i - 1]);
+}
+
+TEST_CASE("Shadow cascades cover the camera frustum", "[math][cascades]")
+{
+    const Mat4 view = LookAt(Vec3(0.0f, 0.0f, 0.0f), Vec3(0.0f, 0.0f, -1.0f), Vec3(0.0f, 1.0f, 0.0f));
+    const Mat4 projection = Perspective(PI * 0.5f, 1.0f, 1.0f, 100.0f);
+
+    CascadeSettings settings;
+    settings.cascade_count = 3;
+    settings.scheme = CascadeSplitScheme::Uniform;
+
+    ShadowCascade cascades[3];
+    REQUIRE(BuildShadowCascades(projection, view, Vec3(0.3f, -1.0f, 0.2f), settings, cascades) == 3);
+
+    REQUIRE(cascades[0].split_near == Catch::Approx(1.0f));
+    REQUIRE(cascades[0].split_far == Catch::Approx(34.0f));
+    REQUIRE(cascades[2].split_far == Catch::Approx(100.0f));
+
+    // 90 degree fov: the far corners of the first slice sit at |x| = |y| = depth
+    REQUIRE(cascades[0].corners[4].z == Catch::Approx(-34.0f));
+    REQUIRE(std::fabs(cascades[0].corners[4].x) == Catch::Approx(34.0f));
+
+    for (const ShadowCascade &cascade : cascades)
+    {
+        for (const Vec3 &corner : cascade.corners)
+        {
+            REQUIRE(Distance(corner, cascade.bounds.center) <= cascade.bounds.radius + 1e-3f);
+            REQUIRE(cascade.frustum.IsVisible(corner, Vec3(0.01f), false));
+        }
+    }
+
+    // A point far outside the slice is rejected by the cascade frustum
+    REQUIRE_FALSE(cascades[0].frustum.IsVisible(Vec3(0.0f, 0.0f, -90.0f), Vec3(0.5f), false));
+}
+
+TEST_CASE("Shadow cascade projections are texel stable", "[math][cascades]")
+{
+    const Mat4 projection = Perspective(PI * 0.4f, 1.5f, 0.5f, 50.0f);
+    const Vec3 light = Vec3(-0.4f, -1.0f, 0.3f);
+
+    CascadeSettings settings;
+    settings.cascade_count = 2;
+    settings.resolution = 1024;
+
+    ShadowCascade a[2], b[2];
+    BuildShadowCascades(projection, LookAt(Vec3(0.0f, 2.0f, 0.0f), Vec3(0.0f, 2.0f, -1.0f), Vec3(0.0f, 1.0f, 0.0f)), light, settings, a);
+    BuildShadowCascades(projection, LookAt(Vec3(0.0f, 2.0f, 0.0f), Vec3(1.0f, 2.0f, -1.0f), Vec3(0.0f, 1.0f, 0.0f)), light, settings, b);
+
+    // Rotating the camera keeps the cascade size (sphere fit)
+    REQUIRE(a[0].bounds.radius == Catch::Approx(b[0].bounds.radius));
+
+    // Translating the camera by a sub-texel amount must move the projection by whole texels only
+    ShadowCascade c[2];
+    BuildShadowCascades(projection, LookAt(Vec3(0.013f, 2.0f, 0.0f), Vec3(0.013f, 2.0f, -1.0f), Vec3(0.0f, 1.0f, 0.0f)), light, settings, c);
+
+    const float texel = 2.0f * a[0].bounds.radius / 1024.0f;
+    const Vec4 row_a = a[0].light_projection[0];
+    const Vec4 row_c = c[0].light_projection[0];
+
+    // m03 = -center_x / radius, so the difference is a multiple of texel / radius
+    const float texel_shift = (row_a.w - row_c.w) * a[0].bounds.radius / texel;
+    REQUIRE(texel_shift == Catch::Approx(std::round(texel_shift)).margin(1e-2));
+}
@@ -0,0 +1,177 @@
+﻿#include <algorithm>
+#include <cfloat>
+#include <random>
+#include <vector>
+#include <xmath.hpp>
+#include <catch2/catch_all.hpp>
+#include "RandomGeometry.h"
+
+using namespace xMath;
+using TestUtils::MakeRandomPoints;
+
+namespace
+{
+    std::vector<uint32_t> Sorted(std::vector<uint32_t> values)
+    {
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+}
+
+TEST_CASE("SpatialHashGrid counting sort layout", "[math][hashgrid]")
+{
+    const std::vector<Vec3> points = MakeRandomPoints(1000, 2, 30.0f);
+    SpatialHashGrid grid(2.0f);
+    grid.Build(points.data(), points.size());
+
+    REQUIRE(grid.GetPointCount() == points.size());
+    REQUIRE(grid.GetTableSize() == 2048);
+
+    std::vector<uint32_t> indices = Sorted(grid.GetSortedIndices());
+    for (uint32_t i = 0; i < indices.size(); i++)
+        REQUIRE(indices[i] == i);
+
+    grid.Clear();
+    REQUIRE(grid.GetPointCount() == 0);
+    std::vector<uint32_t> results;
+    grid.QueryRadius(Vec3(0.0f), 100.0f, results);
+    REQUIRE(results.empty());
+}
+
+TEST_CASE("SpatialHashGrid radius queries match brute force", "[math][hashgrid]")
+{
+    const std::vector<Vec3> points = MakeRandomPoints(5000, 4, 50.0f);
+
+    // A tiny table forces many colliding cells into the same bucket
+    const uint32_t table_size = GENERATE(0u, 16u);
+    SpatialHashGrid grid(3.0f);
+    grid.Build(points.data(), points.size(), table_size);
+
+    const std::vector<Vec3> centers = MakeRandomPoints(50, 8, 60.0f);
+    const float radii[3] = { 2.5f, 7.0f, 400.0f };
+    for (const float radius : radii)
+    {
+        std::vector<uint32_t> neighbors, offsets;
+        const size_t total = grid.QueryRadiusBatch(centers.data(), centers.size(), radius, neighbors, offsets);
+        REQUIRE(total == neighbors.size());
+        REQUIRE(offsets.size() == centers.size() + 1);
+
+        for (size_t q = 0; q < centers.size(); q++)
+        {
+            std::vector<uint32_t> expected;
+            for (uint32_t i = 0; i < points.size(); i++)
+                if (Distance(points[i], centers[q]) <= radius)
+                    expected.push_back(i);
+
+            const std::vector<uint32_t> results(neighbors.begin() + offsets[q], neighbors.begin() + offsets[q + 1]);
+            REQUIRE(Sorted(results) == expected);
+        }
+    }
+}
+
+TEST_CASE("SpatialHashGrid k-nearest queries match brute force", "[math][hashgrid]")
+{
+    const std::vector<Vec3> points = MakeRandomPoints(3000, 6, 40.0f);
+    SpatialHashGrid grid(2.0f);
+    grid.Build(points.data(), points.size(), GENERATE(0u, 64u));
+
+    // Includes queries far outside the occupied cells
+    std::vector<Vec3> queries = MakeRandomPoints(40, 10, 45.0f);
+    queries.emplace_back(300.0f, 0.0f, 0.0f);
+    queries.emplace_back(-80.0f, 90.0f, -70.0f);
+
+    constexpr uint32_t K = 12;
+    std::vector<uint32_t> indices(queries.size() * K);
+    std::vector<float> distances(queries.size() * K);
+    std::vector<uint32_t> found(queries.size());
+    grid.QueryKNearestBatch(queries.data(), queries.size(), K, indices.data(), distances.data(), found.data());
+
+    for (size_t q = 0; q < queries.size(); q++)
+    {
+        std::vector<float> expected;
+        for (const Vec3 &point : points)
+            expected.push_back(Distance(point, queries[q]));
+        std::sort(expected.begin(), expected.end());
+
+        REQUIRE(found[q] == K);
+        for (uint32_t i = 0; i < K; i++)
+        {
+            REQUIRE(distances[q * K + i] == Catch::Approx(expected[i]));
+            REQUIRE(Distance(points[indices[q * K + i]], queries[q]) == Catch::Approx(expected[i]));
+        }
+    }
+
+    // Asking for more neighbors than points returns them all
+    SpatialHashGrid small(1.0f);
+    small.Build(points.data(), 5);
+    uint32_t few_indices[8];
+    float few_distances[8];
+    REQUIRE(small.QueryKNearest(Vec3(0.0f), 8, few_indices, few_distances) == 5);
+    REQUIRE(Sorted(std::vector<uint32_t>(few_indices, few_indices + 5)) == std::vector<uint32_t>{0, 1, 2, 3, 4});
+}
+
+TEST_CASE("SpatialHashGrid k-nearest queries at the cell limits", "[math][hashgrid]")
+{
+    // Coordinates this far out clamp to the outermost cells, so the occupied range spans 2^31 cells
+    std::vector<Vec3> points = MakeRandomPoints(50, 11, 10.0f);
+    points.emplace_back(1e12f, 0.0f, 0.0f);
+    points.emplace_back(-1e12f, 2.0f, 0.0f);
+    SpatialHashGrid grid(1.0f);
+    grid.Build(points.data(), points.size());
+
+    uint32_t index = 0;
+    float distance = 0.0f;
+    REQUIRE(grid.QueryKNearest(points[50], 1, &index, &distance) == 1);
+    REQUIRE(index == 50);
+    REQUIRE(grid.QueryKNearest(points[51], 1, &index, &distance) == 1);
+    REQUIRE(index == 51);
+
+    const Vec3 query(0.5f, -0.25f, 1.0f);
+    float expected = FLT_MAX;
+    for (const Vec3 &point : points)
+        expected = std::min(expected, Distance(point, query));
+    REQUIRE(grid.QueryKNearest(query, 1, &index, &distance) == 1);
+    REQUIRE(distance == Catch::Approx(expected));
+
+    // A radius covering the whole occupied range spans more cells than fit in int32 on every axis
+    const Vec3 corners[3] = { Vec3(1e12f), Vec3(-1e12f), Vec3(0.0f) };
+    SpatialHashGrid wide(1.0f);
+    wide.Build(corners, 3);
+    std::vector<uint32_t> all;
+    wide.QueryRadius(Vec3(0.0f), 2e12f, all);
+    REQUIRE(Sorted(all) == std::vector<uint32_t>{0, 1, 2});
+
+    // A query far outside the occupied cells starts from the nearest occupied cell instead of walking
+    // every ring in between
+    SpatialHashGrid cluster(1.0f);
+    cluster.Build(points.data(), 50);
+    const Vec3 far_query(0.0f, 0.0f, 1e12f);
+    expected = FLT_MAX;
+    for (size_t i = 0; i < 50; i++)
+        expected = std::min(expected, Distance(points[i], far_query));
+    REQUIRE(cluster.QueryKNearest(far_query, 1, &index, &distance) == 1);
+    REQUIRE(distance == Catch::Approx(expected));
+}
+
+TEST_CASE("SpatialHashGrid k-nearest falls back to a linear scan on sparse points", "[math][hashgrid]")
+{
+    // 400 empty cells on every axis between the two points; walking the rings would visit about 400^3 cells
+    const Vec3 points[2] = { Vec3(0.5f), Vec3(400.5f) };
+    SpatialHashGrid grid(1.0f);
+    grid.Build(points, 2);
+
+    uint32_t indices[2] = {};
+    float distances[2] = {};
+    REQUIRE(grid.QueryKNearest(points[0], 2, indices, distances) == 2);
+    REQUIRE(indices[0] == 0);
+    REQUIRE(indices[1] == 1);
+    REQUIRE(distances[0] == Catch::Approx(0.0f));
+    REQUIRE(distances[1] == Catch::Approx(Distance(points[0], points[1])));
+
+    const Vec3 query(300.0f, 290.0f, 310.0f);
+    REQUIRE(grid.QueryKNearest(query, 2, indices, distances) == 2);
+    REQUIRE(indices[0] == 1);
+    REQUIRE(indices[1] == 0);
+    REQUIRE(distances[0] == Catch::Approx(Distance(query, points[1])));
+    REQUIRE(distances[1] == Catch::Approx(Distance(query, points[0])));
+}
@@ -0,0 +1,176 @@
+﻿#include <algorithm>
+#include <random>
+#include <vector>
+#include <xmath.hpp>
+#include <catch2/catch_all.hpp>
+
+using namespace xMath;
+
+namespace
+{
+    std::vector<Rectangle> MakeRandomRects(size_t count, uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> position(0.0f, 1900.0f);
+        std::uniform_real_distribution<float> size(1.0f, 120.0f);
+
+        std::vector<Rectangle> rects;
+        rects.reserve(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            const float x = position(rng), y = position(rng), w = size(rng), h = size(rng);
+            rects.emplace_back(x, y, w, h);
+        }
+        return rects;
+    }
+
+    bool ContainsPoint(const Rectangle &rect, const Vec2 &point)
+    {
+        return point.x >= rect.x && point.x <= rect.x + rect.width && point.y >= rect.y && point.y <= rect.y + rect.height;
+    }
+
+    std::vector<uint32_t> Sorted(std::vector<uint32_t> values)
+    {
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+
+    struct Expected
+    {
+        std::vector<uint32_t> point, rect, region;
+    };
+
+    Expected BruteForce(const std::vector<Rectangle> &rects, const std::vector<bool> &present, const Vec2 &point, const Rectangle &query, const Rectangle *region, size_t region_count)
+    {
+        Expected expected;
+        for (uint32_t i = 0; i < rects.size(); i++)
+        {
+            if (!present[i])
+                continue;
+            if (ContainsPoint(rects[i], point))
+                expected.point.push_back(i);
+            if (rects[i].Intersects(query))
+                expected.rect.push_back(i);
+            for (size_t r = 0; r < region_count; r++)
+                if (rects[i].Intersects(region[r]))
+                {
+                    expected.region.push_back(i);
+                    break;
+                }
+        }
+        return expected;
+    }
+}
+
+TEST_CASE("PackedRTree queries match brute force", "[math][rtree]")
+{
+    const std::vector<Rectangle> rects = MakeRandomRects(20000, 5);
+    const uint32_t node_size = GENERATE(2u, 16u);
+
+    PackedRTree tree;
+    tree.Build(rects.data(), rects.size(), node_size);
+    REQUIRE(tree.GetItemCount() == rects.size());
+    REQUIRE(tree.GetHeight() > 1);
+
+    const Rectangle bounds = tree.GetBounds();
+    for (const Rectangle &rect : rects)
+        REQUIRE(bounds.Contains(rect));
+
+    const std::vector<bool> present(rects.size(), true);
+    const Vec2 point(640.0f, 360.0f);
+    const Rectangle query(100.0f, 200.0f, 300.0f, 150.0f);
+    const Rectangle region[2] = { Rectangle(0.0f, 0.0f, 400.0f, 300.0f), Rectangle(350.0f, 250.0f, 400.0f, 300.0f) };
+    const Expected expected = BruteForce(rects, present, point, query, region, 2);
+
+    std::vector<uint32_t> results;
+    tree.QueryPoint(point, results);
+    REQUIRE(!expected.point.empty());
+    REQUIRE(Sorted(results) == expected.point);
+
+    results.clear();
+    tree.QueryRect(query, results);
+    REQUIRE(Sorted(results) == expected.rect);
+
+    results.clear();
+    tree.QueryRegion(region, 2, results);
+    REQUIRE(Sorted(results) == expected.region);
+}
+
+TEST_CASE("PackedRTree handles tiny inputs", "[math][rtree]")
+{
+    PackedRTree tree;
+    tree.Build(nullptr, 0);
+    REQUIRE(tree.IsEmpty());
+
+    std::vector<uint32_t> results;
+    tree.QueryRect(Rectangle(0.0f, 0.0f, 10.0f, 10.0f), results);
+    REQUIRE(results.empty());
+
+    const Rectangle single(5.0f, 5.0f, 2.0f, 2.0f);
+    tree.Build(&single, 1);
+    REQUIRE(tree.GetNodeCount() == 0);
+    tree.QueryPoint(Vec2(7.0f, 7.0f), results);   // on the edge
+    REQUIRE(results == std::vector<uint32_t>{0});
+}
+
+TEST_CASE("Quadtree queries match brute force while items move", "[math][quadtree]")
+{
+    std::mt19937 rng(31);
+    std::uniform_real_distribution<float> step(-40.0f, 40.0f);
+
+    std::vector<Rectangle> rects = MakeRandomRects(4000, 9);
+    rects.emplace_back(-500.0f, -500.0f, 50.0f, 50.0f);   // outside the world
+    std::vector<bool> present(rects.size(), true);
+
+    Quadtree tree(Rectangle(0.0f, 0.0f, 2048.0f, 2048.0f), 8, GENERATE(1u, 8u));
+    for (uint32_t i = 0; i < rects.size(); i++)
+        tree.Insert(i, rects[i]);
+    REQUIRE(tree.GetItemCount() == rects.size());
+    REQUIRE(tree.GetNodeCount() > 1);
+
+    const Rectangle region[3] = { Rectangle(0.0f, 0.0f, 960.0f, 1080.0f), Rectangle(960.0f, 0.0f, 960.0f, 540.0f), Rectangle(-600.0f, -600.0f, 80.0f, 80.0f) };
+    for (int frame = 0; frame < 6; frame++)
+    {
+        for (uint32_t i = 0; i + 1 < rects.size(); i++)
+        {
+            if (i % 11 == static_cast<uint32_t>(frame))
+            {
+                if (present[i])
+                    tree.Remove(i);
+                else
+                    tree.Insert(i, rects[i]);
+                present[i] = !present[i];
+                continue;
+            }
+            if (!present[i])
+                continue;
+
+            rects[i].x += step(rng);
+            rects[i].y += step(rng);
+            tree.Update(i, rects[i]);
+        }
+
+        const Vec2 point(700.0f + 50.0f * static_cast<float>(frame), 900.0f);
+        const Rectangle query(300.0f, 1200.0f, 500.0f, 200.0f);
+        const Expected expected = BruteForce(rects, present, point, query, region, 3);
+
+        std::vector<uint32_t> results;
+        tree.QueryPoint(point, results);
+        REQUIRE(Sorted(results) == expected.point);
+
+        results.clear();
+        tree.QueryRect(query, results);
+        REQUIRE(Sorted(results) == expected.rect);
+
+        results.clear();
+        tree.QueryRegion(region, 3, results);
+        REQUIRE(Sorted(results) == expected.region);
+    }
+
+    // Removing everything collapses the tree back to its root
+    for (uint32_t i = 0; i < rects.size(); i++)
+        if (present[i])
+            tree.Remove(i);
+    REQUIRE(tree.GetItemCount() == 0);
+    REQUIRE(tree.GetNodeCount() == 1);
+}
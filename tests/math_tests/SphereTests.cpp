@@ -0,0 +1,193 @@
+﻿#include <cmath>
+#include <random>
+#include <vector>
+#include <xmath.hpp>
+#include <catch2/catch_all.hpp>
+#include "RandomGeometry.h"
+
+using namespace xMath;
+using TestUtils::RandomVector;
+
+namespace
+{
+    // Random points strictly inside a ball, plus an antipodal pair on its surface: the ball is the minimal sphere
+    std::vector<Vec3> MakeBallPoints(size_t count, uint32_t seed, const Vec3 &center, float radius)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+        std::vector<Vec3> points;
+        while (points.size() < count)
+        {
+            const Vec3 offset = RandomVector(rng, unit);
+            const float length = std::sqrt(offset.x * offset.x + offset.y * offset.y + offset.z * offset.z);
+            if (length < 0.95f)
+                points.push_back(center + offset * radius);
+        }
+
+        const Vec3 axis = Normalize(Vec3(0.3f, -0.5f, 0.8f));
+        points.insert(points.begin() + static_cast<std::ptrdiff_t>(count / 2), center + axis * radius);
+        points.push_back(center - axis * radius);
+        return points;
+    }
+
+    bool ContainsAll(const Sphere &sphere, const std::vector<Vec3> &points)
+    {
+        for (const Vec3 &point : points)
+        {
+            if (Distance(point, sphere.center) > sphere.radius * (1.0f + 1e-5f) + 1e-5f)
+                return false;
+        }
+        return true;
+    }
+}
+
+TEST_CASE("Sphere fits bound every point", "[math][sphere]")
+{
+    const Vec3 center(4.0f, -2.0f, 7.0f);
+    const std::vector<Vec3> points = MakeBallPoints(GENERATE(2u, 30u, 5000u), 3, center, 10.0f);
+
+    const Sphere exact = Sphere::FromPointsExact(points.data(), points.size());
+    const Sphere epos = Sphere::FromPointsEPOS(points.data(), points.size());
+    const Sphere ritter = Sphere::FromPointsRitter(points.data(), points.size());
+
+    REQUIRE(ContainsAll(exact, points));
+    REQUIRE(ContainsAll(epos, points));
+    REQUIRE(ContainsAll(ritter, points));
+
+    // The antipodal pair pins the minimal sphere
+    REQUIRE(exact.radius == Catch::Approx(10.0f).epsilon(1e-4));
+    REQUIRE(Distance(exact.center, center) < 1e-3f);
+
+    REQUIRE(epos.radius >= exact.radius * (1.0f - 1e-5f));
+    REQUIRE(ritter.radius >= exact.radius * (1.0f - 1e-5f));
+    REQUIRE(epos.radius <= exact.radius * 1.05f);
+    REQUIRE(ritter.radius <= exact.radius * 1.25f);
+}
+
+TEST_CASE("Sphere exact fit on known shapes", "[math][sphere]")
+{
+    SECTION("Cube corners")
+    {
+        std::vector<Vec3> points;
+        for (int i = 0; i < 8; i++)
+            points.emplace_back(i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f);
+
+        const Sphere sphere = Sphere::FromPointsExact(points.data(), points.size());
+        REQUIRE(sphere.radius == Catch::Approx(std::sqrt(3.0f)));
+        REQUIRE(Distance(sphere.center, Vec3(0.0f)) < 1e-4f);
+    }
+
+    SECTION("Obtuse triangle uses its longest edge")
+    {
+        const Vec3 points[3] = { Vec3(-5.0f, 0.0f, 0.0f), Vec3(5.0f, 0.0f, 0.0f), Vec3(0.0f, 1.0f, 0.0f) };
+        const Sphere sphere = Sphere::FromPointsExact(points, 3);
+        REQUIRE(sphere.radius == Catch::Approx(5.0f));
+        REQUIRE(Distance(sphere.center, Vec3(0.0f)) < 1e-4f);
+    }
+
+    SECTION("Coplanar circle")
+    {
+        std::vector<Vec3> points;
+        for (int i = 0; i < 64; i++)
+        {
+            const float angle = static_cast<float>(i) * 0.1f;
+            points.emplace_back(3.0f * std::cos(angle), 2.0f, 3.0f * std::sin(angle));
+        }
+        const Sphere sphere = Sphere::FromPointsExact(points.data(), points.size());
+        REQUIRE(ContainsAll(sphere, points));
+        REQUIRE(sphere.radius == Catch::Approx(3.0f).epsilon(1e-3));
+    }
+
+    SECTION("Collinear and coincident points")
+    {
+        const std::vector<Vec3> line = { Vec3(0.0f), Vec3(1.0f), Vec3(2.0f), Vec3(-2.0f), Vec3(0.5f) };
+        const Sphere sphere = Sphere::FromPointsExact(line.data(), line.size());
+        REQUIRE(sphere.radius == Catch::Approx(2.0f * std::sqrt(3.0f)));
+
+        const std::vector<Vec3> same(10, Vec3(1.0f, 2.0f, 3.0f));
+        const Sphere point = Sphere::FromPointsEPOS(same.data(), same.size());
+        REQUIRE(point.radius == Catch::Approx(0.0f).margin(1e-5));
+
+        REQUIRE(Sphere::FromPointsRitter(nullptr, 0).radius == 0.0f);
+    }
+}
+
+TEST_CASE("Sphere merge and transform", "[math][sphere]")
+{
+    Sphere a(Vec3(0.0f), 1.0f);
+    a.Merge(Sphere(Vec3(4.0f, 0.0f, 0.0f), 1.0f));
+    REQUIRE(a.radius == Catch::Approx(3.0f));
+    REQUIRE(a.center.x == Catch::Approx(2.0f));
+
+    // Merging a contained sphere changes nothing; merging a containing one adopts it
+    a.Merge(Sphere(Vec3(2.0f, 0.5f, 0.0f), 0.5f));
+    REQUIRE(a.radius == Catch::Approx(3.0f));
+    a.Merge(Sphere(Vec3(2.0f, 0.0f, 0.0f), 10.0f));
+    REQUIRE(a.radius == Catch::Approx(10.0f));
+
+    Sphere b(Vec3(0.0f), 1.0f);
+    b.Merge(Vec3(3.0f, 0.0f, 0.0f));
+    REQUIRE(b.radius == Catch::Approx(2.0f));
+    REQUIRE(b.Contains(Vec3(-1.0f, 0.0f, 0.0f)));
+    REQUIRE(b.Contains(Vec3(3.0f, 0.0f, 0.0f)));
+
+    const Mat4 transform = Mat4::Translate(Vec3(5.0f, -1.0f, 2.0f)) * Mat4::RotationDegrees(Vec3(30.0f, 45.0f, 10.0f)) * Mat4::Scale(Vec3(1.0f, 3.0f, 2.0f));
+    const Sphere sphere(Vec3(1.0f, 2.0f, 3.0f), 2.0f);
+    const Sphere moved = sphere * transform;
+    REQUIRE(moved.radius == Catch::Approx(6.0f));
+    REQUIRE(Distance(moved.center, TransformPoint(transform, sphere.center)) < 1e-4f);
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    for (int i = 0; i < 200; i++)
+    {
+        const Vec3 direction = Normalize(RandomVector(rng, unit));
+        const Vec3 surface = TransformPoint(transform, sphere.center + direction * sphere.radius);
+        REQUIRE(Distance(surface, moved.center) <= moved.radius * 1.0001f);
+    }
+}
+
+TEST_CASE("Sphere batch tests match single tests", "[math][sphere]")
+{
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> position(-50.0f, 50.0f), size(0.1f, 5.0f);
+
+    std::vector<Sphere> spheres;
+    BoundingBoxSoA boxes;
+    std::vector<BoundingBox> box_list;
+    for (int i = 0; i < 1000; i++)
+    {
+        const Vec3 center = RandomVector(rng, position);
+        spheres.emplace_back(center, size(rng));
+        const Vec3 min = RandomVector(rng, position);
+        box_list.emplace_back(min, min + RandomVector(rng, size));
+        boxes.Add(box_list.back());
+    }
+
+    const Sphere query(Vec3(3.0f, -4.0f, 10.0f), 20.0f);
+    std::vector<uint8_t> results(spheres.size());
+
+    size_t expected = 0;
+    REQUIRE(IntersectSpheres(query, spheres.data(), spheres.size(), results.data()) > 0);
+    for (size_t i = 0; i < spheres.size(); i++)
+    {
+        REQUIRE(results[i] == (query.Intersects(spheres[i]) ? 1 : 0));
+        expected += results[i];
+    }
+    REQUIRE(IntersectSpheres(query, spheres.data(), spheres.size(), results.data()) == expected);
+
+    expected = 0;
+    const size_t hits = IntersectSphereBoxes(query, boxes, results.data());
+    for (size_t i = 0; i < box_list.size(); i++)
+    {
+        REQUIRE(results[i] == (query.Intersects(box_list[i]) ? 1 : 0));
+        expected += results[i];
+    }
+    REQUIRE(hits == expected);
+    REQUIRE(hits > 0);
+
+    // Touching counts
+    REQUIRE(Sphere(Vec3(0.0f), 1.0f).Intersects(Sphere(Vec3(2.0f, 0.0f, 0.0f), 1.0f)));
+    REQUIRE(Sphere(Vec3(0.0f), 1.0f).Intersects(BoundingBox(Vec3(1.0f, -1.0f, -1.0f), Vec3(2.0f, 1.0f, 1.0f))));
+}
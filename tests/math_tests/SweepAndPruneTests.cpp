@@ -0,0 +1,130 @@
+﻿#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+#include <xmath.hpp>
+#include <catch2/catch_all.hpp>
+#include "RandomGeometry.h"
+
+using namespace xMath;
+using TestUtils::MakeRandomBoxes;
+using TestUtils::RandomVector;
+
+namespace
+{
+    using PairSet = std::set<std::pair<uint32_t, uint32_t>>;
+
+    PairSet BruteForcePairs(const std::vector<BoundingBox> &boxes, const std::vector<bool> &present)
+    {
+        PairSet pairs;
+        for (uint32_t a = 0; a < boxes.size(); a++)
+            for (uint32_t b = a + 1; b < boxes.size(); b++)
+                if (present[a] && present[b] && boxes[a].Intersects(boxes[b]) != Intersection::Outside)
+                    pairs.insert({a, b});
+        return pairs;
+    }
+
+    PairSet ToSet(const std::vector<OverlapPair> &pairs)
+    {
+        PairSet result;
+        for (const OverlapPair &pair : pairs)
+        {
+            REQUIRE(pair.a < pair.b);
+            result.insert({pair.a, pair.b});
+        }
+        return result;
+    }
+}
+
+TEST_CASE("SweepAndPrune reports touching and separating boxes", "[math][sap]")
+{
+    const uint32_t axis = GENERATE(0u, 2u, SweepAndPrune::ALL_AXES);
+    SweepAndPrune broadphase(axis);
+
+    broadphase.Add(0, BoundingBox(Vec3(0.0f), Vec3(1.0f)));
+    broadphase.Add(1, BoundingBox(Vec3(1.0f, 0.0f, 0.0f), Vec3(2.0f, 1.0f, 1.0f)));  // touches 0
+    broadphase.Add(2, BoundingBox(Vec3(5.0f), Vec3(6.0f)));
+    broadphase.UpdatePairs();
+    REQUIRE(broadphase.GetAddedPairs() == std::vector<OverlapPair>{{0, 1}});
+    REQUIRE(broadphase.GetRemovedPairs().empty());
+    REQUIRE(broadphase.IsOverlapping(1, 0));
+
+    // Separate 0 and 1 along y only, and move 2 onto 0
+    broadphase.Update(1, BoundingBox(Vec3(1.0f, 3.0f, 0.0f), Vec3(2.0f, 4.0f, 1.0f)));
+    broadphase.Update(2, BoundingBox(Vec3(0.5f), Vec3(1.5f)));
+    broadphase.UpdatePairs();
+    REQUIRE(broadphase.GetAddedPairs() == std::vector<OverlapPair>{{0, 2}});
+    REQUIRE(broadphase.GetRemovedPairs() == std::vector<OverlapPair>{{0, 1}});
+
+    // Nothing moved, nothing reported
+    broadphase.UpdatePairs();
+    REQUIRE(broadphase.GetAddedPairs().empty());
+    REQUIRE(broadphase.GetRemovedPairs().empty());
+
+    broadphase.Remove(0);
+    REQUIRE(broadphase.GetObjectCount() == 2);
+    broadphase.UpdatePairs();
+    REQUIRE(broadphase.GetRemovedPairs() == std::vector<OverlapPair>{{0, 2}});
+    REQUIRE(broadphase.GetPairCount() == 0);
+    REQUIRE_FALSE(broadphase.Contains(0));
+
+    // The id can be reused after the update
+    broadphase.Add(0, BoundingBox(Vec3(1.2f), Vec3(1.3f)));
+    broadphase.UpdatePairs();
+    REQUIRE(broadphase.GetAddedPairs() == std::vector<OverlapPair>{{0, 2}});
+}
+
+TEST_CASE("SweepAndPrune pairs match brute force under motion", "[math][sap]")
+{
+    const uint32_t axis = GENERATE(1u, SweepAndPrune::ALL_AXES);
+
+    std::mt19937 rng(23);
+    std::uniform_real_distribution<float> step(-0.8f, 0.8f);
+
+    std::vector<BoundingBox> boxes = MakeRandomBoxes(400, 24, 40.0f, 0.5f, 5.0f);
+    std::vector<bool> present(boxes.size(), true);
+    SweepAndPrune broadphase(axis);
+    for (uint32_t i = 0; i < boxes.size(); i++)
+        broadphase.Add(i, boxes[i]);
+
+    broadphase.UpdatePairs();
+    PairSet previous = BruteForcePairs(boxes, present);
+    REQUIRE(ToSet(broadphase.GetAddedPairs()) == previous);
+
+    for (int frame = 0; frame < 20; frame++)
+    {
+        for (uint32_t i = 0; i < boxes.size(); i++)
+        {
+            if (i % 37 == static_cast<uint32_t>(frame))
+            {
+                if (present[i])
+                    broadphase.Remove(i);
+                else
+                    broadphase.Add(i, boxes[i]);
+                present[i] = !present[i];
+                continue;
+            }
+            if (!present[i])
+                continue;
+
+            const Vec3 delta = RandomVector(rng, step);
+            boxes[i] = BoundingBox(boxes[i].GetMin() + delta, boxes[i].GetMax() + delta);
+            broadphase.Update(i, boxes[i]);
+        }
+        broadphase.UpdatePairs();
+
+        const PairSet current = BruteForcePairs(boxes, present);
+        PairSet added, removed;
+        std::set_difference(current.begin(), current.end(), previous.begin(), previous.end(), std::inserter(added, added.end()));
+        std::set_difference(previous.begin(), previous.end(), current.begin(), current.end(), std::inserter(removed, removed.end()));
+
+        REQUIRE(ToSet(broadphase.GetAddedPairs()) == added);
+        REQUIRE(ToSet(broadphase.GetRemovedPairs()) == removed);
+
+        std::vector<OverlapPair> pairs;
+        broadphase.GetPairs(pairs);
+        REQUIRE(ToSet(pairs) == current);
+        previous = current;
+    }
+}
@@ -0,0 +1,382 @@
+﻿#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <xmath.hpp>
+#include <catch2/catch_all.hpp>
+#include "RandomGeometry.h"
+
+using namespace xMath;
+using TestUtils::MakeRandomAABB;
+using TestUtils::RandomVector;
+
+namespace
+{
+    struct Triangle
+    {
+        Vec3 a, b, c;
+    };
+
+    // Reference SAT: projects all box corners and triangle vertices on each of the 13 axes
+    bool ReferenceOverlap(const Triangle &triangle, const BoundingBox &box)
+    {
+        const Vec3 vertices[3] = { triangle.a, triangle.b, triangle.c };
+        const Vec3 edges[3] = { triangle.b - triangle.a, triangle.c - triangle.b, triangle.a - triangle.c };
+        const Vec3 units[3] = { Vec3(1, 0, 0), Vec3(0, 1, 0), Vec3(0, 0, 1) };
+
+        std::vector<Vec3> axes(units, units + 3);
+        axes.push_back(Cross(edges[0], edges[1]));
+        for (const Vec3 &unit : units)
+        {
+            for (const Vec3 &edge : edges)
+                axes.push_back(Cross(unit, edge));
+        }
+
+        for (const Vec3 &axis : axes)
+        {
+            float box_min = FLT_MAX, box_max = -FLT_MAX, triangle_min = FLT_MAX, triangle_max = -FLT_MAX;
+            for (int corner = 0; corner < 8; corner++)
+            {
+                const Vec3 point((corner & 1) ? box.GetMax().x : box.GetMin().x, (corner & 2) ? box.GetMax().y : box.GetMin().y, (corner & 4) ? box.GetMax().z : box.GetMin().z);
+                box_min = std::min(box_min, Dot(axis, point));
+                box_max = std::max(box_max, Dot(axis, point));
+            }
+            for (const Vec3 &vertex : vertices)
+            {
+                triangle_min = std::min(triangle_min, Dot(axis, vertex));
+                triangle_max = std::max(triangle_max, Dot(axis, vertex));
+            }
+            if (triangle_min > box_max || triangle_max < box_min)
+                return false;
+        }
+        return true;
+    }
+
+    BoundingBox Inflate(const BoundingBox &box, float amount)
+    {
+        return { box.GetMin() - Vec3(amount), box.GetMax() + Vec3(amount) };
+    }
+
+    std::vector<Vec3> MakeRandomTriangles(size_t count, uint32_t seed, const Vec3 &min, const Vec3 &max, float size)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::uniform_real_distribution<float> offset(-size, size);
+
+        std::vector<Vec3> vertices;
+        for (size_t i = 0; i < count; i++)
+        {
+            const Vec3 t = RandomVector(rng, unit);
+            const Vec3 center(min.x + (max.x - min.x) * t.x, min.y + (max.y - min.y) * t.y, min.z + (max.z - min.z) * t.z);
+            for (int v = 0; v < 3; v++)
+                vertices.push_back(center + RandomVector(rng, offset));
+        }
+        return vertices;
+    }
+
+    // Closed UV sphere with outward-facing triangles
+    void AppendSphere(const Vec3 &center, float radius, uint32_t rings, uint32_t segments, std::vector<Vec3> &vertices, std::vector<uint32_t> &indices)
+    {
+        const auto base = static_cast<uint32_t>(vertices.size());
+        for (uint32_t ring = 0; ring <= rings; ring++)
+        {
+            const float theta = 3.14159265f * static_cast<float>(ring) / static_cast<float>(rings);
+            for (uint32_t segment = 0; segment < segments; segment++)
+            {
+                const float phi = 2.0f * 3.14159265f * static_cast<float>(segment) / static_cast<float>(segments);
+                vertices.push_back(center + Vec3(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)) * radius);
+            }
+        }
+
+        for (uint32_t ring = 0; ring < rings; ring++)
+        {
+            for (uint32_t segment = 0; segment < segments; segment++)
+            {
+                const uint32_t next = (segment + 1) % segments;
+                const uint32_t i00 = base + ring * segments + segment, i01 = base + ring * segments + next;
+                const uint32_t i10 = base + (ring + 1) * segments + segment, i11 = base + (ring + 1) * segments + next;
+                if (ring != 0)
+                    indices.insert(indices.end(), { i00, i01, i10 });
+                if (ring != rings - 1)
+                    indices.insert(indices.end(), { i01, i11, i10 });
+            }
+        }
+    }
+
+    // Closed box with outward-facing triangles
+    void AppendBox(const Vec3 &min, const Vec3 &max, std::vector<Vec3> &vertices, std::vector<uint32_t> &indices)
+    {
+        const auto base = static_cast<uint32_t>(vertices.size());
+        for (int corner = 0; corner < 8; corner++)
+            vertices.emplace_back((corner & 1) ? max.x : min.x, (corner & 2) ? max.y : min.y, (corner & 4) ? max.z : min.z);
+
+        const uint32_t faces[6][4] = { { 0, 4, 6, 2 }, { 1, 3, 7, 5 }, { 0, 1, 5, 4 }, { 2, 6, 7, 3 }, { 0, 2, 3, 1 }, { 4, 5, 7, 6 } };
+        for (const auto &face : faces)
+        {
+            indices.insert(indices.end(), { base + face[0], base + face[1], base + face[2] });
+            indices.insert(indices.end(), { base + face[0], base + face[2], base + face[3] });
+        }
+    }
+
+    // Point inside a convex closed mesh: behind every triangle plane
+    bool InsideConvex(const Vec3 &point, const std::vector<Vec3> &vertices, const std::vector<uint32_t> &indices, size_t first_index, size_t index_count)
+    {
+        for (size_t i = first_index; i < first_index + index_count; i += 3)
+        {
+            const Vec3 &a = vertices[indices[i]];
+            const Vec3 normal = Cross(vertices[indices[i + 1]] - a, vertices[indices[i + 2]] - a);
+            if (Dot(normal, point - a) > 0.0f)
+                return false;
+        }
+        return true;
+    }
+
+    // Every mismatch against the exact test must be within a hair of the voxel boundary
+    void CheckAgainstReference(const VoxelGrid &grid, const std::vector<Triangle> &triangles, size_t &mismatches)
+    {
+        const float slack = grid.GetVoxelSize() * 1e-3f;
+        for (uint32_t z = 0; z < grid.GetSizeZ(); z++)
+        {
+            for (uint32_t y = 0; y < grid.GetSizeY(); y++)
+            {
+                for (uint32_t x = 0; x < grid.GetSizeX(); x++)
+                {
+                    const BoundingBox voxel = grid.GetVoxelBounds(x, y, z);
+                    bool expected = false, grown = false, shrunk = false;
+                    for (const Triangle &triangle : triangles)
+                    {
+                        expected |= IntersectTriangleBox(triangle.a, triangle.b, triangle.c, voxel);
+                        grown |= IntersectTriangleBox(triangle.a, triangle.b, triangle.c, Inflate(voxel, slack));
+                        shrunk |= IntersectTriangleBox(triangle.a, triangle.b, triangle.c, Inflate(voxel, -slack));
+                    }
+
+                    if (grid.Get(x, y, z) != expected)
+                    {
+                        mismatches++;
+                        REQUIRE(grown);
+                        REQUIRE_FALSE(shrunk);
+                    }
+                }
+            }
+        }
+    }
+
+    void RequireSameVoxels(const VoxelGrid &dense, const SparseVoxelGrid &sparse)
+    {
+        REQUIRE(sparse.CountSet() == dense.CountSet());
+        for (uint32_t z = 0; z < dense.GetSizeZ(); z++)
+        {
+            for (uint32_t y = 0; y < dense.GetSizeY(); y++)
+            {
+                for (uint32_t x = 0; x < dense.GetSizeX(); x++)
+                    REQUIRE(sparse.Get(x, y, z) == dense.Get(x, y, z));
+            }
+        }
+    }
+}
+
+TEST_CASE("Triangle-box SAT matches a corner projection reference", "[math][voxelizer]")
+{
+    // Touching a face, a large triangle through the box, planes just past and just short of a
+    // corner, and a sliver whose bounds overlap the box while passing beside an edge
+    const BoundingBox box(Vec3(0.0f), Vec3(1.0f));
+    REQUIRE(IntersectTriangleBox(Vec3(1, 0, 0), Vec3(1, 1, 0), Vec3(1, 0, 1), box));
+    REQUIRE(IntersectTriangleBox(Vec3(-5, 0.5f, -5), Vec3(5, 0.5f, -5), Vec3(0, 0.5f, 5), box));
+    REQUIRE_FALSE(IntersectTriangleBox(Vec3(3.1f, 0, 0), Vec3(0, 3.1f, 0), Vec3(0, 0, 3.1f), box));
+    REQUIRE(IntersectTriangleBox(Vec3(2.9f, 0, 0), Vec3(0, 2.9f, 0), Vec3(0, 0, 2.9f), box));
+
+    REQUIRE_FALSE(IntersectTriangleBox(Vec3(-1, 3.05f, 0.5f), Vec3(3.05f, -1, 0.5f), Vec3(3.05f, -1, 0.6f), box));
+
+    std::mt19937 rng(11);
+
+    const std::vector<Vec3> vertices = MakeRandomTriangles(4000, 12, Vec3(-3.0f), Vec3(3.0f), 2.0f);
+    BoundingBoxSoA boxes;
+    std::vector<BoundingBox> box_list;
+    for (int i = 0; i < 64; i++)
+    {
+        box_list.push_back(MakeRandomAABB(rng, 3.0f, 0.1f, 2.0f));
+        boxes.Add(box_list.back());
+    }
+
+    size_t hits = 0;
+    std::vector<uint8_t> results(boxes.Size());
+    for (size_t t = 0; t < vertices.size(); t += 3)
+    {
+        const Triangle triangle{ vertices[t], vertices[t + 1], vertices[t + 2] };
+        size_t expected_hits = 0;
+        const size_t batch_hits = IntersectTriangleBoxes(triangle.a, triangle.b, triangle.c, boxes, results.data());
+        for (size_t i = 0; i < box_list.size(); i++)
+        {
+            // Rounding may only differ from the reference when the shapes barely touch
+            const bool hit = IntersectTriangleBox(triangle.a, triangle.b, triangle.c, box_list[i]);
+            if (hit != ReferenceOverlap(triangle, box_list[i]))
+            {
+                REQUIRE(ReferenceOverlap(triangle, Inflate(box_list[i], 1e-4f)));
+                REQUIRE_FALSE(ReferenceOverlap(triangle, Inflate(box_list[i], -1e-4f)));
+            }
+            REQUIRE((results[i] != 0) == hit);
+            expected_hits += hit ? 1 : 0;
+        }
+        REQUIRE(batch_hits == expected_hits);
+        hits += expected_hits;
+    }
+
+    // Both outcomes are well represented
+    REQUIRE(hits > 10000);
+    REQUIRE(hits < 200000);
+}
+
+TEST_CASE("Surface voxelization matches per-voxel triangle tests", "[math][voxelizer]")
+{
+    const uint32_t threads = GENERATE(1u, 3u);
+    VoxelizeSettings settings;
+    settings.thread_count = threads;
+    settings.parallel_threshold = 0;
+
+    // Triangles partly outside the grid on every side
+    const Vec3 origin(-2.0f, -1.5f, -1.0f);
+    const float voxel_size = 0.25f;
+    const std::vector<Vec3> vertices = MakeRandomTriangles(40, 21, origin - Vec3(0.5f), origin + Vec3(7.0f, 5.5f, 5.0f), 1.2f);
+    std::vector<Triangle> triangles;
+    for (size_t t = 0; t < vertices.size(); t += 3)
+        triangles.push_back({ vertices[t], vertices[t + 1], vertices[t + 2] });
+
+    VoxelGrid dense(origin, voxel_size, 26, 21, 19);
+    dense.Voxelize(vertices.data(), nullptr, triangles.size(), settings);
+    REQUIRE(dense.CountSet() > 500);
+
+    size_t mismatches = 0;
+    CheckAgainstReference(dense, triangles, mismatches);
+    REQUIRE(mismatches * 1000 < dense.CountSet());
+
+    SparseVoxelGrid sparse(origin, voxel_size, 26, 21, 19);
+    sparse.Voxelize(vertices.data(), nullptr, triangles.size(), settings);
+    RequireSameVoxels(dense, sparse);
+
+    // Bricks are sorted, non-empty and decode to the right voxels
+    for (size_t i = 0; i < sparse.GetBrickCount(); i++)
+    {
+        const SparseVoxelGrid::Brick brick = sparse.GetBrick(i);
+        REQUIRE(brick.mask != 0);
+        for (uint32_t bit = 0; bit < 64; bit++)
+        {
+            if ((brick.mask >> bit) & 1ull)
+                REQUIRE(dense.Get(brick.x * 4 + bit % 4, brick.y * 4 + bit / 4 % 4, brick.z * 4 + bit / 16));
+        }
+    }
+}
+
+TEST_CASE("Voxelization of axis-aligned faces and repeated calls", "[math][voxelizer]")
+{
+    std::vector<Vec3> vertices;
+    std::vector<uint32_t> indices;
+    AppendBox(Vec3(1.0f), Vec3(3.0f, 5.0f, 2.0f), vertices, indices);
+
+    // Faces lie exactly on voxel boundaries, so both neighbouring layers are touched
+    VoxelGrid grid(Vec3(0.0f), 1.0f, 6, 7, 5);
+    grid.Voxelize(vertices.data(), indices.data(), indices.size() / 3);
+    for (uint32_t z = 0; z < 5; z++)
+    {
+        for (uint32_t y = 0; y < 7; y++)
+        {
+            for (uint32_t x = 0; x < 6; x++)
+                REQUIRE(grid.Get(x, y, z) == (x <= 3 && y <= 5 && z <= 2));
+        }
+    }
+
+    // A second mesh is added to the existing voxels
+    std::vector<Vec3> more;
+    std::vector<uint32_t> more_indices;
+    AppendBox(Vec3(5.2f, 0.2f, 4.2f), Vec3(5.8f, 0.8f, 4.8f), more, more_indices);
+    const size_t before = grid.CountSet();
+    grid.Voxelize(more.data(), more_indices.data(), more_indices.size() / 3);
+    REQUIRE(grid.CountSet() == before + 1);
+    REQUIRE(grid.Get(5, 0, 4));
+
+    grid.Set(5, 0, 4, false);
+    REQUIRE_FALSE(grid.Get(5, 0, 4));
+    grid.Clear();
+    REQUIRE(grid.CountSet() == 0);
+
+    SparseVoxelGrid sparse(Vec3(0.0f), 1.0f, 6, 7, 5);
+    sparse.Voxelize(more.data(), more_indices.data(), more_indices.size() / 3);
+    sparse.Voxelize(vertices.data(), indices.data(), indices.size() / 3);
+    REQUIRE(sparse.CountSet() == before + 1);
+    REQUIRE(sparse.Get(5, 0, 4));
+    sparse.Clear();
+    REQUIRE(sparse.GetBrickCount() == 0);
+}
+
+TEST_CASE("Solid voxelization fills closed meshes", "[math][voxelizer]")
+{
+    const uint32_t threads = GENERATE(1u, 4u);
+    VoxelizeSettings surface_settings;
+    surface_settings.thread_count = threads;
+    surface_settings.parallel_threshold = 0;
+    VoxelizeSettings solid_settings = surface_settings;
+    solid_settings.fill = VoxelFill::Solid;
+
+    // Two disjoint convex meshes; the sphere sticks out of the grid on the -x side
+    std::vector<Vec3> vertices;
+    std::vector<uint32_t> indices;
+    AppendSphere(Vec3(0.3f, 2.1f, 2.4f), 1.9f, 14, 23, vertices, indices);
+    const size_t sphere_indices = indices.size();
+    AppendBox(Vec3(3.13f, 0.71f, 0.52f), Vec3(5.37f, 2.93f, 4.61f), vertices, indices);
+
+    const Vec3 origin(0.0f);
+    const float voxel_size = 0.17f;
+    VoxelGrid surface(origin, voxel_size, 36, 30, 31);
+    surface.Voxelize(vertices.data(), indices.data(), indices.size() / 3, surface_settings);
+    VoxelGrid solid(origin, voxel_size, 36, 30, 31);
+    solid.Voxelize(vertices.data(), indices.data(), indices.size() / 3, solid_settings);
+
+    size_t interior = 0;
+    for (uint32_t z = 0; z < solid.GetSizeZ(); z++)
+    {
+        for (uint32_t y = 0; y < solid.GetSizeY(); y++)
+        {
+            for (uint32_t x = 0; x < solid.GetSizeX(); x++)
+            {
+                const Vec3 center = solid.GetVoxelBounds(x, y, z).GetCenter();
+                const bool inside = InsideConvex(center, vertices, indices, 0, sphere_indices) ||
+                                    InsideConvex(center, vertices, indices, sphere_indices, indices.size() - sphere_indices);
+                REQUIRE(solid.Get(x, y, z) == (surface.Get(x, y, z) || inside));
+                interior += inside && !surface.Get(x, y, z) ? 1 : 0;
+            }
+        }
+    }
+    REQUIRE(interior > 1000);
+
+    SparseVoxelGrid sparse(origin, voxel_size, 36, 30, 31);
+    sparse.Voxelize(vertices.data(), indices.data(), indices.size() / 3, solid_settings);
+    RequireSameVoxels(solid, sparse);
+}
+
+TEST_CASE("Voxelizer benchmark", "[.][benchmark][voxelizer]")
+{
+    std::vector<Vec3> vertices;
+    std::vector<uint32_t> indices;
+    AppendSphere(Vec3(0.0f), 10.0f, 256, 200, vertices, indices);
+    const BoundingBox bounds(Vec3(-10.5f), Vec3(10.5f));
+
+    for (const VoxelFill fill : { VoxelFill::Surface, VoxelFill::Solid })
+    {
+        VoxelizeSettings settings;
+        settings.fill = fill;
+
+        VoxelGrid dense(bounds, 21.0f / 256.0f);
+        auto start = std::chrono::steady_clock::now();
+        dense.Voxelize(vertices.data(), indices.data(), indices.size() / 3, settings);
+        const double dense_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        SparseVoxelGrid sparse(bounds, 21.0f / 256.0f);
+        start = std::chrono::steady_clock::now();
+        sparse.Voxelize(vertices.data(), indices.data(), indices.size() / 3, settings);
+        const double sparse_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::printf("%zu triangles at 256^3, %s: dense %.1f ms, sparse %.1f ms (%zu bricks), %zu voxels\n", indices.size() / 3,
+                    fill == VoxelFill::Solid ? "solid" : "surface", dense_ms, sparse_ms, sparse.GetBrickCount(), dense.CountSet());
+        REQUIRE(sparse.CountSet() == dense.CountSet());
+    }
+}
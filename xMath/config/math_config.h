@@ -50,3 +50,32 @@
 #endif
 
 // -----------------------------------------------------------------------------
+// Matrix storage order
+// -----------------------------------------------------------------------------
+// Defined here rather than in xmath.hpp because every matrix header includes
+// this file, so the library and its consumers always agree on Mat2/Mat3/Mat4
+// member layout regardless of which headers a translation unit pulls in.
+// -----------------------------------------------------------------------------
+
+// Provide numeric constants for conditional compilation. Users may set
+// XMATH_MATRIX_ORDER to either MATRIX_ROW_MAJOR or MATRIX_COLUMN_MAJOR before
+// including any xMath header. Default is row-major.
+#ifndef MATRIX_ROW_MAJOR
+#define MATRIX_ROW_MAJOR 0
+#endif
+
+#ifndef MATRIX_COLUMN_MAJOR
+#define MATRIX_COLUMN_MAJOR 1
+#endif
+
+#ifndef XMATH_MATRIX_ORDER
+#define XMATH_MATRIX_ORDER MATRIX_ROW_MAJOR
+#endif
+
+#if XMATH_MATRIX_ORDER == MATRIX_ROW_MAJOR
+#define XMATH_MATRIX_IS_ROW_MAJOR 1
+#define XMATH_MATRIX_IS_COLUMN_MAJOR 0
+#else
+#define XMATH_MATRIX_IS_ROW_MAJOR 0
+#define XMATH_MATRIX_IS_COLUMN_MAJOR 1
+#endif
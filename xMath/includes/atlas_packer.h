@@ -0,0 +1,136 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* atlas_packer.h
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <xMath/config/math_config.h>
+#include <xMath/includes/rectangle.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	/**
+	 * @enum AtlasHeuristic
+	 * @brief Placement strategy of an AtlasPacker.
+	 */
+	enum class AtlasHeuristic : uint8_t
+	{
+		Skyline,   ///< Bottom-left on a skyline: fast, compact for items of similar height (glyphs)
+		MaxRects   ///< Best short side fit over maximal free rectangles: denser for mixed sizes, slower
+	};
+
+	/**
+	 * @class AtlasPacker
+	 * @brief Packs rectangles into a fixed-size texture atlas.
+	 *
+	 * Positions are whole pixels with a top-left origin. Items can be inserted one at a time as
+	 * they are needed (glyphs rendered on demand), or in bulk: InsertBatch sorts the items once
+	 * (tallest or largest first) before placing them, which packs noticeably tighter.
+	 *
+	 * @code
+	 * AtlasPacker packer(1024, 1024, AtlasHeuristic::Skyline, 1);
+	 * Rectangle placement;
+	 * if (packer.Insert(glyph_width, glyph_height, placement))
+	 *     Upload(glyph, placement);
+	 * @endcode
+	 */
+	class XMATH_API AtlasPacker
+	{
+	public:
+		/**
+		 * @brief Constructs an empty atlas.
+		 * @param width The atlas width in pixels.
+		 * @param height The atlas height in pixels.
+		 * @param heuristic The placement strategy.
+		 * @param padding Empty pixels kept to the right of and below every item.
+		 */
+		AtlasPacker(uint32_t width, uint32_t height, AtlasHeuristic heuristic = AtlasHeuristic::Skyline, uint32_t padding = 0);
+		~AtlasPacker() = default;
+
+		/**
+		 * @brief Places one item.
+		 * @param width The item width in pixels.
+		 * @param height The item height in pixels.
+		 * @param placement Output rectangle of the item in the atlas (without padding).
+		 * @return false if the item does not fit anymore.
+		 */
+		bool Insert(uint32_t width, uint32_t height, Rectangle &placement);
+
+		/**
+		 * @brief Places many items, largest first.
+		 * @param rects In: the item sizes (width, height). Out: x and y of placed items; -1 for items that did not fit.
+		 * @param count The number of items.
+		 * @return The number of items placed.
+		 */
+		size_t InsertBatch(Rectangle *rects, size_t count);
+
+		/**
+		 * @brief Removes all items.
+		 */
+		void Clear();
+
+		[[nodiscard]] uint32_t GetWidth() const { return m_Width; }
+		[[nodiscard]] uint32_t GetHeight() const { return m_Height; }
+		[[nodiscard]] AtlasHeuristic GetHeuristic() const { return m_Heuristic; }
+
+		/**
+		 * @brief Gets the fraction of the atlas covered by placed items, padding included.
+		 * @return The occupancy in [0, 1].
+		 */
+		[[nodiscard]] float GetOccupancy() const;
+
+	private:
+		struct Span
+		{
+			int32_t x, y, width;   // A horizontal run of the skyline at height y
+		};
+
+		struct Area
+		{
+			int32_t x, y, width, height;
+		};
+
+		bool InsertSkyline(int32_t width, int32_t height, int32_t &x, int32_t &y);
+		bool InsertMaxRects(int32_t width, int32_t height, int32_t &x, int32_t &y);
+		void SplitFreeAreas(const Area &used);
+		void PruneFreeAreas();
+
+		uint32_t m_Width;
+		uint32_t m_Height;
+		AtlasHeuristic m_Heuristic;
+		uint32_t m_Padding;
+		uint64_t m_UsedArea = 0;
+		std::vector<Span> m_Skyline;       // Skyline runs from left to right
+		std::vector<Area> m_FreeAreas;     // Maximal free rectangles
+		std::vector<Area> m_NewFreeAreas;  // Free rectangles created by the last split
+	};
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,273 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* bvh.h
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <xMath/config/math_config.h>
+#include <xMath/includes/bounding_box.h>
+#include <xMath/includes/frustum.h>
+#include <xMath/includes/ray.h>
+#include <xMath/includes/soa.h>
+#include <xMath/includes/vector.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	/**
+	 * @enum BVHBuildMethod
+	 * @brief How BVH::Build chooses its splits.
+	 */
+	enum class BVHBuildMethod : uint8_t
+	{
+		BinnedSAH, // Top-down binned surface area heuristic: best trees, for static or rarely rebuilt scenes
+		Linear     // Morton-code sorted LBVH (Karras): fastest build, for scenes rebuilt every frame
+	};
+
+	/**
+	 * @struct BVHBuildSettings
+	 * @brief Parameters of the BVH builders.
+	 */
+	struct BVHBuildSettings
+	{
+		BVHBuildMethod method = BVHBuildMethod::BinnedSAH;
+		uint32_t max_leaf_size = 4;         // Ranges of this size or smaller become leaves
+		uint32_t bin_count = 16;            // SAH bins per axis (2 - 32); unused by the linear builder
+		uint32_t thread_count = 0;          // Worker threads; 0 uses std::thread::hardware_concurrency
+		uint32_t parallel_threshold = 4096; // Smallest range whose subtrees are built on separate threads (linear: smallest threaded build)
+	};
+
+	/**
+	 * @struct BVHNode
+	 * @brief Inner node of a flattened BVH, one cache line holding the bounds of both children.
+	 *
+	 * The child bounds are stored as structure-of-arrays so the two children are tested together.
+	 * A child with count > 0 is a leaf covering primitives [child, child + count) of the BVH's
+	 * leaf order; otherwise child is the index of another node, or INVALID_INDEX when the slot is
+	 * empty (only possible for the root of a single-leaf tree).
+	 */
+	struct alignas(64) BVHNode
+	{
+		static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+		float min_x[2]; // Child bounds, minimum x
+		float min_y[2]; // Child bounds, minimum y
+		float min_z[2]; // Child bounds, minimum z
+		float max_x[2]; // Child bounds, maximum x
+		float max_y[2]; // Child bounds, maximum y
+		float max_z[2]; // Child bounds, maximum z
+		uint32_t child[2]; // Node index, or first leaf primitive when count > 0
+		uint32_t count[2]; // Leaf primitive count, 0 for inner children
+
+		[[nodiscard]] bool IsLeaf(uint32_t i) const { return count[i] > 0; }
+		[[nodiscard]] bool IsEmpty(uint32_t i) const { return count[i] == 0 && child[i] == INVALID_INDEX; }
+	};
+
+	static_assert(sizeof(BVHNode) == 64, "BVHNode must fill exactly one cache line");
+
+	/**
+	 * @class BVH
+	 * @brief Bounding volume hierarchy over an array of BoundingBox primitives.
+	 *
+	 * Built top-down with a binned surface area heuristic, with large subtrees built on worker
+	 * threads, or as a linear BVH: primitives sorted along a Morton curve with a parallel radix
+	 * sort, and all inner nodes emitted independently from the sorted codes. Nodes are stored depth first, so the first child of a node is usually the next
+	 * node in memory (rotations applied by Optimize relax this until the next Build). Moving
+	 * primitives are handled with UpdatePrimitive and Refit. Queries return the indices of the
+	 * input boxes.
+	 *
+	 * @code
+	 * BVH bvh;
+	 * bvh.Build(boxes.data(), boxes.size());
+	 *
+	 * std::vector<uint32_t> visible;
+	 * bvh.QueryFrustum(frustum, visible);
+	 * @endcode
+	 */
+	class XMATH_API BVH
+	{
+	public:
+		BVH() = default;
+		~BVH() = default;
+
+		/**
+		 * @brief Builds the hierarchy, replacing any previous one.
+		 * @param boxes The primitive bounds.
+		 * @param count The number of primitives.
+		 * @param settings The builder parameters.
+		 */
+		void Build(const BoundingBox *boxes, size_t count, const BVHBuildSettings &settings = {});
+
+		/**
+		 * @brief Removes all nodes and primitives.
+		 */
+		void Clear();
+
+		/**
+		 * @brief Changes the bounds of a primitive and marks its leaf for the next Refit.
+		 * @param primitive The primitive index given to Build.
+		 * @param box The new bounds.
+		 */
+		void UpdatePrimitive(uint32_t primitive, const BoundingBox &box);
+
+		/**
+		 * @brief Updates the bounds of every node above a changed primitive, bottom up.
+		 *
+		 * Only nodes marked by UpdatePrimitive and their ancestors are visited; a node whose
+		 * bounds did not change stops the walk towards the root. Child bounds are recomputed as
+		 * the union of their contents (BoundingBox::Merge semantics), so they can shrink as well
+		 * as grow.
+		 *
+		 * @return The number of nodes visited.
+		 */
+		size_t Refit();
+
+		/**
+		 * @brief Applies tree rotations to the nodes visited by the last Refit.
+		 *
+		 * Refitting keeps the topology, so the tree gets worse as objects move apart. At each
+		 * node, a child is swapped with a grandchild on the other side when that lowers the
+		 * surface area of the affected child (Kopta et al., "Fast, Effective BVH Updates for
+		 * Animated Scenes"). Rotations that would push the tree past MAX_DEPTH are skipped, so
+		 * the traversal stacks stay bounded. Run it after Refit; rebuild occasionally when objects move far.
+		 *
+		 * @return The number of rotations applied.
+		 */
+		size_t Optimize();
+
+		/**
+		 * @brief Collects the primitives whose bounds intersect a frustum.
+		 *
+		 * Subtrees fully inside the frustum are collected without further plane tests.
+		 *
+		 * @param frustum The frustum.
+		 * @param results Output primitive indices (appended).
+		 */
+		void QueryFrustum(const Frustum &frustum, std::vector<uint32_t> &results) const;
+
+		/**
+		 * @brief Collects the primitives whose bounds overlap a box.
+		 * @param box The query box.
+		 * @param results Output primitive indices (appended).
+		 */
+		void QueryOverlap(const BoundingBox &box, std::vector<uint32_t> &results) const;
+
+		/**
+		 * @brief Collects the primitives whose bounds are hit by a ray segment, nearer subtrees first.
+		 * @param origin The ray origin.
+		 * @param direction The ray direction (not necessarily normalized; distances are in units of its length).
+		 * @param max_distance The length of the segment.
+		 * @param results Output primitive indices (appended).
+		 */
+		void QueryRay(const Vec3 &origin, const Vec3 &direction, float max_distance, std::vector<uint32_t> &results) const;
+
+		/**
+		 * @brief Finds the nearest primitive bounds hit by a ray segment.
+		 * @param origin The ray origin.
+		 * @param direction The ray direction.
+		 * @param max_distance The length of the segment.
+		 * @param primitive Output index of the hit primitive.
+		 * @param distance Output entry distance along the ray (0 when the origin is inside the box).
+		 * @return True if a primitive was hit.
+		 */
+		bool RaycastBounds(const Vec3 &origin, const Vec3 &direction, float max_distance, uint32_t &primitive, float &distance) const;
+
+		/**
+		 * @brief Finds the nearest primitive bounds hit by each ray of a packet.
+		 *
+		 * The packet descends the tree together: a node is visited once for all rays that hit
+		 * it, which shares memory traffic between coherent rays (picking, line-of-sight fans).
+		 *
+		 * @param packet The rays; only active lanes are traced.
+		 * @param primitives Output nearest primitive per lane (written for hit lanes only).
+		 * @param distances Output entry distance per lane (written for hit lanes only).
+		 * @return The mask of lanes that hit a primitive.
+		 */
+		uint8_t RaycastBounds(const RayPacket8 &packet, uint32_t *primitives, float *distances) const;
+
+		/**
+		 * @brief Tests which rays of a packet hit any primitive bounds.
+		 *
+		 * Any-hit query for visibility and occlusion rays: a lane stops as soon as it hits
+		 * something, and traversal ends when every lane has.
+		 *
+		 * @param packet The rays; only active lanes are traced.
+		 * @return The mask of lanes that hit a primitive.
+		 */
+		uint8_t TestOcclusion(const RayPacket8 &packet) const;
+
+		/**
+		 * @brief Finds the primitive whose bounds are closest to a point.
+		 * @param point The query point.
+		 * @param primitive Output index of the closest primitive.
+		 * @param distance Output distance from the point to its bounds (0 inside).
+		 * @return True unless the hierarchy is empty.
+		 */
+		bool QueryClosest(const Vec3 &point, uint32_t &primitive, float &distance) const;
+
+		[[nodiscard]] bool IsEmpty() const { return m_Nodes.empty(); }
+		[[nodiscard]] size_t GetNodeCount() const { return m_Nodes.size(); }
+		[[nodiscard]] size_t GetPrimitiveCount() const { return m_Indices.size(); }
+		[[nodiscard]] const std::vector<BVHNode> &GetNodes() const { return m_Nodes; }
+
+		/**
+		 * @brief Gets the primitive indices in leaf order; leaf children of nodes index into this array.
+		 * @return The leaf-ordered primitive indices.
+		 */
+		[[nodiscard]] const std::vector<uint32_t> &GetLeafIndices() const { return m_Indices; }
+
+		/**
+		 * @brief Gets the bounds of the whole hierarchy.
+		 * @return The root bounds, or an empty box when nothing is built.
+		 */
+		[[nodiscard]] BoundingBox GetBounds() const;
+
+	private:
+		static constexpr uint32_t MAX_DEPTH = 60;
+
+		void MarkDirty(uint32_t node);
+		void LinkChildren(uint32_t node);
+		[[nodiscard]] uint32_t GetChildHeight(uint32_t node, uint32_t c) const;
+		[[nodiscard]] uint32_t GetDepth(uint32_t node) const;
+		void UpdateHeights(uint32_t node);
+
+		std::vector<BVHNode> m_Nodes;        // Depth-first inner nodes, root at 0
+		std::vector<uint32_t> m_Indices;     // Primitive indices in leaf order
+		BoundingBoxSoA m_PrimitiveBounds;    // Primitive bounds in leaf order
+		std::vector<uint32_t> m_Parents;     // Parent node of each node (INVALID_INDEX for the root)
+		std::vector<uint32_t> m_LeafNode;    // Node holding each primitive, by primitive index
+		std::vector<uint32_t> m_LeafSlot;    // Position of each primitive in leaf order, by primitive index
+		std::vector<uint8_t> m_Heights;      // Per node: inner levels in its subtree, itself included
+		std::vector<uint8_t> m_Dirty;        // Per node: queued for the next Refit
+		std::vector<uint32_t> m_DirtyNodes;  // Nodes queued for the next Refit
+		std::vector<uint32_t> m_RefitNodes;  // Nodes visited by the last Refit, for Optimize
+	};
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,127 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* clipping.h
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <xMath/config/math_config.h>
+#include <xMath/includes/plane.h>
+#include <xMath/includes/vector.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	/**
+	 * @brief Largest plane set the clipping functions accept; plane i is bit i of the outcodes.
+	 */
+	inline constexpr uint32_t MAX_CLIP_PLANES = 32;
+
+	/**
+	 * @struct ClipCodes
+	 * @brief Combined outcodes of a batch of points.
+	 */
+	struct ClipCodes
+	{
+		uint32_t any_outside = 0; // Planes at least one point is behind
+		uint32_t all_outside = 0; // Planes every point is behind; non-zero means the batch is culled
+	};
+
+	/**
+	 * @brief Classifies points against a plane set.
+	 *
+	 * The planes keep the side where Plane::Dot is not negative, the Frustum convention. A
+	 * point is outside a plane when its Dot is below -epsilon. The planes are swept one at a
+	 * time over the whole batch.
+	 *
+	 * @param planes The planes.
+	 * @param plane_count The number of planes (at most MAX_CLIP_PLANES).
+	 * @param points The points.
+	 * @param count The number of points.
+	 * @param codes Optional output: per point, bit i set when the point is behind plane i.
+	 * @param epsilon Distance behind a plane still counted as on it.
+	 * @return The union and intersection of the outcodes.
+	 */
+	XMATH_API ClipCodes ClassifyPoints(const Plane *planes, uint32_t plane_count, const Vec3 *points, size_t count, uint32_t *codes = nullptr, float epsilon = 0.0f);
+
+	/**
+	 * @brief Clips a convex polygon against one plane (Sutherland-Hodgman).
+	 *
+	 * Keeps the part in front of the plane. Vertices within epsilon of the plane are kept as
+	 * they are rather than split, so no sliver edges appear. New vertices are interpolated from
+	 * the vertex in front, so polygons that share an edge get identical points on it.
+	 *
+	 * @param polygon The polygon vertices, in order.
+	 * @param count The number of vertices.
+	 * @param plane The plane.
+	 * @param output Output vertices; must hold count + 1 and must not alias polygon.
+	 * @param epsilon Distance behind the plane still counted as on it.
+	 * @return The number of output vertices; below 3 when nothing is left.
+	 */
+	XMATH_API uint32_t ClipPolygon(const Vec3 *polygon, uint32_t count, const Plane &plane, Vec3 *output, float epsilon = 0.0f);
+
+	/**
+	 * @brief Clips a convex polygon against a plane set.
+	 *
+	 * The vertices are classified against every plane first. A polygon behind one plane is
+	 * rejected and one in front of all planes is copied without clipping. Otherwise it is clipped
+	 * only by the planes some vertex is behind: the other planes cannot cut it, since clipping
+	 * only adds points on the polygon's edges.
+	 *
+	 * @param polygon The polygon vertices, in order.
+	 * @param count The number of vertices.
+	 * @param planes The planes.
+	 * @param plane_count The number of planes (at most MAX_CLIP_PLANES).
+	 * @param output Output vertices; must hold count + plane_count.
+	 * @param scratch Working buffer of the same size as output.
+	 * @param epsilon Distance behind a plane still counted as on it.
+	 * @return The number of output vertices; 0 when nothing is left.
+	 */
+	XMATH_API uint32_t ClipPolygon(const Vec3 *polygon, uint32_t count, const Plane *planes, uint32_t plane_count, Vec3 *output, Vec3 *scratch, float epsilon = 0.0f);
+
+	/**
+	 * @brief Clips a triangle list against a plane set.
+	 *
+	 * The corners are classified in blocks before any clipping, so rejected and fully inside
+	 * triangles cost one pass over the planes. Each clipped polygon is written back as a
+	 * triangle fan. No memory is allocated.
+	 *
+	 * @param vertices The vertex positions.
+	 * @param indices Three indices per triangle, or nullptr when the vertices are already a triangle list.
+	 * @param triangle_count The number of triangles.
+	 * @param planes The planes.
+	 * @param plane_count The number of planes (at most MAX_CLIP_PLANES).
+	 * @param output Output triangle list, three vertices per triangle.
+	 * @param capacity The number of triangles output can hold; triangle_count * (plane_count + 1) always suffices.
+	 * @param source_triangles Optional output: the input triangle of each output triangle (for UVs or material lookups).
+	 * @param epsilon Distance behind a plane still counted as on it.
+	 * @return The number of output triangles; stops early when the output is full.
+	 */
+	XMATH_API size_t ClipTriangles(const Vec3 *vertices, const uint32_t *indices, size_t triangle_count, const Plane *planes, uint32_t plane_count,
+	                               Vec3 *output, size_t capacity, uint32_t *source_triangles = nullptr, float epsilon = 0.0f);
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,151 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* closest_point.h
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <xMath/config/math_config.h>
+#include <xMath/includes/oriented_bounding_box.h>
+#include <xMath/includes/soa.h>
+#include <xMath/includes/vector.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	/**
+	 * @brief Finds the point of a segment closest to a point.
+	 * @param point The query point.
+	 * @param a The segment start.
+	 * @param b The segment end.
+	 * @return The closest point on the segment.
+	 */
+	XMATH_API Vec3 ClosestPointOnSegment(const Vec3 &point, const Vec3 &a, const Vec3 &b);
+
+	/**
+	 * @brief Finds the point of a triangle closest to a point.
+	 *
+	 * Classifies the point into the Voronoi regions of the triangle's vertices, edges and face
+	 * (Ericson 5.1.5), so only the needed feature is computed.
+	 *
+	 * @param point The query point.
+	 * @param a The first triangle vertex.
+	 * @param b The second triangle vertex.
+	 * @param c The third triangle vertex.
+	 * @return The closest point on the triangle.
+	 */
+	XMATH_API Vec3 ClosestPointOnTriangle(const Vec3 &point, const Vec3 &a, const Vec3 &b, const Vec3 &c);
+
+	/**
+	 * @brief Finds the closest points of two segments (Ericson 5.1.9).
+	 *
+	 * Degenerate segments are treated as points. For parallel segments one of the closest
+	 * pairs is returned.
+	 *
+	 * @param a0 The start of segment a.
+	 * @param a1 The end of segment a.
+	 * @param b0 The start of segment b.
+	 * @param b1 The end of segment b.
+	 * @param point_a Output closest point on segment a.
+	 * @param point_b Output closest point on segment b.
+	 * @return The squared distance between the segments.
+	 */
+	XMATH_API float ClosestPointsSegmentSegment(const Vec3 &a0, const Vec3 &a1, const Vec3 &b0, const Vec3 &b1, Vec3 &point_a, Vec3 &point_b);
+
+	/**
+	 * @brief Finds the closest points of two triangles.
+	 *
+	 * Intersecting triangles are found by testing each edge against the other triangle and
+	 * return zero with both points on the intersection. Otherwise the closest pair is one of
+	 * the nine edge pairs or one of the six vertex-triangle pairs.
+	 *
+	 * @param a0 The first vertex of triangle a.
+	 * @param a1 The second vertex of triangle a.
+	 * @param a2 The third vertex of triangle a.
+	 * @param b0 The first vertex of triangle b.
+	 * @param b1 The second vertex of triangle b.
+	 * @param b2 The third vertex of triangle b.
+	 * @param point_a Output closest point on triangle a.
+	 * @param point_b Output closest point on triangle b.
+	 * @return The squared distance between the triangles.
+	 */
+	XMATH_API float ClosestPointsTriangleTriangle(const Vec3 &a0, const Vec3 &a1, const Vec3 &a2, const Vec3 &b0, const Vec3 &b1, const Vec3 &b2,
+	                                              Vec3 &point_a, Vec3 &point_b);
+
+	/**
+	 * @brief Closest points on segments for a batch of points; query i uses element i of every array.
+	 *
+	 * The batch kernels clamp and select instead of branching, so their loops vectorize.
+	 *
+	 * @param points The query points.
+	 * @param a The segment starts.
+	 * @param b The segment ends.
+	 * @param distances_squared Output squared distances; must hold points.Size() values.
+	 * @param closest Optional output closest points, resized to points.Size().
+	 */
+	XMATH_API void ClosestPointsOnSegments(const Vec3SoA &points, const Vec3SoA &a, const Vec3SoA &b, float *distances_squared, Vec3SoA *closest = nullptr);
+
+	/**
+	 * @brief Closest points on triangles for a batch of points; query i uses element i of every array.
+	 *
+	 * Computes the projection onto the plane and the closest points of all three edges, then
+	 * selects the projection when it lies inside the triangle and the nearest edge point otherwise.
+	 *
+	 * @param points The query points.
+	 * @param a The first triangle vertices.
+	 * @param b The second triangle vertices.
+	 * @param c The third triangle vertices.
+	 * @param distances_squared Output squared distances; must hold points.Size() values.
+	 * @param closest Optional output closest points, resized to points.Size().
+	 */
+	XMATH_API void ClosestPointsOnTriangles(const Vec3SoA &points, const Vec3SoA &a, const Vec3SoA &b, const Vec3SoA &c, float *distances_squared,
+	                                        Vec3SoA *closest = nullptr);
+
+	/**
+	 * @brief Closest points between pairs of segments; query i uses element i of every array.
+	 * @param a0 The starts of the first segments.
+	 * @param a1 The ends of the first segments.
+	 * @param b0 The starts of the second segments.
+	 * @param b1 The ends of the second segments.
+	 * @param distances_squared Output squared distances; must hold a0.Size() values.
+	 * @param closest_a Optional output closest points on the first segments, resized to a0.Size().
+	 * @param closest_b Optional output closest points on the second segments, resized to a0.Size().
+	 */
+	XMATH_API void ClosestPointsSegmentsSegments(const Vec3SoA &a0, const Vec3SoA &a1, const Vec3SoA &b0, const Vec3SoA &b1, float *distances_squared,
+	                                             Vec3SoA *closest_a = nullptr, Vec3SoA *closest_b = nullptr);
+
+	/**
+	 * @brief Closest points on one oriented box for a batch of points (zero distance inside).
+	 *
+	 * Batch form of OrientedBoundingBox::GetClosestPoint.
+	 *
+	 * @param box The box.
+	 * @param points The query points.
+	 * @param distances_squared Output squared distances; must hold points.Size() values.
+	 * @param closest Optional output closest points, resized to points.Size().
+	 */
+	XMATH_API void ClosestPointsOnOBB(const OrientedBoundingBox &box, const Vec3SoA &points, float *distances_squared, Vec3SoA *closest = nullptr);
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,223 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* convex_hull.h
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <xMath/config/math_config.h>
+#include <xMath/includes/plane.h>
+#include <xMath/includes/vector.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	/**
+	 * @struct ConvexHullSettings
+	 * @brief Parameters of the convex hull builder.
+	 */
+	struct ConvexHullSettings
+	{
+		float epsilon = 0.0f; // Distance below which a point counts as on a plane; 0 derives it from the extent of the input
+	};
+
+	/**
+	 * @class ConvexHull
+	 * @brief 3D convex hull of a point set, built with quickhull.
+	 *
+	 * The result is a closed polyhedron: vertices, convex polygon faces with outward planes
+	 * (Plane::Dot is positive outside), an edge list with the two faces of each edge, and the
+	 * neighbors of each vertex. Adjacent triangles that are coplanar within epsilon are merged
+	 * into one polygon, and vertices that end up inside a face or on an edge are dropped.
+	 *
+	 * Coplanar input gives a flat hull with two opposite faces. Collinear or coincident input
+	 * has no hull and Build returns false.
+	 *
+	 * The half-edge mesh and point lists of the builder are kept in the object, so rebuilding
+	 * a hull of similar size does not allocate.
+	 *
+	 * @code
+	 * ConvexHull hull;
+	 * if (hull.Build(mesh_positions.data(), mesh_positions.size()))
+	 * {
+	 *     hull.Simplify(24);
+	 *     for (const Plane &plane : hull.GetPlanes())
+	 *         proxy.AddPlane(plane);
+	 * }
+	 * @endcode
+	 */
+	class XMATH_API ConvexHull
+	{
+	public:
+		static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+		/**
+		 * @struct Edge
+		 * @brief An edge of the hull: its two vertices and the faces on either side.
+		 *
+		 * faces[0] walks the edge from vertices[0] to vertices[1], faces[1] the other way.
+		 */
+		struct Edge
+		{
+			uint32_t vertices[2];
+			uint32_t faces[2];
+		};
+
+		ConvexHull() = default;
+		~ConvexHull() = default;
+
+		/**
+		 * @brief Builds the hull of a point set, replacing any previous one.
+		 * @param points The points.
+		 * @param count The number of points.
+		 * @param settings The builder parameters.
+		 * @return True if a hull was built; false (and an empty hull) for fewer than three non-collinear points.
+		 */
+		bool Build(const Vec3 *points, size_t count, const ConvexHullSettings &settings = {});
+
+		/**
+		 * @brief Reduces the hull to at most a number of faces, keeping it around the original one.
+		 *
+		 * Keeps the planes of the largest faces, preferring normals that differ from the ones
+		 * already kept, and rebuilds the hull as the intersection of their half-spaces. Every
+		 * original point stays inside. If the chosen planes do not enclose a bounded region, more
+		 * planes are added until they do, so the result can exceed max_faces in that case only.
+		 *
+		 * @param max_faces The face budget (at least 4).
+		 * @return True if the hull was simplified; false if it already had few enough faces, is flat, or
+		 *         the reduced hull could not be built. The hull is unchanged when this returns false.
+		 */
+		bool Simplify(uint32_t max_faces);
+
+		/**
+		 * @brief Removes the hull, keeping the allocated storage.
+		 */
+		void Clear();
+
+		/**
+		 * @brief Tests a point against every face plane.
+		 * @param point The point.
+		 * @param tolerance Distance outside the planes still accepted.
+		 * @return True if the point is inside or within tolerance of the hull.
+		 */
+		[[nodiscard]] bool Contains(const Vec3 &point, float tolerance = 0.0f) const;
+
+		/**
+		 * @brief Finds the vertex furthest along a direction by hill climbing over the vertex neighbors.
+		 * @param direction The query direction.
+		 * @return The support vertex; the hull must not be empty.
+		 */
+		[[nodiscard]] Vec3 Support(const Vec3 &direction) const;
+
+		[[nodiscard]] bool IsEmpty() const { return m_Planes.empty(); }
+
+		/**
+		 * @brief Gets the hull vertices.
+		 */
+		[[nodiscard]] const std::vector<Vec3> &GetVertices() const { return m_Vertices; }
+
+		/**
+		 * @brief Gets, for each hull vertex, the index of the input point it came from.
+		 *
+		 * INVALID_INDEX after Simplify, whose vertices are plane intersections.
+		 */
+		[[nodiscard]] const std::vector<uint32_t> &GetSourceIndices() const { return m_SourceIndices; }
+
+		/**
+		 * @brief Gets the outward face planes, one per face.
+		 */
+		[[nodiscard]] const std::vector<Plane> &GetPlanes() const { return m_Planes; }
+
+		[[nodiscard]] size_t GetFaceCount() const { return m_Planes.size(); }
+
+		/**
+		 * @brief Gets the vertices of a face, counter-clockwise around its normal.
+		 * @param face The face index.
+		 * @param count Output number of vertices.
+		 * @return The vertex indices.
+		 */
+		[[nodiscard]] const uint32_t *GetFaceVertices(size_t face, uint32_t &count) const;
+
+		/**
+		 * @brief Gets the hull edges.
+		 */
+		[[nodiscard]] const std::vector<Edge> &GetEdges() const { return m_Edges; }
+
+		/**
+		 * @brief Gets the vertices sharing an edge with a vertex.
+		 * @param vertex The vertex index.
+		 * @param count Output number of neighbors.
+		 * @return The neighbor vertex indices.
+		 */
+		[[nodiscard]] const uint32_t *GetVertexNeighbors(uint32_t vertex, uint32_t &count) const;
+
+	private:
+		struct HalfEdge
+		{
+			uint32_t origin; // Input point index
+			uint32_t next;
+			uint32_t twin;
+			uint32_t face;
+		};
+
+		struct BuildFace
+		{
+			uint32_t edge;           // First half-edge of the triangle
+			Plane plane;
+			uint32_t outside;        // First point of the outside list, linked through m_NextOutside
+			uint32_t farthest;       // Outside point furthest from the plane
+			float farthest_distance;
+			uint32_t visit;          // Horizon search stamp
+			bool alive;
+		};
+
+		void BuildFlat(const Vec3 *points, size_t count, const Vec3 &normal, const Vec3 &origin);
+		void ExtractPolygons(const Vec3 *points, size_t count);
+		void BuildTopology();
+
+		// Output
+		std::vector<Vec3> m_Vertices;
+		std::vector<uint32_t> m_SourceIndices;
+		std::vector<Plane> m_Planes;
+		std::vector<uint32_t> m_FaceOffsets;     // Face f uses m_FaceIndices[m_FaceOffsets[f] .. m_FaceOffsets[f + 1])
+		std::vector<uint32_t> m_FaceIndices;
+		std::vector<Edge> m_Edges;
+		std::vector<uint32_t> m_NeighborOffsets; // Vertex v uses m_Neighbors[m_NeighborOffsets[v] .. m_NeighborOffsets[v + 1])
+		std::vector<uint32_t> m_Neighbors;
+		float m_Epsilon = 0.0f;
+
+		// Builder storage, reused between builds
+		std::vector<HalfEdge> m_HalfEdges;
+		std::vector<BuildFace> m_BuildFaces;
+		std::vector<uint32_t> m_FreeHalfEdges;
+		std::vector<uint32_t> m_FreeFaces;
+		std::vector<uint32_t> m_NextOutside;
+		std::vector<uint32_t> m_Scratch;
+	};
+}
+
+/// -------------------------------------------------------
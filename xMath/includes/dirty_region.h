@@ -0,0 +1,124 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* dirty_region.h
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <xMath/config/math_config.h>
+#include <xMath/includes/rectangle.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	/**
+	 * @class DirtyRegion
+	 * @brief Accumulates dirty rectangles for partial redraw and keeps them merged into a small set.
+	 *
+	 * Each added rectangle is clipped to the screen and merged with an existing one when the
+	 * merge adds little overdraw. The wasted area of a merge is the area of the combined
+	 * bounds that neither rectangle covered. Merges whose waste is at most merge_threshold of
+	 * the combined area happen at once. When the set grows past max_rects, the cheapest pair is
+	 * merged regardless. Finding that pair compares all pairs, so each Add costs O(max_rects^2)
+	 * and a frame with n dirty rectangles O(n * max_rects^2); keep max_rects small.
+	 *
+	 * @code
+	 * DirtyRegion dirty(Rectangle(0.0f, 0.0f, 1920.0f, 1080.0f));
+	 * for (const Widget &widget : changed)
+	 *     dirty.Add(widget.bounds);
+	 *
+	 * if (dirty.GetCoverage() > 0.6f)
+	 *     RedrawAll();
+	 * else
+	 *     for (const Rectangle &rect : dirty.GetRects())
+	 *         Redraw(rect);
+	 * dirty.Clear();
+	 * @endcode
+	 */
+	class XMATH_API DirtyRegion
+	{
+	public:
+		/**
+		 * @brief Constructs an empty region.
+		 * @param bounds The screen or surface; added rectangles are clipped to it.
+		 * @param max_rects The largest number of rectangles kept (at least 1).
+		 * @param merge_threshold Merges wasting at most this fraction of the combined area happen immediately.
+		 */
+		explicit DirtyRegion(const Rectangle &bounds, uint32_t max_rects = 8, float merge_threshold = 0.25f);
+		~DirtyRegion() = default;
+
+		/**
+		 * @brief Marks a rectangle dirty.
+		 * @param rect The rectangle; empty or off-screen rectangles are ignored.
+		 */
+		void Add(const Rectangle &rect);
+
+		/**
+		 * @brief Marks the whole surface dirty.
+		 */
+		void AddAll();
+
+		/**
+		 * @brief Removes all rectangles, keeping the storage.
+		 */
+		void Clear();
+
+		[[nodiscard]] bool IsEmpty() const { return m_Rects.empty(); }
+		[[nodiscard]] const std::vector<Rectangle> &GetRects() const { return m_Rects; }
+		[[nodiscard]] const Rectangle &GetSurfaceBounds() const { return m_Bounds; }
+
+		/**
+		 * @brief Gets the total area to redraw (overlaps between rectangles counted twice).
+		 * @return The area.
+		 */
+		[[nodiscard]] float GetArea() const;
+
+		/**
+		 * @brief Gets the redraw area as a fraction of the surface, to decide on a full redraw.
+		 * @return The fraction; can exceed 1 if the rectangles overlap.
+		 */
+		[[nodiscard]] float GetCoverage() const;
+
+		/**
+		 * @brief Gets the bounds of all dirty rectangles.
+		 * @return The bounds, or an empty rectangle if nothing is dirty.
+		 */
+		[[nodiscard]] Rectangle GetBounds() const;
+
+	private:
+		void Insert(Rectangle rect);
+		void EnforceLimit();
+
+		Rectangle m_Bounds;
+		uint32_t m_MaxRects;
+		float m_MergeThreshold;
+		std::vector<Rectangle> m_Rects;
+	};
+
+}
+
+/// -------------------------------------------------------
@@ -26,9 +26,11 @@
 */
 #pragma once
 #include <xMath/config/math_config.h>
+#include <xMath/includes/mat4.h>
 #include <xMath/includes/math_utils.h>
 #include <xMath/includes/matrix.h>
 #include <xMath/includes/plane.h>
+#include <xMath/includes/soa.h>
 #include <xMath/includes/vector.h>
 
 // -------------------------------------------------------------
@@ -52,6 +54,32 @@ namespace xMath
 		 */
 		Frustum(const Matrix &view, const Matrix &projection);
 
+		/**
+		 * @brief Depth conventions of a clip space, combined as bit flags.
+		 */
+		enum DepthFlags : uint8_t
+		{
+			DEPTH_ZERO_TO_ONE         = 0,      // Clip z in [0, w] (D3D, Vulkan, Mat4::PerspectiveProjection)
+			DEPTH_NEGATIVE_ONE_TO_ONE = 1 << 0, // Clip z in [-w, w] (OpenGL, projection.h Perspective/Ortho)
+			DEPTH_REVERSED            = 1 << 1, // Near maps to the far end of the depth range (reverse-Z)
+			DEPTH_INFINITE_FAR        = 1 << 2  // The projection has no far plane
+		};
+
+		/**
+		 * @brief Constructs a frustum from a combined view-projection matrix.
+		 *
+		 * Uses the Mat4 convention of this library (clip = view_projection * point), so the planes are
+		 * sums and differences of the matrix rows. Pass the product the renderer already has instead of
+		 * the separate view and projection matrices.
+		 *
+		 * With DEPTH_INFINITE_FAR the far plane is replaced by a plane that accepts every point, so the
+		 * plane indices and masks keep their meaning.
+		 *
+		 * @param view_projection The combined view-projection matrix (projection * view).
+		 * @param depth_flags The depth convention of the projection, a combination of DepthFlags.
+		 */
+		explicit Frustum(const Mat4 &view_projection, uint8_t depth_flags = DEPTH_ZERO_TO_ONE);
+
 		/**
 		 * @brief Checks if a cube defined by its center and extent intersects with the frustum.
 		 * @param center The center of the cube.
@@ -61,6 +89,81 @@ namespace xMath
 		 */
 		bool IsVisible(const Vec3 &center, const Vec3 &extent, bool ignore_depth) const;
 
+		/**
+		 * @brief Plane mask with all six frustum planes active.
+		 */
+		static constexpr uint8_t PLANE_MASK_ALL = 0x3F;
+
+		/**
+		 * @brief Plane mask with only the four side planes active (near and far are skipped).
+		 */
+		static constexpr uint8_t PLANE_MASK_NO_DEPTH = 0x3C;
+
+		/**
+		 * @brief Checks a cube against the planes enabled in a plane mask, for hierarchical culling.
+		 *
+		 * Bit i of the mask enables plane i (near, far, left, right, top, bottom). Planes that fully
+		 * contain the cube are cleared from the mask, so the updated mask can be handed to the children
+		 * of a BVH or octree node: anything inside the parent is inside those planes as well.
+		 *
+		 * @param center The center of the cube.
+		 * @param extent The extent of the cube.
+		 * @param plane_mask In: the planes to test. Out: the planes the cube still straddles (left untouched when Outside).
+		 * @return Outside if an active plane rejects the cube, Inside once no active plane is left, Intersects otherwise.
+		 */
+		[[nodiscard]] Intersection CheckCubeMasked(const Vec3 &center, const Vec3 &extent, uint8_t &plane_mask) const;
+
+		/**
+		 * @brief Checks a sphere against the planes enabled in a plane mask, for hierarchical culling.
+		 *
+		 * Same contract as CheckCubeMasked: planes that fully contain the sphere are cleared from the mask.
+		 *
+		 * @param center The center of the sphere.
+		 * @param radius The radius of the sphere.
+		 * @param plane_mask In: the planes to test. Out: the planes the sphere still straddles (left untouched when Outside).
+		 * @return Outside if an active plane rejects the sphere, Inside once no active plane is left, Intersects otherwise.
+		 */
+		[[nodiscard]] Intersection CheckSphereMasked(const Vec3 &center, float radius, uint8_t &plane_mask) const;
+
+		/**
+		 * @brief Value of a cached failing-plane byte when no plane rejected the object.
+		 */
+		static constexpr uint8_t PLANE_NONE = 0xFF;
+
+		/**
+		 * @brief Checks a cube for visibility, testing the plane that rejected it last frame first.
+		 *
+		 * Objects culled last frame are usually culled by the same plane again, so with a still or
+		 * slowly moving camera most invisible objects cost a single plane test.
+		 *
+		 * @param center The center of the cube.
+		 * @param extent The extent of the cube.
+		 * @param last_plane In: the plane that rejected the cube last frame, or PLANE_NONE. Out: the rejecting plane this frame, or PLANE_NONE.
+		 * @return True if the cube is at least partially visible.
+		 */
+		bool IsVisibleCoherent(const Vec3 &center, const Vec3 &extent, uint8_t &last_plane) const;
+
+		/**
+		 * @brief Culls a batch of boxes stored as structure-of-arrays.
+		 *
+		 * Without a plane cache the planes are swept one at a time over the whole batch. With a cache,
+		 * each box first tests its cached failing plane (see IsVisibleCoherent) and only survivors pay
+		 * for the remaining planes.
+		 *
+		 * @param bounds The boxes to test.
+		 * @param visible Output, one byte per box: 1 when visible, 0 when culled.
+		 * @param last_plane Optional per-box failing-plane cache (PLANE_NONE initially), updated in place.
+		 * @return The number of visible boxes.
+		 */
+		size_t CullBatch(const BoundingBoxSoA &bounds, uint8_t *visible, uint8_t *last_plane = nullptr) const;
+
+		/**
+		 * @brief Gets one of the six frustum planes.
+		 * @param index The plane index (0 near, 1 far, 2 left, 3 right, 4 top, 5 bottom).
+		 * @return The normalized plane; its positive side is inside the frustum.
+		 */
+		[[nodiscard]] const Plane &GetPlane(uint32_t index) const { return m_Planes[index]; }
+
 	private:
 
 		/**
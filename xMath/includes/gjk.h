@@ -0,0 +1,185 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* gjk.h
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <xMath/config/math_config.h>
+#include <xMath/includes/bounding_box.h>
+#include <xMath/includes/oriented_bounding_box.h>
+#include <xMath/includes/sphere.h>
+#include <xMath/includes/vector.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	/**
+	 * @class ConvexShape
+	 * @brief Support-function view of a convex shape, the input of the GJK and EPA queries.
+	 *
+	 * The support function returns the point of the shape furthest along a direction. The view
+	 * refers to the shape without copying it, so the shape must outlive the view; build it right
+	 * before the query.
+	 *
+	 * @code
+	 * const OrientedBoundingBox crate = ...;
+	 * const Sphere ball = ...;
+	 * const GJKResult result = GJKDistance(ConvexShape(crate), ConvexShape(ball), &pair_cache);
+	 * @endcode
+	 */
+	class XMATH_API ConvexShape
+	{
+	public:
+		/**
+		 * @brief Signature of a support function.
+		 * @param data The shape data given to the constructor.
+		 * @param count The element count given to the constructor.
+		 * @param direction The query direction; not necessarily normalized, never zero.
+		 * @return The point of the shape furthest along the direction.
+		 */
+		using SupportFunction = Vec3 (*)(const void *data, size_t count, const Vec3 &direction);
+
+		/**
+		 * @brief Views an axis-aligned box.
+		 */
+		explicit ConvexShape(const BoundingBox &box);
+
+		/**
+		 * @brief Views a sphere.
+		 */
+		explicit ConvexShape(const Sphere &sphere);
+
+		/**
+		 * @brief Views an oriented box.
+		 */
+		explicit ConvexShape(const OrientedBoundingBox &box);
+
+		/**
+		 * @brief Views the convex hull of a point cloud; the support function scans every point.
+		 * @param points The points (at least one).
+		 * @param count The number of points.
+		 */
+		ConvexShape(const Vec3 *points, size_t count);
+
+		/**
+		 * @brief Views a custom shape through its own support function.
+		 * @param data The shape data passed back to the function.
+		 * @param count An element count passed back to the function.
+		 * @param support The support function.
+		 */
+		ConvexShape(const void *data, size_t count, SupportFunction support);
+
+		/**
+		 * @brief Gets the point of the shape furthest along a direction.
+		 * @param direction The query direction (non-zero).
+		 * @return The support point.
+		 */
+		[[nodiscard]] Vec3 Support(const Vec3 &direction) const { return m_Support(m_Data, m_Count, direction); }
+
+	private:
+		const void *m_Data;
+		size_t m_Count;
+		SupportFunction m_Support;
+	};
+
+	/**
+	 * @struct GJKCache
+	 * @brief Simplex kept between frames for one shape pair.
+	 *
+	 * Stores the search directions of the final simplex. The next query rebuilds its start
+	 * simplex from them, so a pair that moved a little starts next to the answer instead of
+	 * from an arbitrary direction. Keep one cache per pair, zero-initialized.
+	 */
+	struct GJKCache
+	{
+		Vec3 directions[4];
+		uint32_t count = 0;
+	};
+
+	/**
+	 * @struct GJKResult
+	 * @brief Outcome of a GJK distance query.
+	 */
+	struct GJKResult
+	{
+		bool intersecting = false; // True if the shapes overlap or touch; the distance and points are then zero / unspecified
+		float distance = 0.0f;     // Distance between the shapes
+		Vec3 point_a;              // Closest point on shape a
+		Vec3 point_b;              // Closest point on shape b
+		uint32_t iterations = 0;   // Support queries made
+	};
+
+	/**
+	 * @struct EPAResult
+	 * @brief Outcome of a penetration query.
+	 */
+	struct EPAResult
+	{
+		bool intersecting = false; // False if the shapes are apart; see GJKDistance
+		Vec3 normal;               // Unit direction from a towards b; moving b by normal * depth separates the shapes
+		float depth = 0.0f;        // Penetration depth
+		Vec3 point_a;              // Deepest point of a inside b
+		Vec3 point_b;              // Deepest point of b inside a; point_a - point_b == normal * depth
+	};
+
+	/**
+	 * @brief Computes the distance and closest points between two convex shapes (GJK).
+	 * @param a The first shape.
+	 * @param b The second shape.
+	 * @param cache Optional simplex from the previous query of this pair, updated on return; may be nullptr.
+	 * @return The distance, closest points and whether the shapes intersect.
+	 */
+	XMATH_API GJKResult GJKDistance(const ConvexShape &a, const ConvexShape &b, GJKCache *cache = nullptr);
+
+	/**
+	 * @brief Tests two convex shapes for overlap (GJK).
+	 *
+	 * Stops as soon as a separating axis is found, so it is cheaper than GJKDistance for
+	 * pairs that are apart.
+	 *
+	 * @param a The first shape.
+	 * @param b The second shape.
+	 * @param cache Optional simplex from the previous query of this pair, updated on return; may be nullptr.
+	 * @return True if the shapes overlap or touch.
+	 */
+	XMATH_API bool GJKIntersects(const ConvexShape &a, const ConvexShape &b, GJKCache *cache = nullptr);
+
+	/**
+	 * @brief Computes the penetration depth and direction of two overlapping convex shapes.
+	 *
+	 * Runs GJK to find a simplex enclosing the origin, then expands it into the polytope of
+	 * the Minkowski difference until the face nearest the origin is found (EPA).
+	 *
+	 * @param a The first shape.
+	 * @param b The second shape.
+	 * @param cache Optional simplex from the previous query of this pair, updated on return; may be nullptr.
+	 * @return The penetration, or intersecting == false if the shapes are apart.
+	 */
+	XMATH_API EPAResult EPAPenetration(const ConvexShape &a, const ConvexShape &b, GJKCache *cache = nullptr);
+}
+
+/// -------------------------------------------------------
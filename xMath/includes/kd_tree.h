@@ -0,0 +1,167 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* kd_tree.h
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <xMath/config/math_config.h>
+#include <xMath/includes/vector.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	/**
+	 * @struct KDTreeBuildSettings
+	 * @brief Parameters of the KD-tree builder.
+	 */
+	struct KDTreeBuildSettings
+	{
+		uint32_t leaf_size = 8;              // Ranges of this size or smaller are scanned linearly
+		uint32_t thread_count = 0;           // Worker threads for Build and the batch queries; 0 uses std::thread::hardware_concurrency
+		uint32_t parallel_threshold = 16384; // Smallest range (or query batch) split across threads
+	};
+
+	/**
+	 * @class KDTree
+	 * @brief Static KD-tree over a point cloud, for nearest, k-nearest and radius queries.
+	 *
+	 * The tree is implicit: the points are reordered so that every range [begin, end) is a
+	 * subtree whose splitting point sits at its middle, begin + (end - begin) / 2, with the left
+	 * subtree before it and the right one after it. Only the split axis is stored per point, so
+	 * there are no node pointers and the layout is just the points in tree order. Splits are at
+	 * the median along the widest axis of the range, which keeps the depth at log2(n). Large
+	 * subtrees are built on worker threads.
+	 *
+	 * Queries compare squared distances and skip a subtree when the squared distance to its
+	 * splitting plane already exceeds the current search radius.
+	 *
+	 * @code
+	 * KDTree tree;
+	 * tree.Build(cloud.data(), cloud.size());
+	 *
+	 * std::vector<uint32_t> nearest(scan.size());
+	 * std::vector<float> distances(scan.size());
+	 * tree.QueryNearestBatch(scan.data(), scan.size(), nearest.data(), distances.data());
+	 * @endcode
+	 */
+	class XMATH_API KDTree
+	{
+	public:
+		static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+		KDTree() = default;
+		~KDTree() = default;
+
+		/**
+		 * @brief Builds the tree, replacing any previous one.
+		 * @param points The points; they are copied, so the array may change afterwards.
+		 * @param count The number of points.
+		 * @param settings The builder parameters.
+		 */
+		void Build(const Vec3 *points, size_t count, const KDTreeBuildSettings &settings = {});
+
+		/**
+		 * @brief Removes all points, keeping the allocated storage.
+		 */
+		void Clear();
+
+		/**
+		 * @brief Finds the point nearest to a position.
+		 * @param point The query position.
+		 * @param distance Optional output distance to the nearest point; may be nullptr.
+		 * @return The index of the nearest point, or INVALID_INDEX if the tree is empty.
+		 */
+		uint32_t QueryNearest(const Vec3 &point, float *distance = nullptr) const;
+
+		/**
+		 * @brief Finds the k points nearest to a position.
+		 * @param point The query position.
+		 * @param k The number of neighbors wanted.
+		 * @param indices Output point indices, nearest first; must hold k values.
+		 * @param distances Output distances matching indices; must hold k values.
+		 * @return The number of neighbors found, min(k, point count).
+		 */
+		uint32_t QueryKNearest(const Vec3 &point, uint32_t k, uint32_t *indices, float *distances) const;
+
+		/**
+		 * @brief Collects the points within a radius of a position.
+		 * @param center The query position.
+		 * @param radius The search radius (inclusive).
+		 * @param results Point indices are appended here, in no particular order.
+		 */
+		void QueryRadius(const Vec3 &center, float radius, std::vector<uint32_t> &results) const;
+
+		/**
+		 * @brief Nearest query for many positions, split across worker threads.
+		 * @param points The query positions.
+		 * @param count The number of query positions.
+		 * @param indices Output nearest point index per query (INVALID_INDEX if the tree is empty).
+		 * @param distances Optional output distance per query; may be nullptr.
+		 */
+		void QueryNearestBatch(const Vec3 *points, size_t count, uint32_t *indices, float *distances = nullptr) const;
+
+		/**
+		 * @brief k-nearest query for many positions, split across worker threads.
+		 * @param points The query positions.
+		 * @param count The number of query positions.
+		 * @param k The number of neighbors wanted per query.
+		 * @param indices Output point indices, k per query, nearest first; must hold count * k values.
+		 * @param distances Output distances matching indices; must hold count * k values.
+		 * @param found Optional output number of neighbors found per query; may be nullptr.
+		 */
+		void QueryKNearestBatch(const Vec3 *points, size_t count, uint32_t k, uint32_t *indices, float *distances, uint32_t *found = nullptr) const;
+
+		/**
+		 * @brief Radius query for many positions, with the results in compressed-row layout.
+		 * @param centers The query positions.
+		 * @param count The number of query positions.
+		 * @param radius The search radius (inclusive).
+		 * @param neighbors Output point indices of all queries, concatenated.
+		 * @param offsets Output count + 1 offsets: the neighbors of query i are [offsets[i], offsets[i + 1]).
+		 * @return The total number of neighbors.
+		 */
+		size_t QueryRadiusBatch(const Vec3 *centers, size_t count, float radius, std::vector<uint32_t> &neighbors, std::vector<uint32_t> &offsets) const;
+
+		[[nodiscard]] size_t GetPointCount() const { return m_Indices.size(); }
+
+		/**
+		 * @brief Gets the point indices in tree order.
+		 * @return The reordered point indices.
+		 */
+		[[nodiscard]] const std::vector<uint32_t> &GetSortedIndices() const { return m_Indices; }
+
+	private:
+		KDTreeBuildSettings m_Settings;
+		std::vector<uint32_t> m_Indices;   // Point indices in tree order
+		std::vector<float> m_X, m_Y, m_Z;  // Point positions in tree order
+		std::vector<uint8_t> m_Axis;       // Split axis of the subtree centered on each point
+	};
+
+}
+
+/// -------------------------------------------------------
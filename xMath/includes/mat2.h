@@ -46,7 +46,7 @@ namespace xMath
 	 // Element names are logical (mRC = row R, column C). The physical
 		// declaration order below controls contiguous memory layout returned by
 		// any potential Data() accessor. Choose row-major or column-major
-		// by defining XMATH_MATRIX_IS_ROW_MAJOR (set by xmath.hpp).
+		// by defining XMATH_MATRIX_IS_ROW_MAJOR (set by math_config.h).
 #if XMATH_MATRIX_IS_ROW_MAJOR
 		float m00, m01;
 		float m10, m11;
@@ -196,6 +196,15 @@ namespace xMath
 	 */
 	XMATH_API Vec3 Cross(const Vec3& a, const Vec3& b);
 
+	/**
+	 * @brief Transforms a point by a 4x4 matrix, including the perspective divide.
+	 *
+	 * @param m The transformation matrix.
+	 * @param point The point to transform (w = 1).
+	 * @return The transformed point divided by w, or zero if w is zero.
+	 */
+	XMATH_API Vec3 TransformPoint(const Mat4 &m, const Vec3 &point);
+
 	/**
 	 * @brief Calculates the length (magnitude) of a 2D vector.
 	 *
@@ -0,0 +1,125 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* multi_frustum.h
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <xMath/config/math_config.h>
+#include <xMath/includes/frustum.h>
+#include <xMath/includes/soa.h>
+#include <xMath/includes/vector.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	/**
+	 * @class MultiFrustum
+	 * @brief Culls objects against up to 32 frusta in a single pass.
+	 *
+	 * Shadow cascades, cube map faces and split-screen views can share one sweep over the
+	 * bounds instead of one sweep per view. The planes are stored plane-major across the
+	 * frusta, so the inner loop for one object runs over contiguous arrays.
+	 *
+	 * Bit i of a view mask is set when the object is visible in the frustum at index i.
+	 *
+	 * @code
+	 * MultiFrustum views;
+	 * for (const ShadowCascade &cascade : cascades)
+	 *     views.Add(cascade.frustum);
+	 * views.CullBatch(bounds, view_masks.data());
+	 * @endcode
+	 */
+	class XMATH_API MultiFrustum
+	{
+	public:
+		static constexpr uint32_t MAX_FRUSTA = 32;
+
+		MultiFrustum() = default;
+		~MultiFrustum() = default;
+
+		/**
+		 * @brief Appends a frustum.
+		 * @param frustum The frustum to add.
+		 * @return The index (view mask bit) of the frustum.
+		 */
+		uint32_t Add(const Frustum &frustum);
+
+		/**
+		 * @brief Replaces the frustum at an index, e.g. when a view moves.
+		 * @param index The index returned by Add.
+		 * @param frustum The new frustum.
+		 */
+		void Set(uint32_t index, const Frustum &frustum);
+
+		/**
+		 * @brief Removes all frusta.
+		 */
+		void Clear() { m_Count = 0; }
+
+		/**
+		 * @brief Gets the number of frusta.
+		 * @return The number of frusta.
+		 */
+		[[nodiscard]] uint32_t GetCount() const { return m_Count; }
+
+		/**
+		 * @brief Gets the view mask with a bit set for every frustum.
+		 * @return The mask of all views.
+		 */
+		[[nodiscard]] uint32_t GetAllMask() const { return m_Count == MAX_FRUSTA ? 0xFFFFFFFFu : (1u << m_Count) - 1u; }
+
+		/**
+		 * @brief Culls one box against every frustum.
+		 * @param center The center of the box.
+		 * @param extent The half-size of the box.
+		 * @return The view mask of the box.
+		 */
+		[[nodiscard]] uint32_t Cull(const Vec3 &center, const Vec3 &extent) const;
+
+		/**
+		 * @brief Culls a batch of boxes against every frustum in one pass.
+		 * @param bounds The boxes to test.
+		 * @param view_masks Output, one mask per box.
+		 * @return The number of boxes visible in at least one view.
+		 */
+		size_t CullBatch(const BoundingBoxSoA &bounds, uint32_t *view_masks) const;
+
+	private:
+		// Plane-major storage: [plane][frustum]
+		float m_NormalX[6][MAX_FRUSTA] = {};
+		float m_NormalY[6][MAX_FRUSTA] = {};
+		float m_NormalZ[6][MAX_FRUSTA] = {};
+		float m_AbsNormalX[6][MAX_FRUSTA] = {};
+		float m_AbsNormalY[6][MAX_FRUSTA] = {};
+		float m_AbsNormalZ[6][MAX_FRUSTA] = {};
+		float m_Distance[6][MAX_FRUSTA] = {};
+		uint32_t m_Count = 0;
+	};
+
+}
+
+/// -------------------------------------------------------
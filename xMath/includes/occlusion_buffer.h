@@ -0,0 +1,166 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* occlusion_buffer.h
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <xMath/config/math_config.h>
+#include <xMath/includes/bounding_box.h>
+#include <xMath/includes/frustum.h>
+#include <xMath/includes/mat4.h>
+#include <xMath/includes/soa.h>
+#include <xMath/includes/vector.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	/**
+	 * @class OcclusionBuffer
+	 * @brief Low-resolution software depth buffer for occlusion culling on the CPU.
+	 *
+	 * Occluder triangles are rasterized into a tiled depth buffer (8x4 pixel tiles stored
+	 * contiguously) and every tile keeps the farthest depth written to it as a one-level
+	 * hierarchical Z. Occludee boxes are projected to a screen rectangle and their nearest
+	 * depth; most of them are accepted or rejected by the tile values alone.
+	 *
+	 * Depth is stored normalized and convention independent: 0 at the near plane, 1 at the far
+	 * plane, whatever the DepthFlags of the projection are.
+	 *
+	 * @code
+	 * OcclusionBuffer occlusion(256, 128, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE);
+	 * occlusion.Clear();
+	 * occlusion.SetViewProjection(projection * view);
+	 * occlusion.RasterizeTriangles(vertices.data(), indices.data(), indices.size() / 3);
+	 * occlusion.TestBatch(bounds, visible.data());
+	 * @endcode
+	 */
+	class XMATH_API OcclusionBuffer
+	{
+	public:
+		static constexpr uint32_t TILE_WIDTH = 8;  // Pixels per tile row
+		static constexpr uint32_t TILE_HEIGHT = 4; // Rows per tile
+
+		/**
+		 * @brief Creates a cleared occlusion buffer.
+		 * @param width The width in pixels (rounded up to whole tiles).
+		 * @param height The height in pixels (rounded up to whole tiles).
+		 * @param depth_flags The depth convention of the projection, a combination of Frustum::DepthFlags.
+		 */
+		OcclusionBuffer(uint32_t width, uint32_t height, uint8_t depth_flags = Frustum::DEPTH_ZERO_TO_ONE);
+		~OcclusionBuffer() = default;
+
+		/**
+		 * @brief Resets every pixel and tile to the far plane.
+		 */
+		void Clear();
+
+		/**
+		 * @brief Sets the matrix used to project occluders and occludees.
+		 * @param view_projection The combined view-projection matrix (projection * view).
+		 */
+		void SetViewProjection(const Mat4 &view_projection);
+
+		/**
+		 * @brief Rasterizes indexed world-space occluder triangles.
+		 *
+		 * Triangles that cross the near plane are skipped, which only makes the buffer more
+		 * conservative. Both windings are rasterized.
+		 *
+		 * @param vertices The vertex positions.
+		 * @param indices Three indices per triangle.
+		 * @param triangle_count The number of triangles.
+		 */
+		void RasterizeTriangles(const Vec3 *vertices, const uint32_t *indices, size_t triangle_count);
+
+		/**
+		 * @brief Tests whether any part of a box may be visible.
+		 * @param box The world-space box.
+		 * @return false only when the box is completely hidden behind rasterized occluders.
+		 */
+		[[nodiscard]] bool IsVisible(const BoundingBox &box) const;
+
+		/**
+		 * @brief Tests whether any part of a box given by center and extent may be visible.
+		 * @param center The center of the box.
+		 * @param extent The half-size of the box.
+		 * @return false only when the box is completely hidden behind rasterized occluders.
+		 */
+		[[nodiscard]] bool IsVisible(const Vec3 &center, const Vec3 &extent) const;
+
+		/**
+		 * @brief Tests a batch of boxes.
+		 * @param bounds The boxes to test.
+		 * @param visible Output, one byte per box: 1 if it may be visible, 0 if occluded.
+		 * @return The number of boxes that may be visible.
+		 */
+		size_t TestBatch(const BoundingBoxSoA &bounds, uint8_t *visible) const;
+
+		/**
+		 * @brief Gets the normalized depth of a pixel (0 = near plane, 1 = far plane).
+		 * @param x The pixel column.
+		 * @param y The pixel row, 0 at the top.
+		 * @return The stored depth.
+		 */
+		[[nodiscard]] float GetDepth(uint32_t x, uint32_t y) const;
+
+		/**
+		 * @brief Gets the farthest depth stored in the tile that contains a pixel.
+		 * @param x The pixel column.
+		 * @param y The pixel row, 0 at the top.
+		 * @return The tile depth.
+		 */
+		[[nodiscard]] float GetTileDepth(uint32_t x, uint32_t y) const;
+
+		[[nodiscard]] uint32_t GetWidth() const { return m_Width; }
+		[[nodiscard]] uint32_t GetHeight() const { return m_Height; }
+
+	private:
+		struct ScreenVertex
+		{
+			float x, y;  // Pixel coordinates
+			float depth; // Normalized depth
+			bool valid;  // false when the point is on or behind the near plane
+		};
+
+		[[nodiscard]] ScreenVertex Project(float x, float y, float z) const;
+		void RasterizeTriangle(const ScreenVertex &v0, const ScreenVertex &v1, const ScreenVertex &v2);
+		void UpdateTileDepth(uint32_t tile);
+
+		uint32_t m_Width = 0;
+		uint32_t m_Height = 0;
+		uint32_t m_TilesX = 0;
+		uint32_t m_TilesY = 0;
+		uint8_t m_DepthFlags = Frustum::DEPTH_ZERO_TO_ONE;
+		float m_Rows[4][4] = {};        // View-projection rows
+		std::vector<float> m_Depth;     // Tile-major pixel depths, TILE_WIDTH * TILE_HEIGHT per tile
+		std::vector<float> m_TileDepth; // Farthest depth per tile
+	};
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,175 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* octree.h
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <xMath/config/math_config.h>
+#include <xMath/includes/bounding_box.h>
+#include <xMath/includes/frustum.h>
+#include <xMath/includes/sphere.h>
+#include <xMath/includes/vector.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	/**
+	 * @class LooseOctree
+	 * @brief Loose octree over dynamic BoundingBox objects.
+	 *
+	 * Every node's bounds are twice the size of its cell, so an object is stored in the single
+	 * node at the depth matching its size whose cell contains its center. The depth follows
+	 * directly from the object's largest extent, which makes insertion and relocation constant
+	 * time (at most one walk of MAX_DEPTH links) and never requires splitting or refitting.
+	 * Objects whose center lies outside the world bounds are kept at the root.
+	 *
+	 * Objects are identified by caller-chosen dense indices, like BVH primitives. Nodes and
+	 * objects live in pooled arrays with free lists; objects of a node form an intrusive list.
+	 *
+	 * @code
+	 * LooseOctree octree(BoundingBox(Vec3(-1024.0f), Vec3(1024.0f)));
+	 * octree.Insert(entity, bounds);
+	 * octree.Update(entity, moved_bounds); // every frame for moving entities
+	 *
+	 * std::vector<uint32_t> visible;
+	 * octree.QueryFrustum(frustum, visible);
+	 * @endcode
+	 */
+	class XMATH_API LooseOctree
+	{
+	public:
+		static constexpr uint32_t MAX_DEPTH = 16;
+		static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+		/**
+		 * @brief Constructs an empty octree.
+		 * @param world_bounds The region subdivided by the tree; it is expanded to a cube.
+		 * @param max_depth The deepest level (at most MAX_DEPTH). Objects smaller than the deepest cell are stored there.
+		 */
+		explicit LooseOctree(const BoundingBox &world_bounds, uint32_t max_depth = 8);
+		~LooseOctree() = default;
+
+		/**
+		 * @brief Adds an object.
+		 * @param id The object index; must not be in the tree already.
+		 * @param box The bounds of the object.
+		 */
+		void Insert(uint32_t id, const BoundingBox &box);
+
+		/**
+		 * @brief Changes the bounds of an object, moving it to another node only when needed.
+		 * @param id The object index.
+		 * @param box The new bounds.
+		 */
+		void Update(uint32_t id, const BoundingBox &box);
+
+		/**
+		 * @brief Removes an object; nodes left empty are returned to the pool.
+		 * @param id The object index.
+		 */
+		void Remove(uint32_t id);
+
+		/**
+		 * @brief Removes all objects and nodes, keeping the pooled storage.
+		 */
+		void Clear();
+
+		/**
+		 * @brief Collects the objects whose bounds intersect a frustum.
+		 * @param frustum The frustum.
+		 * @param results Object indices are appended here.
+		 */
+		void QueryFrustum(const Frustum &frustum, std::vector<uint32_t> &results) const;
+
+		/**
+		 * @brief Collects the objects whose bounds intersect a sphere.
+		 * @param sphere The sphere.
+		 * @param results Object indices are appended here.
+		 */
+		void QuerySphere(const Sphere &sphere, std::vector<uint32_t> &results) const;
+
+		/**
+		 * @brief Collects the objects whose bounds overlap a box.
+		 * @param box The query box.
+		 * @param results Object indices are appended here.
+		 */
+		void QueryOverlap(const BoundingBox &box, std::vector<uint32_t> &results) const;
+
+		[[nodiscard]] bool Contains(uint32_t id) const { return id < m_Objects.size() && m_Objects[id].node != INVALID_INDEX; }
+		[[nodiscard]] size_t GetObjectCount() const { return m_ObjectCount; }
+		[[nodiscard]] size_t GetNodeCount() const { return m_Nodes.size() - m_FreeNodes.size(); }
+		[[nodiscard]] uint32_t GetMaxDepth() const { return m_MaxDepth; }
+
+		/**
+		 * @brief Gets the depth of the node an object is stored in.
+		 * @param id The object index.
+		 * @return The depth, 0 for the root.
+		 */
+		[[nodiscard]] uint32_t GetObjectDepth(uint32_t id) const;
+
+	private:
+		struct Node
+		{
+			Vec3 center;              // Center of the cell
+			float half_size;          // Half size of the cell; the loose bounds are twice as large
+			uint32_t parent;
+			uint32_t children[8];     // Octant index: x | y << 1 | z << 2
+			uint32_t first_object;    // Head of the intrusive object list
+			uint32_t subtree_count;   // Objects in this node and below, for pruning
+			uint8_t depth;
+			uint8_t octant;           // Slot in the parent
+		};
+
+		struct Object
+		{
+			Vec3 center;
+			Vec3 extent;
+			uint32_t node = INVALID_INDEX;
+			uint32_t prev = INVALID_INDEX;
+			uint32_t next = INVALID_INDEX;
+		};
+
+		[[nodiscard]] uint32_t SelectDepth(const Vec3 &center, const Vec3 &extent) const;
+		[[nodiscard]] bool InCell(const Node &node, const Vec3 &point) const;
+		uint32_t FindOrCreateNode(const Vec3 &center, uint32_t depth);
+		uint32_t AllocateNode(uint32_t parent, uint8_t octant, const Vec3 &center, float half_size, uint8_t depth);
+		void Link(uint32_t id, uint32_t node);
+		void Unlink(uint32_t id);
+
+		Vec3 m_WorldMin;
+		float m_WorldSize;                 // Edge length of the root cell
+		uint32_t m_MaxDepth;
+		size_t m_ObjectCount = 0;
+		std::vector<Node> m_Nodes;         // Node pool, root at 0
+		std::vector<uint32_t> m_FreeNodes; // Released node slots
+		std::vector<Object> m_Objects;     // Indexed by object id
+	};
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,192 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* oriented_bounding_box.h
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <xMath/config/math_config.h>
+#include <xMath/includes/bounding_box.h>
+#include <xMath/includes/frustum.h>
+#include <xMath/includes/mat3.h>
+#include <xMath/includes/mat4.h>
+#include <xMath/includes/math_utils.h>
+#include <xMath/includes/vector.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	/**
+	 * @class OrientedBoundingBox
+	 * @brief Box with its own orientation: a center, an orthonormal basis and half extents along each basis axis.
+	 *
+	 * Fits long rotated objects far tighter than the AABB of BoundingBox::operator*(Matrix),
+	 * which grows with the rotation. Overlap tests use the separating axis theorem.
+	 *
+	 * @code
+	 * const OrientedBoundingBox box(mesh_bounds, world_transform);
+	 * if (box.Intersects(frustum) != Intersection::Outside)
+	 *     Draw(mesh);
+	 * @endcode
+	 */
+	class XMATH_API OrientedBoundingBox
+	{
+	public:
+		/**
+		 * @brief Constructs an empty box at the origin with the identity basis.
+		 */
+		OrientedBoundingBox();
+
+		/**
+		 * @brief Constructs a box from its parts.
+		 * @param center The center.
+		 * @param basis The local axes as the columns of an orthonormal matrix.
+		 * @param extents The half extents along each local axis (non-negative).
+		 */
+		OrientedBoundingBox(const Vec3 &center, const Mat3 &basis, const Vec3 &extents);
+
+		/**
+		 * @brief Constructs the box covering an AABB after an affine transform.
+		 *
+		 * Exact for translation, rotation and (non-uniform) scale: the axes are the normalized
+		 * basis columns of the transform and the extents are scaled by their lengths. Shear is not
+		 * representable; the axes are then orthonormalized and the box only approximates the result.
+		 *
+		 * @param box The local-space box.
+		 * @param transform The local-to-world matrix.
+		 */
+		OrientedBoundingBox(const BoundingBox &box, const Mat4 &transform);
+
+		~OrientedBoundingBox() = default;
+
+		/**
+		 * @brief Fits a box to a set of points using principal component analysis.
+		 *
+		 * The axes are the eigenvectors of the covariance matrix of the points (Jacobi iteration),
+		 * and the extents are the range of the points along each axis. Works best for elongated
+		 * point sets; the box always contains every point.
+		 *
+		 * @param points The points.
+		 * @param count The number of points.
+		 * @return The fitted box, or an empty box if count is 0.
+		 */
+		[[nodiscard]] static OrientedBoundingBox FromPoints(const Vec3 *points, size_t count);
+
+		[[nodiscard]] const Vec3 &GetCenter() const { return m_Center; }
+		[[nodiscard]] const Mat3 &GetBasis() const { return m_Basis; }
+		[[nodiscard]] const Vec3 &GetExtents() const { return m_Extents; }
+
+		/**
+		 * @brief Gets one local axis.
+		 * @param index The axis (0 - 2).
+		 * @return The unit axis in world space.
+		 */
+		[[nodiscard]] Vec3 GetAxis(int index) const;
+
+		/**
+		 * @brief Retrieves the eight corner points of the box.
+		 * @param corners Pointer to an array of 8 Vec3 objects to store the corner points.
+		 */
+		void GetCorners(std::array<Vec3, 8> *corners) const;
+
+		/**
+		 * @brief Gets the smallest axis-aligned box containing this box.
+		 * @return The enclosing AABB.
+		 */
+		[[nodiscard]] BoundingBox GetBoundingBox() const;
+
+		/**
+		 * @brief Calculates the closest point on or in the box to a given point.
+		 * @param point The point.
+		 * @return The closest point.
+		 */
+		[[nodiscard]] Vec3 GetClosestPoint(const Vec3 &point) const;
+
+		/**
+		 * @brief Checks if a point is inside the box (surface included).
+		 * @param point The point.
+		 * @return True if the point is inside.
+		 */
+		[[nodiscard]] bool Contains(const Vec3 &point) const;
+
+		/**
+		 * @brief Separating axis test against another box: 3 + 3 face axes and 9 edge cross products.
+		 * @param box The other box.
+		 * @return True if the boxes overlap (touching counts).
+		 */
+		[[nodiscard]] bool Intersects(const OrientedBoundingBox &box) const;
+
+		/**
+		 * @brief Separating axis test against an axis-aligned box.
+		 * @param box The axis-aligned box.
+		 * @return True if the boxes overlap (touching counts).
+		 */
+		[[nodiscard]] bool Intersects(const BoundingBox &box) const;
+
+		/**
+		 * @brief Tests the box against the planes of a frustum enabled in a mask.
+		 *
+		 * Each plane is tested with the projected radius of the box on its normal. Planes the box
+		 * is fully inside are cleared from the mask, as in Frustum::CheckCubeMasked, so children of a
+		 * hierarchy can skip them.
+		 *
+		 * @param frustum The frustum.
+		 * @param plane_mask The planes to test; updated to the planes the box still straddles.
+		 * @return Outside, Inside (no plane straddled) or Intersects.
+		 */
+		[[nodiscard]] Intersection Intersects(const Frustum &frustum, uint8_t &plane_mask) const;
+
+		/**
+		 * @brief Tests the box against all six planes of a frustum.
+		 * @param frustum The frustum.
+		 * @return Outside, Inside or Intersects.
+		 */
+		[[nodiscard]] Intersection Intersects(const Frustum &frustum) const;
+
+	private:
+		Vec3 m_Center;
+		Mat3 m_Basis;   // Columns are the local axes
+		Vec3 m_Extents; // Half size along each local axis
+	};
+
+	/**
+	 * @brief Separating axis test of one box against an array of boxes.
+	 *
+	 * The 15 axis tests of each pair are combined without early outs, so the loop has no
+	 * data-dependent branches.
+	 *
+	 * @param box The query box.
+	 * @param boxes The boxes.
+	 * @param count The number of boxes.
+	 * @param results Output 1 per overlapping box, 0 otherwise; must hold count values.
+	 * @return The number of overlapping boxes.
+	 */
+	XMATH_API size_t IntersectOrientedBoxes(const OrientedBoundingBox &box, const OrientedBoundingBox *boxes, size_t count, uint8_t *results);
+
+}
+
+/// -------------------------------------------------------
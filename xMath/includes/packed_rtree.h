@@ -0,0 +1,135 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* packed_rtree.h
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <xMath/config/math_config.h>
+#include <xMath/includes/rectangle.h>
+#include <xMath/includes/vector.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	/**
+	 * @class PackedRTree
+	 * @brief Static 2D R-tree over Rectangle items, bulk loaded with Sort-Tile-Recursive.
+	 *
+	 * Every level is tiled by STR (sorted into vertical slices by center x, then by center y
+	 * within a slice) and packed into full nodes, so the tree has minimal height and nearly no
+	 * overlap between siblings. All levels live in one array; items are the bottom level.
+	 * Use it for content that changes rarely (static sprites, laid-out UI), and Quadtree for
+	 * content that moves.
+	 *
+	 * Queries use the inclusive edges of Rectangle::Intersects: touching counts as a hit.
+	 *
+	 * @code
+	 * PackedRTree tree;
+	 * tree.Build(widget_rects.data(), widget_rects.size());
+	 *
+	 * std::vector<uint32_t> hits;
+	 * tree.QueryPoint(mouse, hits);
+	 * @endcode
+	 */
+	class XMATH_API PackedRTree
+	{
+	public:
+		static constexpr uint32_t DEFAULT_NODE_SIZE = 16;
+
+		PackedRTree() = default;
+		~PackedRTree() = default;
+
+		/**
+		 * @brief Builds the tree, replacing any previous one.
+		 * @param rects The item rectangles (x, y = top-left corner).
+		 * @param count The number of items.
+		 * @param node_size The number of children per node (at least 2).
+		 */
+		void Build(const Rectangle *rects, size_t count, uint32_t node_size = DEFAULT_NODE_SIZE);
+
+		/**
+		 * @brief Removes all items.
+		 */
+		void Clear();
+
+		/**
+		 * @brief Collects the items containing a point.
+		 * @param point The point.
+		 * @param results Item indices are appended here.
+		 */
+		void QueryPoint(const Vec2 &point, std::vector<uint32_t> &results) const;
+
+		/**
+		 * @brief Collects the items intersecting a rectangle.
+		 * @param rect The query rectangle.
+		 * @param results Item indices are appended here.
+		 */
+		void QueryRect(const Rectangle &rect, std::vector<uint32_t> &results) const;
+
+		/**
+		 * @brief Collects the items intersecting a region made of several rectangles.
+		 *
+		 * The tree is walked once for the whole region (split-screen viewports, scissor or dirty
+		 * rectangles), and each item is reported at most once.
+		 *
+		 * @param region The rectangles forming the visible region.
+		 * @param region_count The number of rectangles.
+		 * @param results Item indices are appended here.
+		 */
+		void QueryRegion(const Rectangle *region, size_t region_count, std::vector<uint32_t> &results) const;
+
+		[[nodiscard]] bool IsEmpty() const { return m_ItemCount == 0; }
+		[[nodiscard]] size_t GetItemCount() const { return m_ItemCount; }
+		[[nodiscard]] size_t GetNodeCount() const { return m_Boxes.size() - m_ItemCount; }
+		[[nodiscard]] uint32_t GetHeight() const { return static_cast<uint32_t>(m_LevelEnds.size()); }
+
+		/**
+		 * @brief Gets the bounds of all items.
+		 * @return The bounds, or an empty rectangle if the tree is empty.
+		 */
+		[[nodiscard]] Rectangle GetBounds() const;
+
+	private:
+		struct Box
+		{
+			float min_x, min_y, max_x, max_y;
+		};
+
+		template <typename Test>
+		void Query(const Test &test, std::vector<uint32_t> &results) const;
+
+		uint32_t m_NodeSize = DEFAULT_NODE_SIZE;
+		size_t m_ItemCount = 0;
+		std::vector<Box> m_Boxes;           // Items first, then each level of nodes; the root is last
+		std::vector<uint32_t> m_Links;      // Item index for items, first child for nodes
+		std::vector<uint32_t> m_LevelEnds;  // End of each level in m_Boxes, items first
+	};
+
+}
+
+/// -------------------------------------------------------
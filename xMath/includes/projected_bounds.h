@@ -0,0 +1,109 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* projected_bounds.h
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <xMath/config/math_config.h>
+#include <xMath/includes/bounding_box.h>
+#include <xMath/includes/frustum.h>
+#include <xMath/includes/mat4.h>
+#include <xMath/includes/rectangle.h>
+#include <xMath/includes/soa.h>
+#include <xMath/includes/sphere.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	/**
+	 * @brief Projects a box to its screen-space rectangle and nearest depth.
+	 *
+	 * Box edges that cross the near plane are clipped against it, so the rectangle stays
+	 * tight and conservative for boxes that surround the camera.
+	 *
+	 * @param view_projection The combined view-projection matrix (projection * view).
+	 * @param center The center of the box.
+	 * @param extent The half-size of the box.
+	 * @param viewport The viewport in pixels (top-left origin, y down).
+	 * @param depth_flags The depth convention of the projection, a combination of Frustum::DepthFlags.
+	 * @param rect Output rectangle, clamped to the viewport.
+	 * @param min_depth Output normalized depth of the nearest point (0 = near plane, 1 = far plane).
+	 * @return false if the box is entirely behind the near plane or off screen (rect is then empty).
+	 */
+	XMATH_API bool ProjectBoundingBox(const Mat4 &view_projection, const Vec3 &center, const Vec3 &extent, const Rectangle &viewport,
+	                                  uint8_t depth_flags, Rectangle &rect, float &min_depth);
+
+	/**
+	 * @brief Projects a sphere to its exact screen-space rectangle and nearest depth.
+	 *
+	 * Uses the tangent-plane construction of Mara and McGuire ("2D Polyhedral Bounds of a
+	 * Clipped, Perspective-Projected 3D Sphere"), which is exact for perspective projections
+	 * and handles spheres that cross the near plane.
+	 *
+	 * @param view The view matrix.
+	 * @param projection A right-handed perspective projection (w = -z in view space), as built by projection.h.
+	 * @param sphere The world-space sphere.
+	 * @param viewport The viewport in pixels (top-left origin, y down).
+	 * @param depth_flags The depth convention of the projection, a combination of Frustum::DepthFlags.
+	 * @param rect Output rectangle, clamped to the viewport.
+	 * @param min_depth Output normalized depth of the nearest point (0 = near plane, 1 = far plane).
+	 * @return false if the sphere is entirely behind the near plane or off screen (rect is then empty).
+	 */
+	XMATH_API bool ProjectSphere(const Mat4 &view, const Mat4 &projection, const Sphere &sphere, const Rectangle &viewport,
+	                             uint8_t depth_flags, Rectangle &rect, float &min_depth);
+
+	/**
+	 * @brief Projects a batch of boxes. See ProjectBoundingBox.
+	 * @param view_projection The combined view-projection matrix (projection * view).
+	 * @param bounds The boxes to project.
+	 * @param viewport The viewport in pixels.
+	 * @param depth_flags The depth convention of the projection.
+	 * @param rects Output, one rectangle per box.
+	 * @param min_depths Output, one normalized depth per box.
+	 * @return The number of boxes with a non-empty rectangle.
+	 */
+	XMATH_API size_t ProjectBoundingBoxes(const Mat4 &view_projection, const BoundingBoxSoA &bounds, const Rectangle &viewport,
+	                                      uint8_t depth_flags, Rectangle *rects, float *min_depths);
+
+	/**
+	 * @brief Projects a batch of spheres. See ProjectSphere.
+	 * @param view The view matrix.
+	 * @param projection A right-handed perspective projection.
+	 * @param spheres The spheres to project.
+	 * @param count The number of spheres.
+	 * @param viewport The viewport in pixels.
+	 * @param depth_flags The depth convention of the projection.
+	 * @param rects Output, one rectangle per sphere.
+	 * @param min_depths Output, one normalized depth per sphere.
+	 * @return The number of spheres with a non-empty rectangle.
+	 */
+	XMATH_API size_t ProjectSpheres(const Mat4 &view, const Mat4 &projection, const Sphere *spheres, size_t count, const Rectangle &viewport,
+	                                uint8_t depth_flags, Rectangle *rects, float *min_depths);
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,167 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* quadtree.h
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <xMath/config/math_config.h>
+#include <xMath/includes/rectangle.h>
+#include <xMath/includes/vector.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	/**
+	 * @class Quadtree
+	 * @brief Dynamic 2D quadtree over Rectangle items that insert, move and disappear.
+	 *
+	 * Each item is stored in the deepest node whose bounds contain it entirely, so items that
+	 * straddle a split line stay in the parent. A node splits once it holds more than
+	 * split_threshold items and collapses again when its subtree drops to that count. Items
+	 * outside the world bounds are kept at the root.
+	 *
+	 * Items are identified by caller-chosen dense indices. Nodes are allocated from a pool in
+	 * blocks of four siblings and items form an intrusive list per node, so moving items does
+	 * not allocate. Queries use the inclusive edges of Rectangle::Intersects.
+	 *
+	 * @code
+	 * Quadtree tree(Rectangle(0.0f, 0.0f, 4096.0f, 4096.0f));
+	 * tree.Insert(sprite, sprite_rect);
+	 * tree.Update(sprite, moved_rect);
+	 *
+	 * std::vector<uint32_t> visible;
+	 * tree.QueryRect(camera_rect, visible);
+	 * @endcode
+	 */
+	class XMATH_API Quadtree
+	{
+	public:
+		static constexpr uint32_t MAX_DEPTH = 16;
+		static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+		/**
+		 * @brief Constructs an empty quadtree.
+		 * @param world_bounds The region subdivided by the tree.
+		 * @param max_depth The deepest level (at most MAX_DEPTH).
+		 * @param split_threshold The number of items a node holds before it splits.
+		 */
+		explicit Quadtree(const Rectangle &world_bounds, uint32_t max_depth = 8, uint32_t split_threshold = 8);
+		~Quadtree() = default;
+
+		/**
+		 * @brief Adds an item.
+		 * @param id The item index; must not be in the tree already.
+		 * @param rect The item rectangle.
+		 */
+		void Insert(uint32_t id, const Rectangle &rect);
+
+		/**
+		 * @brief Changes the rectangle of an item, moving it only when it no longer fits its node.
+		 * @param id The item index.
+		 * @param rect The new rectangle.
+		 */
+		void Update(uint32_t id, const Rectangle &rect);
+
+		/**
+		 * @brief Removes an item.
+		 * @param id The item index.
+		 */
+		void Remove(uint32_t id);
+
+		/**
+		 * @brief Removes all items and nodes, keeping the pooled storage.
+		 */
+		void Clear();
+
+		/**
+		 * @brief Collects the items containing a point.
+		 * @param point The point.
+		 * @param results Item indices are appended here.
+		 */
+		void QueryPoint(const Vec2 &point, std::vector<uint32_t> &results) const;
+
+		/**
+		 * @brief Collects the items intersecting a rectangle.
+		 * @param rect The query rectangle.
+		 * @param results Item indices are appended here.
+		 */
+		void QueryRect(const Rectangle &rect, std::vector<uint32_t> &results) const;
+
+		/**
+		 * @brief Collects the items intersecting a region made of several rectangles, each once.
+		 * @param region The rectangles forming the visible region.
+		 * @param region_count The number of rectangles.
+		 * @param results Item indices are appended here.
+		 */
+		void QueryRegion(const Rectangle *region, size_t region_count, std::vector<uint32_t> &results) const;
+
+		[[nodiscard]] bool Contains(uint32_t id) const { return id < m_Items.size() && m_Items[id].node != INVALID_INDEX; }
+		[[nodiscard]] size_t GetItemCount() const { return m_ItemCount; }
+		[[nodiscard]] size_t GetNodeCount() const { return m_Nodes.size() - m_FreeBlocks.size() * 4; }
+
+	private:
+		struct Node
+		{
+			float min_x, min_y, max_x, max_y;
+			uint32_t parent;
+			uint32_t first_child;     // First of four consecutive children, INVALID_INDEX for a leaf
+			uint32_t first_item;      // Head of the intrusive item list
+			uint32_t item_count;      // Items in this node
+			uint32_t subtree_count;   // Items in this node and below
+			uint32_t depth;
+		};
+
+		struct Item
+		{
+			float min_x, min_y, max_x, max_y;
+			uint32_t node = INVALID_INDEX;
+			uint32_t prev = INVALID_INDEX;
+			uint32_t next = INVALID_INDEX;
+		};
+
+		template <typename Test>
+		void Query(const Test &test, std::vector<uint32_t> &results) const;
+
+		[[nodiscard]] uint32_t FindChild(const Node &node, const Item &item) const;
+		uint32_t FindNode(const Item &item);
+		void Split(uint32_t node);
+		void Collapse(uint32_t node);
+		void Link(uint32_t id, uint32_t node);
+		void Unlink(uint32_t id);
+
+		uint32_t m_MaxDepth;
+		uint32_t m_SplitThreshold;
+		size_t m_ItemCount = 0;
+		std::vector<Node> m_Nodes;          // Node pool, root at 0, children in blocks of four
+		std::vector<uint32_t> m_FreeBlocks; // First node of each released block
+		std::vector<Item> m_Items;          // Indexed by item id
+	};
+
+}
+
+/// -------------------------------------------------------
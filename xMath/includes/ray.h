@@ -0,0 +1,185 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* ray.h
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cfloat>
+#include <cstddef>
+#include <cstdint>
+#include <xMath/config/math_config.h>
+#include <xMath/includes/bounding_box.h>
+#include <xMath/includes/frustum.h>
+#include <xMath/includes/mat4.h>
+#include <xMath/includes/rectangle.h>
+#include <xMath/includes/soa.h>
+#include <xMath/includes/vector.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	/**
+	 * @brief A ray segment with a precomputed inverse direction.
+	 *
+	 * The inverse direction turns every slab test into multiplies. Zero direction components
+	 * give infinite inverse components, which the slab tests handle.
+	 *
+	 * @code
+	 * const Ray ray = Ray::FromScreen(view_projection.GetInverse(), mouse, viewport, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE);
+	 * float distance;
+	 * if (IntersectRayBox(ray, box.GetCenter(), box.GetExtents(), distance))
+	 *     Select(ray.GetPoint(distance));
+	 * @endcode
+	 */
+	struct XMATH_API Ray
+	{
+		Vec3 origin;
+		Vec3 direction;
+		Vec3 inv_direction;
+		float max_distance;
+
+		Ray();
+
+		/**
+		 * @brief Constructs a ray.
+		 * @param origin The start point.
+		 * @param direction The direction; distances are measured in multiples of its length.
+		 * @param max_distance The end of the segment along the direction.
+		 */
+		Ray(const Vec3 &origin, const Vec3 &direction, float max_distance = FLT_MAX);
+
+		/**
+		 * @brief Returns origin + direction * t.
+		 */
+		[[nodiscard]] Vec3 GetPoint(float t) const;
+
+		/**
+		 * @brief Builds a picking ray through a screen position.
+		 *
+		 * The point is unprojected onto the near plane and into the view volume with the inverse
+		 * view-projection matrix. The ray starts on the near plane, has a unit direction, and
+		 * ends on the far plane (unbounded for DEPTH_INFINITE_FAR).
+		 *
+		 * @param inverse_view_projection The inverse of projection * view.
+		 * @param screen_point The position in pixels (top-left origin, y down).
+		 * @param viewport The viewport in pixels.
+		 * @param depth_flags The depth convention of the projection, a combination of Frustum::DepthFlags.
+		 * @return The picking ray.
+		 */
+		[[nodiscard]] static Ray FromScreen(const Mat4 &inverse_view_projection, const Vec2 &screen_point, const Rectangle &viewport, uint8_t depth_flags);
+	};
+
+	/**
+	 * @brief Eight rays in structure-of-arrays layout for packet traversal.
+	 *
+	 * Each test runs the same arithmetic on all eight lanes in a fixed-size loop that compilers
+	 * vectorize, and returns a lane mask. Lanes cleared in `active` are ignored.
+	 */
+	struct XMATH_API RayPacket8
+	{
+		static constexpr uint32_t LANES = 8;
+		static constexpr uint8_t ALL_LANES = 0xFF;
+
+		float origin_x[LANES], origin_y[LANES], origin_z[LANES];
+		float inv_dir_x[LANES], inv_dir_y[LANES], inv_dir_z[LANES];
+		float max_distance[LANES];
+		uint8_t active;
+
+		/**
+		 * @brief Constructs an empty packet (no active lanes).
+		 */
+		RayPacket8();
+
+		/**
+		 * @brief Builds a packet from up to eight rays; missing lanes stay inactive.
+		 * @param rays The rays.
+		 * @param count The number of rays (at most LANES).
+		 */
+		RayPacket8(const Ray *rays, size_t count);
+
+		/**
+		 * @brief Stores a ray in a lane and activates it.
+		 */
+		void Set(uint32_t lane, const Ray &ray);
+
+		/**
+		 * @brief Returns the ray stored in a lane.
+		 */
+		[[nodiscard]] Ray Get(uint32_t lane) const;
+
+		/**
+		 * @brief Slab test of all active lanes against one box.
+		 * @param t_enter Output entry distance per lane (only meaningful for hit lanes).
+		 * @return The mask of lanes that hit the box within their segment.
+		 */
+		uint8_t IntersectBox(float min_x, float min_y, float min_z, float max_x, float max_y, float max_z, float *t_enter) const;
+	};
+
+	/**
+	 * @brief Slab test of a ray against a box.
+	 * @param ray The ray.
+	 * @param center The center of the box.
+	 * @param extent The half-size of the box.
+	 * @param distance Output entry distance (0 when the origin is inside the box).
+	 * @return true if the segment hits the box.
+	 */
+	XMATH_API bool IntersectRayBox(const Ray &ray, const Vec3 &center, const Vec3 &extent, float &distance);
+
+	/**
+	 * @brief Slab test of a ray against a box given by its corners.
+	 * @param ray The ray.
+	 * @param min The minimum corner of the box.
+	 * @param max The maximum corner of the box.
+	 * @param distance Output entry distance (0 when the origin is inside the box).
+	 * @return true if the segment hits the box.
+	 */
+	XMATH_API bool IntersectRayBounds(const Ray &ray, const Vec3 &min, const Vec3 &max, float &distance);
+
+	/**
+	 * @brief Slab test of a ray against every box of a SoA array.
+	 *
+	 * Each box is three min/max slab updates and the distance is written with a select, so the
+	 * loop vectorizes across boxes.
+	 *
+	 * @param ray The ray.
+	 * @param boxes The boxes.
+	 * @param distances Output entry distance per box, or -1 on a miss; must hold boxes.Size() values.
+	 * @return The number of boxes hit.
+	 */
+	XMATH_API size_t IntersectRayBoxes(const Ray &ray, const BoundingBoxSoA &boxes, float *distances);
+
+	/**
+	 * @brief Finds the nearest box of a SoA array hit by a ray.
+	 * @param ray The ray.
+	 * @param boxes The boxes.
+	 * @param index Output index of the nearest box.
+	 * @param distance Output entry distance of the nearest box.
+	 * @return true if any box was hit.
+	 */
+	XMATH_API bool RaycastBoxes(const Ray &ray, const BoundingBoxSoA &boxes, uint32_t &index, float &distance);
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,122 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* shadow_cascades.h
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <array>
+#include <cstdint>
+#include <xMath/config/math_config.h>
+#include <xMath/includes/frustum.h>
+#include <xMath/includes/mat4.h>
+#include <xMath/includes/sphere.h>
+#include <xMath/includes/vector.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	/**
+	 * @brief Maximum number of cascades produced by BuildShadowCascades.
+	 */
+	inline constexpr uint32_t MAX_SHADOW_CASCADES = 8;
+
+	/**
+	 * @brief How the camera depth range is divided between cascades.
+	 */
+	enum class CascadeSplitScheme : uint8_t
+	{
+	    Uniform,     ///< Equal depth slices
+	    Logarithmic, ///< Constant ratio between consecutive splits
+	    Practical    ///< Blend of the two, weighted by CascadeSettings::lambda
+	};
+
+	/**
+	 * @struct CascadeSettings
+	 * @brief Input parameters for BuildShadowCascades.
+	 */
+	struct XMATH_API CascadeSettings
+	{
+	    uint32_t cascade_count = 4;                                     ///< Number of cascades (1 - MAX_SHADOW_CASCADES)
+	    CascadeSplitScheme scheme = CascadeSplitScheme::Practical;      ///< Split distribution
+	    float lambda = 0.5f;                                            ///< Practical scheme weight: 0 = uniform, 1 = logarithmic
+	    float shadow_distance = 0.0f;                                   ///< Clamp for the far split; 0 uses the camera far plane
+	    float caster_padding = 0.0f;                                    ///< Extra depth towards the light for casters outside the view
+	    uint32_t resolution = 2048;                                     ///< Shadow map size in texels, used for texel snapping
+	    uint8_t depth_flags = Frustum::DEPTH_NEGATIVE_ONE_TO_ONE;       ///< Depth convention of the camera projection
+	};
+
+	/**
+	 * @struct ShadowCascade
+	 * @brief One slice of the camera frustum and the light matrices that cover it.
+	 */
+	struct XMATH_API ShadowCascade
+	{
+	    float split_near = 0.0f;                ///< View depth where the slice starts
+	    float split_far = 0.0f;                 ///< View depth where the slice ends
+	    std::array<Vec3, 8> corners;            ///< World-space corners: near (0-3) then far (4-7)
+	    Sphere bounds;                          ///< Bounding sphere of the corners
+	    Mat4 light_view;                        ///< Rotation-only light view matrix
+	    Mat4 light_projection;                  ///< Texel-snapped orthographic projection
+	    Mat4 light_view_projection;             ///< light_projection * light_view
+	    Frustum frustum;                        ///< Culling frustum of light_view_projection
+	};
+
+	/**
+	 * @brief Computes the split distances for a set of cascades.
+	 *
+	 * @param z_near View depth of the first split (camera near plane).
+	 * @param z_far View depth of the last split.
+	 * @param cascade_count Number of cascades.
+	 * @param scheme Split distribution.
+	 * @param lambda Practical scheme weight: 0 = uniform, 1 = logarithmic.
+	 * @param splits Output array of cascade_count + 1 distances; splits[0] = z_near and splits[cascade_count] = z_far.
+	 */
+	XMATH_API void ComputeCascadeSplits(float z_near, float z_far, uint32_t cascade_count, CascadeSplitScheme scheme, float lambda, float *splits);
+
+	/**
+	 * @brief Slices the camera frustum into cascades and fits a stable light projection to each.
+	 *
+	 * Each cascade is enclosed by a bounding sphere, so the size of its light projection does
+	 * not change as the camera rotates. The projection is then snapped to whole shadow map
+	 * texels in light space to stop edges from shimmering while the camera moves.
+	 *
+	 * @param projection Camera projection matrix. Needs a finite far plane unless shadow_distance is set.
+	 * @param view Camera view matrix.
+	 * @param light_direction Direction the light travels in (does not need to be normalized).
+	 * @param settings Cascade count, split scheme and shadow map parameters.
+	 * @param cascades Output array with room for settings.cascade_count entries.
+	 * @return uint32_t Number of cascades written (cascade_count clamped to MAX_SHADOW_CASCADES).
+	 *
+	 * @note - Light matrices are built with LookAt and Ortho from projection.h, so their clip depth is in [-w, w].
+	 * @code
+	 * std::array<ShadowCascade, 4> cascades;
+	 * BuildShadowCascades(projection, view, sun_direction, CascadeSettings{}, cascades.data());
+	 * @endcode
+	 */
+	XMATH_API uint32_t BuildShadowCascades(const Mat4 &projection, const Mat4 &view, const Vec3 &light_direction, const CascadeSettings &settings, ShadowCascade *cascades);
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,178 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* soa.h
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <xMath/includes/bounding_box.h>
+#include <xMath/includes/vector.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	/**
+	 * @struct BoundingBoxSoA
+	 * @brief Structure-of-arrays storage for many bounding boxes in center/extent form.
+	 *
+	 * Batch kernels (frustum culling, multi-view culling, ray slab tests) stream one component
+	 * at a time over these arrays, which keeps their inner loops free of gathers and lets the
+	 * compiler vectorize them.
+	 */
+	struct BoundingBoxSoA
+	{
+		std::vector<float> center_x; // Box center, x component
+		std::vector<float> center_y; // Box center, y component
+		std::vector<float> center_z; // Box center, z component
+		std::vector<float> extent_x; // Box half-size, x component
+		std::vector<float> extent_y; // Box half-size, y component
+		std::vector<float> extent_z; // Box half-size, z component
+
+		/**
+		 * @brief Gets the number of boxes stored.
+		 * @return The number of boxes.
+		 */
+		[[nodiscard]] size_t Size() const { return center_x.size(); }
+
+		/**
+		 * @brief Reserves storage for a number of boxes.
+		 * @param count The number of boxes to reserve.
+		 */
+		void Reserve(size_t count)
+		{
+			center_x.reserve(count); center_y.reserve(count); center_z.reserve(count);
+			extent_x.reserve(count); extent_y.reserve(count); extent_z.reserve(count);
+		}
+
+		/**
+		 * @brief Removes all boxes.
+		 */
+		void Clear()
+		{
+			center_x.clear(); center_y.clear(); center_z.clear();
+			extent_x.clear(); extent_y.clear(); extent_z.clear();
+		}
+
+		/**
+		 * @brief Appends a box given by its center and extent.
+		 * @param center The center of the box.
+		 * @param extent The half-size of the box.
+		 */
+		void Add(const Vec3 &center, const Vec3 &extent)
+		{
+			center_x.push_back(center.x); center_y.push_back(center.y); center_z.push_back(center.z);
+			extent_x.push_back(extent.x); extent_y.push_back(extent.y); extent_z.push_back(extent.z);
+		}
+
+		/**
+		 * @brief Appends a bounding box.
+		 * @param box The box to append.
+		 */
+		void Add(const BoundingBox &box) { Add(box.GetCenter(), box.GetExtents()); }
+
+		/**
+		 * @brief Overwrites the box at an index, e.g. after the object moved.
+		 * @param index The index of the box.
+		 * @param box The new bounds.
+		 */
+		void Set(size_t index, const BoundingBox &box)
+		{
+			const Vec3 center = box.GetCenter();
+			const Vec3 extent = box.GetExtents();
+			center_x[index] = center.x; center_y[index] = center.y; center_z[index] = center.z;
+			extent_x[index] = extent.x; extent_y[index] = extent.y; extent_z[index] = extent.z;
+		}
+
+		/**
+		 * @brief Reads back the box at an index.
+		 * @param index The index of the box.
+		 * @return The box as min/max corners.
+		 */
+		[[nodiscard]] BoundingBox Get(size_t index) const
+		{
+			const Vec3 center(center_x[index], center_y[index], center_z[index]);
+			const Vec3 extent(extent_x[index], extent_y[index], extent_z[index]);
+			return {center - extent, center + extent};
+		}
+	};
+
+	/**
+	 * @struct Vec3SoA
+	 * @brief Structure-of-arrays storage for many points, for the batch distance queries.
+	 */
+	struct Vec3SoA
+	{
+		std::vector<float> x; // x components
+		std::vector<float> y; // y components
+		std::vector<float> z; // z components
+
+		/**
+		 * @brief Gets the number of points stored.
+		 * @return The number of points.
+		 */
+		[[nodiscard]] size_t Size() const { return x.size(); }
+
+		/**
+		 * @brief Reserves storage for a number of points.
+		 * @param count The number of points to reserve.
+		 */
+		void Reserve(size_t count) { x.reserve(count); y.reserve(count); z.reserve(count); }
+
+		/**
+		 * @brief Sets the number of points, e.g. before a batch query writes into them.
+		 * @param count The new number of points.
+		 */
+		void Resize(size_t count) { x.resize(count); y.resize(count); z.resize(count); }
+
+		/**
+		 * @brief Removes all points.
+		 */
+		void Clear() { x.clear(); y.clear(); z.clear(); }
+
+		/**
+		 * @brief Appends a point.
+		 * @param point The point to append.
+		 */
+		void Add(const Vec3 &point) { x.push_back(point.x); y.push_back(point.y); z.push_back(point.z); }
+
+		/**
+		 * @brief Overwrites the point at an index.
+		 * @param index The index of the point.
+		 * @param point The new point.
+		 */
+		void Set(size_t index, const Vec3 &point) { x[index] = point.x; y[index] = point.y; z[index] = point.z; }
+
+		/**
+		 * @brief Reads back the point at an index.
+		 * @param index The index of the point.
+		 * @return The point.
+		 */
+		[[nodiscard]] Vec3 Get(size_t index) const { return {x[index], y[index], z[index]}; }
+	};
+
+}
+
+// -------------------------------------------------------
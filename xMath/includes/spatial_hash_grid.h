@@ -0,0 +1,151 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* spatial_hash_grid.h
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <xMath/config/math_config.h>
+#include <xMath/includes/vector.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	/**
+	 * @class SpatialHashGrid
+	 * @brief Uniform grid over a set of points, hashed into a fixed table, for neighbor searches.
+	 *
+	 * Build counting-sorts the points by hash bucket: each bucket is a contiguous range
+	 * [cell_start, cell_start + cell_count) of the sorted point arrays, so there are no per-cell
+	 * allocations and a bucket scan reads contiguous memory. A cell size close to the typical
+	 * query radius keeps radius queries to 27 cells.
+	 *
+	 * @code
+	 * SpatialHashGrid grid(smoothing_radius);
+	 * grid.Build(positions.data(), positions.size());
+	 *
+	 * std::vector<uint32_t> neighbors, offsets;
+	 * grid.QueryRadiusBatch(positions.data(), positions.size(), smoothing_radius, neighbors, offsets);
+	 * // neighbors of point i: neighbors[offsets[i]] .. neighbors[offsets[i + 1] - 1]
+	 * @endcode
+	 */
+	class XMATH_API SpatialHashGrid
+	{
+	public:
+		/**
+		 * @brief Constructs an empty grid.
+		 * @param cell_size The edge length of a grid cell.
+		 */
+		explicit SpatialHashGrid(float cell_size);
+		~SpatialHashGrid() = default;
+
+		/**
+		 * @brief Builds the grid, replacing any previous contents.
+		 * @param points The points; they are copied, so the array may change afterwards.
+		 * @param count The number of points.
+		 * @param table_size The number of hash buckets, rounded up to a power of two; 0 uses twice the point count.
+		 */
+		void Build(const Vec3 *points, size_t count, uint32_t table_size = 0);
+
+		/**
+		 * @brief Removes all points, keeping the allocated storage.
+		 */
+		void Clear();
+
+		/**
+		 * @brief Collects the points within a radius of a position.
+		 * @param center The query position.
+		 * @param radius The search radius (inclusive).
+		 * @param results Point indices are appended here, in no particular order.
+		 */
+		void QueryRadius(const Vec3 &center, float radius, std::vector<uint32_t> &results) const;
+
+		/**
+		 * @brief Radius query for many positions, with the results in compressed-row layout.
+		 * @param centers The query positions.
+		 * @param count The number of query positions.
+		 * @param radius The search radius (inclusive).
+		 * @param neighbors Output point indices of all queries, concatenated.
+		 * @param offsets Output count + 1 offsets: the neighbors of query i are [offsets[i], offsets[i + 1]).
+		 * @return The total number of neighbors.
+		 */
+		size_t QueryRadiusBatch(const Vec3 *centers, size_t count, float radius, std::vector<uint32_t> &neighbors, std::vector<uint32_t> &offsets) const;
+
+		/**
+		 * @brief Finds the k points nearest to a position.
+		 *
+		 * Searches rings of cells outwards from the query cell and stops once no unvisited cell
+		 * can hold a closer point. Falls back to a linear scan once more cells than points have been
+		 * visited, so sparse data with large gaps between points stays O(n).
+		 *
+		 * @param point The query position.
+		 * @param k The number of neighbors wanted.
+		 * @param indices Output point indices, nearest first; must hold k values.
+		 * @param distances Output distances matching indices; must hold k values.
+		 * @return The number of neighbors found, min(k, point count).
+		 */
+		uint32_t QueryKNearest(const Vec3 &point, uint32_t k, uint32_t *indices, float *distances) const;
+
+		/**
+		 * @brief k-nearest query for many positions.
+		 * @param points The query positions.
+		 * @param count The number of query positions.
+		 * @param k The number of neighbors wanted per query.
+		 * @param indices Output point indices, k per query, nearest first; must hold count * k values.
+		 * @param distances Output distances matching indices; must hold count * k values.
+		 * @param found Optional output number of neighbors found per query; may be nullptr.
+		 */
+		void QueryKNearestBatch(const Vec3 *points, size_t count, uint32_t k, uint32_t *indices, float *distances, uint32_t *found = nullptr) const;
+
+		[[nodiscard]] float GetCellSize() const { return m_CellSize; }
+		[[nodiscard]] size_t GetPointCount() const { return m_Indices.size(); }
+		[[nodiscard]] size_t GetTableSize() const { return m_CellStart.size(); }
+
+		/**
+		 * @brief Gets the point indices in bucket order; bucket ranges index into this array.
+		 * @return The sorted point indices.
+		 */
+		[[nodiscard]] const std::vector<uint32_t> &GetSortedIndices() const { return m_Indices; }
+
+	private:
+		[[nodiscard]] int32_t CellCoord(float value) const;
+		[[nodiscard]] uint32_t Hash(int32_t x, int32_t y, int32_t z) const;
+
+		float m_CellSize;
+		float m_InverseCellSize;
+		uint32_t m_TableMask = 0;
+		int32_t m_MinCell[3] = { 0, 0, 0 };  // Cell range covered by the points
+		int32_t m_MaxCell[3] = { -1, -1, -1 };
+		std::vector<uint32_t> m_CellStart;   // Per bucket: first position in the sorted arrays
+		std::vector<uint32_t> m_CellCount;   // Per bucket: number of points
+		std::vector<uint32_t> m_Indices;     // Point indices in bucket order
+		std::vector<float> m_X, m_Y, m_Z;    // Point positions in bucket order
+	};
+
+}
+
+/// -------------------------------------------------------
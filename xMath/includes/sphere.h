@@ -25,6 +25,12 @@
 * -------------------------------------------------------
 */
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <xMath/config/math_config.h>
+#include <xMath/includes/bounding_box.h>
+#include <xMath/includes/mat4.h>
+#include <xMath/includes/soa.h>
 #include <xMath/includes/vector.h>
 
 // -------------------------------------------------------
@@ -35,7 +41,7 @@ namespace xMath
      * @class Sphere
      * @brief Represents a sphere defined by a center and radius for collision detection and visibility testing in 3D graphics.
      */
-    class Sphere
+    class XMATH_API Sphere
     {
     public:
         /**
@@ -52,6 +58,88 @@ namespace xMath
 
         ~Sphere() = default;
 
+        /**
+         * @brief Computes a bounding sphere with Ritter's algorithm.
+         *
+         * Starts from the most distant pair of the axis-extreme points and grows the sphere to
+         * include every point in one more pass. Two passes over the points; the result is
+         * typically 5 - 20% larger than the minimal sphere.
+         *
+         * @param points The points.
+         * @param count The number of points.
+         * @return The bounding sphere, or a zero sphere if count is 0.
+         */
+        [[nodiscard]] static Sphere FromPointsRitter(const Vec3* points, size_t count);
+
+        /**
+         * @brief Computes a near-minimal bounding sphere with the EPOS-26 algorithm.
+         *
+         * Finds the extreme points along 13 fixed directions, computes the exact minimal sphere
+         * of those 26 points, then grows it to include the rest (Larsson, "Fast and Tight Fitting
+         * Bounding Spheres"). Two passes over the points; usually within 1 - 2% of the minimal sphere.
+         *
+         * @param points The points.
+         * @param count The number of points.
+         * @return The bounding sphere, or a zero sphere if count is 0.
+         */
+        [[nodiscard]] static Sphere FromPointsEPOS(const Vec3* points, size_t count);
+
+        /**
+         * @brief Computes the minimal bounding sphere with Welzl's algorithm.
+         *
+         * The iterative form over a shuffled copy of the points: each nested loop fixes one more
+         * support point and rescans the points before it. Expected linear time.
+         *
+         * @param points The points.
+         * @param count The number of points.
+         * @return The minimal bounding sphere, or a zero sphere if count is 0.
+         */
+        [[nodiscard]] static Sphere FromPointsExact(const Vec3* points, size_t count);
+
+        /**
+         * @brief Transforms the sphere; the radius is scaled by the largest axis scale of the matrix.
+         *
+         * The result bounds the transformed sphere for any combination of translation, rotation
+         * and (non-uniform) scale. Sheared matrices can stretch it beyond the largest axis scale.
+         *
+         * @param transform The affine transformation matrix to apply.
+         * @return The transformed sphere, which bounds the transformed original.
+         */
+        Sphere operator*(const Mat4& transform) const;
+
+        /**
+         * @brief Grows the sphere to the smallest sphere enclosing it and another sphere.
+         * @param sphere The sphere to merge with.
+         */
+        void Merge(const Sphere& sphere);
+
+        /**
+         * @brief Grows the sphere to the smallest sphere enclosing it and a point, keeping the far side fixed.
+         * @param point The point to include.
+         */
+        void Merge(const Vec3& point);
+
+        /**
+         * @brief Checks if a point lies inside the sphere (surface included).
+         * @param point The point.
+         * @return True if the point is inside.
+         */
+        [[nodiscard]] bool Contains(const Vec3& point) const;
+
+        /**
+         * @brief Checks if two spheres overlap (touching counts).
+         * @param sphere The other sphere.
+         * @return True if they overlap.
+         */
+        [[nodiscard]] bool Intersects(const Sphere& sphere) const;
+
+        /**
+         * @brief Checks if the sphere overlaps a box (touching counts).
+         * @param box The box.
+         * @return True if they overlap.
+         */
+        [[nodiscard]] bool Intersects(const BoundingBox& box) const;
+
         /**
          * @brief The center of the sphere.
          */
@@ -62,6 +150,29 @@ namespace xMath
          */
         float radius;
     };
+
+    /**
+     * @brief Tests a sphere against an array of spheres.
+     * @param sphere The query sphere.
+     * @param spheres The spheres.
+     * @param count The number of spheres.
+     * @param results Output 1 per overlapping sphere, 0 otherwise; must hold count values.
+     * @return The number of overlapping spheres.
+     */
+    XMATH_API size_t IntersectSpheres(const Sphere& sphere, const Sphere* spheres, size_t count, uint8_t* results);
+
+    /**
+     * @brief Tests a sphere against every box of a SoA array.
+     *
+     * The per-axis distance outside each slab is clamped arithmetically and the hit is stored as
+     * a bool, so the loop has no control flow and vectorizes across boxes.
+     *
+     * @param sphere The query sphere.
+     * @param boxes The boxes.
+     * @param results Output 1 per overlapping box, 0 otherwise; must hold boxes.Size() values.
+     * @return The number of overlapping boxes.
+     */
+    XMATH_API size_t IntersectSphereBoxes(const Sphere& sphere, const BoundingBoxSoA& boxes, uint8_t* results);
 }
 
 /// -------------------------------------------------------
@@ -0,0 +1,185 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* sweep_and_prune.h
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+#include <xMath/config/math_config.h>
+#include <xMath/includes/bounding_box.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	/**
+	 * @struct OverlapPair
+	 * @brief Two objects whose bounds overlap; always stored with a < b.
+	 */
+	struct OverlapPair
+	{
+		uint32_t a;
+		uint32_t b;
+
+		bool operator==(const OverlapPair &other) const { return a == other.a && b == other.b; }
+	};
+
+	/**
+	 * @class SweepAndPrune
+	 * @brief Broadphase that keeps box endpoints sorted and reports overlapping pairs incrementally.
+	 *
+	 * Endpoints are kept sorted with insertion sort, which is close to linear when objects move
+	 * a little each frame. Two modes are available:
+	 *
+	 * - ALL_AXES (default): endpoints are sorted on x, y and z, and the pair set is updated only
+	 *   by the swaps of the sort (Baraff). A min passing a max on any axis tests the pair; a max
+	 *   passing a min removes it. No sweep is needed.
+	 * - A single axis (0, 1 or 2): only that axis is sorted; UpdatePairs sweeps it and compares
+	 *   the result with the previous frame. Better when objects move far between frames.
+	 *
+	 * Add, Update and Remove only record the new bounds; UpdatePairs applies them and fills the
+	 * added and removed pair lists. Touching boxes count as overlapping, as in BoundingBox::Intersects.
+	 *
+	 * @code
+	 * SweepAndPrune broadphase;
+	 * broadphase.Add(id, bounds);
+	 * ...
+	 * broadphase.Update(id, moved_bounds);
+	 * broadphase.UpdatePairs();
+	 * for (const OverlapPair &pair : broadphase.GetAddedPairs())
+	 *     BeginContact(pair.a, pair.b);
+	 * @endcode
+	 */
+	class XMATH_API SweepAndPrune
+	{
+	public:
+		static constexpr uint32_t ALL_AXES = 3;
+
+		/**
+		 * @brief Constructs an empty broadphase.
+		 * @param sweep_axis 0, 1 or 2 to sort and sweep a single axis, or ALL_AXES for fully incremental updates.
+		 */
+		explicit SweepAndPrune(uint32_t sweep_axis = ALL_AXES);
+		~SweepAndPrune() = default;
+
+		/**
+		 * @brief Adds an object.
+		 * @param id The object index; must not be present already.
+		 * @param box The bounds of the object.
+		 */
+		void Add(uint32_t id, const BoundingBox &box);
+
+		/**
+		 * @brief Changes the bounds of an object.
+		 * @param id The object index.
+		 * @param box The new bounds.
+		 */
+		void Update(uint32_t id, const BoundingBox &box);
+
+		/**
+		 * @brief Removes an object; its pairs are reported as removed by the next UpdatePairs.
+		 * @param id The object index.
+		 */
+		void Remove(uint32_t id);
+
+		/**
+		 * @brief Removes all objects and pairs without reporting them.
+		 */
+		void Clear();
+
+		/**
+		 * @brief Sorts the endpoints and updates the pair set.
+		 *
+		 * Afterwards GetAddedPairs and GetRemovedPairs hold the difference to the previous call.
+		 * A pair that appears and disappears again within one update is in neither list.
+		 */
+		void UpdatePairs();
+
+		[[nodiscard]] const std::vector<OverlapPair> &GetAddedPairs() const { return m_Added; }
+		[[nodiscard]] const std::vector<OverlapPair> &GetRemovedPairs() const { return m_Removed; }
+
+		/**
+		 * @brief Gets all currently overlapping pairs, sorted.
+		 * @param pairs Output pairs; previous contents are replaced.
+		 */
+		void GetPairs(std::vector<OverlapPair> &pairs) const;
+
+		[[nodiscard]] size_t GetPairCount() const;
+		[[nodiscard]] bool IsOverlapping(uint32_t a, uint32_t b) const;
+		[[nodiscard]] bool Contains(uint32_t id) const { return id < m_Proxies.size() && m_Proxies[id].state != ProxyState::Free; }
+		[[nodiscard]] size_t GetObjectCount() const { return m_ObjectCount; }
+
+	private:
+		enum class ProxyState : uint8_t
+		{
+			Free,
+			Active,
+			Removing
+		};
+
+		struct Proxy
+		{
+			float min[3];
+			float max[3];
+			uint32_t endpoint[3][2];  // Positions of the min and max endpoints per sorted axis
+			ProxyState state = ProxyState::Free;
+		};
+
+		struct Endpoint
+		{
+			float value;
+			uint32_t data;          // Object id << 1 | 1 for a max endpoint
+
+			[[nodiscard]] uint32_t GetId() const { return data >> 1; }
+			[[nodiscard]] bool IsMax() const { return (data & 1) != 0; }
+		};
+
+		[[nodiscard]] bool Overlaps(uint32_t a, uint32_t b) const;
+		void SortAxis(uint32_t axis, bool report);
+		void SweepAxis();
+		void AddPair(uint32_t a, uint32_t b);
+		void RemovePair(uint32_t a, uint32_t b);
+		void FinishEvents();
+
+		uint32_t m_SweepAxis;
+		uint32_t m_FirstAxis;
+		uint32_t m_AxisCount;
+		size_t m_ObjectCount = 0;
+		std::vector<Proxy> m_Proxies;                 // Indexed by object id
+		std::vector<Endpoint> m_Endpoints[3];         // Sorted endpoints per axis
+		std::vector<uint32_t> m_PendingRemovals;
+		std::unordered_set<uint64_t> m_PairSet;       // ALL_AXES mode
+		std::vector<uint64_t> m_PairList;             // Single-axis mode, sorted
+		std::vector<uint64_t> m_SweepScratch;
+		std::vector<uint32_t> m_Active;
+		std::vector<OverlapPair> m_Added;
+		std::vector<OverlapPair> m_Removed;
+	};
+
+}
+
+/// -------------------------------------------------------
@@ -237,7 +237,7 @@ namespace xMath
 		 *
 		 * @return The vector with absolute values.
 		 */
-		[[nodiscard]] TVector2 Abs() const { return TVector2(abs(x), abs(y)); }
+		[[nodiscard]] TVector2 Abs() const { return TVector2(std::abs(x), std::abs(y)); }
 
 		/**
 		 * @brief Returns a vector with the minimum components of two vectors.
@@ -25,6 +25,7 @@
 * -------------------------------------------------------
 */
 #pragma once
+#include <cmath>
 #include <limits>
 
 // -----------------------------------------------------
@@ -254,7 +255,7 @@ namespace xMath
 		 * @brief Returns a vector with the absolute values of each component.
 		 * @return A vector with the absolute values of each component.
 		 */
-		[[nodiscard]] TVector3 Abs() const { return TVector3(abs(x), abs(y), abs(z)); }
+		[[nodiscard]] TVector3 Abs() const { return TVector3(std::abs(x), std::abs(y), std::abs(z)); }
 	};
 
 	/**
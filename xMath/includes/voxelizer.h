@@ -0,0 +1,289 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* voxelizer.h
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <xMath/config/math_config.h>
+#include <xMath/includes/bounding_box.h>
+#include <xMath/includes/soa.h>
+#include <xMath/includes/vector.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	/**
+	 * @brief Tests a triangle against a box with the separating axis theorem.
+	 *
+	 * Checks the 13 candidate axes of Akenine-Möller's test: the three box axes, the triangle
+	 * normal and the nine cross products of box axes and triangle edges. Touching counts as
+	 * overlapping.
+	 *
+	 * @param a The first triangle vertex.
+	 * @param b The second triangle vertex.
+	 * @param c The third triangle vertex.
+	 * @param box The box.
+	 * @return True if the triangle and the box overlap.
+	 */
+	XMATH_API bool IntersectTriangleBox(const Vec3 &a, const Vec3 &b, const Vec3 &c, const BoundingBox &box);
+
+	/**
+	 * @brief Tests a triangle against every box of a SoA array.
+	 *
+	 * All 13 axes are evaluated and combined without early outs, so the loop has no
+	 * data-dependent branches and vectorizes across boxes.
+	 *
+	 * @param a The first triangle vertex.
+	 * @param b The second triangle vertex.
+	 * @param c The third triangle vertex.
+	 * @param boxes The boxes.
+	 * @param results Output 1 per overlapping box, 0 otherwise; must hold boxes.Size() values.
+	 * @return The number of overlapping boxes.
+	 */
+	XMATH_API size_t IntersectTriangleBoxes(const Vec3 &a, const Vec3 &b, const Vec3 &c, const BoundingBoxSoA &boxes, uint8_t *results);
+
+	/**
+	 * @enum VoxelFill
+	 * @brief Which voxels a mesh voxelization sets.
+	 */
+	enum class VoxelFill : uint8_t
+	{
+		Surface, // Voxels whose box overlaps a triangle (conservative, 26-separating)
+		Solid    // Surface voxels plus voxels whose center lies inside the mesh; the mesh must be closed
+	};
+
+	/**
+	 * @struct VoxelizeSettings
+	 * @brief Parameters of a mesh voxelization.
+	 */
+	struct VoxelizeSettings
+	{
+		VoxelFill fill = VoxelFill::Surface; // Which voxels to set
+		uint32_t thread_count = 0;           // Worker threads; 0 uses std::thread::hardware_concurrency
+		uint32_t parallel_threshold = 4096;  // Smallest triangle count split across threads
+	};
+
+	/**
+	 * @class VoxelGrid
+	 * @brief Dense grid of one-bit voxels, packed 64 per word along x.
+	 *
+	 * Voxel (x, y, z) covers origin + [x, x + 1) * voxel_size on each axis. Rows along x are
+	 * contiguous, so a row can be read as words with GetRow.
+	 *
+	 * @code
+	 * VoxelGrid grid(mesh_bounds, 0.25f);
+	 * grid.Voxelize(positions.data(), indices.data(), indices.size() / 3, { VoxelFill::Solid });
+	 * if (grid.Get(x, y, z))
+	 *     MarkBlocked(x, y, z);
+	 * @endcode
+	 */
+	class XMATH_API VoxelGrid
+	{
+	public:
+		VoxelGrid();
+
+		/**
+		 * @brief Constructs an empty grid.
+		 * @param origin The minimum corner of voxel (0, 0, 0).
+		 * @param voxel_size The edge length of a voxel (positive).
+		 * @param size_x The number of voxels along x.
+		 * @param size_y The number of voxels along y.
+		 * @param size_z The number of voxels along z.
+		 */
+		VoxelGrid(const Vec3 &origin, float voxel_size, uint32_t size_x, uint32_t size_y, uint32_t size_z);
+
+		/**
+		 * @brief Constructs an empty grid covering a box, rounding its size up to whole voxels.
+		 * @param bounds The region to cover; its minimum corner becomes the origin.
+		 * @param voxel_size The edge length of a voxel (positive).
+		 */
+		VoxelGrid(const BoundingBox &bounds, float voxel_size);
+
+		/**
+		 * @brief Sets the voxels touched by a triangle mesh, keeping the voxels already set.
+		 *
+		 * The grid is split into slabs along z that are filled on worker threads. Triangles
+		 * outside the grid are clipped away.
+		 *
+		 * @param vertices The vertex positions.
+		 * @param indices Three vertex indices per triangle, or nullptr for consecutive vertex triples.
+		 * @param triangle_count The number of triangles.
+		 * @param settings The fill mode and threading parameters.
+		 */
+		void Voxelize(const Vec3 *vertices, const uint32_t *indices, size_t triangle_count, const VoxelizeSettings &settings = {});
+
+		/**
+		 * @brief Clears every voxel.
+		 */
+		void Clear();
+
+		/**
+		 * @brief Gets a voxel.
+		 * @return True if the voxel is set.
+		 */
+		[[nodiscard]] bool Get(uint32_t x, uint32_t y, uint32_t z) const;
+
+		/**
+		 * @brief Sets or clears a voxel.
+		 */
+		void Set(uint32_t x, uint32_t y, uint32_t z, bool value);
+
+		/**
+		 * @brief Counts the set voxels.
+		 * @return The number of set voxels.
+		 */
+		[[nodiscard]] size_t CountSet() const;
+
+		/**
+		 * @brief Gets the packed words of one row along x; voxel x is bit x % 64 of word x / 64.
+		 * @return GetWordsPerRow() words.
+		 */
+		[[nodiscard]] const uint64_t *GetRow(uint32_t y, uint32_t z) const;
+
+		/**
+		 * @brief Gets the box covered by a voxel.
+		 */
+		[[nodiscard]] BoundingBox GetVoxelBounds(uint32_t x, uint32_t y, uint32_t z) const;
+
+		/**
+		 * @brief Gets the box covered by the whole grid.
+		 */
+		[[nodiscard]] BoundingBox GetBounds() const;
+
+		[[nodiscard]] const Vec3 &GetOrigin() const { return m_Origin; }
+		[[nodiscard]] float GetVoxelSize() const { return m_VoxelSize; }
+		[[nodiscard]] uint32_t GetSizeX() const { return m_SizeX; }
+		[[nodiscard]] uint32_t GetSizeY() const { return m_SizeY; }
+		[[nodiscard]] uint32_t GetSizeZ() const { return m_SizeZ; }
+		[[nodiscard]] uint32_t GetWordsPerRow() const { return m_WordsPerRow; }
+
+	private:
+		Vec3 m_Origin;
+		float m_VoxelSize;
+		uint32_t m_SizeX;
+		uint32_t m_SizeY;
+		uint32_t m_SizeZ;
+		uint32_t m_WordsPerRow;
+		std::vector<uint64_t> m_Words; // Rows along x, ordered by y then z
+	};
+
+	/**
+	 * @class SparseVoxelGrid
+	 * @brief Grid of one-bit voxels that only stores the non-empty 4x4x4 bricks.
+	 *
+	 * Each brick is one 64-bit mask; voxel (x, y, z) of a brick is bit (z * 4 + y) * 4 + x.
+	 * Bricks are kept sorted by key, so lookups are a binary search. Voxelization works through
+	 * one 4-voxel slab at a time, so its scratch memory is a slab, not the whole grid.
+	 */
+	class XMATH_API SparseVoxelGrid
+	{
+	public:
+		static constexpr uint32_t BRICK_SIZE = 4;
+
+		/**
+		 * @struct Brick
+		 * @brief A non-empty brick: its coordinates in bricks and its voxel mask.
+		 */
+		struct Brick
+		{
+			uint32_t x;
+			uint32_t y;
+			uint32_t z;
+			uint64_t mask;
+		};
+
+		SparseVoxelGrid();
+
+		/**
+		 * @brief Constructs an empty grid; see VoxelGrid for the parameters.
+		 */
+		SparseVoxelGrid(const Vec3 &origin, float voxel_size, uint32_t size_x, uint32_t size_y, uint32_t size_z);
+
+		/**
+		 * @brief Constructs an empty grid covering a box; see VoxelGrid for the parameters.
+		 */
+		SparseVoxelGrid(const BoundingBox &bounds, float voxel_size);
+
+		/**
+		 * @brief Sets the voxels touched by a triangle mesh; see VoxelGrid::Voxelize.
+		 */
+		void Voxelize(const Vec3 *vertices, const uint32_t *indices, size_t triangle_count, const VoxelizeSettings &settings = {});
+
+		/**
+		 * @brief Removes every brick.
+		 */
+		void Clear();
+
+		/**
+		 * @brief Gets a voxel.
+		 * @return True if the voxel is set.
+		 */
+		[[nodiscard]] bool Get(uint32_t x, uint32_t y, uint32_t z) const;
+
+		/**
+		 * @brief Counts the set voxels.
+		 * @return The number of set voxels.
+		 */
+		[[nodiscard]] size_t CountSet() const;
+
+		/**
+		 * @brief Gets the number of stored (non-empty) bricks.
+		 */
+		[[nodiscard]] size_t GetBrickCount() const { return m_Masks.size(); }
+
+		/**
+		 * @brief Gets a stored brick.
+		 * @param index The brick index, below GetBrickCount().
+		 */
+		[[nodiscard]] Brick GetBrick(size_t index) const;
+
+		/**
+		 * @brief Gets the box covered by a voxel.
+		 */
+		[[nodiscard]] BoundingBox GetVoxelBounds(uint32_t x, uint32_t y, uint32_t z) const;
+
+		[[nodiscard]] const Vec3 &GetOrigin() const { return m_Origin; }
+		[[nodiscard]] float GetVoxelSize() const { return m_VoxelSize; }
+		[[nodiscard]] uint32_t GetSizeX() const { return m_SizeX; }
+		[[nodiscard]] uint32_t GetSizeY() const { return m_SizeY; }
+		[[nodiscard]] uint32_t GetSizeZ() const { return m_SizeZ; }
+
+	private:
+		[[nodiscard]] uint64_t GetKey(uint32_t brick_x, uint32_t brick_y, uint32_t brick_z) const;
+
+		Vec3 m_Origin;
+		float m_VoxelSize;
+		uint32_t m_SizeX;
+		uint32_t m_SizeY;
+		uint32_t m_SizeZ;
+		std::vector<uint64_t> m_Keys;  // Sorted brick keys, (z * bricks_y + y) * bricks_x + x
+		std::vector<uint64_t> m_Masks; // Voxel mask per key
+	};
+}
+
+/// -------------------------------------------------------
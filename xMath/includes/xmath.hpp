@@ -75,56 +75,53 @@
 #define XMATH_COORD_DEFINED 1
 #endif
 
-// Matrix storage order configuration
-// Provide numeric constants for conditional compilation. Users may set
-// XMATH_MATRIX_ORDER to either MATRIX_ROW_MAJOR or MATRIX_COLUMN_MAJOR before
-// including this header. Default is row-major.
-#ifndef MATRIX_ROW_MAJOR
-#define MATRIX_ROW_MAJOR 0
-#endif
-
-#ifndef MATRIX_COLUMN_MAJOR
-#define MATRIX_COLUMN_MAJOR 1
-#endif
-
-#ifndef XMATH_MATRIX_ORDER
-#define XMATH_MATRIX_ORDER MATRIX_ROW_MAJOR
-#endif
-
-#if XMATH_MATRIX_ORDER == MATRIX_ROW_MAJOR
-#define XMATH_MATRIX_IS_ROW_MAJOR 1
-#define XMATH_MATRIX_IS_COLUMN_MAJOR 0
-#else
-#define XMATH_MATRIX_IS_ROW_MAJOR 0
-#define XMATH_MATRIX_IS_COLUMN_MAJOR 1
-#endif
-
 ///////////////////////////////////////////////////////////
 ///					INCLUDE UMBRELLA 					///
 ///////////////////////////////////////////////////////////
 
 // Order matters: vector types must be available before dot/epsilon overloads.
+#include <xMath/includes/atlas_packer.h>
 #include <xMath/includes/bounding_box.h>
+#include <xMath/includes/bvh.h>
+#include <xMath/includes/clipping.h>
+#include <xMath/includes/closest_point.h>
 #include <xMath/includes/constants.h>
+#include <xMath/includes/convex_hull.h>
 #include <xMath/includes/vector.h>
+#include <xMath/includes/dirty_region.h>
 // ReSharper disable once CppWrongIncludesOrder
 #include <xMath/includes/epsilon.h>
 //#include <xMath/includes/dot.h> // Dot was removed and placed into math_util.h
 #include <xMath/includes/frustum.h>
+#include <xMath/includes/gjk.h>
+#include <xMath/includes/kd_tree.h>
 #include <xMath/includes/mat2.h>
 #include <xMath/includes/mat3.h>
 #include <xMath/includes/mat4.h>
 #include <xMath/includes/math_utils.h>
 #include <xMath/includes/matrix.h>
+#include <xMath/includes/multi_frustum.h>
+#include <xMath/includes/occlusion_buffer.h>
+#include <xMath/includes/octree.h>
+#include <xMath/includes/oriented_bounding_box.h>
+#include <xMath/includes/packed_rtree.h>
 #include <xMath/includes/plane.h>
+#include <xMath/includes/projected_bounds.h>
 #include <xMath/includes/projection.h>
+#include <xMath/includes/quadtree.h>
 #include <xMath/includes/quat.h>
+#include <xMath/includes/ray.h>
 #include <xMath/includes/rectangle.h>
 #include <xMath/includes/rotation.h>
 #include <xMath/includes/scale.h>
+#include <xMath/includes/shadow_cascades.h>
+#include <xMath/includes/soa.h>
+#include <xMath/includes/spatial_hash_grid.h>
 #include <xMath/includes/sphere.h>
+#include <xMath/includes/sweep_and_prune.h>
 #include <xMath/includes/transforms.h>
 #include <xMath/includes/translate.h>
+#include <xMath/includes/voxelizer.h>
 
 // Legacy forwarding namespace (kept for backward compatibility with previous API usage)
 namespace xMath::Utils
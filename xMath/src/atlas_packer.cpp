@@ -0,0 +1,299 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* atlas_packer.cpp
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <numeric>
+#include <xmath.hpp>
+#include <xMath/includes/atlas_packer.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	AtlasPacker::AtlasPacker(const uint32_t width, const uint32_t height, const AtlasHeuristic heuristic, const uint32_t padding) :
+	    m_Width(width), m_Height(height), m_Heuristic(heuristic), m_Padding(padding)
+	{
+	    assert(width > 0 && height > 0);
+	    Clear();
+	}
+
+	void AtlasPacker::Clear()
+	{
+	    // Padding trails every item, so the last row and column may keep theirs outside the atlas
+	    const int32_t width = static_cast<int32_t>(m_Width + m_Padding);
+	    const int32_t height = static_cast<int32_t>(m_Height + m_Padding);
+
+	    m_UsedArea = 0;
+	    m_Skyline.clear();
+	    m_FreeAreas.clear();
+	    m_NewFreeAreas.clear();
+	    if (m_Heuristic == AtlasHeuristic::Skyline)
+	        m_Skyline.push_back({ 0, 0, width });
+	    else
+	        m_FreeAreas.push_back({ 0, 0, width, height });
+	}
+
+	float AtlasPacker::GetOccupancy() const
+	{
+	    const double area = static_cast<double>(m_Width) * static_cast<double>(m_Height);
+	    return static_cast<float>(std::min(static_cast<double>(m_UsedArea) / area, 1.0));
+	}
+
+	bool AtlasPacker::InsertSkyline(const int32_t width, const int32_t height, int32_t &x, int32_t &y)
+	{
+	    const int32_t atlas_width = static_cast<int32_t>(m_Width + m_Padding);
+	    const int32_t atlas_height = static_cast<int32_t>(m_Height + m_Padding);
+
+	    // Bottom-left rule: lowest resulting bottom edge, then the narrowest run to limit waste
+	    size_t best = m_Skyline.size();
+	    int32_t best_bottom = INT_MAX, best_width = INT_MAX, best_y = 0;
+	    for (size_t i = 0; i < m_Skyline.size(); i++)
+	    {
+	        const int32_t left = m_Skyline[i].x;
+	        if (left + width > atlas_width)
+	            break;
+
+	        int32_t top = 0;
+	        int32_t remaining = width;
+	        for (size_t j = i; remaining > 0; j++)
+	        {
+	            top = std::max(top, m_Skyline[j].y);
+	            remaining -= m_Skyline[j].width;
+	        }
+
+	        const int32_t bottom = top + height;
+	        if (bottom > atlas_height)
+	            continue;
+
+	        if (bottom < best_bottom || (bottom == best_bottom && m_Skyline[i].width < best_width))
+	        {
+	            best = i;
+	            best_bottom = bottom;
+	            best_width = m_Skyline[i].width;
+	            best_y = top;
+	        }
+	    }
+
+	    if (best == m_Skyline.size())
+	        return false;
+
+	    x = m_Skyline[best].x;
+	    y = best_y;
+
+	    // The new run covers [x, x + width); shorten or drop the runs it hides
+	    m_Skyline.insert(m_Skyline.begin() + static_cast<std::ptrdiff_t>(best), { x, best_bottom, width });
+	    const int32_t right = x + width;
+	    size_t next = best + 1;
+	    while (next < m_Skyline.size() && m_Skyline[next].x < right)
+	    {
+	        Span &span = m_Skyline[next];
+	        const int32_t shrink = right - span.x;
+	        if (shrink >= span.width)
+	        {
+	            m_Skyline.erase(m_Skyline.begin() + static_cast<std::ptrdiff_t>(next));
+	            continue;
+	        }
+	        span.x += shrink;
+	        span.width -= shrink;
+	        break;
+	    }
+
+	    // Merge neighbouring runs of equal height
+	    for (size_t i = 0; i + 1 < m_Skyline.size();)
+	    {
+	        if (m_Skyline[i].y == m_Skyline[i + 1].y)
+	        {
+	            m_Skyline[i].width += m_Skyline[i + 1].width;
+	            m_Skyline.erase(m_Skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+	        }
+	        else
+	        {
+	            i++;
+	        }
+	    }
+	    return true;
+	}
+
+	bool AtlasPacker::InsertMaxRects(const int32_t width, const int32_t height, int32_t &x, int32_t &y)
+	{
+	    // Best short side fit: the free rectangle leaving the smallest leftover on its shorter side
+	    size_t best = m_FreeAreas.size();
+	    int32_t best_short = INT_MAX, best_long = INT_MAX;
+	    for (size_t i = 0; i < m_FreeAreas.size(); i++)
+	    {
+	        const Area &area = m_FreeAreas[i];
+	        if (area.width < width || area.height < height)
+	            continue;
+
+	        const int32_t leftover_x = area.width - width;
+	        const int32_t leftover_y = area.height - height;
+	        const int32_t short_side = std::min(leftover_x, leftover_y);
+	        const int32_t long_side = std::max(leftover_x, leftover_y);
+	        if (short_side < best_short || (short_side == best_short && long_side < best_long))
+	        {
+	            best = i;
+	            best_short = short_side;
+	            best_long = long_side;
+	        }
+	    }
+
+	    if (best == m_FreeAreas.size())
+	        return false;
+
+	    x = m_FreeAreas[best].x;
+	    y = m_FreeAreas[best].y;
+	    SplitFreeAreas({ x, y, width, height });
+	    PruneFreeAreas();
+	    return true;
+	}
+
+	void AtlasPacker::SplitFreeAreas(const Area &used)
+	{
+	    m_NewFreeAreas.clear();
+	    for (size_t i = 0; i < m_FreeAreas.size();)
+	    {
+	        const Area area = m_FreeAreas[i];
+	        if (used.x >= area.x + area.width || used.x + used.width <= area.x || used.y >= area.y + area.height || used.y + used.height <= area.y)
+	        {
+	            i++;
+	            continue;
+	        }
+
+	        // Up to four maximal pieces of the free rectangle around the used one
+	        if (used.x > area.x)
+	            m_NewFreeAreas.push_back({ area.x, area.y, used.x - area.x, area.height });
+	        if (used.x + used.width < area.x + area.width)
+	            m_NewFreeAreas.push_back({ used.x + used.width, area.y, area.x + area.width - used.x - used.width, area.height });
+	        if (used.y > area.y)
+	            m_NewFreeAreas.push_back({ area.x, area.y, area.width, used.y - area.y });
+	        if (used.y + used.height < area.y + area.height)
+	            m_NewFreeAreas.push_back({ area.x, used.y + used.height, area.width, area.y + area.height - used.y - used.height });
+
+	        m_FreeAreas[i] = m_FreeAreas.back();
+	        m_FreeAreas.pop_back();
+	    }
+	}
+
+	void AtlasPacker::PruneFreeAreas()
+	{
+	    const auto contains = [](const Area &outer, const Area &inner)
+	    {
+	        return inner.x >= outer.x && inner.y >= outer.y && inner.x + inner.width <= outer.x + outer.width && inner.y + inner.height <= outer.y + outer.height;
+	    };
+
+	    // The untouched free rectangles were already maximal; only the new pieces can be redundant
+	    std::vector<Area> &pieces = m_NewFreeAreas;
+	    for (size_t i = 0; i < pieces.size();)
+	    {
+	        bool redundant = false;
+	        for (size_t j = 0; j < pieces.size() && !redundant; j++)
+	            redundant = j != i && contains(pieces[j], pieces[i]) && (!contains(pieces[i], pieces[j]) || j < i);
+	        for (size_t j = 0; j < m_FreeAreas.size() && !redundant; j++)
+	            redundant = contains(m_FreeAreas[j], pieces[i]);
+
+	        if (redundant)
+	        {
+	            pieces[i] = pieces.back();
+	            pieces.pop_back();
+	        }
+	        else
+	        {
+	            i++;
+	        }
+	    }
+
+	    m_FreeAreas.insert(m_FreeAreas.end(), pieces.begin(), pieces.end());
+	}
+
+	bool AtlasPacker::Insert(const uint32_t width, const uint32_t height, Rectangle &placement)
+	{
+	    if (width == 0 || height == 0)
+	    {
+	        placement = Rectangle(0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height));
+	        return true;
+	    }
+
+	    const int32_t padded_width = static_cast<int32_t>(width + m_Padding);
+	    const int32_t padded_height = static_cast<int32_t>(height + m_Padding);
+
+	    int32_t x = 0, y = 0;
+	    const bool placed = m_Heuristic == AtlasHeuristic::Skyline ? InsertSkyline(padded_width, padded_height, x, y) : InsertMaxRects(padded_width, padded_height, x, y);
+	    if (!placed)
+	        return false;
+
+	    m_UsedArea += static_cast<uint64_t>(padded_width) * static_cast<uint64_t>(padded_height);
+	    placement = Rectangle(static_cast<float>(x), static_cast<float>(y), static_cast<float>(width), static_cast<float>(height));
+	    return true;
+	}
+
+	size_t AtlasPacker::InsertBatch(Rectangle *rects, const size_t count)
+	{
+	    assert(rects != nullptr || count == 0);
+
+	    // Skyline packs best by decreasing height, MaxRects by decreasing longer side
+	    std::vector<uint32_t> order(count);
+	    std::iota(order.begin(), order.end(), 0u);
+	    if (m_Heuristic == AtlasHeuristic::Skyline)
+	    {
+	        std::sort(order.begin(), order.end(), [rects](const uint32_t a, const uint32_t b)
+	        {
+	            return rects[a].height != rects[b].height ? rects[a].height > rects[b].height : rects[a].width > rects[b].width;
+	        });
+	    }
+	    else
+	    {
+	        std::sort(order.begin(), order.end(), [rects](const uint32_t a, const uint32_t b)
+	        {
+	            const float long_a = std::max(rects[a].width, rects[a].height), long_b = std::max(rects[b].width, rects[b].height);
+	            return long_a != long_b ? long_a > long_b : std::min(rects[a].width, rects[a].height) > std::min(rects[b].width, rects[b].height);
+	        });
+	    }
+
+	    size_t placed = 0;
+	    for (const uint32_t index : order)
+	    {
+	        Rectangle &rect = rects[index];
+	        Rectangle placement;
+	        if (Insert(static_cast<uint32_t>(rect.width), static_cast<uint32_t>(rect.height), placement))
+	        {
+	            rect.x = placement.x;
+	            rect.y = placement.y;
+	            placed++;
+	        }
+	        else
+	        {
+	            rect.x = -1.0f;
+	            rect.y = -1.0f;
+	        }
+	    }
+	    return placed;
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,1304 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* bvh.cpp
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <functional>
+#include <future>
+#include <limits>
+#include <queue>
+#include <thread>
+#include <xmath.hpp>
+#include <xMath/includes/bvh.h>
+#include "parallel_for.h"
+
+/// -------------------------------------------------------
+
+namespace xMath
+{
+	namespace
+	{
+	    constexpr float FLOAT_MAX = std::numeric_limits<float>::max();
+	    // Builds stop splitting at BVH::MAX_DEPTH and Optimize never rotates past it, so the
+	    // traversal stacks (at most one entry per level) cannot overflow
+	    constexpr uint32_t STACK_SIZE = 128;
+	    constexpr uint32_t MAX_BINS = 32;
+
+	    struct Aabb
+	    {
+	        float min[3] = { FLOAT_MAX, FLOAT_MAX, FLOAT_MAX };
+	        float max[3] = { -FLOAT_MAX, -FLOAT_MAX, -FLOAT_MAX };
+
+	        void Grow(const Aabb &other)
+	        {
+	            for (int a = 0; a < 3; a++)
+	            {
+	                min[a] = std::min(min[a], other.min[a]);
+	                max[a] = std::max(max[a], other.max[a]);
+	            }
+	        }
+
+	        void Grow(const float *point)
+	        {
+	            for (int a = 0; a < 3; a++)
+	            {
+	                min[a] = std::min(min[a], point[a]);
+	                max[a] = std::max(max[a], point[a]);
+	            }
+	        }
+
+	        // Half of the surface area; the SAH only compares ratios
+	        [[nodiscard]] float HalfArea() const
+	        {
+	            const float dx = max[0] - min[0], dy = max[1] - min[1], dz = max[2] - min[2];
+	            return dx < 0.0f ? 0.0f : dx * dy + dy * dz + dz * dx;
+	        }
+	    };
+
+	    struct BuildNode
+	    {
+	        Aabb bounds;
+	        uint32_t left = 0;
+	        uint32_t right = 0;
+	        uint32_t first = 0;
+	        uint32_t count = 0; // > 0 for leaves
+	    };
+
+	    class Builder
+	    {
+	    public:
+	        Builder(const BoundingBox *boxes, const size_t count, const BVHBuildSettings &settings, uint32_t *indices, const uint32_t max_depth)
+	            : m_Settings(settings), m_Indices(indices), m_MaxDepth(max_depth)
+	        {
+	            m_Bounds.resize(count);
+	            m_Centroids.resize(count * 3);
+	            for (size_t i = 0; i < count; i++)
+	            {
+	                const Vec3 &min = boxes[i].GetMin();
+	                const Vec3 &max = boxes[i].GetMax();
+	                m_Bounds[i].min[0] = min.x; m_Bounds[i].min[1] = min.y; m_Bounds[i].min[2] = min.z;
+	                m_Bounds[i].max[0] = max.x; m_Bounds[i].max[1] = max.y; m_Bounds[i].max[2] = max.z;
+	                m_Centroids[i * 3 + 0] = (min.x + max.x) * 0.5f;
+	                m_Centroids[i * 3 + 1] = (min.y + max.y) * 0.5f;
+	                m_Centroids[i * 3 + 2] = (min.z + max.z) * 0.5f;
+	            }
+
+	            // A binary tree with count leaves has at most 2 * count - 1 nodes
+	            m_Nodes.resize(std::max<size_t>(count * 2, 1));
+	            m_Settings.bin_count = std::clamp(m_Settings.bin_count, 2u, MAX_BINS);
+	            m_Settings.max_leaf_size = std::max(m_Settings.max_leaf_size, 1u);
+
+	            uint32_t threads = m_Settings.thread_count ? m_Settings.thread_count : std::thread::hardware_concurrency();
+	            while (threads > 1)
+	            {
+	                m_SpawnDepth++;
+	                threads >>= 1;
+	            }
+	        }
+
+	        uint32_t Build(const uint32_t begin, const uint32_t end, const uint32_t depth)
+	        {
+	            const uint32_t node_index = m_NodeCount.fetch_add(1, std::memory_order_relaxed);
+	            BuildNode &node = m_Nodes[node_index];
+
+	            Aabb centroid_bounds;
+	            for (uint32_t i = begin; i < end; i++)
+	            {
+	                node.bounds.Grow(m_Bounds[m_Indices[i]]);
+	                centroid_bounds.Grow(&m_Centroids[m_Indices[i] * 3]);
+	            }
+
+	            const uint32_t count = end - begin;
+	            if (count <= m_Settings.max_leaf_size || depth >= m_MaxDepth)
+	            {
+	                node.first = begin;
+	                node.count = count;
+	                return node_index;
+	            }
+
+	            uint32_t mid = Partition(begin, end, centroid_bounds);
+	            if (mid == begin || mid == end)
+	            {
+	                // All centroids fell in one bin (or coincide): median split on the widest axis
+	                int axis = 0;
+	                for (int a = 1; a < 3; a++)
+	                {
+	                    if (centroid_bounds.max[a] - centroid_bounds.min[a] > centroid_bounds.max[axis] - centroid_bounds.min[axis])
+	                        axis = a;
+	                }
+
+	                mid = begin + count / 2;
+	                std::nth_element(m_Indices + begin, m_Indices + mid, m_Indices + end, [&](const uint32_t a, const uint32_t b)
+	                {
+	                    return m_Centroids[a * 3 + axis] < m_Centroids[b * 3 + axis];
+	                });
+	            }
+
+	            uint32_t left, right;
+	            if (count >= m_Settings.parallel_threshold && depth < m_SpawnDepth)
+	            {
+	                std::future<uint32_t> left_task = std::async(std::launch::async, [this, begin, mid, depth] { return Build(begin, mid, depth + 1); });
+	                right = Build(mid, end, depth + 1);
+	                left = left_task.get();
+	            }
+	            else
+	            {
+	                left = Build(begin, mid, depth + 1);
+	                right = Build(mid, end, depth + 1);
+	            }
+
+	            node.left = left;
+	            node.right = right;
+	            return node_index;
+	        }
+
+	        [[nodiscard]] const BuildNode &GetNode(const uint32_t index) const { return m_Nodes[index]; }
+
+	    private:
+	        // Binned SAH split; returns the partition point in [begin, end]
+	        uint32_t Partition(const uint32_t begin, const uint32_t end, const Aabb &centroid_bounds)
+	        {
+	            const uint32_t bins = m_Settings.bin_count;
+
+	            float best_cost = FLOAT_MAX;
+	            int best_axis = -1;
+	            uint32_t best_bin = 0;
+
+	            for (int axis = 0; axis < 3; axis++)
+	            {
+	                const float extent = centroid_bounds.max[axis] - centroid_bounds.min[axis];
+	                if (extent <= 1e-12f)
+	                    continue;
+
+	                Aabb bin_bounds[MAX_BINS];
+	                uint32_t bin_count[MAX_BINS] = {};
+	                const float scale = static_cast<float>(bins) / extent;
+
+	                for (uint32_t i = begin; i < end; i++)
+	                {
+	                    const uint32_t prim = m_Indices[i];
+	                    const uint32_t bin = std::min(bins - 1, static_cast<uint32_t>((m_Centroids[prim * 3 + axis] - centroid_bounds.min[axis]) * scale));
+	                    bin_bounds[bin].Grow(m_Bounds[prim]);
+	                    bin_count[bin]++;
+	                }
+
+	                // Sweep from the right to get the cost of everything right of each split
+	                float right_area[MAX_BINS];
+	                uint32_t right_count[MAX_BINS];
+	                Aabb right_bounds;
+	                uint32_t right_total = 0;
+	                for (uint32_t b = bins - 1; b > 0; b--)
+	                {
+	                    right_bounds.Grow(bin_bounds[b]);
+	                    right_total += bin_count[b];
+	                    right_area[b] = right_bounds.HalfArea();
+	                    right_count[b] = right_total;
+	                }
+
+	                Aabb left_bounds;
+	                uint32_t left_total = 0;
+	                for (uint32_t b = 0; b < bins - 1; b++)
+	                {
+	                    left_bounds.Grow(bin_bounds[b]);
+	                    left_total += bin_count[b];
+
+	                    const float cost = left_bounds.HalfArea() * static_cast<float>(left_total) + right_area[b + 1] * static_cast<float>(right_count[b + 1]);
+	                    if (left_total > 0 && right_count[b + 1] > 0 && cost < best_cost)
+	                    {
+	                        best_cost = cost;
+	                        best_axis = axis;
+	                        best_bin = b;
+	                    }
+	                }
+	            }
+
+	            if (best_axis < 0)
+	                return begin;
+
+	            const float min = centroid_bounds.min[best_axis];
+	            const float scale = static_cast<float>(bins) / (centroid_bounds.max[best_axis] - min);
+	            const uint32_t *split = std::partition(m_Indices + begin, m_Indices + end, [&](const uint32_t prim)
+	            {
+	                return std::min(bins - 1, static_cast<uint32_t>((m_Centroids[prim * 3 + best_axis] - min) * scale)) <= best_bin;
+	            });
+
+	            return static_cast<uint32_t>(split - m_Indices);
+	        }
+
+	        BVHBuildSettings m_Settings;
+	        uint32_t *m_Indices;
+	        uint32_t m_MaxDepth;
+	        uint32_t m_SpawnDepth = 0;
+	        std::vector<Aabb> m_Bounds;
+	        std::vector<float> m_Centroids;
+	        std::vector<BuildNode> m_Nodes;
+	        std::atomic<uint32_t> m_NodeCount{0};
+	    };
+
+	    // Spreads the low 10 bits of value so there are two zero bits between each
+	    uint32_t ExpandBits(uint32_t value)
+	    {
+	        value = (value * 0x00010001u) & 0xFF0000FFu;
+	        value = (value * 0x00000101u) & 0x0F00F00Fu;
+	        value = (value * 0x00000011u) & 0xC30C30C3u;
+	        value = (value * 0x00000005u) & 0x49249249u;
+	        return value;
+	    }
+
+	    // Linear BVH (Karras, "Maximizing Parallelism in the Construction of BVHs, Octrees, and k-d Trees").
+	    // Inner nodes are [0, count - 1) and the leaf of sorted primitive i is count - 1 + i; leaves are
+	    // not stored but made from the primitive bounds on demand.
+	    class LinearBuilder
+	    {
+	    public:
+	        LinearBuilder(const BoundingBox *boxes, const size_t count, const BVHBuildSettings &settings, uint32_t *indices)
+	            : m_Boxes(boxes), m_Indices(indices), m_Count(static_cast<uint32_t>(count)), m_MaxLeafSize(std::max(settings.max_leaf_size, 1u))
+	        {
+	            const uint32_t threads = settings.thread_count ? settings.thread_count : std::max(std::thread::hardware_concurrency(), 1u);
+	            m_ChunkSize = threads <= 1 || count < settings.parallel_threshold ? std::max<size_t>(count, 1) : (count + threads - 1) / threads;
+	            m_Nodes.resize(count - 1);
+	            m_Parents.resize(count * 2 - 1);
+	        }
+
+	        uint32_t Build()
+	        {
+	            ComputeCodes();
+	            SortCodes();
+
+	            // Inner nodes only depend on the sorted codes, so each is emitted independently
+	            m_Parents[0] = BVHNode::INVALID_INDEX;
+	            detail::ParallelFor(m_Count - 1, m_ChunkSize, [this](size_t, const size_t begin, const size_t end)
+	            {
+	                for (size_t i = begin; i < end; i++)
+	                    EmitNode(static_cast<int32_t>(i));
+	            });
+
+	            ComputeBounds();
+	            return 0;
+	        }
+
+	        [[nodiscard]] BuildNode GetNode(const uint32_t index) const
+	        {
+	            if (index < m_Count - 1)
+	                return m_Nodes[index];
+
+	            BuildNode leaf;
+	            leaf.bounds = GetLeafBounds(index - (m_Count - 1));
+	            leaf.first = index - (m_Count - 1);
+	            leaf.count = 1;
+	            return leaf;
+	        }
+
+	    private:
+	        [[nodiscard]] Aabb GetLeafBounds(const uint32_t position) const
+	        {
+	            const BoundingBox &box = m_Boxes[m_Indices[position]];
+	            const Vec3 &min = box.GetMin();
+	            const Vec3 &max = box.GetMax();
+	            Aabb bounds;
+	            bounds.min[0] = min.x; bounds.min[1] = min.y; bounds.min[2] = min.z;
+	            bounds.max[0] = max.x; bounds.max[1] = max.y; bounds.max[2] = max.z;
+	            return bounds;
+	        }
+
+	        [[nodiscard]] Aabb GetBounds(const uint32_t index) const
+	        {
+	            return index < m_Count - 1 ? m_Nodes[index].bounds : GetLeafBounds(index - (m_Count - 1));
+	        }
+
+	        void ComputeCodes()
+	        {
+	            Aabb centroid_bounds;
+	            for (uint32_t i = 0; i < m_Count; i++)
+	            {
+	                const Vec3 center = m_Boxes[i].GetCenter();
+	                const float point[3] = { center.x, center.y, center.z };
+	                centroid_bounds.Grow(point);
+	            }
+
+	            float offset[3], scale[3];
+	            for (int a = 0; a < 3; a++)
+	            {
+	                const float extent = centroid_bounds.max[a] - centroid_bounds.min[a];
+	                offset[a] = centroid_bounds.min[a];
+	                scale[a] = extent > 0.0f ? 1023.0f / extent : 0.0f;
+	            }
+
+	            m_Codes.resize(m_Count);
+	            detail::ParallelFor(m_Count, m_ChunkSize, [&](size_t, const size_t begin, const size_t end)
+	            {
+	                for (size_t i = begin; i < end; i++)
+	                {
+	                    const Vec3 center = m_Boxes[i].GetCenter();
+	                    const uint32_t x = static_cast<uint32_t>((center.x - offset[0]) * scale[0]);
+	                    const uint32_t y = static_cast<uint32_t>((center.y - offset[1]) * scale[1]);
+	                    const uint32_t z = static_cast<uint32_t>((center.z - offset[2]) * scale[2]);
+	                    m_Codes[i] = ExpandBits(x) << 2 | ExpandBits(y) << 1 | ExpandBits(z);
+	                    m_Indices[i] = static_cast<uint32_t>(i);
+	                }
+	            });
+	        }
+
+	        // Stable LSD radix sort of (code, index) pairs, three 11-bit digits covering the 30-bit codes
+	        void SortCodes()
+	        {
+	            constexpr uint32_t DIGIT_BITS = 11;
+	            constexpr uint32_t RADIX = 1u << DIGIT_BITS;
+
+	            const size_t chunk_count = (m_Count + m_ChunkSize - 1) / m_ChunkSize;
+	            std::vector<uint32_t> histograms(chunk_count * RADIX);
+	            std::vector<uint32_t> codes(m_Count), indices(m_Count);
+	            uint32_t *source_codes = m_Codes.data(), *source_indices = m_Indices;
+	            uint32_t *target_codes = codes.data(), *target_indices = indices.data();
+
+	            for (uint32_t shift = 0; shift < 30; shift += DIGIT_BITS)
+	            {
+	                std::fill(histograms.begin(), histograms.end(), 0u);
+	                detail::ParallelFor(m_Count, m_ChunkSize, [&](const size_t chunk, const size_t begin, const size_t end)
+	                {
+	                    uint32_t *histogram = &histograms[chunk * RADIX];
+	                    for (size_t i = begin; i < end; i++)
+	                        histogram[(source_codes[i] >> shift) & (RADIX - 1)]++;
+	                });
+
+	                // Digit-major prefix sum: each chunk scatters after the earlier chunks with the same digit
+	                uint32_t offset = 0;
+	                for (uint32_t digit = 0; digit < RADIX; digit++)
+	                {
+	                    for (size_t chunk = 0; chunk < chunk_count; chunk++)
+	                    {
+	                        const uint32_t bucket = histograms[chunk * RADIX + digit];
+	                        histograms[chunk * RADIX + digit] = offset;
+	                        offset += bucket;
+	                    }
+	                }
+
+	                detail::ParallelFor(m_Count, m_ChunkSize, [&](const size_t chunk, const size_t begin, const size_t end)
+	                {
+	                    uint32_t *positions = &histograms[chunk * RADIX];
+	                    for (size_t i = begin; i < end; i++)
+	                    {
+	                        const uint32_t position = positions[(source_codes[i] >> shift) & (RADIX - 1)]++;
+	                        target_codes[position] = source_codes[i];
+	                        target_indices[position] = source_indices[i];
+	                    }
+	                });
+
+	                std::swap(source_codes, target_codes);
+	                std::swap(source_indices, target_indices);
+	            }
+
+	            // An odd number of passes leaves the result in the scratch arrays
+	            std::copy(source_codes, source_codes + m_Count, m_Codes.data());
+	            std::copy(source_indices, source_indices + m_Count, m_Indices);
+	        }
+
+	        // Length of the common prefix of the keys at i and j; equal codes are told apart by position
+	        [[nodiscard]] int32_t CommonPrefix(const int32_t i, const int32_t j) const
+	        {
+	            if (j < 0 || j >= static_cast<int32_t>(m_Count))
+	                return -1;
+
+	            const uint32_t a = m_Codes[i], b = m_Codes[j];
+	            if (a != b)
+	                return std::countl_zero(a ^ b);
+	            return 32 + std::countl_zero(static_cast<uint32_t>(i) ^ static_cast<uint32_t>(j));
+	        }
+
+	        void EmitNode(const int32_t i)
+	        {
+	            // Direction of the range: towards the neighbor sharing the longer prefix
+	            const int32_t d = CommonPrefix(i, i + 1) > CommonPrefix(i, i - 1) ? 1 : -1;
+	            const int32_t min_prefix = CommonPrefix(i, i - d);
+
+	            // Find the other end with an exponential then a binary search
+	            int32_t max_length = 2;
+	            while (CommonPrefix(i, i + max_length * d) > min_prefix)
+	                max_length *= 2;
+
+	            int32_t length = 0;
+	            for (int32_t step = max_length / 2; step >= 1; step /= 2)
+	            {
+	                if (CommonPrefix(i, i + (length + step) * d) > min_prefix)
+	                    length += step;
+	            }
+	            const int32_t j = i + length * d;
+
+	            // Find the split: the last position sharing more than the node prefix with i
+	            const int32_t node_prefix = CommonPrefix(i, j);
+	            int32_t split = 0;
+	            for (int32_t divisor = 2, step = length; step > 1; divisor *= 2)
+	            {
+	                step = (length + divisor - 1) / divisor;
+	                if (CommonPrefix(i, i + (split + step) * d) > node_prefix)
+	                    split += step;
+	            }
+	            const int32_t gamma = i + split * d + std::min(d, 0);
+
+	            const uint32_t first = static_cast<uint32_t>(std::min(i, j)), last = static_cast<uint32_t>(std::max(i, j));
+	            const uint32_t leaf_base = m_Count - 1;
+	            BuildNode &node = m_Nodes[i];
+	            node.left = first == static_cast<uint32_t>(gamma) ? leaf_base + gamma : gamma;
+	            node.right = last == static_cast<uint32_t>(gamma) + 1 ? leaf_base + gamma + 1 : gamma + 1;
+	            m_Parents[node.left] = static_cast<uint32_t>(i);
+	            m_Parents[node.right] = static_cast<uint32_t>(i);
+
+	            // Small subtrees become one leaf over their contiguous range
+	            node.first = first;
+	            node.count = last - first + 1 <= m_MaxLeafSize ? last - first + 1 : 0;
+	        }
+
+	        void ComputeBounds()
+	        {
+	            // Bottom up from every leaf; the second child to arrive at a node merges both
+	            std::vector<std::atomic<uint32_t>> visits(m_Count - 1);
+	            detail::ParallelFor(m_Count, m_ChunkSize, [&](size_t, const size_t begin, const size_t end)
+	            {
+	                for (size_t i = begin; i < end; i++)
+	                {
+	                    for (uint32_t node = m_Parents[m_Count - 1 + i]; node != BVHNode::INVALID_INDEX; node = m_Parents[node])
+	                    {
+	                        if (visits[node].fetch_add(1, std::memory_order_acq_rel) == 0)
+	                            break;
+
+	                        Aabb bounds = GetBounds(m_Nodes[node].left);
+	                        bounds.Grow(GetBounds(m_Nodes[node].right));
+	                        m_Nodes[node].bounds = bounds;
+	                    }
+	                }
+	            });
+	        }
+
+	        const BoundingBox *m_Boxes;
+	        uint32_t *m_Indices;
+	        uint32_t m_Count;
+	        uint32_t m_MaxLeafSize;
+	        size_t m_ChunkSize = 1;
+	        std::vector<uint32_t> m_Codes;
+	        std::vector<BuildNode> m_Nodes;
+	        std::vector<uint32_t> m_Parents;
+	    };
+
+	    void SetChildBounds(BVHNode &node, const uint32_t c, const Aabb &bounds)
+	    {
+	        node.min_x[c] = bounds.min[0]; node.min_y[c] = bounds.min[1]; node.min_z[c] = bounds.min[2];
+	        node.max_x[c] = bounds.max[0]; node.max_y[c] = bounds.max[1]; node.max_z[c] = bounds.max[2];
+	    }
+
+	    template <typename TreeBuilder>
+	    uint32_t Flatten(const TreeBuilder &builder, const uint32_t build_index, std::vector<BVHNode> &nodes)
+	    {
+	        const uint32_t node_index = static_cast<uint32_t>(nodes.size());
+	        nodes.emplace_back();
+
+	        const BuildNode &build_node = builder.GetNode(build_index);
+	        const uint32_t children[2] = { build_node.left, build_node.right };
+
+	        for (uint32_t c = 0; c < 2; c++)
+	        {
+	            const BuildNode &child = builder.GetNode(children[c]);
+	            SetChildBounds(nodes[node_index], c, child.bounds);
+
+	            if (child.count > 0)
+	            {
+	                nodes[node_index].child[c] = child.first;
+	                nodes[node_index].count[c] = child.count;
+	            }
+	            else
+	            {
+	                // Depth first: the recursion may grow the vector, so store through the index afterwards
+	                const uint32_t child_index = Flatten(builder, children[c], nodes);
+	                nodes[node_index].child[c] = child_index;
+	                nodes[node_index].count[c] = 0;
+	            }
+	        }
+
+	        return node_index;
+	    }
+
+	    template <typename TreeBuilder>
+	    void EmitNodes(const TreeBuilder &builder, const uint32_t root, std::vector<BVHNode> &nodes)
+	    {
+	        const BuildNode &root_node = builder.GetNode(root);
+	        if (root_node.count == 0)
+	        {
+	            Flatten(builder, root, nodes);
+	            return;
+	        }
+
+	        // Single leaf: wrap it in a root with an empty second slot
+	        BVHNode &node = nodes.emplace_back();
+	        SetChildBounds(node, 0, root_node.bounds);
+	        SetChildBounds(node, 1, Aabb());
+	        node.child[0] = root_node.first;
+	        node.count[0] = root_node.count;
+	        node.child[1] = BVHNode::INVALID_INDEX;
+	        node.count[1] = 0;
+	    }
+
+	    Aabb GetChildBounds(const BVHNode &node, const uint32_t c)
+	    {
+	        Aabb bounds;
+	        bounds.min[0] = node.min_x[c]; bounds.min[1] = node.min_y[c]; bounds.min[2] = node.min_z[c];
+	        bounds.max[0] = node.max_x[c]; bounds.max[1] = node.max_y[c]; bounds.max[2] = node.max_z[c];
+	        return bounds;
+	    }
+
+	    bool SameBounds(const Aabb &a, const Aabb &b)
+	    {
+	        return a.min[0] == b.min[0] && a.min[1] == b.min[1] && a.min[2] == b.min[2] &&
+	               a.max[0] == b.max[0] && a.max[1] == b.max[1] && a.max[2] == b.max[2];
+	    }
+
+	    void SwapChildren(BVHNode &a, const uint32_t slot_a, BVHNode &b, const uint32_t slot_b)
+	    {
+	        std::swap(a.min_x[slot_a], b.min_x[slot_b]); std::swap(a.min_y[slot_a], b.min_y[slot_b]); std::swap(a.min_z[slot_a], b.min_z[slot_b]);
+	        std::swap(a.max_x[slot_a], b.max_x[slot_b]); std::swap(a.max_y[slot_a], b.max_y[slot_b]); std::swap(a.max_z[slot_a], b.max_z[slot_b]);
+	        std::swap(a.child[slot_a], b.child[slot_b]);
+	        std::swap(a.count[slot_a], b.count[slot_b]);
+	    }
+
+	    Vec3 ChildCenter(const BVHNode &node, const uint32_t c)
+	    {
+	        return {(node.min_x[c] + node.max_x[c]) * 0.5f, (node.min_y[c] + node.max_y[c]) * 0.5f, (node.min_z[c] + node.max_z[c]) * 0.5f};
+	    }
+
+	    Vec3 ChildExtent(const BVHNode &node, const uint32_t c)
+	    {
+	        return {(node.max_x[c] - node.min_x[c]) * 0.5f, (node.max_y[c] - node.min_y[c]) * 0.5f, (node.max_z[c] - node.min_z[c]) * 0.5f};
+	    }
+
+	    // Entry distance of the ray into a child box, or -1 when the child is empty or missed
+	    float ChildEntry(const Ray &ray, const BVHNode &node, const uint32_t c)
+	    {
+	        float t;
+	        if (node.IsEmpty(c) || !IntersectRayBounds(ray, Vec3(node.min_x[c], node.min_y[c], node.min_z[c]), Vec3(node.max_x[c], node.max_y[c], node.max_z[c]), t))
+	            return -1.0f;
+	        return t;
+	    }
+
+	    // Entry distance of the ray into a primitive box, or -1 on a miss
+	    float PrimitiveEntry(const Ray &ray, const BoundingBoxSoA &prims, const uint32_t i)
+	    {
+	        float t;
+	        if (!IntersectRayBox(ray, Vec3(prims.center_x[i], prims.center_y[i], prims.center_z[i]), Vec3(prims.extent_x[i], prims.extent_y[i], prims.extent_z[i]), t))
+	            return -1.0f;
+	        return t;
+	    }
+
+	    float DistanceSquared(const Vec3 &point, const float min_x, const float min_y, const float min_z, const float max_x, const float max_y, const float max_z)
+	    {
+	        const float dx = std::max({ min_x - point.x, 0.0f, point.x - max_x });
+	        const float dy = std::max({ min_y - point.y, 0.0f, point.y - max_y });
+	        const float dz = std::max({ min_z - point.z, 0.0f, point.z - max_z });
+	        return dx * dx + dy * dy + dz * dz;
+	    }
+	}
+
+	void BVH::Build(const BoundingBox *boxes, const size_t count, const BVHBuildSettings &settings)
+	{
+	    Clear();
+	    if (count == 0)
+	        return;
+
+	    assert(boxes != nullptr && count < BVHNode::INVALID_INDEX);
+
+	    m_Indices.resize(count);
+	    for (size_t i = 0; i < count; i++)
+	        m_Indices[i] = static_cast<uint32_t>(i);
+
+	    m_Nodes.reserve(count);
+	    if (settings.method == BVHBuildMethod::Linear && count > 1)
+	    {
+	        LinearBuilder builder(boxes, count, settings, m_Indices.data());
+	        EmitNodes(builder, builder.Build(), m_Nodes);
+	    }
+	    else
+	    {
+	        Builder builder(boxes, count, settings, m_Indices.data(), MAX_DEPTH);
+	        EmitNodes(builder, builder.Build(0, static_cast<uint32_t>(count), 0), m_Nodes);
+	    }
+
+	    m_PrimitiveBounds.Reserve(count);
+	    for (const uint32_t index : m_Indices)
+	        m_PrimitiveBounds.Add(boxes[index]);
+
+	    m_Parents.assign(m_Nodes.size(), BVHNode::INVALID_INDEX);
+	    m_LeafNode.resize(count);
+	    m_LeafSlot.resize(count);
+	    m_Dirty.assign(m_Nodes.size(), 0);
+	    for (uint32_t n = 0; n < m_Nodes.size(); n++)
+	        LinkChildren(n);
+
+	    // Children follow their parents after the depth-first flattening
+	    m_Heights.assign(m_Nodes.size(), 1);
+	    for (uint32_t n = static_cast<uint32_t>(m_Nodes.size()); n-- > 0;)
+	        m_Heights[n] = static_cast<uint8_t>(1 + std::max(GetChildHeight(n, 0), GetChildHeight(n, 1)));
+	}
+
+	void BVH::Clear()
+	{
+	    m_Nodes.clear();
+	    m_Indices.clear();
+	    m_PrimitiveBounds.Clear();
+	    m_Parents.clear();
+	    m_LeafNode.clear();
+	    m_LeafSlot.clear();
+	    m_Heights.clear();
+	    m_Dirty.clear();
+	    m_DirtyNodes.clear();
+	    m_RefitNodes.clear();
+	}
+
+	void BVH::LinkChildren(const uint32_t node_index)
+	{
+	    const BVHNode &node = m_Nodes[node_index];
+	    for (uint32_t c = 0; c < 2; c++)
+	    {
+	        if (node.IsEmpty(c))
+	            continue;
+
+	        if (!node.IsLeaf(c))
+	        {
+	            m_Parents[node.child[c]] = node_index;
+	            continue;
+	        }
+
+	        for (uint32_t i = node.child[c]; i < node.child[c] + node.count[c]; i++)
+	        {
+	            m_LeafNode[m_Indices[i]] = node_index;
+	            m_LeafSlot[m_Indices[i]] = i;
+	        }
+	    }
+	}
+
+	uint32_t BVH::GetChildHeight(const uint32_t node, const uint32_t c) const
+	{
+	    const BVHNode &n = m_Nodes[node];
+	    return n.IsLeaf(c) || n.IsEmpty(c) ? 0 : m_Heights[n.child[c]];
+	}
+
+	uint32_t BVH::GetDepth(uint32_t node) const
+	{
+	    uint32_t depth = 0;
+	    while (m_Parents[node] != BVHNode::INVALID_INDEX)
+	    {
+	        node = m_Parents[node];
+	        depth++;
+	    }
+	    return depth;
+	}
+
+	void BVH::UpdateHeights(uint32_t node)
+	{
+	    while (node != BVHNode::INVALID_INDEX)
+	    {
+	        const uint8_t height = static_cast<uint8_t>(1 + std::max(GetChildHeight(node, 0), GetChildHeight(node, 1)));
+	        if (height == m_Heights[node])
+	            return;
+
+	        m_Heights[node] = height;
+	        node = m_Parents[node];
+	    }
+	}
+
+	void BVH::MarkDirty(const uint32_t node)
+	{
+	    if (m_Dirty[node])
+	        return;
+
+	    m_Dirty[node] = 1;
+	    m_DirtyNodes.push_back(node);
+	}
+
+	void BVH::UpdatePrimitive(const uint32_t primitive, const BoundingBox &box)
+	{
+	    assert(primitive < m_LeafSlot.size());
+
+	    m_PrimitiveBounds.Set(m_LeafSlot[primitive], box);
+	    MarkDirty(m_LeafNode[primitive]);
+	}
+
+	size_t BVH::Refit()
+	{
+	    m_RefitNodes.clear();
+
+	    // Children have larger indices than their parents (depth-first order), so the largest
+	    // dirty index is always safe to process next. After rotations a parent can be visited
+	    // early; it is then simply queued again by its child.
+	    std::priority_queue<uint32_t> queue(m_DirtyNodes.begin(), m_DirtyNodes.end());
+	    m_DirtyNodes.clear();
+
+	    const BoundingBoxSoA &prims = m_PrimitiveBounds;
+	    while (!queue.empty())
+	    {
+	        const uint32_t node_index = queue.top();
+	        queue.pop();
+	        if (!m_Dirty[node_index])
+	            continue;
+
+	        m_Dirty[node_index] = 0;
+	        m_RefitNodes.push_back(node_index);
+
+	        BVHNode &node = m_Nodes[node_index];
+	        bool changed = false;
+	        for (uint32_t c = 0; c < 2; c++)
+	        {
+	            if (node.IsEmpty(c))
+	                continue;
+
+	            Aabb bounds;
+	            if (node.IsLeaf(c))
+	            {
+	                for (uint32_t i = node.child[c]; i < node.child[c] + node.count[c]; i++)
+	                {
+	                    const float min[3] = { prims.center_x[i] - prims.extent_x[i], prims.center_y[i] - prims.extent_y[i], prims.center_z[i] - prims.extent_z[i] };
+	                    const float max[3] = { prims.center_x[i] + prims.extent_x[i], prims.center_y[i] + prims.extent_y[i], prims.center_z[i] + prims.extent_z[i] };
+	                    bounds.Grow(min);
+	                    bounds.Grow(max);
+	                }
+	            }
+	            else
+	            {
+	                const BVHNode &child = m_Nodes[node.child[c]];
+	                bounds = GetChildBounds(child, 0);
+	                if (!child.IsEmpty(1))
+	                    bounds.Grow(GetChildBounds(child, 1));
+	            }
+
+	            if (!SameBounds(bounds, GetChildBounds(node, c)))
+	            {
+	                SetChildBounds(node, c, bounds);
+	                changed = true;
+	            }
+	        }
+
+	        // Unchanged bounds stop the walk: the ancestors already contain them
+	        const uint32_t parent = m_Parents[node_index];
+	        if (changed && parent != BVHNode::INVALID_INDEX && !m_Dirty[parent])
+	        {
+	            m_Dirty[parent] = 1;
+	            queue.push(parent);
+	        }
+	    }
+
+	    return m_RefitNodes.size();
+	}
+
+	size_t BVH::Optimize()
+	{
+	    // Bottom up, so rotations lower in the tree are reflected in the bounds seen above
+	    std::sort(m_RefitNodes.begin(), m_RefitNodes.end(), std::greater<>());
+	    m_RefitNodes.erase(std::unique(m_RefitNodes.begin(), m_RefitNodes.end()), m_RefitNodes.end());
+
+	    size_t rotations = 0;
+	    for (const uint32_t node_index : m_RefitNodes)
+	    {
+	        BVHNode &node = m_Nodes[node_index];
+	        if (node.IsEmpty(0) || node.IsEmpty(1))
+	            continue;
+
+	        // Swapping the other child with a grandchild changes only the surface area of the inner child
+	        float best_benefit = 0.0f;
+	        uint32_t best_side = 0, best_grandchild = 0;
+	        uint32_t depth = BVHNode::INVALID_INDEX;
+	        for (uint32_t side = 0; side < 2; side++)
+	        {
+	            if (node.IsLeaf(side))
+	                continue;
+
+	            const BVHNode &child = m_Nodes[node.child[side]];
+	            if (child.IsEmpty(0) || child.IsEmpty(1))
+	                continue;
+
+	            const float current = GetChildBounds(node, side).HalfArea();
+	            for (uint32_t k = 0; k < 2; k++)
+	            {
+	                Aabb rotated = GetChildBounds(node, 1 - side);
+	                rotated.Grow(GetChildBounds(child, 1 - k));
+
+	                const float benefit = current - rotated.HalfArea();
+	                if (benefit <= best_benefit)
+	                    continue;
+
+	                // The other child moves one level down; skip rotations that would deepen the tree past MAX_DEPTH
+	                const uint32_t child_height = 1 + std::max(GetChildHeight(node_index, 1 - side), GetChildHeight(node.child[side], 1 - k));
+	                const uint32_t height = 1 + std::max(child_height, GetChildHeight(node.child[side], k));
+	                if (height > m_Heights[node_index])
+	                {
+	                    if (depth == BVHNode::INVALID_INDEX)
+	                        depth = GetDepth(node_index);
+	                    if (depth + height > MAX_DEPTH)
+	                        continue;
+	                }
+
+	                best_benefit = benefit;
+	                best_side = side;
+	                best_grandchild = k;
+	            }
+	        }
+
+	        if (best_benefit <= 0.0f)
+	            continue;
+
+	        const uint32_t child_index = node.child[best_side];
+	        BVHNode &child = m_Nodes[child_index];
+	        SwapChildren(node, 1 - best_side, child, best_grandchild);
+
+	        Aabb child_bounds = GetChildBounds(child, 0);
+	        child_bounds.Grow(GetChildBounds(child, 1));
+	        SetChildBounds(node, best_side, child_bounds);
+
+	        LinkChildren(node_index);
+	        LinkChildren(child_index);
+	        UpdateHeights(child_index);
+	        UpdateHeights(node_index);
+	        rotations++;
+	    }
+
+	    m_RefitNodes.clear();
+	    return rotations;
+	}
+
+	BoundingBox BVH::GetBounds() const
+	{
+	    if (m_Nodes.empty())
+	        return {};
+
+	    const BVHNode &root = m_Nodes[0];
+	    Vec3 min(root.min_x[0], root.min_y[0], root.min_z[0]);
+	    Vec3 max(root.max_x[0], root.max_y[0], root.max_z[0]);
+	    if (!root.IsEmpty(1))
+	    {
+	        min = Vec3(std::min(min.x, root.min_x[1]), std::min(min.y, root.min_y[1]), std::min(min.z, root.min_z[1]));
+	        max = Vec3(std::max(max.x, root.max_x[1]), std::max(max.y, root.max_y[1]), std::max(max.z, root.max_z[1]));
+	    }
+	    return {min, max};
+	}
+
+	void BVH::QueryFrustum(const Frustum &frustum, std::vector<uint32_t> &results) const
+	{
+	    if (m_Nodes.empty())
+	        return;
+
+	    uint32_t stack[STACK_SIZE];
+	    uint8_t mask_stack[STACK_SIZE];
+	    uint32_t stack_size = 0;
+	    stack[stack_size] = 0;
+	    mask_stack[stack_size++] = Frustum::PLANE_MASK_ALL;
+
+	    const BoundingBoxSoA &prims = m_PrimitiveBounds;
+	    while (stack_size > 0)
+	    {
+	        --stack_size;
+	        const BVHNode &node = m_Nodes[stack[stack_size]];
+	        const uint8_t parent_mask = mask_stack[stack_size];
+
+	        for (uint32_t c = 0; c < 2; c++)
+	        {
+	            if (node.IsEmpty(c))
+	                continue;
+
+	            // Planes the parent is fully inside are skipped; an empty mask accepts without testing
+	            uint8_t mask = parent_mask;
+	            if (mask != 0 && frustum.CheckCubeMasked(ChildCenter(node, c), ChildExtent(node, c), mask) == Intersection::Outside)
+	                continue;
+
+	            if (!node.IsLeaf(c))
+	            {
+	                assert(stack_size < STACK_SIZE);
+	                stack[stack_size] = node.child[c];
+	                mask_stack[stack_size++] = mask;
+	                continue;
+	            }
+
+	            const uint32_t end = node.child[c] + node.count[c];
+	            for (uint32_t i = node.child[c]; i < end; i++)
+	            {
+	                uint8_t prim_mask = mask;
+	                if (prim_mask == 0 || frustum.CheckCubeMasked(Vec3(prims.center_x[i], prims.center_y[i], prims.center_z[i]),
+	                                                        Vec3(prims.extent_x[i], prims.extent_y[i], prims.extent_z[i]), prim_mask) != Intersection::Outside)
+	                    results.push_back(m_Indices[i]);
+	            }
+	        }
+	    }
+	}
+
+	void BVH::QueryOverlap(const BoundingBox &box, std::vector<uint32_t> &results) const
+	{
+	    if (m_Nodes.empty())
+	        return;
+
+	    const Vec3 &qmin = box.GetMin();
+	    const Vec3 &qmax = box.GetMax();
+
+	    uint32_t stack[STACK_SIZE];
+	    uint32_t stack_size = 0;
+	    stack[stack_size++] = 0;
+
+	    const BoundingBoxSoA &prims = m_PrimitiveBounds;
+	    while (stack_size > 0)
+	    {
+	        const BVHNode &node = m_Nodes[stack[--stack_size]];
+	        for (uint32_t c = 0; c < 2; c++)
+	        {
+	            const bool overlaps = node.min_x[c] <= qmax.x && node.max_x[c] >= qmin.x &&
+	                                  node.min_y[c] <= qmax.y && node.max_y[c] >= qmin.y &&
+	                                  node.min_z[c] <= qmax.z && node.max_z[c] >= qmin.z;
+	            if (!overlaps || node.IsEmpty(c))
+	                continue;
+
+	            if (!node.IsLeaf(c))
+	            {
+	                assert(stack_size < STACK_SIZE);
+	                stack[stack_size++] = node.child[c];
+	                continue;
+	            }
+
+	            const uint32_t end = node.child[c] + node.count[c];
+	            for (uint32_t i = node.child[c]; i < end; i++)
+	            {
+	                if (std::fabs(prims.center_x[i] - (qmin.x + qmax.x) * 0.5f) <= prims.extent_x[i] + (qmax.x - qmin.x) * 0.5f &&
+	                    std::fabs(prims.center_y[i] - (qmin.y + qmax.y) * 0.5f) <= prims.extent_y[i] + (qmax.y - qmin.y) * 0.5f &&
+	                    std::fabs(prims.center_z[i] - (qmin.z + qmax.z) * 0.5f) <= prims.extent_z[i] + (qmax.z - qmin.z) * 0.5f)
+	                    results.push_back(m_Indices[i]);
+	            }
+	        }
+	    }
+	}
+
+	void BVH::QueryRay(const Vec3 &origin, const Vec3 &direction, const float max_distance, std::vector<uint32_t> &results) const
+	{
+	    if (m_Nodes.empty())
+	        return;
+
+	    const Ray ray(origin, direction, max_distance);
+	    const BoundingBoxSoA &prims = m_PrimitiveBounds;
+
+	    uint32_t stack[STACK_SIZE];
+	    uint32_t stack_size = 0;
+	    stack[stack_size++] = 0;
+
+	    while (stack_size > 0)
+	    {
+	        const BVHNode &node = m_Nodes[stack[--stack_size]];
+
+	        float t[2];
+	        for (uint32_t c = 0; c < 2; c++)
+	            t[c] = ChildEntry(ray, node, c);
+
+	        // Visit the nearer child first: it is pushed last
+	        const uint32_t first = (t[1] >= 0.0f && (t[0] < 0.0f || t[1] < t[0])) ? 1 : 0;
+	        for (uint32_t k = 0; k < 2; k++)
+	        {
+	            const uint32_t c = k == 0 ? first : 1 - first;
+	            if (t[c] < 0.0f)
+	                continue;
+
+	            if (node.IsLeaf(c))
+	            {
+	                const uint32_t end = node.child[c] + node.count[c];
+	                for (uint32_t i = node.child[c]; i < end; i++)
+	                {
+	                    if (PrimitiveEntry(ray, prims, i) >= 0.0f)
+	                        results.push_back(m_Indices[i]);
+	                }
+	            }
+	        }
+
+	        for (uint32_t k = 0; k < 2; k++)
+	        {
+	            const uint32_t c = k == 0 ? 1 - first : first;
+	            if (t[c] >= 0.0f && !node.IsLeaf(c))
+	            {
+	                assert(stack_size < STACK_SIZE);
+	                stack[stack_size++] = node.child[c];
+	            }
+	        }
+	    }
+	}
+
+	bool BVH::RaycastBounds(const Vec3 &origin, const Vec3 &direction, const float max_distance, uint32_t &primitive, float &distance) const
+	{
+	    if (m_Nodes.empty())
+	        return false;
+
+	    Ray ray(origin, direction, max_distance);
+	    const BoundingBoxSoA &prims = m_PrimitiveBounds;
+	    bool hit = false;
+
+	    uint32_t stack[STACK_SIZE];
+	    float t_stack[STACK_SIZE];
+	    uint32_t stack_size = 0;
+	    stack[stack_size] = 0;
+	    t_stack[stack_size++] = 0.0f;
+
+	    while (stack_size > 0)
+	    {
+	        --stack_size;
+	        // Nodes pushed before a closer hit was found can be skipped
+	        if (t_stack[stack_size] > ray.max_distance)
+	            continue;
+
+	        const BVHNode &node = m_Nodes[stack[stack_size]];
+
+	        float t[2];
+	        for (uint32_t c = 0; c < 2; c++)
+	            t[c] = ChildEntry(ray, node, c);
+
+	        const uint32_t near_child = (t[1] >= 0.0f && (t[0] < 0.0f || t[1] < t[0])) ? 1 : 0;
+	        const uint32_t order[2] = { 1 - near_child, near_child };
+	        for (const uint32_t c : order)
+	        {
+	            if (t[c] < 0.0f)
+	                continue;
+
+	            if (!node.IsLeaf(c))
+	            {
+	                assert(stack_size < STACK_SIZE);
+	                stack[stack_size] = node.child[c];
+	                t_stack[stack_size++] = t[c];
+	                continue;
+	            }
+
+	            const uint32_t end = node.child[c] + node.count[c];
+	            for (uint32_t i = node.child[c]; i < end; i++)
+	            {
+	                const float t_hit = PrimitiveEntry(ray, prims, i);
+	                if (t_hit >= 0.0f && (!hit || t_hit < ray.max_distance))
+	                {
+	                    hit = true;
+	                    primitive = m_Indices[i];
+	                    distance = t_hit;
+	                    ray.max_distance = t_hit;
+	                }
+	            }
+	        }
+	    }
+
+	    return hit;
+	}
+
+	uint8_t BVH::RaycastBounds(const RayPacket8 &packet, uint32_t *primitives, float *distances) const
+	{
+	    assert(primitives != nullptr && distances != nullptr);
+	    if (m_Nodes.empty() || packet.active == 0)
+	        return 0;
+
+	    // Segments shrink to the nearest hit per lane
+	    RayPacket8 rays = packet;
+	    const BoundingBoxSoA &prims = m_PrimitiveBounds;
+	    uint8_t hits = 0;
+
+	    uint32_t stack[STACK_SIZE];
+	    uint8_t mask_stack[STACK_SIZE];
+	    uint32_t stack_size = 0;
+	    stack[stack_size] = 0;
+	    mask_stack[stack_size++] = packet.active;
+
+	    float t[2][RayPacket8::LANES];
+	    float t_prim[RayPacket8::LANES];
+	    while (stack_size > 0)
+	    {
+	        --stack_size;
+	        const BVHNode &node = m_Nodes[stack[stack_size]];
+	        const uint8_t node_mask = mask_stack[stack_size];
+
+	        uint8_t mask[2] = { 0, 0 };
+	        float t_min[2] = { FLT_MAX, FLT_MAX };
+	        for (uint32_t c = 0; c < 2; c++)
+	        {
+	            if (node.IsEmpty(c))
+	                continue;
+
+	            rays.active = node_mask;
+	            mask[c] = rays.IntersectBox(node.min_x[c], node.min_y[c], node.min_z[c], node.max_x[c], node.max_y[c], node.max_z[c], t[c]);
+	            for (uint32_t lane = 0; lane < RayPacket8::LANES; lane++)
+	                if (mask[c] & (1u << lane))
+	                    t_min[c] = std::min(t_min[c], t[c][lane]);
+	        }
+
+	        // Leaves first, then inner children with the nearer one on top of the stack
+	        const uint32_t near_child = t_min[1] < t_min[0] ? 1 : 0;
+	        const uint32_t order[2] = { 1 - near_child, near_child };
+	        for (const uint32_t c : order)
+	        {
+	            if (mask[c] == 0)
+	                continue;
+
+	            if (!node.IsLeaf(c))
+	            {
+	                assert(stack_size < STACK_SIZE);
+	                stack[stack_size] = node.child[c];
+	                mask_stack[stack_size++] = mask[c];
+	                continue;
+	            }
+
+	            const uint32_t end = node.child[c] + node.count[c];
+	            for (uint32_t i = node.child[c]; i < end; i++)
+	            {
+	                rays.active = mask[c];
+	                const uint8_t prim_mask = rays.IntersectBox(prims.center_x[i] - prims.extent_x[i], prims.center_y[i] - prims.extent_y[i], prims.center_z[i] - prims.extent_z[i],
+	                                                            prims.center_x[i] + prims.extent_x[i], prims.center_y[i] + prims.extent_y[i], prims.center_z[i] + prims.extent_z[i], t_prim);
+	                for (uint32_t lane = 0; lane < RayPacket8::LANES; lane++)
+	                {
+	                    if (!(prim_mask & (1u << lane)) || ((hits & (1u << lane)) && t_prim[lane] >= rays.max_distance[lane]))
+	                        continue;
+
+	                    hits |= static_cast<uint8_t>(1u << lane);
+	                    primitives[lane] = m_Indices[i];
+	                    distances[lane] = t_prim[lane];
+	                    rays.max_distance[lane] = t_prim[lane];
+	                }
+	            }
+	        }
+	    }
+
+	    return hits;
+	}
+
+	uint8_t BVH::TestOcclusion(const RayPacket8 &packet) const
+	{
+	    if (m_Nodes.empty() || packet.active == 0)
+	        return 0;
+
+	    RayPacket8 rays = packet;
+	    const BoundingBoxSoA &prims = m_PrimitiveBounds;
+	    uint8_t remaining = packet.active;
+
+	    uint32_t stack[STACK_SIZE];
+	    uint8_t mask_stack[STACK_SIZE];
+	    uint32_t stack_size = 0;
+	    stack[stack_size] = 0;
+	    mask_stack[stack_size++] = packet.active;
+
+	    float t[RayPacket8::LANES];
+	    while (stack_size > 0 && remaining != 0)
+	    {
+	        --stack_size;
+	        const BVHNode &node = m_Nodes[stack[stack_size]];
+	        const uint8_t node_mask = mask_stack[stack_size] & remaining;
+	        if (node_mask == 0)
+	            continue;
+
+	        for (uint32_t c = 0; c < 2 && remaining != 0; c++)
+	        {
+	            if (node.IsEmpty(c))
+	                continue;
+
+	            rays.active = node_mask & remaining;
+	            const uint8_t mask = rays.IntersectBox(node.min_x[c], node.min_y[c], node.min_z[c], node.max_x[c], node.max_y[c], node.max_z[c], t);
+	            if (mask == 0)
+	                continue;
+
+	            if (!node.IsLeaf(c))
+	            {
+	                assert(stack_size < STACK_SIZE);
+	                stack[stack_size] = node.child[c];
+	                mask_stack[stack_size++] = mask;
+	                continue;
+	            }
+
+	            const uint32_t end = node.child[c] + node.count[c];
+	            for (uint32_t i = node.child[c]; i < end && (remaining & mask) != 0; i++)
+	            {
+	                rays.active = mask & remaining;
+	                remaining &= static_cast<uint8_t>(~rays.IntersectBox(prims.center_x[i] - prims.extent_x[i], prims.center_y[i] - prims.extent_y[i], prims.center_z[i] - prims.extent_z[i],
+	                                                                     prims.center_x[i] + prims.extent_x[i], prims.center_y[i] + prims.extent_y[i], prims.center_z[i] + prims.extent_z[i], t));
+	            }
+	        }
+	    }
+
+	    return packet.active & static_cast<uint8_t>(~remaining);
+	}
+
+	bool BVH::QueryClosest(const Vec3 &point, uint32_t &primitive, float &distance) const
+	{
+	    if (m_Nodes.empty())
+	        return false;
+
+	    const BoundingBoxSoA &prims = m_PrimitiveBounds;
+	    float best = FLOAT_MAX;
+
+	    uint32_t stack[STACK_SIZE];
+	    float d_stack[STACK_SIZE];
+	    uint32_t stack_size = 0;
+	    stack[stack_size] = 0;
+	    d_stack[stack_size++] = 0.0f;
+
+	    while (stack_size > 0)
+	    {
+	        --stack_size;
+	        if (d_stack[stack_size] >= best)
+	            continue;
+
+	        const BVHNode &node = m_Nodes[stack[stack_size]];
+
+	        float d[2];
+	        for (uint32_t c = 0; c < 2; c++)
+	            d[c] = node.IsEmpty(c) ? FLOAT_MAX : DistanceSquared(point, node.min_x[c], node.min_y[c], node.min_z[c], node.max_x[c], node.max_y[c], node.max_z[c]);
+
+	        // Push the farther child first so the nearer one tightens the bound sooner
+	        const uint32_t near_child = d[1] < d[0] ? 1 : 0;
+	        const uint32_t order[2] = { 1 - near_child, near_child };
+	        for (const uint32_t c : order)
+	        {
+	            if (d[c] >= best)
+	                continue;
+
+	            if (!node.IsLeaf(c))
+	            {
+	                assert(stack_size < STACK_SIZE);
+	                stack[stack_size] = node.child[c];
+	                d_stack[stack_size++] = d[c];
+	                continue;
+	            }
+
+	            const uint32_t end = node.child[c] + node.count[c];
+	            for (uint32_t i = node.child[c]; i < end; i++)
+	            {
+	                const float d2 = DistanceSquared(point, prims.center_x[i] - prims.extent_x[i], prims.center_y[i] - prims.extent_y[i], prims.center_z[i] - prims.extent_z[i],
+	                                                 prims.center_x[i] + prims.extent_x[i], prims.center_y[i] + prims.extent_y[i], prims.center_z[i] + prims.extent_z[i]);
+	                if (d2 < best)
+	                {
+	                    best = d2;
+	                    primitive = m_Indices[i];
+	                }
+	            }
+	        }
+	    }
+
+	    distance = std::sqrt(best);
+	    return true;
+	}
+
+}
+
+/// -------------------------------------------------------
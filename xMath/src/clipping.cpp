@@ -0,0 +1,201 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* clipping.cpp
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <xmath.hpp>
+#include <xMath/includes/clipping.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	namespace
+	{
+	    // Triangles classified per block in ClipTriangles
+	    constexpr size_t CLASSIFY_BLOCK = 64;
+
+	    float PlaneDistance(const Plane &plane, const Vec3 &point)
+	    {
+	        return plane.normal.x * point.x + plane.normal.y * point.y + plane.normal.z * point.z + plane.d;
+	    }
+
+	    // Clips by the planes of a mask in order, alternating between two buffers so the result
+	    // ends in output
+	    uint32_t ClipByMask(const Vec3 *polygon, uint32_t count, const Plane *planes, uint32_t mask, Vec3 *output, Vec3 *scratch, const float epsilon)
+	    {
+	        Vec3 *target = std::popcount(mask) % 2 == 1 ? output : scratch;
+	        const Vec3 *source = polygon;
+	        while (mask != 0)
+	        {
+	            const int plane = std::countr_zero(mask);
+	            mask &= mask - 1;
+
+	            count = ClipPolygon(source, count, planes[plane], target, epsilon);
+	            if (count < 3)
+	                return 0;
+	            source = target;
+	            target = target == output ? scratch : output;
+	        }
+	        return count;
+	    }
+	}
+
+	ClipCodes ClassifyPoints(const Plane *planes, const uint32_t plane_count, const Vec3 *points, const size_t count, uint32_t *codes, const float epsilon)
+	{
+	    assert(plane_count <= MAX_CLIP_PLANES);
+
+	    ClipCodes result;
+	    if (codes)
+	        std::fill(codes, codes + count, 0u);
+	    for (uint32_t i = 0; i < plane_count; i++)
+	    {
+	        const Plane &plane = planes[i];
+	        const uint32_t bit = 1u << i;
+	        size_t outside = 0;
+	        for (size_t p = 0; p < count; p++)
+	        {
+	            const bool behind = PlaneDistance(plane, points[p]) < -epsilon;
+	            outside += behind;
+	            if (codes)
+	                codes[p] |= behind ? bit : 0u;
+	        }
+
+	        if (outside > 0)
+	            result.any_outside |= bit;
+	        if (outside == count && count > 0)
+	            result.all_outside |= bit;
+	    }
+	    return result;
+	}
+
+	uint32_t ClipPolygon(const Vec3 *polygon, const uint32_t count, const Plane &plane, Vec3 *output, const float epsilon)
+	{
+	    assert(polygon != output);
+	    if (count == 0)
+	        return 0;
+
+	    uint32_t written = 0;
+	    const Vec3 *a = &polygon[count - 1];
+	    float distance_a = PlaneDistance(plane, *a);
+	    for (uint32_t i = 0; i < count; i++)
+	    {
+	        const Vec3 *b = &polygon[i];
+	        const float distance_b = PlaneDistance(plane, *b);
+
+	        // Edge a -> b crosses the plane: interpolate from the front vertex for a watertight split
+	        if ((distance_a > epsilon && distance_b < -epsilon) || (distance_a < -epsilon && distance_b > epsilon))
+	        {
+	            const bool a_front = distance_a > 0.0f;
+	            const Vec3 &front = a_front ? *a : *b;
+	            const Vec3 &back = a_front ? *b : *a;
+	            const float front_distance = a_front ? distance_a : distance_b;
+	            const float back_distance = a_front ? distance_b : distance_a;
+	            output[written++] = front + (back - front) * (front_distance / (front_distance - back_distance));
+	        }
+	        if (distance_b >= -epsilon)
+	            output[written++] = *b;
+
+	        a = b;
+	        distance_a = distance_b;
+	    }
+	    return written;
+	}
+
+	uint32_t ClipPolygon(const Vec3 *polygon, const uint32_t count, const Plane *planes, const uint32_t plane_count, Vec3 *output, Vec3 *scratch, const float epsilon)
+	{
+	    if (count < 3)
+	        return 0;
+
+	    const ClipCodes codes = ClassifyPoints(planes, plane_count, polygon, count, nullptr, epsilon);
+	    if (codes.all_outside != 0)
+	        return 0;
+	    if (codes.any_outside == 0)
+	    {
+	        std::copy(polygon, polygon + count, output);
+	        return count;
+	    }
+	    return ClipByMask(polygon, count, planes, codes.any_outside, output, scratch, epsilon);
+	}
+
+	size_t ClipTriangles(const Vec3 *vertices, const uint32_t *indices, const size_t triangle_count, const Plane *planes, const uint32_t plane_count,
+	                     Vec3 *output, const size_t capacity, uint32_t *source_triangles, const float epsilon)
+	{
+	    assert(plane_count <= MAX_CLIP_PLANES);
+
+	    Vec3 corners[CLASSIFY_BLOCK * 3];
+	    uint32_t codes[CLASSIFY_BLOCK * 3];
+	    Vec3 polygon[3 + MAX_CLIP_PLANES], scratch[3 + MAX_CLIP_PLANES];
+
+	    size_t written = 0;
+	    const auto emit = [&](const Vec3 &a, const Vec3 &b, const Vec3 &c, const size_t source)
+	    {
+	        output[written * 3 + 0] = a;
+	        output[written * 3 + 1] = b;
+	        output[written * 3 + 2] = c;
+	        if (source_triangles)
+	            source_triangles[written] = static_cast<uint32_t>(source);
+	        written++;
+	    };
+
+	    for (size_t block = 0; block < triangle_count; block += CLASSIFY_BLOCK)
+	    {
+	        const size_t block_count = std::min(CLASSIFY_BLOCK, triangle_count - block);
+	        for (size_t i = 0; i < block_count * 3; i++)
+	            corners[i] = vertices[indices ? indices[block * 3 + i] : block * 3 + i];
+
+	        const ClipCodes block_codes = ClassifyPoints(planes, plane_count, corners, block_count * 3, codes, epsilon);
+	        if (block_codes.all_outside != 0)
+	            continue;
+
+	        for (size_t t = 0; t < block_count; t++)
+	        {
+	            if (written == capacity)
+	                return written;
+
+	            const Vec3 *triangle = &corners[t * 3];
+	            const uint32_t *triangle_codes = &codes[t * 3];
+	            if ((triangle_codes[0] & triangle_codes[1] & triangle_codes[2]) != 0)
+	                continue;
+
+	            const uint32_t straddled = triangle_codes[0] | triangle_codes[1] | triangle_codes[2];
+	            if (straddled == 0)
+	            {
+	                emit(triangle[0], triangle[1], triangle[2], block + t);
+	                continue;
+	            }
+
+	            const uint32_t count = ClipByMask(triangle, 3, planes, straddled, polygon, scratch, epsilon);
+	            for (uint32_t i = 1; i + 1 < count && written < capacity; i++)
+	                emit(polygon[0], polygon[i], polygon[i + 1], block + t);
+	        }
+	    }
+	    return written;
+	}
+}
+
+/// -------------------------------------------------------
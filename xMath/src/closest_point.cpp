@@ -0,0 +1,449 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* closest_point.cpp
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <xmath.hpp>
+#include <xMath/includes/closest_point.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	namespace
+	{
+	    float Clamp01(const float value)
+	    {
+	        return std::min(std::max(value, 0.0f), 1.0f);
+	    }
+
+	    // Segment parameters of the closest points of two segments, without branches so the batch
+	    // loop vectorizes. d1, d2 are the directions and r = a0 - b0 (Ericson 5.1.9).
+	    void SegmentSegmentParameters(const float d1x, const float d1y, const float d1z, const float d2x, const float d2y, const float d2z,
+	                                  const float rx, const float ry, const float rz, float &s, float &t)
+	    {
+	        const float a = d1x * d1x + d1y * d1y + d1z * d1z;
+	        const float e = d2x * d2x + d2y * d2y + d2z * d2z;
+	        const float b = d1x * d2x + d1y * d2y + d1z * d2z;
+	        const float c = d1x * rx + d1y * ry + d1z * rz;
+	        const float f = d2x * rx + d2y * ry + d2z * rz;
+	        // A zero-length direction has zero products too, so clamping the divisors keeps those terms at zero
+	        const float inv_a = 1.0f / std::max(a, FLT_MIN);
+	        const float inv_e = 1.0f / std::max(e, FLT_MIN);
+
+	        // Closest point of the infinite lines; parallel lines start from s = 0
+	        const float denominator = a * e - b * b;
+	        const float line_s = Clamp01((b * f - c * e) / std::max(denominator, FLT_MIN));
+	        s = denominator > FLT_EPSILON * a * e ? line_s : 0.0f;
+
+	        // Clamping t to the segment, or a point-like segment b, moves s to the closest point of t
+	        const float unclamped = (b * s + f) * inv_e;
+	        t = Clamp01(unclamped);
+	        s = t != unclamped || e <= 0.0f ? Clamp01((b * t - c) * inv_a) : s;
+	    }
+
+	    // Closest point of segment a -> b to p as the clamped parameter along the segment
+	    float SegmentParameter(const float px, const float py, const float pz, const float ax, const float ay, const float az,
+	                           const float abx, const float aby, const float abz)
+	    {
+	        const float length_squared = abx * abx + aby * aby + abz * abz;
+	        const float projection = (px - ax) * abx + (py - ay) * aby + (pz - az) * abz;
+	        return Clamp01(projection / std::max(length_squared, FLT_MIN));
+	    }
+
+	    // Segment p -> q against triangle a, b, c; writes the crossing point when they intersect
+	    bool IntersectSegmentTriangle(const Vec3 &p, const Vec3 &q, const Vec3 &a, const Vec3 &b, const Vec3 &c, Vec3 &hit)
+	    {
+	        const Vec3 normal = Cross(b - a, c - a);
+	        const float distance_p = Dot(normal, p - a);
+	        const float distance_q = Dot(normal, q - a);
+	        if ((distance_p > 0.0f && distance_q > 0.0f) || (distance_p < 0.0f && distance_q < 0.0f) || distance_p == distance_q)
+	            return false;
+
+	        const Vec3 point = p + (q - p) * (distance_p / (distance_p - distance_q));
+	        if (Dot(Cross(b - a, point - a), normal) < 0.0f || Dot(Cross(c - b, point - b), normal) < 0.0f ||
+	            Dot(Cross(a - c, point - c), normal) < 0.0f)
+	            return false;
+	        hit = point;
+	        return true;
+	    }
+
+	    // Batch loops, instantiated with and without the closest point outputs so neither has a
+	    // branch per element
+	    template <bool WRITE_CLOSEST>
+	    void SegmentBatch(const Vec3SoA &points, const Vec3SoA &a, const Vec3SoA &b, float *distances_squared, float *qx, float *qy, float *qz)
+	    {
+	        const float *px = points.x.data(), *py = points.y.data(), *pz = points.z.data();
+	        const float *ax = a.x.data(), *ay = a.y.data(), *az = a.z.data();
+	        const float *bx = b.x.data(), *by = b.y.data(), *bz = b.z.data();
+	        const size_t count = points.Size();
+	        for (size_t i = 0; i < count; i++)
+	        {
+	            const float abx = bx[i] - ax[i], aby = by[i] - ay[i], abz = bz[i] - az[i];
+	            const float t = SegmentParameter(px[i], py[i], pz[i], ax[i], ay[i], az[i], abx, aby, abz);
+	            const float cx = ax[i] + abx * t, cy = ay[i] + aby * t, cz = az[i] + abz * t;
+	            distances_squared[i] = (px[i] - cx) * (px[i] - cx) + (py[i] - cy) * (py[i] - cy) + (pz[i] - cz) * (pz[i] - cz);
+	            if constexpr (WRITE_CLOSEST)
+	            {
+	                qx[i] = cx;
+	                qy[i] = cy;
+	                qz[i] = cz;
+	            }
+	        }
+	    }
+
+	    // The Voronoi region tests of ClosestPointOnTriangle evaluated together, each selecting its
+	    // barycentric weights, with the first region of the scalar order applied last
+	    template <bool WRITE_CLOSEST>
+	    void TriangleBatch(const Vec3SoA &points, const Vec3SoA &a, const Vec3SoA &b, const Vec3SoA &c, float *distances_squared,
+	                       float *closest_x, float *closest_y, float *closest_z)
+	    {
+	        const float *points_x = points.x.data(), *points_y = points.y.data(), *points_z = points.z.data();
+	        const float *a_x = a.x.data(), *a_y = a.y.data(), *a_z = a.z.data();
+	        const float *b_x = b.x.data(), *b_y = b.y.data(), *b_z = b.z.data();
+	        const float *c_x = c.x.data(), *c_y = c.y.data(), *c_z = c.z.data();
+	        const size_t count = points.Size();
+	        for (size_t i = 0; i < count; i++)
+	        {
+	            const float px = points_x[i], py = points_y[i], pz = points_z[i];
+	            const float ax = a_x[i], ay = a_y[i], az = a_z[i];
+	            const float bx = b_x[i], by = b_y[i], bz = b_z[i];
+	            const float cx = c_x[i], cy = c_y[i], cz = c_z[i];
+	            const float abx = bx - ax, aby = by - ay, abz = bz - az;
+	            const float acx = cx - ax, acy = cy - ay, acz = cz - az;
+	            const float d1 = abx * (px - ax) + aby * (py - ay) + abz * (pz - az);
+	            const float d2 = acx * (px - ax) + acy * (py - ay) + acz * (pz - az);
+	            const float d3 = abx * (px - bx) + aby * (py - by) + abz * (pz - bz);
+	            const float d4 = acx * (px - bx) + acy * (py - by) + acz * (pz - bz);
+	            const float d5 = abx * (px - cx) + aby * (py - cy) + abz * (pz - cz);
+	            const float d6 = acx * (px - cx) + acy * (py - cy) + acz * (pz - cz);
+	            const float va = d3 * d6 - d5 * d4;
+	            const float vb = d5 * d2 - d1 * d6;
+	            const float vc = d1 * d4 - d3 * d2;
+
+	            // Face region
+	            const float inv_sum = 1.0f / std::max(va + vb + vc, FLT_MIN);
+	            float v = vb * inv_sum;
+	            float w = vc * inv_sum;
+
+	            // Edge bc, edge ac, vertex c, edge ab, vertex b, vertex a
+	            const float bc = (d4 - d3) / std::max((d4 - d3) + (d5 - d6), FLT_MIN);
+	            // Non-short-circuit conditions and unconditional divisions keep the loop free of branches
+	            const bool on_bc = (va <= 0.0f) & (d4 - d3 >= 0.0f) & (d5 - d6 >= 0.0f);
+	            v = on_bc ? 1.0f - bc : v;
+	            w = on_bc ? bc : w;
+
+	            const float ac = d2 / std::max(d2 - d6, FLT_MIN);
+	            const bool on_ac = (vb <= 0.0f) & (d2 >= 0.0f) & (d6 <= 0.0f);
+	            v = on_ac ? 0.0f : v;
+	            w = on_ac ? ac : w;
+
+	            const bool on_c = (d6 >= 0.0f) & (d5 <= d6);
+	            v = on_c ? 0.0f : v;
+	            w = on_c ? 1.0f : w;
+
+	            const float ab = d1 / std::max(d1 - d3, FLT_MIN);
+	            const bool on_ab = (vc <= 0.0f) & (d1 >= 0.0f) & (d3 <= 0.0f);
+	            v = on_ab ? ab : v;
+	            w = on_ab ? 0.0f : w;
+
+	            const bool on_b = (d3 >= 0.0f) & (d4 <= d3);
+	            v = on_b ? 1.0f : v;
+	            w = on_b ? 0.0f : w;
+
+	            const bool on_a = (d1 <= 0.0f) & (d2 <= 0.0f);
+	            v = on_a ? 0.0f : v;
+	            w = on_a ? 0.0f : w;
+
+	            const float qx = ax + abx * v + acx * w;
+	            const float qy = ay + aby * v + acy * w;
+	            const float qz = az + abz * v + acz * w;
+	            distances_squared[i] = (px - qx) * (px - qx) + (py - qy) * (py - qy) + (pz - qz) * (pz - qz);
+	            if constexpr (WRITE_CLOSEST)
+	            {
+	                closest_x[i] = qx;
+	                closest_y[i] = qy;
+	                closest_z[i] = qz;
+	            }
+	        }
+	    }
+
+	    template <bool WRITE_CLOSEST>
+	    void SegmentPairBatch(const Vec3SoA &a0, const Vec3SoA &a1, const Vec3SoA &b0, const Vec3SoA &b1, float *distances_squared, Vec3SoA *closest_a, Vec3SoA *closest_b)
+	    {
+	        const float *a0x = a0.x.data(), *a0y = a0.y.data(), *a0z = a0.z.data();
+	        const float *a1x = a1.x.data(), *a1y = a1.y.data(), *a1z = a1.z.data();
+	        const float *b0x = b0.x.data(), *b0y = b0.y.data(), *b0z = b0.z.data();
+	        const float *b1x = b1.x.data(), *b1y = b1.y.data(), *b1z = b1.z.data();
+	        float *qax = WRITE_CLOSEST ? closest_a->x.data() : nullptr, *qay = WRITE_CLOSEST ? closest_a->y.data() : nullptr, *qaz = WRITE_CLOSEST ? closest_a->z.data() : nullptr;
+	        float *qbx = WRITE_CLOSEST ? closest_b->x.data() : nullptr, *qby = WRITE_CLOSEST ? closest_b->y.data() : nullptr, *qbz = WRITE_CLOSEST ? closest_b->z.data() : nullptr;
+	        const size_t count = a0.Size();
+	        for (size_t i = 0; i < count; i++)
+	        {
+	            const float d1x = a1x[i] - a0x[i], d1y = a1y[i] - a0y[i], d1z = a1z[i] - a0z[i];
+	            const float d2x = b1x[i] - b0x[i], d2y = b1y[i] - b0y[i], d2z = b1z[i] - b0z[i];
+	            float s, t;
+	            SegmentSegmentParameters(d1x, d1y, d1z, d2x, d2y, d2z, a0x[i] - b0x[i], a0y[i] - b0y[i], a0z[i] - b0z[i], s, t);
+
+	            const float pax = a0x[i] + d1x * s, pay = a0y[i] + d1y * s, paz = a0z[i] + d1z * s;
+	            const float pbx = b0x[i] + d2x * t, pby = b0y[i] + d2y * t, pbz = b0z[i] + d2z * t;
+	            distances_squared[i] = (pax - pbx) * (pax - pbx) + (pay - pby) * (pay - pby) + (paz - pbz) * (paz - pbz);
+	            if constexpr (WRITE_CLOSEST)
+	            {
+	                qax[i] = pax;
+	                qay[i] = pay;
+	                qaz[i] = paz;
+	                qbx[i] = pbx;
+	                qby[i] = pby;
+	                qbz[i] = pbz;
+	            }
+	        }
+	    }
+
+	    template <bool WRITE_CLOSEST>
+	    void OBBBatch(const OrientedBoundingBox &box, const Vec3SoA &points, float *distances_squared, float *qx, float *qy, float *qz)
+	    {
+	        const Vec3 &center = box.GetCenter();
+	        const Vec3 &extents = box.GetExtents();
+	        const Vec3 u = box.GetBasis().Column(0), v = box.GetBasis().Column(1), w = box.GetBasis().Column(2);
+	        const float *px = points.x.data(), *py = points.y.data(), *pz = points.z.data();
+
+	        // Local coordinates clamped to the extents; the basis is orthonormal, so local distances are world distances
+	        const size_t count = points.Size();
+	        for (size_t i = 0; i < count; i++)
+	        {
+	            const float ox = px[i] - center.x, oy = py[i] - center.y, oz = pz[i] - center.z;
+	            const float lu = ox * u.x + oy * u.y + oz * u.z;
+	            const float lv = ox * v.x + oy * v.y + oz * v.z;
+	            const float lw = ox * w.x + oy * w.y + oz * w.z;
+	            const float cu = std::min(std::max(lu, -extents.x), extents.x);
+	            const float cv = std::min(std::max(lv, -extents.y), extents.y);
+	            const float cw = std::min(std::max(lw, -extents.z), extents.z);
+	            distances_squared[i] = (lu - cu) * (lu - cu) + (lv - cv) * (lv - cv) + (lw - cw) * (lw - cw);
+	            if constexpr (WRITE_CLOSEST)
+	            {
+	                qx[i] = center.x + u.x * cu + v.x * cv + w.x * cw;
+	                qy[i] = center.y + u.y * cu + v.y * cv + w.y * cw;
+	                qz[i] = center.z + u.z * cu + v.z * cv + w.z * cw;
+	            }
+	        }
+	    }
+	}
+
+	Vec3 ClosestPointOnSegment(const Vec3 &point, const Vec3 &a, const Vec3 &b)
+	{
+	    const Vec3 ab = b - a;
+	    return a + ab * SegmentParameter(point.x, point.y, point.z, a.x, a.y, a.z, ab.x, ab.y, ab.z);
+	}
+
+	Vec3 ClosestPointOnTriangle(const Vec3 &point, const Vec3 &a, const Vec3 &b, const Vec3 &c)
+	{
+	    const Vec3 ab = b - a;
+	    const Vec3 ac = c - a;
+
+	    // Vertex region a
+	    const Vec3 ap = point - a;
+	    const float d1 = Dot(ab, ap);
+	    const float d2 = Dot(ac, ap);
+	    if (d1 <= 0.0f && d2 <= 0.0f)
+	        return a;
+
+	    // Vertex region b
+	    const Vec3 bp = point - b;
+	    const float d3 = Dot(ab, bp);
+	    const float d4 = Dot(ac, bp);
+	    if (d3 >= 0.0f && d4 <= d3)
+	        return b;
+
+	    // Edge region ab
+	    const float vc = d1 * d4 - d3 * d2;
+	    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+	        return a + ab * (d1 / (d1 - d3));
+
+	    // Vertex region c
+	    const Vec3 cp = point - c;
+	    const float d5 = Dot(ab, cp);
+	    const float d6 = Dot(ac, cp);
+	    if (d6 >= 0.0f && d5 <= d6)
+	        return c;
+
+	    // Edge region ac
+	    const float vb = d5 * d2 - d1 * d6;
+	    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+	        return a + ac * (d2 / (d2 - d6));
+
+	    // Edge region bc
+	    const float va = d3 * d6 - d5 * d4;
+	    if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f)
+	        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+	    // Face region; a degenerate triangle that reaches here falls back to its edges
+	    const float sum = va + vb + vc;
+	    if (sum <= 0.0f)
+	    {
+	        const Vec3 candidates[3] = { ClosestPointOnSegment(point, a, b), ClosestPointOnSegment(point, a, c), ClosestPointOnSegment(point, b, c) };
+	        const auto distance = [&](const Vec3 &candidate) { return Dot(point - candidate, point - candidate); };
+	        return *std::min_element(candidates, candidates + 3, [&](const Vec3 &l, const Vec3 &r) { return distance(l) < distance(r); });
+	    }
+	    const float denominator = 1.0f / sum;
+	    return a + ab * (vb * denominator) + ac * (vc * denominator);
+	}
+
+	float ClosestPointsSegmentSegment(const Vec3 &a0, const Vec3 &a1, const Vec3 &b0, const Vec3 &b1, Vec3 &point_a, Vec3 &point_b)
+	{
+	    const Vec3 d1 = a1 - a0;
+	    const Vec3 d2 = b1 - b0;
+	    const Vec3 r = a0 - b0;
+	    float s, t;
+	    SegmentSegmentParameters(d1.x, d1.y, d1.z, d2.x, d2.y, d2.z, r.x, r.y, r.z, s, t);
+	    point_a = a0 + d1 * s;
+	    point_b = b0 + d2 * t;
+	    return Dot(point_a - point_b, point_a - point_b);
+	}
+
+	float ClosestPointsTriangleTriangle(const Vec3 &a0, const Vec3 &a1, const Vec3 &a2, const Vec3 &b0, const Vec3 &b1, const Vec3 &b2,
+	                                    Vec3 &point_a, Vec3 &point_b)
+	{
+	    const Vec3 a[3] = { a0, a1, a2 };
+	    const Vec3 b[3] = { b0, b1, b2 };
+
+	    // Intersecting triangles: an edge of one crosses the other (coplanar overlaps are caught
+	    // below with zero distance)
+	    for (int i = 0; i < 3; i++)
+	    {
+	        Vec3 hit;
+	        if (IntersectSegmentTriangle(a[i], a[(i + 1) % 3], b0, b1, b2, hit) || IntersectSegmentTriangle(b[i], b[(i + 1) % 3], a0, a1, a2, hit))
+	        {
+	            point_a = hit;
+	            point_b = hit;
+	            return 0.0f;
+	        }
+	    }
+
+	    float best = FLT_MAX;
+	    const auto update = [&](const Vec3 &on_a, const Vec3 &on_b)
+	    {
+	        const float distance = Dot(on_a - on_b, on_a - on_b);
+	        if (distance < best)
+	        {
+	            best = distance;
+	            point_a = on_a;
+	            point_b = on_b;
+	        }
+	    };
+
+	    for (int i = 0; i < 3; i++)
+	    {
+	        for (int j = 0; j < 3; j++)
+	        {
+	            Vec3 on_a, on_b;
+	            ClosestPointsSegmentSegment(a[i], a[(i + 1) % 3], b[j], b[(j + 1) % 3], on_a, on_b);
+	            update(on_a, on_b);
+	        }
+	    }
+	    for (int i = 0; i < 3; i++)
+	    {
+	        update(a[i], ClosestPointOnTriangle(a[i], b0, b1, b2));
+	        update(ClosestPointOnTriangle(b[i], a0, a1, a2), b[i]);
+	    }
+	    return best;
+	}
+
+	void ClosestPointsOnSegments(const Vec3SoA &points, const Vec3SoA &a, const Vec3SoA &b, float *distances_squared, Vec3SoA *closest)
+	{
+	    const size_t count = points.Size();
+	    assert(a.Size() == count && b.Size() == count);
+	    assert(distances_squared != nullptr || count == 0);
+
+	    if (closest)
+	    {
+	        closest->Resize(count);
+	        SegmentBatch<true>(points, a, b, distances_squared, closest->x.data(), closest->y.data(), closest->z.data());
+	    }
+	    else
+	    {
+	        SegmentBatch<false>(points, a, b, distances_squared, nullptr, nullptr, nullptr);
+	    }
+	}
+
+	void ClosestPointsOnTriangles(const Vec3SoA &points, const Vec3SoA &a, const Vec3SoA &b, const Vec3SoA &c, float *distances_squared, Vec3SoA *closest)
+	{
+	    const size_t count = points.Size();
+	    assert(a.Size() == count && b.Size() == count && c.Size() == count);
+	    assert(distances_squared != nullptr || count == 0);
+
+	    if (closest)
+	    {
+	        closest->Resize(count);
+	        TriangleBatch<true>(points, a, b, c, distances_squared, closest->x.data(), closest->y.data(), closest->z.data());
+	    }
+	    else
+	    {
+	        TriangleBatch<false>(points, a, b, c, distances_squared, nullptr, nullptr, nullptr);
+	    }
+	}
+
+	void ClosestPointsSegmentsSegments(const Vec3SoA &a0, const Vec3SoA &a1, const Vec3SoA &b0, const Vec3SoA &b1, float *distances_squared,
+	                                   Vec3SoA *closest_a, Vec3SoA *closest_b)
+	{
+	    const size_t count = a0.Size();
+	    assert(a1.Size() == count && b0.Size() == count && b1.Size() == count);
+	    assert(distances_squared != nullptr || count == 0);
+
+	    // Both outputs or none keeps the loop free of per-element branches
+	    Vec3SoA scratch;
+	    if (closest_a || closest_b)
+	    {
+	        Vec3SoA &out_a = closest_a ? *closest_a : scratch;
+	        Vec3SoA &out_b = closest_b ? *closest_b : scratch;
+	        out_a.Resize(count);
+	        out_b.Resize(count);
+	        SegmentPairBatch<true>(a0, a1, b0, b1, distances_squared, &out_a, &out_b);
+	    }
+	    else
+	    {
+	        SegmentPairBatch<false>(a0, a1, b0, b1, distances_squared, nullptr, nullptr);
+	    }
+	}
+
+	void ClosestPointsOnOBB(const OrientedBoundingBox &box, const Vec3SoA &points, float *distances_squared, Vec3SoA *closest)
+	{
+	    assert(distances_squared != nullptr || points.Size() == 0);
+
+	    if (closest)
+	    {
+	        closest->Resize(points.Size());
+	        OBBBatch<true>(box, points, distances_squared, closest->x.data(), closest->y.data(), closest->z.data());
+	    }
+	    else
+	    {
+	        OBBBatch<false>(box, points, distances_squared, nullptr, nullptr, nullptr);
+	    }
+	}
+}
+
+/// -------------------------------------------------------
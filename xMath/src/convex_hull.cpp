@@ -0,0 +1,744 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* convex_hull.cpp
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include <xmath.hpp>
+#include <xMath/includes/convex_hull.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	namespace
+	{
+	    constexpr uint32_t NONE = ConvexHull::INVALID_INDEX;
+
+	    // Edge of the hole left by the visible faces, with the half-edge across it on the kept side
+	    struct HorizonEdge
+	    {
+	        uint32_t from;
+	        uint32_t to;
+	        uint32_t twin;
+	    };
+
+	    // Newell normal of a polygon; its length is twice the area
+	    Vec3 GetPolygonNormal(const Vec3 *points, const uint32_t *polygon, const size_t count)
+	    {
+	        Vec3 normal(0.0f);
+	        for (size_t i = 0; i < count; i++)
+	        {
+	            const Vec3 &a = points[polygon[i]];
+	            const Vec3 &b = points[polygon[(i + 1) % count]];
+	            normal.x += (a.y - b.y) * (a.z + b.z);
+	            normal.y += (a.z - b.z) * (a.x + b.x);
+	            normal.z += (a.x - b.x) * (a.y + b.y);
+	        }
+	        return normal;
+	    }
+
+	    // Removes polygon vertices that lie within epsilon of the line through their neighbors
+	    void RemoveCollinear(const Vec3 *points, std::vector<uint32_t> &polygon, const float epsilon)
+	    {
+	        bool removed = true;
+	        while (removed && polygon.size() > 3)
+	        {
+	            removed = false;
+	            for (size_t i = 0; i < polygon.size() && polygon.size() > 3; i++)
+	            {
+	                const Vec3 &prev = points[polygon[(i + polygon.size() - 1) % polygon.size()]];
+	                const Vec3 &next = points[polygon[(i + 1) % polygon.size()]];
+	                const Vec3 line = next - prev;
+	                const float length_squared = Length2(line);
+	                const Vec3 offset = points[polygon[i]] - prev;
+	                const float distance_squared = length_squared > 0.0f ? Length2(Cross(offset, line)) / length_squared : Length2(offset);
+	                if (distance_squared <= epsilon * epsilon)
+	                {
+	                    polygon.erase(polygon.begin() + static_cast<std::ptrdiff_t>(i));
+	                    removed = true;
+	                }
+	            }
+	        }
+	    }
+	}
+
+	bool ConvexHull::Build(const Vec3 *points, const size_t count, const ConvexHullSettings &settings)
+	{
+	    assert(points != nullptr || count == 0);
+	    assert(count < NONE);
+
+	    Clear();
+	    m_HalfEdges.clear();
+	    m_BuildFaces.clear();
+	    m_FreeHalfEdges.clear();
+	    m_FreeFaces.clear();
+	    if (count < 3)
+	        return false;
+
+	    // Tolerance from the magnitude of the coordinates, as in qhull
+	    uint32_t extremes[6] = {};
+	    Vec3 max_abs(0.0f);
+	    for (uint32_t i = 0; i < count; i++)
+	    {
+	        for (int axis = 0; axis < 3; axis++)
+	        {
+	            if (points[i][axis] < points[extremes[axis * 2]][axis])
+	                extremes[axis * 2] = i;
+	            if (points[i][axis] > points[extremes[axis * 2 + 1]][axis])
+	                extremes[axis * 2 + 1] = i;
+	            max_abs[axis] = std::max(max_abs[axis], std::abs(points[i][axis]));
+	        }
+	    }
+	    m_Epsilon = settings.epsilon > 0.0f ? settings.epsilon : 3.0f * FLT_EPSILON * (max_abs.x + max_abs.y + max_abs.z);
+	    const float epsilon = m_Epsilon;
+
+	    // Initial tetrahedron: the most distant pair of extremes, the point furthest from their
+	    // line, and the point furthest from the plane of those three
+	    uint32_t simplex[4] = {};
+	    float best = -1.0f;
+	    for (int a = 0; a < 6; a++)
+	    {
+	        for (int b = a + 1; b < 6; b++)
+	        {
+	            const float distance = Length2(points[extremes[a]] - points[extremes[b]]);
+	            if (distance > best)
+	            {
+	                best = distance;
+	                simplex[0] = extremes[a];
+	                simplex[1] = extremes[b];
+	            }
+	        }
+	    }
+	    if (best <= epsilon * epsilon)
+	        return false;
+
+	    const Vec3 line = points[simplex[1]] - points[simplex[0]];
+	    best = -1.0f;
+	    for (uint32_t i = 0; i < count; i++)
+	    {
+	        const float distance = Length2(Cross(points[i] - points[simplex[0]], line));
+	        if (distance > best)
+	        {
+	            best = distance;
+	            simplex[2] = i;
+	        }
+	    }
+	    if (best <= epsilon * epsilon * Length2(line))
+	        return false;
+
+	    const Vec3 normal = Normalize(Cross(line, points[simplex[2]] - points[simplex[0]]));
+	    float furthest = 0.0f;
+	    for (uint32_t i = 0; i < count; i++)
+	    {
+	        const float distance = Dot(normal, points[i] - points[simplex[0]]);
+	        if (std::abs(distance) > std::abs(furthest))
+	        {
+	            furthest = distance;
+	            simplex[3] = i;
+	        }
+	    }
+	    if (std::abs(furthest) <= epsilon)
+	    {
+	        BuildFlat(points, count, normal, points[simplex[0]]);
+	        return !IsEmpty();
+	    }
+
+	    const auto allocate_edge = [this]
+	    {
+	        if (m_FreeHalfEdges.empty())
+	        {
+	            m_HalfEdges.push_back({});
+	            return static_cast<uint32_t>(m_HalfEdges.size() - 1);
+	        }
+	        const uint32_t edge = m_FreeHalfEdges.back();
+	        m_FreeHalfEdges.pop_back();
+	        return edge;
+	    };
+
+	    // Adds triangle a -> b -> c (counter-clockwise seen from outside); twins are left unset
+	    const auto add_face = [&](const uint32_t a, const uint32_t b, const uint32_t c)
+	    {
+	        uint32_t face;
+	        if (m_FreeFaces.empty())
+	        {
+	            face = static_cast<uint32_t>(m_BuildFaces.size());
+	            m_BuildFaces.push_back({});
+	        }
+	        else
+	        {
+	            face = m_FreeFaces.back();
+	            m_FreeFaces.pop_back();
+	        }
+
+	        const uint32_t e0 = allocate_edge(), e1 = allocate_edge(), e2 = allocate_edge();
+	        m_HalfEdges[e0] = { a, e1, NONE, face };
+	        m_HalfEdges[e1] = { b, e2, NONE, face };
+	        m_HalfEdges[e2] = { c, e0, NONE, face };
+	        m_BuildFaces[face] = { e0, Plane(points[a], points[b], points[c]), NONE, NONE, 0.0f, 0, true };
+	        return face;
+	    };
+
+	    // Adds a point to the outside list of the face it is furthest in front of, if any
+	    const auto assign_point = [&](const uint32_t point, const uint32_t *faces, const size_t face_count)
+	    {
+	        uint32_t best_face = NONE;
+	        float best_distance = epsilon;
+	        for (size_t i = 0; i < face_count; i++)
+	        {
+	            const float distance = m_BuildFaces[faces[i]].plane.Dot(points[point]);
+	            if (distance > best_distance)
+	            {
+	                best_distance = distance;
+	                best_face = faces[i];
+	            }
+	        }
+	        if (best_face == NONE)
+	            return;
+
+	        BuildFace &face = m_BuildFaces[best_face];
+	        m_NextOutside[point] = face.outside;
+	        face.outside = point;
+	        if (best_distance > face.farthest_distance)
+	        {
+	            face.farthest_distance = best_distance;
+	            face.farthest = point;
+	        }
+	    };
+
+	    // Orient the tetrahedron so every face has the opposite vertex behind it
+	    if (furthest > 0.0f)
+	        std::swap(simplex[1], simplex[2]);
+	    static constexpr int tetrahedron[4][4] = { { 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 1, 3, 2, 0 }, { 2, 3, 0, 1 } };
+	    uint32_t initial_faces[4];
+	    for (int f = 0; f < 4; f++)
+	    {
+	        uint32_t a = simplex[tetrahedron[f][0]], b = simplex[tetrahedron[f][1]], c = simplex[tetrahedron[f][2]];
+	        if (Plane(points[a], points[b], points[c]).Dot(points[simplex[tetrahedron[f][3]]]) > 0.0f)
+	            std::swap(b, c);
+	        initial_faces[f] = add_face(a, b, c);
+	    }
+	    for (uint32_t e = 0; e < m_HalfEdges.size(); e++)
+	    {
+	        for (uint32_t other = 0; other < m_HalfEdges.size(); other++)
+	        {
+	            if (m_HalfEdges[other].origin == m_HalfEdges[m_HalfEdges[e].next].origin && m_HalfEdges[m_HalfEdges[other].next].origin == m_HalfEdges[e].origin)
+	                m_HalfEdges[e].twin = other;
+	        }
+	    }
+
+	    m_NextOutside.assign(count, NONE);
+	    for (uint32_t i = 0; i < count; i++)
+	    {
+	        if (i != simplex[0] && i != simplex[1] && i != simplex[2] && i != simplex[3])
+	            assign_point(i, initial_faces, 4);
+	    }
+
+	    std::vector<uint32_t> pending(initial_faces, initial_faces + 4);
+	    std::vector<uint32_t> visible, new_faces;
+	    std::vector<HorizonEdge> horizon;
+	    std::vector<std::pair<uint32_t, uint32_t>> search;
+	    std::vector<uint32_t> &orphans = m_Scratch;
+	    uint32_t stamp = 0;
+	    while (!pending.empty())
+	    {
+	        const uint32_t start = pending.back();
+	        pending.pop_back();
+	        if (!m_BuildFaces[start].alive || m_BuildFaces[start].outside == NONE)
+	            continue;
+
+	        const uint32_t eye = m_BuildFaces[start].farthest;
+	        const Vec3 &eye_point = points[eye];
+
+	        // Depth-first search over the faces the eye sees; the edges into faces it does not
+	        // see are the horizon, found in order around the hole
+	        stamp++;
+	        visible.clear();
+	        horizon.clear();
+	        m_BuildFaces[start].visit = stamp;
+	        visible.push_back(start);
+	        search.assign(1, { m_BuildFaces[start].edge, 3 });
+	        while (!search.empty())
+	        {
+	            auto &[edge, remaining] = search.back();
+	            if (remaining == 0)
+	            {
+	                search.pop_back();
+	                continue;
+	            }
+
+	            const HalfEdge current = m_HalfEdges[edge];
+	            edge = current.next;
+	            remaining--;
+
+	            const HalfEdge &twin = m_HalfEdges[current.twin];
+	            BuildFace &neighbor = m_BuildFaces[twin.face];
+	            if (neighbor.visit == stamp)
+	                continue;
+	            if (neighbor.plane.Dot(eye_point) > epsilon)
+	            {
+	                neighbor.visit = stamp;
+	                visible.push_back(twin.face);
+	                search.emplace_back(twin.next, 2);
+	            }
+	            else
+	            {
+	                horizon.push_back({ current.origin, m_HalfEdges[current.next].origin, current.twin });
+	            }
+	        }
+
+	        // Release the visible faces, keeping their outside points for reassignment
+	        orphans.clear();
+	        for (const uint32_t face : visible)
+	        {
+	            BuildFace &build_face = m_BuildFaces[face];
+	            for (uint32_t point = build_face.outside; point != NONE; point = m_NextOutside[point])
+	            {
+	                if (point != eye)
+	                    orphans.push_back(point);
+	            }
+	            uint32_t edge = build_face.edge;
+	            for (int i = 0; i < 3; i++)
+	            {
+	                m_FreeHalfEdges.push_back(edge);
+	                edge = m_HalfEdges[edge].next;
+	            }
+	            build_face.alive = false;
+	            m_FreeFaces.push_back(face);
+	        }
+
+	        // Cone of new faces from the horizon to the eye
+	        new_faces.clear();
+	        for (const HorizonEdge &edge : horizon)
+	        {
+	            const uint32_t face = add_face(edge.from, edge.to, eye);
+	            const uint32_t base = m_BuildFaces[face].edge;
+	            m_HalfEdges[base].twin = edge.twin;
+	            m_HalfEdges[edge.twin].twin = base;
+	            new_faces.push_back(face);
+	        }
+	        for (size_t i = 0; i < new_faces.size(); i++)
+	        {
+	            assert(horizon[i].to == horizon[(i + 1) % horizon.size()].from);
+	            const uint32_t to_eye = m_HalfEdges[m_BuildFaces[new_faces[i]].edge].next;
+	            const uint32_t next_from_eye = m_HalfEdges[m_HalfEdges[m_BuildFaces[new_faces[(i + 1) % new_faces.size()]].edge].next].next;
+	            m_HalfEdges[to_eye].twin = next_from_eye;
+	            m_HalfEdges[next_from_eye].twin = to_eye;
+	        }
+
+	        for (const uint32_t point : orphans)
+	            assign_point(point, new_faces.data(), new_faces.size());
+	        for (const uint32_t face : new_faces)
+	        {
+	            if (m_BuildFaces[face].outside != NONE)
+	                pending.push_back(face);
+	        }
+	    }
+
+	    ExtractPolygons(points, count);
+	    BuildTopology();
+	    return !IsEmpty();
+	}
+
+	void ConvexHull::BuildFlat(const Vec3 *points, const size_t count, const Vec3 &normal, const Vec3 &origin)
+	{
+	    // Andrew's monotone chain in a basis of the plane
+	    const Vec3 u = Normalize(std::abs(normal.x) < 0.6f ? Cross(normal, Vec3(1.0f, 0.0f, 0.0f)) : Cross(normal, Vec3(0.0f, 1.0f, 0.0f)));
+	    const Vec3 v = Cross(normal, u);
+	    std::vector<uint32_t> &order = m_Scratch;
+	    order.resize(count);
+	    for (uint32_t i = 0; i < count; i++)
+	        order[i] = i;
+	    const auto project = [&](const uint32_t i) { const Vec3 offset = points[i] - origin; return std::make_pair(Dot(offset, u), Dot(offset, v)); };
+	    std::sort(order.begin(), order.end(), [&](const uint32_t l, const uint32_t r) { return project(l) < project(r); });
+
+	    const auto turn = [&](const uint32_t o, const uint32_t a, const uint32_t b)
+	    {
+	        const auto [ox, oy] = project(o);
+	        const auto [ax, ay] = project(a);
+	        const auto [bx, by] = project(b);
+	        return (ax - ox) * (by - oy) - (ay - oy) * (bx - ox);
+	    };
+
+	    std::vector<uint32_t> polygon;
+	    for (int pass = 0; pass < 2; pass++)
+	    {
+	        const size_t base = polygon.size();
+	        for (size_t k = 0; k < count; k++)
+	        {
+	            const uint32_t i = pass == 0 ? order[k] : order[count - 1 - k];
+	            while (polygon.size() >= base + 2 && turn(polygon[polygon.size() - 2], polygon.back(), i) <= 0.0f)
+	                polygon.pop_back();
+	            polygon.push_back(i);
+	        }
+	        polygon.pop_back();
+	    }
+	    RemoveCollinear(points, polygon, m_Epsilon);
+	    if (polygon.size() < 3)
+	        return;
+
+	    // Front face counter-clockwise around the normal, back face reversed
+	    Vec3 center(0.0f);
+	    for (const uint32_t i : polygon)
+	    {
+	        m_SourceIndices.push_back(i);
+	        m_Vertices.push_back(points[i]);
+	        center += points[i];
+	    }
+	    center = center / static_cast<float>(polygon.size());
+
+	    const auto size = static_cast<uint32_t>(polygon.size());
+	    m_Planes.emplace_back(normal, -Dot(normal, center));
+	    m_Planes.emplace_back(-normal, Dot(normal, center));
+	    m_FaceOffsets = { 0, size, size * 2 };
+	    for (uint32_t i = 0; i < size; i++)
+	        m_FaceIndices.push_back(i);
+	    for (uint32_t i = 0; i < size; i++)
+	        m_FaceIndices.push_back(size - 1 - i);
+	    BuildTopology();
+	}
+
+	void ConvexHull::ExtractPolygons(const Vec3 *points, const size_t count)
+	{
+	    // Groups of adjacent triangles within epsilon of the plane of the group's first triangle
+	    std::vector<uint32_t> group(m_BuildFaces.size(), NONE), members, polygon;
+	    std::vector<uint32_t> &remap = m_Scratch;
+	    std::vector<uint32_t> &boundary_next = m_NextOutside;
+	    remap.assign(count, NONE);
+	    boundary_next.assign(count, NONE);
+
+	    const auto emit = [&](const std::vector<uint32_t> &vertices)
+	    {
+	        const Vec3 normal = GetPolygonNormal(points, vertices.data(), vertices.size());
+	        if (Length2(normal) == 0.0f)
+	            return;
+
+	        Vec3 center(0.0f);
+	        for (const uint32_t vertex : vertices)
+	        {
+	            center += points[vertex];
+	            if (remap[vertex] == NONE)
+	            {
+	                remap[vertex] = static_cast<uint32_t>(m_Vertices.size());
+	                m_Vertices.push_back(points[vertex]);
+	                m_SourceIndices.push_back(vertex);
+	            }
+	            m_FaceIndices.push_back(remap[vertex]);
+	        }
+	        const Vec3 unit = Normalize(normal);
+	        m_Planes.emplace_back(unit, -Dot(unit, center / static_cast<float>(vertices.size())));
+	        m_FaceOffsets.push_back(static_cast<uint32_t>(m_FaceIndices.size()));
+	    };
+
+	    // Largest triangles first: their planes are the most accurate seeds
+	    std::vector<std::pair<float, uint32_t>> seeds;
+	    for (uint32_t face = 0; face < m_BuildFaces.size(); face++)
+	    {
+	        if (!m_BuildFaces[face].alive)
+	            continue;
+	        const HalfEdge &edge = m_HalfEdges[m_BuildFaces[face].edge];
+	        const Vec3 &a = points[edge.origin];
+	        const Vec3 &b = points[m_HalfEdges[edge.next].origin];
+	        const Vec3 &c = points[m_HalfEdges[m_HalfEdges[edge.next].next].origin];
+	        seeds.emplace_back(Length2(Cross(b - a, c - a)), face);
+	    }
+	    std::sort(seeds.begin(), seeds.end(), [](const auto &l, const auto &r) { return l.first > r.first; });
+
+	    m_FaceOffsets.assign(1, 0);
+	    uint32_t group_count = 0;
+	    for (const auto &[area, seed] : seeds)
+	    {
+	        if (group[seed] != NONE)
+	            continue;
+
+	        const Plane &plane = m_BuildFaces[seed].plane;
+	        const uint32_t id = group_count++;
+	        group[seed] = id;
+	        members.assign(1, seed);
+	        for (size_t m = 0; m < members.size(); m++)
+	        {
+	            uint32_t edge = m_BuildFaces[members[m]].edge;
+	            for (int i = 0; i < 3; i++, edge = m_HalfEdges[edge].next)
+	            {
+	                const uint32_t neighbor = m_HalfEdges[m_HalfEdges[edge].twin].face;
+	                if (group[neighbor] != NONE || Dot(m_BuildFaces[neighbor].plane.normal, plane.normal) <= 0.0f)
+	                    continue;
+
+	                bool coplanar = true;
+	                uint32_t neighbor_edge = m_BuildFaces[neighbor].edge;
+	                for (int j = 0; j < 3; j++, neighbor_edge = m_HalfEdges[neighbor_edge].next)
+	                    coplanar &= std::abs(plane.Dot(points[m_HalfEdges[neighbor_edge].origin])) <= m_Epsilon;
+	                if (coplanar)
+	                {
+	                    group[neighbor] = id;
+	                    members.push_back(neighbor);
+	                }
+	            }
+	        }
+
+	        // Walk the boundary of the group from vertex to vertex
+	        uint32_t first = NONE;
+	        size_t boundary_count = 0;
+	        for (const uint32_t member : members)
+	        {
+	            uint32_t edge = m_BuildFaces[member].edge;
+	            for (int i = 0; i < 3; i++, edge = m_HalfEdges[edge].next)
+	            {
+	                if (group[m_HalfEdges[m_HalfEdges[edge].twin].face] == id)
+	                    continue;
+	                first = m_HalfEdges[edge].origin;
+	                boundary_next[first] = m_HalfEdges[m_HalfEdges[edge].next].origin;
+	                boundary_count++;
+	            }
+	        }
+
+	        polygon.clear();
+	        uint32_t vertex = first;
+	        do
+	        {
+	            polygon.push_back(vertex);
+	            vertex = boundary_next[vertex];
+	        } while (vertex != first && polygon.size() <= boundary_count);
+
+	        if (vertex != first || polygon.size() != boundary_count)
+	        {
+	            // Not a simple loop (only for inconsistent input); keep the triangles as they are
+	            for (const uint32_t member : members)
+	            {
+	                const uint32_t edge = m_BuildFaces[member].edge;
+	                polygon = { m_HalfEdges[edge].origin, m_HalfEdges[m_HalfEdges[edge].next].origin, m_HalfEdges[m_HalfEdges[m_HalfEdges[edge].next].next].origin };
+	                emit(polygon);
+	            }
+	            continue;
+	        }
+
+	        RemoveCollinear(points, polygon, m_Epsilon);
+	        if (polygon.size() >= 3)
+	            emit(polygon);
+	    }
+	}
+
+	void ConvexHull::BuildTopology()
+	{
+	    // Every face edge, keyed by its sorted vertex pair so the two sides end up adjacent
+	    struct FaceEdge
+	    {
+	        uint32_t low;
+	        uint32_t high;
+	        uint32_t from;
+	        uint32_t face;
+	    };
+	    std::vector<FaceEdge> face_edges;
+	    face_edges.reserve(m_FaceIndices.size());
+	    for (uint32_t face = 0; face + 1 < m_FaceOffsets.size(); face++)
+	    {
+	        const uint32_t begin = m_FaceOffsets[face], end = m_FaceOffsets[face + 1];
+	        for (uint32_t i = begin; i < end; i++)
+	        {
+	            const uint32_t from = m_FaceIndices[i];
+	            const uint32_t to = m_FaceIndices[i + 1 < end ? i + 1 : begin];
+	            face_edges.push_back({ std::min(from, to), std::max(from, to), from, face });
+	        }
+	    }
+	    std::sort(face_edges.begin(), face_edges.end(), [](const FaceEdge &l, const FaceEdge &r) { return l.low != r.low ? l.low < r.low : l.high < r.high; });
+
+	    m_Edges.clear();
+	    for (size_t i = 0; i < face_edges.size(); i++)
+	    {
+	        const FaceEdge &edge = face_edges[i];
+	        Edge result{ { edge.from, edge.from == edge.low ? edge.high : edge.low }, { edge.face, INVALID_INDEX } };
+	        if (i + 1 < face_edges.size() && face_edges[i + 1].low == edge.low && face_edges[i + 1].high == edge.high)
+	            result.faces[1] = face_edges[++i].face;
+	        m_Edges.push_back(result);
+	    }
+
+	    m_NeighborOffsets.assign(m_Vertices.size() + 1, 0);
+	    for (const Edge &edge : m_Edges)
+	    {
+	        m_NeighborOffsets[edge.vertices[0] + 1]++;
+	        m_NeighborOffsets[edge.vertices[1] + 1]++;
+	    }
+	    for (size_t v = 0; v < m_Vertices.size(); v++)
+	        m_NeighborOffsets[v + 1] += m_NeighborOffsets[v];
+
+	    m_Neighbors.resize(m_NeighborOffsets.back());
+	    std::vector<uint32_t> fill(m_NeighborOffsets.begin(), m_NeighborOffsets.end() - 1);
+	    for (const Edge &edge : m_Edges)
+	    {
+	        m_Neighbors[fill[edge.vertices[0]]++] = edge.vertices[1];
+	        m_Neighbors[fill[edge.vertices[1]]++] = edge.vertices[0];
+	    }
+	}
+
+	bool ConvexHull::Simplify(const uint32_t max_faces)
+	{
+	    assert(max_faces >= 4);
+	    const size_t face_count = m_Planes.size();
+	    if (face_count <= max_faces || face_count <= 2)
+	        return false;
+
+	    // Face areas and a point strictly inside
+	    std::vector<float> areas(face_count);
+	    for (size_t face = 0; face < face_count; face++)
+	    {
+	        uint32_t count;
+	        const uint32_t *vertices = GetFaceVertices(face, count);
+	        areas[face] = 0.5f * Length(GetPolygonNormal(m_Vertices.data(), vertices, count));
+	    }
+	    Vec3 center(0.0f);
+	    for (const Vec3 &vertex : m_Vertices)
+	        center += vertex;
+	    center = center / static_cast<float>(m_Vertices.size());
+
+	    // Greedy choice: large faces whose normals differ from the ones already chosen
+	    std::vector<uint32_t> chosen;
+	    std::vector<float> closest_dot(face_count, -1.0f);
+	    std::vector<bool> used(face_count, false);
+	    const auto choose_next = [&]
+	    {
+	        size_t best = 0;
+	        float best_score = -1.0f;
+	        for (size_t face = 0; face < face_count; face++)
+	        {
+	            const float score = areas[face] * (1.0f - std::max(closest_dot[face], 0.0f));
+	            if (!used[face] && score > best_score)
+	            {
+	                best_score = score;
+	                best = face;
+	            }
+	        }
+	        used[best] = true;
+	        chosen.push_back(static_cast<uint32_t>(best));
+	        for (size_t face = 0; face < face_count; face++)
+	            closest_dot[face] = std::max(closest_dot[face], Dot(m_Planes[face].normal, m_Planes[best].normal));
+	    };
+	    while (chosen.size() < max_faces)
+	        choose_next();
+
+	    // The intersection of the half-spaces n.(x - c) <= h is the dual of the hull of the
+	    // points n / h: each dual face m.y = k maps back to the vertex c + m / k. The region is
+	    // bounded exactly when the dual hull contains the origin strictly.
+	    std::vector<Vec3> dual_points, vertices;
+	    ConvexHull dual;
+	    while (true)
+	    {
+	        dual_points.clear();
+	        for (const uint32_t face : chosen)
+	        {
+	            const Plane &plane = m_Planes[face];
+	            const float height = -(plane.d + Dot(plane.normal, center));
+	            dual_points.push_back(plane.normal / height);
+	        }
+
+	        bool bounded = dual.Build(dual_points.data(), dual_points.size());
+	        for (const Plane &plane : dual.GetPlanes())
+	            bounded &= -plane.d > dual.m_Epsilon;
+	        if (bounded)
+	            break;
+	        if (chosen.size() == face_count)
+	            return false;
+	        choose_next();
+	    }
+
+	    for (const Plane &plane : dual.GetPlanes())
+	        vertices.push_back(center + plane.normal / -plane.d);
+
+	    // Built aside so a failed build leaves this hull untouched
+	    ConvexHull simplified;
+	    if (!simplified.Build(vertices.data(), vertices.size()))
+	        return false;
+
+	    // The vertices are new points, not input points
+	    simplified.m_SourceIndices.assign(simplified.m_Vertices.size(), INVALID_INDEX);
+	    std::swap(*this, simplified);
+	    return true;
+	}
+
+	void ConvexHull::Clear()
+	{
+	    m_Vertices.clear();
+	    m_SourceIndices.clear();
+	    m_Planes.clear();
+	    m_FaceOffsets.clear();
+	    m_FaceIndices.clear();
+	    m_Edges.clear();
+	    m_NeighborOffsets.clear();
+	    m_Neighbors.clear();
+	}
+
+	bool ConvexHull::Contains(const Vec3 &point, const float tolerance) const
+	{
+	    for (const Plane &plane : m_Planes)
+	    {
+	        if (plane.Dot(point) > tolerance)
+	            return false;
+	    }
+	    return !m_Planes.empty();
+	}
+
+	Vec3 ConvexHull::Support(const Vec3 &direction) const
+	{
+	    assert(!m_Vertices.empty());
+
+	    // The support function of a convex polytope has no local maxima, so climbing always ends at the top
+	    uint32_t current = 0;
+	    float best = Dot(m_Vertices[0], direction);
+	    for (bool improved = true; improved;)
+	    {
+	        improved = false;
+	        for (uint32_t n = m_NeighborOffsets[current]; n < m_NeighborOffsets[current + 1]; n++)
+	        {
+	            const float dot = Dot(m_Vertices[m_Neighbors[n]], direction);
+	            if (dot > best)
+	            {
+	                best = dot;
+	                current = m_Neighbors[n];
+	                improved = true;
+	            }
+	        }
+	    }
+	    return m_Vertices[current];
+	}
+
+	const uint32_t *ConvexHull::GetFaceVertices(const size_t face, uint32_t &count) const
+	{
+	    assert(face < m_Planes.size());
+	    count = m_FaceOffsets[face + 1] - m_FaceOffsets[face];
+	    return m_FaceIndices.data() + m_FaceOffsets[face];
+	}
+
+	const uint32_t *ConvexHull::GetVertexNeighbors(const uint32_t vertex, uint32_t &count) const
+	{
+	    assert(vertex < m_Vertices.size());
+	    count = m_NeighborOffsets[vertex + 1] - m_NeighborOffsets[vertex];
+	    return m_Neighbors.data() + m_NeighborOffsets[vertex];
+	}
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,178 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* dirty_region.cpp
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <xmath.hpp>
+#include <xMath/includes/dirty_region.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	namespace
+	{
+	    float Area(const Rectangle &rect)
+	    {
+	        return rect.width * rect.height;
+	    }
+
+	    Rectangle Union(const Rectangle &a, const Rectangle &b)
+	    {
+	        const float min_x = std::min(a.x, b.x), min_y = std::min(a.y, b.y);
+	        const float max_x = std::max(a.x + a.width, b.x + b.width), max_y = std::max(a.y + a.height, b.y + b.height);
+	        return {min_x, min_y, max_x - min_x, max_y - min_y};
+	    }
+
+	    float OverlapArea(const Rectangle &a, const Rectangle &b)
+	    {
+	        const float w = std::min(a.x + a.width, b.x + b.width) - std::max(a.x, b.x);
+	        const float h = std::min(a.y + a.height, b.y + b.height) - std::max(a.y, b.y);
+	        return w > 0.0f && h > 0.0f ? w * h : 0.0f;
+	    }
+
+	    // Area of the merged bounds that neither rectangle covers
+	    float MergeWaste(const Rectangle &a, const Rectangle &b, const Rectangle &merged)
+	    {
+	        return Area(merged) - Area(a) - Area(b) + OverlapArea(a, b);
+	    }
+	}
+
+	DirtyRegion::DirtyRegion(const Rectangle &bounds, const uint32_t max_rects, const float merge_threshold) :
+	    m_Bounds(bounds), m_MaxRects(std::max(max_rects, 1u)), m_MergeThreshold(merge_threshold)
+	{
+	    assert(bounds.IsDefined());
+	    m_Rects.reserve(m_MaxRects + 1);
+	}
+
+	void DirtyRegion::Add(const Rectangle &rect)
+	{
+	    // Clip to the surface
+	    const float min_x = std::max(rect.x, m_Bounds.x), min_y = std::max(rect.y, m_Bounds.y);
+	    const float max_x = std::min(rect.x + rect.width, m_Bounds.x + m_Bounds.width);
+	    const float max_y = std::min(rect.y + rect.height, m_Bounds.y + m_Bounds.height);
+	    if (max_x <= min_x || max_y <= min_y)
+	        return;
+
+	    Insert(Rectangle(min_x, min_y, max_x - min_x, max_y - min_y));
+	    EnforceLimit();
+	}
+
+	void DirtyRegion::AddAll()
+	{
+	    m_Rects.clear();
+	    m_Rects.push_back(m_Bounds);
+	}
+
+	void DirtyRegion::Clear()
+	{
+	    m_Rects.clear();
+	}
+
+	void DirtyRegion::Insert(Rectangle rect)
+	{
+	    // Merging can make the result cheap to merge with further rectangles, so repeat until stable
+	    bool merged = true;
+	    while (merged)
+	    {
+	        merged = false;
+	        for (size_t i = 0; i < m_Rects.size(); i++)
+	        {
+	            const Rectangle &existing = m_Rects[i];
+	            if (existing.Contains(rect))
+	                return;
+
+	            const Rectangle combined = Union(existing, rect);
+	            if (MergeWaste(existing, rect, combined) > m_MergeThreshold * Area(combined))
+	                continue;
+
+	            rect = combined;
+	            m_Rects[i] = m_Rects.back();
+	            m_Rects.pop_back();
+	            merged = true;
+	            break;
+	        }
+	    }
+
+	    m_Rects.push_back(rect);
+	}
+
+	void DirtyRegion::EnforceLimit()
+	{
+	    while (m_Rects.size() > m_MaxRects)
+	    {
+	        // Merge the pair that wastes the least area
+	        size_t best_a = 0, best_b = 1;
+	        float best_waste = FLT_MAX;
+	        for (size_t a = 0; a < m_Rects.size(); a++)
+	            for (size_t b = a + 1; b < m_Rects.size(); b++)
+	            {
+	                const float waste = MergeWaste(m_Rects[a], m_Rects[b], Union(m_Rects[a], m_Rects[b]));
+	                if (waste < best_waste)
+	                {
+	                    best_waste = waste;
+	                    best_a = a;
+	                    best_b = b;
+	                }
+	            }
+
+	        const Rectangle combined = Union(m_Rects[best_a], m_Rects[best_b]);
+	        m_Rects[best_b] = m_Rects.back();
+	        m_Rects.pop_back();
+	        m_Rects[best_a] = m_Rects.back();
+	        m_Rects.pop_back();
+	        Insert(combined);
+	    }
+	}
+
+	float DirtyRegion::GetArea() const
+	{
+	    float area = 0.0f;
+	    for (const Rectangle &rect : m_Rects)
+	        area += Area(rect);
+	    return area;
+	}
+
+	float DirtyRegion::GetCoverage() const
+	{
+	    return GetArea() / Area(m_Bounds);
+	}
+
+	Rectangle DirtyRegion::GetBounds() const
+	{
+	    if (m_Rects.empty())
+	        return Rectangle::ZERO;
+
+	    Rectangle bounds = m_Rects[0];
+	    for (size_t i = 1; i < m_Rects.size(); i++)
+	        bounds = Union(bounds, m_Rects[i]);
+	    return bounds;
+	}
+
+}
+
+/// -------------------------------------------------------
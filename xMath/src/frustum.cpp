@@ -25,6 +25,8 @@
 * -------------------------------------------------------
 */
 #include <cassert>
+#include <cmath>
+#include <limits>
 #include <vector.h>
 #include <xmath.hpp>
 #include <xMath/includes/frustum.h>
@@ -80,6 +82,48 @@ namespace xMath
 	    m_Planes[5].Normalize();
 	}
 
+	Frustum::Frustum(const Mat4 &view_projection, const uint8_t depth_flags)
+	{
+	    // Rows of the matrix; each plane is a sum or difference of two rows (Gribb & Hartmann).
+	    // Read through the named elements so the result does not depend on the storage order.
+	    const Mat4 &m = view_projection;
+	    const Vec4 row0(m.m00, m.m01, m.m02, m.m03);
+	    const Vec4 row1(m.m10, m.m11, m.m12, m.m13);
+	    const Vec4 row2(m.m20, m.m21, m.m22, m.m23);
+	    const Vec4 row3(m.m30, m.m31, m.m32, m.m33);
+
+	    // Clip-space depth bounds: z >= 0 or z >= -w at one end, z <= w at the other
+	    const Vec4 depth_low = (depth_flags & DEPTH_NEGATIVE_ONE_TO_ONE) ? row3 + row2 : row2;
+	    const Vec4 depth_high = row3 - row2;
+	    const bool reversed = (depth_flags & DEPTH_REVERSED) != 0;
+
+	    const Vec4 planes[6] = {
+	        reversed ? depth_high : depth_low, // Near
+	        reversed ? depth_low : depth_high, // Far
+	        row3 + row0,                       // Left
+	        row3 - row0,                       // Right
+	        row3 - row1,                       // Top
+	        row3 + row1                        // Bottom
+	    };
+
+	    for (size_t i = 0; i < 6; i++)
+	    {
+	        const Vec4 &p = planes[i];
+	        const float length = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+	        const float inv_length = length > 0.0f ? 1.0f / length : 0.0f;
+
+	        m_Planes[i].normal = Vec3(p.x * inv_length, p.y * inv_length, p.z * inv_length);
+	        m_Planes[i].d = p.w * inv_length;
+	    }
+
+	    // An infinite far plane degenerates (zero normal); use a plane that contains everything
+	    if (depth_flags & DEPTH_INFINITE_FAR)
+	    {
+	        m_Planes[1].normal = Vec3(0.0f, 0.0f, 0.0f);
+	        m_Planes[1].d = std::numeric_limits<float>::max();
+	    }
+	}
+
 	bool Frustum::IsVisible(const Vec3 &center, const Vec3 &extent, bool ignore_depth /*= false*/) const
 	{
 	    return CheckCube(center, extent, ignore_depth) != Intersection::Outside;
@@ -140,6 +184,139 @@ namespace xMath
 	    // otherwise we are fully in view
 	    return Intersection::Inside;
 	}
+
+	Intersection Frustum::CheckCubeMasked(const Vec3 &center, const Vec3 &extent, uint8_t &plane_mask) const
+	{
+	    assert(!center.IsNaN() && !extent.IsNaN());
+
+	    uint8_t mask = plane_mask;
+
+	    for (uint32_t i = 0; i < 6; i++)
+	    {
+	        const uint8_t bit = static_cast<uint8_t>(1u << i);
+	        if (!(mask & bit))
+	            continue;
+
+	        const Plane &plane = m_Planes[i];
+
+	        float d = Dot(plane.normal, center) + plane.d;
+	        float r = std::fabs(plane.normal.x) * extent.x + std::fabs(plane.normal.y) * extent.y + std::fabs(plane.normal.z) * extent.z;
+
+	        if (d + r < 0.0f)
+	            return Intersection::Outside;
+
+	        // fully on the inner side, children never need this plane again
+	        if (d - r >= 0.0f)
+	            mask &= static_cast<uint8_t>(~bit);
+	    }
+
+	    plane_mask = mask;
+	    return mask ? Intersection::Intersects : Intersection::Inside;
+	}
+
+	Intersection Frustum::CheckSphereMasked(const Vec3 &center, float radius, uint8_t &plane_mask) const
+	{
+	    assert(!center.IsNaN() && radius >= 0.0f);
+
+	    uint8_t mask = plane_mask;
+
+	    for (uint32_t i = 0; i < 6; i++)
+	    {
+	        const uint8_t bit = static_cast<uint8_t>(1u << i);
+	        if (!(mask & bit))
+	            continue;
+
+	        const Plane &plane = m_Planes[i];
+	        float distance = Dot(plane.normal, center) + plane.d;
+
+	        if (distance < -radius)
+	            return Intersection::Outside;
+
+	        if (distance >= radius)
+	            mask &= static_cast<uint8_t>(~bit);
+	    }
+
+	    plane_mask = mask;
+	    return mask ? Intersection::Intersects : Intersection::Inside;
+	}
+
+	bool Frustum::IsVisibleCoherent(const Vec3 &center, const Vec3 &extent, uint8_t &last_plane) const
+	{
+	    assert(!center.IsNaN() && !extent.IsNaN());
+
+	    const auto is_outside = [&](uint32_t i)
+	    {
+	        const Plane &plane = m_Planes[i];
+	        float d = Dot(plane.normal, center) + plane.d;
+	        float r = std::fabs(plane.normal.x) * extent.x + std::fabs(plane.normal.y) * extent.y + std::fabs(plane.normal.z) * extent.z;
+	        return d + r < 0.0f;
+	    };
+
+	    // last frame's failing plane usually rejects the object again
+	    const uint8_t cached = last_plane;
+	    if (cached < 6 && is_outside(cached))
+	        return false;
+
+	    for (uint32_t i = 0; i < 6; i++)
+	    {
+	        if (i != cached && is_outside(i))
+	        {
+	            last_plane = static_cast<uint8_t>(i);
+	            return false;
+	        }
+	    }
+
+	    last_plane = PLANE_NONE;
+	    return true;
+	}
+
+	size_t Frustum::CullBatch(const BoundingBoxSoA &bounds, uint8_t *visible, uint8_t *last_plane) const
+	{
+	    const size_t count = bounds.Size();
+
+	    const float *cx = bounds.center_x.data();
+	    const float *cy = bounds.center_y.data();
+	    const float *cz = bounds.center_z.data();
+	    const float *ex = bounds.extent_x.data();
+	    const float *ey = bounds.extent_y.data();
+	    const float *ez = bounds.extent_z.data();
+
+	    size_t visible_count = 0;
+
+	    if (last_plane)
+	    {
+	        for (size_t i = 0; i < count; i++)
+	        {
+	            visible[i] = IsVisibleCoherent(Vec3(cx[i], cy[i], cz[i]), Vec3(ex[i], ey[i], ez[i]), last_plane[i]) ? 1 : 0;
+	            visible_count += visible[i];
+	        }
+
+	        return visible_count;
+	    }
+
+	    // plane-major sweep: one plane over the whole batch keeps the inner loop branch free
+	    for (size_t i = 0; i < count; i++)
+	        visible[i] = 1;
+
+	    for (uint32_t p = 0; p < 6; p++)
+	    {
+	        const Plane &plane = m_Planes[p];
+	        const float nx = plane.normal.x, ny = plane.normal.y, nz = plane.normal.z, pd = plane.d;
+	        const float ax = std::fabs(nx), ay = std::fabs(ny), az = std::fabs(nz);
+
+	        for (size_t i = 0; i < count; i++)
+	        {
+	            const float d = nx * cx[i] + ny * cy[i] + nz * cz[i] + pd;
+	            const float r = ax * ex[i] + ay * ey[i] + az * ez[i];
+	            visible[i] &= static_cast<uint8_t>(d + r >= 0.0f);
+	        }
+	    }
+
+	    for (size_t i = 0; i < count; i++)
+	        visible_count += visible[i];
+
+	    return visible_count;
+	}
 }
 
 /// -------------------------------------------------------------
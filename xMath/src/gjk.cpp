@@ -0,0 +1,627 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* gjk.cpp
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+#include <xmath.hpp>
+#include <xMath/includes/gjk.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	namespace
+	{
+	    constexpr uint32_t MAX_GJK_ITERATIONS = 64;
+	    constexpr uint32_t MAX_EPA_ITERATIONS = 255;
+	    constexpr size_t MAX_EPA_FACES = 1024;
+	    constexpr float GJK_TOLERANCE = 1e-6f;   // Relative improvement below which GJK stops
+	    constexpr float EPA_TOLERANCE = 1e-4f;   // Relative improvement below which EPA stops
+	    constexpr float DEGENERATE_EPSILON = 1e-10f;
+
+	    Vec3 SupportBox(const void *data, size_t, const Vec3 &direction)
+	    {
+	        const auto &box = *static_cast<const BoundingBox *>(data);
+	        return { direction.x >= 0.0f ? box.GetMax().x : box.GetMin().x,
+	                 direction.y >= 0.0f ? box.GetMax().y : box.GetMin().y,
+	                 direction.z >= 0.0f ? box.GetMax().z : box.GetMin().z };
+	    }
+
+	    Vec3 SupportSphere(const void *data, size_t, const Vec3 &direction)
+	    {
+	        const auto &sphere = *static_cast<const Sphere *>(data);
+	        const float length = std::sqrt(Dot(direction, direction));
+	        return sphere.center + direction * (sphere.radius / length);
+	    }
+
+	    Vec3 SupportOrientedBox(const void *data, size_t, const Vec3 &direction)
+	    {
+	        const auto &box = *static_cast<const OrientedBoundingBox *>(data);
+	        Vec3 point = box.GetCenter();
+	        for (int i = 0; i < 3; i++)
+	        {
+	            const Vec3 axis = box.GetAxis(i);
+	            point += axis * (Dot(axis, direction) >= 0.0f ? box.GetExtents()[i] : -box.GetExtents()[i]);
+	        }
+	        return point;
+	    }
+
+	    Vec3 SupportPoints(const void *data, const size_t count, const Vec3 &direction)
+	    {
+	        const auto *points = static_cast<const Vec3 *>(data);
+	        size_t best = 0;
+	        float best_dot = Dot(points[0], direction);
+	        for (size_t i = 1; i < count; i++)
+	        {
+	            const float dot = Dot(points[i], direction);
+	            if (dot > best_dot)
+	            {
+	                best_dot = dot;
+	                best = i;
+	            }
+	        }
+	        return points[best];
+	    }
+
+	    // A point of the Minkowski difference a - b with the shape points and direction it came from
+	    struct SupportPoint
+	    {
+	        Vec3 w;
+	        Vec3 a;
+	        Vec3 b;
+	        Vec3 direction;
+	    };
+
+	    SupportPoint GetSupport(const ConvexShape &a, const ConvexShape &b, const Vec3 &direction)
+	    {
+	        const Vec3 point_a = a.Support(direction);
+	        const Vec3 point_b = b.Support(-direction);
+	        return { point_a - point_b, point_a, point_b, direction };
+	    }
+
+	    struct Simplex
+	    {
+	        SupportPoint points[4];
+	        float weights[4] = {};
+	        uint32_t count = 0;
+	    };
+
+	    // Replaces the simplex by the vertices listed, with their barycentric weights
+	    void Keep(Simplex &simplex, const std::initializer_list<std::pair<uint32_t, float>> vertices)
+	    {
+	        SupportPoint points[4];
+	        float weights[4];
+	        uint32_t count = 0;
+	        for (const auto &[index, weight] : vertices)
+	        {
+	            points[count] = simplex.points[index];
+	            weights[count++] = weight;
+	        }
+	        for (uint32_t i = 0; i < count; i++)
+	        {
+	            simplex.points[i] = points[i];
+	            simplex.weights[i] = weights[i];
+	        }
+	        simplex.count = count;
+	    }
+
+	    Vec3 GetClosest(const Simplex &simplex)
+	    {
+	        Vec3 point(0.0f);
+	        for (uint32_t i = 0; i < simplex.count; i++)
+	            point += simplex.points[i].w * simplex.weights[i];
+	        return point;
+	    }
+
+	    void ReduceSegment(Simplex &simplex, const uint32_t i0, const uint32_t i1)
+	    {
+	        const Vec3 &a = simplex.points[i0].w;
+	        const Vec3 edge = simplex.points[i1].w - a;
+	        const float length_squared = Dot(edge, edge);
+	        const float t = length_squared > DEGENERATE_EPSILON ? -Dot(a, edge) / length_squared : 0.0f;
+	        if (t <= 0.0f)
+	            Keep(simplex, { { i0, 1.0f } });
+	        else if (t >= 1.0f)
+	            Keep(simplex, { { i1, 1.0f } });
+	        else
+	            Keep(simplex, { { i0, 1.0f - t }, { i1, t } });
+	    }
+
+	    // Closest point of a triangle to the origin by Voronoi regions (Ericson 5.1.5)
+	    void ReduceTriangle(Simplex &simplex, const uint32_t i0, const uint32_t i1, const uint32_t i2)
+	    {
+	        const Vec3 &a = simplex.points[i0].w;
+	        const Vec3 &b = simplex.points[i1].w;
+	        const Vec3 &c = simplex.points[i2].w;
+	        const Vec3 ab = b - a;
+	        const Vec3 ac = c - a;
+
+	        const float d1 = -Dot(ab, a);
+	        const float d2 = -Dot(ac, a);
+	        if (d1 <= 0.0f && d2 <= 0.0f)
+	            return Keep(simplex, { { i0, 1.0f } });
+
+	        const float d3 = -Dot(ab, b);
+	        const float d4 = -Dot(ac, b);
+	        if (d3 >= 0.0f && d4 <= d3)
+	            return Keep(simplex, { { i1, 1.0f } });
+
+	        // The barycentric numerators as normal . (b x c) and so on, written with the edge vectors.
+	        // The dot product form (Ericson: vc = d1 * d4 - d3 * d2) cancels catastrophically on
+	        // sliver triangles, which GJK produces when a new support point lands near a vertex.
+	        const Vec3 normal = Cross(ab, ac);
+	        const float vc = Dot(normal, Cross(a, ab));
+	        if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f)
+	        {
+	            const float t = d1 / (d1 - d3);
+	            return Keep(simplex, { { i0, 1.0f - t }, { i1, t } });
+	        }
+
+	        const float d5 = -Dot(ab, c);
+	        const float d6 = -Dot(ac, c);
+	        if (d6 >= 0.0f && d5 <= d6)
+	            return Keep(simplex, { { i2, 1.0f } });
+
+	        const float vb = Dot(normal, Cross(ac, a));
+	        if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f)
+	        {
+	            const float t = d2 / (d2 - d6);
+	            return Keep(simplex, { { i0, 1.0f - t }, { i2, t } });
+	        }
+
+	        const float sum = Dot(normal, normal);
+	        const float va = sum - vb - vc;
+	        if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f)
+	        {
+	            const float t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+	            return Keep(simplex, { { i1, 1.0f - t }, { i2, t } });
+	        }
+
+	        if (sum <= DEGENERATE_EPSILON)
+	        {
+	            // Collinear vertices: the closest point is on the longest edge
+	            const float ab_length = Dot(ab, ab), ac_length = Dot(ac, ac), bc_length = Dot(c - b, c - b);
+	            if (ab_length >= ac_length && ab_length >= bc_length)
+	                return ReduceSegment(simplex, i0, i1);
+	            return ac_length >= bc_length ? ReduceSegment(simplex, i0, i2) : ReduceSegment(simplex, i1, i2);
+	        }
+	        Keep(simplex, { { i0, va / sum }, { i1, vb / sum }, { i2, vc / sum } });
+	    }
+
+	    // Closest point of a tetrahedron to the origin: the origin itself if it is inside,
+	    // otherwise the closest point over the faces it lies in front of (Ericson 5.1.6)
+	    void ReduceTetrahedron(Simplex &simplex)
+	    {
+	        static constexpr uint32_t faces[4][4] = { { 0, 1, 2, 3 }, { 0, 2, 3, 1 }, { 0, 3, 1, 2 }, { 1, 3, 2, 0 } };
+
+	        Simplex best;
+	        float best_distance = FLT_MAX;
+	        bool inside = true;
+	        for (const auto &face : faces)
+	        {
+	            const Vec3 &a = simplex.points[face[0]].w;
+	            const Vec3 normal = Cross(simplex.points[face[1]].w - a, simplex.points[face[2]].w - a);
+	            const float origin_side = -Dot(normal, a);
+	            const float opposite_side = Dot(normal, simplex.points[face[3]].w - a);
+	            if (opposite_side != 0.0f && origin_side * opposite_side >= 0.0f)
+	                continue;
+
+	            inside = false;
+	            Simplex candidate = simplex;
+	            ReduceTriangle(candidate, face[0], face[1], face[2]);
+	            const Vec3 closest = GetClosest(candidate);
+	            const float distance = Dot(closest, closest);
+	            if (distance < best_distance)
+	            {
+	                best_distance = distance;
+	                best = candidate;
+	            }
+	        }
+
+	        if (inside)
+	        {
+	            // Weights of the origin from the signed volumes of the sub-tetrahedra
+	            const auto volume = [](const Vec3 &a, const Vec3 &b, const Vec3 &c, const Vec3 &d) { return Dot(Cross(b - a, c - a), d - a); };
+	            const Vec3 origin(0.0f);
+	            const Vec3 &p0 = simplex.points[0].w, &p1 = simplex.points[1].w, &p2 = simplex.points[2].w, &p3 = simplex.points[3].w;
+	            const float total = volume(p0, p1, p2, p3);
+	            simplex.weights[0] = volume(origin, p1, p2, p3) / total;
+	            simplex.weights[1] = volume(p0, origin, p2, p3) / total;
+	            simplex.weights[2] = volume(p0, p1, origin, p3) / total;
+	            simplex.weights[3] = 1.0f - simplex.weights[0] - simplex.weights[1] - simplex.weights[2];
+	            return;
+	        }
+	        simplex = best;
+	    }
+
+	    // Reduces the simplex to the smallest face holding its point closest to the origin and returns that point
+	    Vec3 Reduce(Simplex &simplex)
+	    {
+	        switch (simplex.count)
+	        {
+	        case 1: simplex.weights[0] = 1.0f; break;
+	        case 2: ReduceSegment(simplex, 0, 1); break;
+	        case 3: ReduceTriangle(simplex, 0, 1, 2); break;
+	        default: ReduceTetrahedron(simplex); break;
+	        }
+	        return GetClosest(simplex);
+	    }
+
+	    bool Contains(const Simplex &simplex, const Vec3 &w, const float scale)
+	    {
+	        for (uint32_t i = 0; i < simplex.count; i++)
+	        {
+	            const Vec3 offset = simplex.points[i].w - w;
+	            if (Dot(offset, offset) <= DEGENERATE_EPSILON * scale)
+	                return true;
+	        }
+	        return false;
+	    }
+
+	    struct GJKState
+	    {
+	        Simplex simplex;
+	        Vec3 closest;
+	        bool intersecting = false;
+	        uint32_t iterations = 0;
+	    };
+
+	    // GJK on the Minkowski difference a - b. With EARLY_OUT it stops at the first separating
+	    // axis instead of converging to the closest point.
+	    template <bool EARLY_OUT>
+	    GJKState RunGJK(const ConvexShape &a, const ConvexShape &b, GJKCache *cache)
+	    {
+	        GJKState state;
+	        Simplex &simplex = state.simplex;
+	        float scale = 0.0f;
+
+	        // Warm start from the directions of the previous simplex, skipping repeated points
+	        if (cache != nullptr)
+	        {
+	            for (uint32_t i = 0; i < std::min(cache->count, 4u); i++)
+	            {
+	                const SupportPoint point = GetSupport(a, b, cache->directions[i]);
+	                state.iterations++;
+	                if (simplex.count == 0 || !Contains(simplex, point.w, scale))
+	                {
+	                    simplex.points[simplex.count++] = point;
+	                    scale = std::max(scale, Dot(point.w, point.w));
+	                }
+	            }
+	        }
+	        if (simplex.count == 0)
+	        {
+	            simplex.points[simplex.count++] = GetSupport(a, b, Vec3(1.0f, 0.0f, 0.0f));
+	            state.iterations++;
+	            scale = Dot(simplex.points[0].w, simplex.points[0].w);
+	        }
+	        state.closest = Reduce(simplex);
+
+	        while (state.iterations < MAX_GJK_ITERATIONS)
+	        {
+	            const float distance_squared = Dot(state.closest, state.closest);
+	            if (simplex.count == 4 || distance_squared <= DEGENERATE_EPSILON * std::max(scale, 1.0f))
+	            {
+	                state.intersecting = true;
+	                break;
+	            }
+
+	            const SupportPoint point = GetSupport(a, b, -state.closest);
+	            state.iterations++;
+	            const float projection = Dot(state.closest, point.w);
+	            if (EARLY_OUT && projection > 0.0f)
+	                break;
+	            if (distance_squared - projection <= GJK_TOLERANCE * distance_squared || Contains(simplex, point.w, scale))
+	                break;
+
+	            // Keep the previous simplex if rounding stops the distance from shrinking
+	            const Simplex previous = simplex;
+	            simplex.points[simplex.count++] = point;
+	            scale = std::max(scale, Dot(point.w, point.w));
+	            const Vec3 closest = Reduce(simplex);
+	            if (Dot(closest, closest) >= distance_squared)
+	            {
+	                simplex = previous;
+	                break;
+	            }
+	            state.closest = closest;
+	        }
+
+	        if (cache != nullptr)
+	        {
+	            cache->count = simplex.count;
+	            for (uint32_t i = 0; i < simplex.count; i++)
+	                cache->directions[i] = simplex.points[i].direction;
+	        }
+	        return state;
+	    }
+
+	    void GetWitnessPoints(const Simplex &simplex, Vec3 &point_a, Vec3 &point_b)
+	    {
+	        point_a = Vec3(0.0f);
+	        point_b = Vec3(0.0f);
+	        for (uint32_t i = 0; i < simplex.count; i++)
+	        {
+	            point_a += simplex.points[i].a * simplex.weights[i];
+	            point_b += simplex.points[i].b * simplex.weights[i];
+	        }
+	    }
+
+	    // Distance of w from the line or plane through the first count simplex points
+	    float GetOffset(const Simplex &simplex, const Vec3 &w)
+	    {
+	        const Vec3 &origin = simplex.points[0].w;
+	        if (simplex.count == 1)
+	            return Length(w - origin);
+	        if (simplex.count == 2)
+	        {
+	            const Vec3 line = Normalize(simplex.points[1].w - origin);
+	            return Length(Cross(w - origin, line));
+	        }
+	        const Vec3 normal = Normalize(Cross(simplex.points[1].w - origin, simplex.points[2].w - origin));
+	        return std::abs(Dot(w - origin, normal));
+	    }
+
+	    // Grows a simplex that touches the origin into a tetrahedron by adding support points off
+	    // its line or plane. Returns false if the Minkowski difference is flat.
+	    bool ExpandToTetrahedron(const ConvexShape &a, const ConvexShape &b, Simplex &simplex, const float scale)
+	    {
+	        const float threshold = std::sqrt(scale) * 1e-5f + 1e-12f;
+	        const Vec3 axes[3] = { Vec3(1.0f, 0.0f, 0.0f), Vec3(0.0f, 1.0f, 0.0f), Vec3(0.0f, 0.0f, 1.0f) };
+	        while (simplex.count < 4)
+	        {
+	            // Directions perpendicular to the current line or plane, or the axes for a point
+	            Vec3 candidates[6];
+	            uint32_t candidate_count = 0;
+	            if (simplex.count == 1)
+	            {
+	                for (const Vec3 &axis : axes)
+	                {
+	                    candidates[candidate_count++] = axis;
+	                    candidates[candidate_count++] = -axis;
+	                }
+	            }
+	            else if (simplex.count == 2)
+	            {
+	                const Vec3 line = simplex.points[1].w - simplex.points[0].w;
+	                const Vec3 axis = std::abs(line.x) < std::abs(line.y) ? (std::abs(line.x) < std::abs(line.z) ? axes[0] : axes[2]) : (std::abs(line.y) < std::abs(line.z) ? axes[1] : axes[2]);
+	                const Vec3 u = Normalize(Cross(line, axis));
+	                const Vec3 v = Normalize(Cross(line, u));
+	                candidates[candidate_count++] = u;
+	                candidates[candidate_count++] = -u;
+	                candidates[candidate_count++] = v;
+	                candidates[candidate_count++] = -v;
+	                candidates[candidate_count++] = u + v;
+	                candidates[candidate_count++] = -u - v;
+	            }
+	            else
+	            {
+	                const Vec3 normal = Cross(simplex.points[1].w - simplex.points[0].w, simplex.points[2].w - simplex.points[0].w);
+	                candidates[candidate_count++] = normal;
+	                candidates[candidate_count++] = -normal;
+	            }
+
+	            bool added = false;
+	            for (uint32_t i = 0; i < candidate_count && !added; i++)
+	            {
+	                const SupportPoint point = GetSupport(a, b, candidates[i]);
+	                if (GetOffset(simplex, point.w) > threshold)
+	                {
+	                    simplex.points[simplex.count++] = point;
+	                    added = true;
+	                }
+	            }
+	            if (!added)
+	                return false;
+	        }
+	        return true;
+	    }
+
+	    struct PolytopeFace
+	    {
+	        uint32_t vertices[3];
+	        Vec3 normal;
+	        float distance;
+	    };
+
+	    PolytopeFace MakeFace(const std::vector<SupportPoint> &points, const uint32_t i0, const uint32_t i1, const uint32_t i2)
+	    {
+	        const Vec3 normal = Cross(points[i1].w - points[i0].w, points[i2].w - points[i0].w);
+	        const float length = std::sqrt(Dot(normal, normal));
+	        if (length <= DEGENERATE_EPSILON)
+	            return { { i0, i1, i2 }, Vec3(0.0f), FLT_MAX };
+	        const Vec3 unit = normal / length;
+	        return { { i0, i1, i2 }, unit, Dot(unit, points[i0].w) };
+	    }
+
+	    // Fills the result from the polytope face nearest the origin. The witness points use the
+	    // unclamped barycentric coordinates of the origin's projection, so point_a - point_b stays
+	    // normal * depth even when rounding puts the projection just outside the face.
+	    void SetContact(const std::vector<SupportPoint> &points, const PolytopeFace &face, EPAResult &result)
+	    {
+	        const SupportPoint &p0 = points[face.vertices[0]];
+	        const SupportPoint &p1 = points[face.vertices[1]];
+	        const SupportPoint &p2 = points[face.vertices[2]];
+	        const Vec3 projection = face.normal * face.distance;
+
+	        // Ericson 3.4: barycentric coordinates from dot products
+	        const Vec3 v0 = p1.w - p0.w, v1 = p2.w - p0.w, v2 = projection - p0.w;
+	        const float d00 = Dot(v0, v0), d01 = Dot(v0, v1), d11 = Dot(v1, v1);
+	        const float d20 = Dot(v2, v0), d21 = Dot(v2, v1);
+	        const float denominator = d00 * d11 - d01 * d01;
+	        const float v = denominator != 0.0f ? (d11 * d20 - d01 * d21) / denominator : 0.0f;
+	        const float w = denominator != 0.0f ? (d00 * d21 - d01 * d20) / denominator : 0.0f;
+	        const float u = 1.0f - v - w;
+
+	        result.normal = face.normal;
+	        result.depth = std::max(face.distance, 0.0f);
+	        result.point_a = p0.a * u + p1.a * v + p2.a * w;
+	        result.point_b = p0.b * u + p1.b * v + p2.b * w;
+	    }
+
+	    // Fills the result for a flat Minkowski difference, where the shapes only touch: zero
+	    // depth, the normal of the simplex plane when it has one, and the witness points of the
+	    // simplex feature nearest the origin.
+	    void SetFlatContact(Simplex &simplex, EPAResult &result)
+	    {
+	        simplex.count = std::min(simplex.count, 3u);
+	        const Vec3 normal = simplex.count == 3 ? Cross(simplex.points[1].w - simplex.points[0].w, simplex.points[2].w - simplex.points[0].w) : Vec3(0.0f);
+	        result.normal = Dot(normal, normal) > DEGENERATE_EPSILON ? Normalize(normal) : Vec3(1.0f, 0.0f, 0.0f);
+	        result.depth = 0.0f;
+	        Reduce(simplex);
+	        GetWitnessPoints(simplex, result.point_a, result.point_b);
+	    }
+	}
+
+	ConvexShape::ConvexShape(const BoundingBox &box) : m_Data(&box), m_Count(1), m_Support(SupportBox)
+	{
+	}
+
+	ConvexShape::ConvexShape(const Sphere &sphere) : m_Data(&sphere), m_Count(1), m_Support(SupportSphere)
+	{
+	}
+
+	ConvexShape::ConvexShape(const OrientedBoundingBox &box) : m_Data(&box), m_Count(1), m_Support(SupportOrientedBox)
+	{
+	}
+
+	ConvexShape::ConvexShape(const Vec3 *points, const size_t count) : m_Data(points), m_Count(count), m_Support(SupportPoints)
+	{
+	    assert(points != nullptr && count > 0);
+	}
+
+	ConvexShape::ConvexShape(const void *data, const size_t count, const SupportFunction support) : m_Data(data), m_Count(count), m_Support(support)
+	{
+	    assert(support != nullptr);
+	}
+
+	GJKResult GJKDistance(const ConvexShape &a, const ConvexShape &b, GJKCache *cache)
+	{
+	    const GJKState state = RunGJK<false>(a, b, cache);
+
+	    GJKResult result;
+	    result.intersecting = state.intersecting;
+	    result.iterations = state.iterations;
+	    GetWitnessPoints(state.simplex, result.point_a, result.point_b);
+	    result.distance = state.intersecting ? 0.0f : std::sqrt(Dot(state.closest, state.closest));
+	    return result;
+	}
+
+	bool GJKIntersects(const ConvexShape &a, const ConvexShape &b, GJKCache *cache)
+	{
+	    return RunGJK<true>(a, b, cache).intersecting;
+	}
+
+	EPAResult EPAPenetration(const ConvexShape &a, const ConvexShape &b, GJKCache *cache)
+	{
+	    GJKState state = RunGJK<false>(a, b, cache);
+
+	    EPAResult result;
+	    if (!state.intersecting)
+	        return result;
+	    result.intersecting = true;
+
+	    Simplex &simplex = state.simplex;
+	    float scale = 0.0f;
+	    for (uint32_t i = 0; i < simplex.count; i++)
+	        scale = std::max(scale, Dot(simplex.points[i].w, simplex.points[i].w));
+
+	    if (!ExpandToTetrahedron(a, b, simplex, scale))
+	    {
+	        SetFlatContact(simplex, result);
+	        return result;
+	    }
+
+	    // Tetrahedron with outward-facing faces
+	    std::vector<SupportPoint> points(simplex.points, simplex.points + 4);
+	    std::vector<PolytopeFace> faces;
+	    static constexpr uint32_t tetrahedron[4][4] = { { 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 0, 2, 3, 1 }, { 1, 3, 2, 0 } };
+	    for (const auto &face : tetrahedron)
+	    {
+	        const Vec3 normal = Cross(points[face[1]].w - points[face[0]].w, points[face[2]].w - points[face[0]].w);
+	        const bool inward = Dot(normal, points[face[3]].w - points[face[0]].w) > 0.0f;
+	        faces.push_back(inward ? MakeFace(points, face[0], face[2], face[1]) : MakeFace(points, face[0], face[1], face[2]));
+	    }
+
+	    std::vector<std::pair<uint32_t, uint32_t>> horizon;
+	    const float tolerance = EPA_TOLERANCE * std::sqrt(scale);
+	    for (uint32_t iteration = 0; iteration < MAX_EPA_ITERATIONS; iteration++)
+	    {
+	        const auto nearest = std::min_element(faces.begin(), faces.end(), [](const PolytopeFace &l, const PolytopeFace &r) { return l.distance < r.distance; });
+	        if (nearest->distance == FLT_MAX)
+	            break;
+
+	        const SupportPoint point = GetSupport(a, b, nearest->normal);
+	        if (Dot(point.w, nearest->normal) - nearest->distance <= tolerance || faces.size() >= MAX_EPA_FACES)
+	        {
+	            SetContact(points, *nearest, result);
+	            return result;
+	        }
+
+	        // Remove the faces the new point sees and collect the edges of the hole they leave
+	        const auto index = static_cast<uint32_t>(points.size());
+	        points.push_back(point);
+	        horizon.clear();
+	        for (size_t f = 0; f < faces.size();)
+	        {
+	            const PolytopeFace &face = faces[f];
+	            if (Dot(face.normal, point.w - points[face.vertices[0]].w) <= 0.0f)
+	            {
+	                f++;
+	                continue;
+	            }
+
+	            for (int e = 0; e < 3; e++)
+	            {
+	                const std::pair<uint32_t, uint32_t> edge(face.vertices[e], face.vertices[(e + 1) % 3]);
+	                const auto shared = std::find(horizon.begin(), horizon.end(), std::make_pair(edge.second, edge.first));
+	                if (shared != horizon.end())
+	                    horizon.erase(shared);
+	                else
+	                    horizon.push_back(edge);
+	            }
+	            faces[f] = faces.back();
+	            faces.pop_back();
+	        }
+
+	        for (const auto &[from, to] : horizon)
+	            faces.push_back(MakeFace(points, from, to, index));
+	    }
+
+	    // Every face degenerate: the polytope has collapsed onto a plane, so the shapes only touch
+	    const auto nearest = std::min_element(faces.begin(), faces.end(), [](const PolytopeFace &l, const PolytopeFace &r) { return l.distance < r.distance; });
+	    if (nearest->distance == FLT_MAX)
+	        SetFlatContact(simplex, result);
+	    else
+	        SetContact(points, *nearest, result);
+	    return result;
+	}
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,340 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* kd_tree.cpp
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <future>
+#include <numeric>
+#include <thread>
+#include <xmath.hpp>
+#include <xMath/includes/kd_tree.h>
+#include "parallel_for.h"
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	namespace
+	{
+	    // Median splits keep the depth at log2(count) <= 32, and the search pushes at most one range per level
+	    constexpr uint32_t STACK_SIZE = 64;
+
+	    struct SearchRange
+	    {
+	        uint32_t begin;
+	        uint32_t end;
+	        float distance_squared; // Lower bound on the squared distance to any point in the range
+	    };
+
+	    class Builder
+	    {
+	    public:
+	        Builder(const Vec3 *points, uint32_t *indices, uint8_t *axes, const KDTreeBuildSettings &settings)
+	            : m_Points(points), m_Indices(indices), m_Axes(axes), m_Settings(settings)
+	        {
+	            uint32_t threads = settings.thread_count ? settings.thread_count : std::thread::hardware_concurrency();
+	            while (threads > 1)
+	            {
+	                m_SpawnDepth++;
+	                threads >>= 1;
+	            }
+	        }
+
+	        void Build(const uint32_t begin, const uint32_t end, const uint32_t depth)
+	        {
+	            const uint32_t count = end - begin;
+	            if (count <= m_Settings.leaf_size)
+	                return;
+
+	            // Split at the median of the widest axis
+	            float min[3] = { FLT_MAX, FLT_MAX, FLT_MAX }, max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+	            for (uint32_t i = begin; i < end; i++)
+	            {
+	                const Vec3 &point = m_Points[m_Indices[i]];
+	                min[0] = std::min(min[0], point.x); max[0] = std::max(max[0], point.x);
+	                min[1] = std::min(min[1], point.y); max[1] = std::max(max[1], point.y);
+	                min[2] = std::min(min[2], point.z); max[2] = std::max(max[2], point.z);
+	            }
+
+	            uint8_t axis = 0;
+	            for (uint8_t a = 1; a < 3; a++)
+	            {
+	                if (max[a] - min[a] > max[axis] - min[axis])
+	                    axis = a;
+	            }
+
+	            const uint32_t mid = begin + count / 2;
+	            std::nth_element(m_Indices + begin, m_Indices + mid, m_Indices + end, [this, axis](const uint32_t a, const uint32_t b)
+	            {
+	                return m_Points[a][axis] < m_Points[b][axis];
+	            });
+	            m_Axes[mid] = axis;
+
+	            if (count >= m_Settings.parallel_threshold && depth < m_SpawnDepth)
+	            {
+	                std::future<void> left_task = std::async(std::launch::async, [this, begin, mid, depth] { Build(begin, mid, depth + 1); });
+	                Build(mid + 1, end, depth + 1);
+	                left_task.get();
+	            }
+	            else
+	            {
+	                Build(begin, mid, depth + 1);
+	                Build(mid + 1, end, depth + 1);
+	            }
+	        }
+
+	    private:
+	        const Vec3 *m_Points;
+	        uint32_t *m_Indices;
+	        uint8_t *m_Axes;
+	        KDTreeBuildSettings m_Settings;
+	        uint32_t m_SpawnDepth = 0;
+	    };
+
+	    // Calls visit(position, distance_squared) for every point that may lie within the radius.
+	    // radius_squared is read again after every visit, so visit may shrink it.
+	    template <typename Visit>
+	    void Search(const float *xs, const float *ys, const float *zs, const uint8_t *axes, const uint32_t count, const uint32_t leaf_size,
+	                const Vec3 &point, const float &radius_squared, const Visit &visit)
+	    {
+	        const float *coords[3] = { xs, ys, zs };
+	        const float query[3] = { point.x, point.y, point.z };
+	        const auto visit_point = [&](const uint32_t i)
+	        {
+	            const float dx = xs[i] - point.x, dy = ys[i] - point.y, dz = zs[i] - point.z;
+	            const float distance_squared = dx * dx + dy * dy + dz * dz;
+	            if (distance_squared <= radius_squared)
+	                visit(i, distance_squared);
+	        };
+
+	        SearchRange stack[STACK_SIZE];
+	        uint32_t stack_size = 0;
+	        stack[stack_size++] = { 0, count, 0.0f };
+
+	        while (stack_size > 0)
+	        {
+	            SearchRange range = stack[--stack_size];
+	            if (range.distance_squared > radius_squared)
+	                continue;
+
+	            while (range.end - range.begin > leaf_size)
+	            {
+	                const uint32_t mid = range.begin + (range.end - range.begin) / 2;
+	                visit_point(mid);
+
+	                // Descend into the side holding the query first; the other side lies beyond the splitting plane
+	                const uint8_t axis = axes[mid];
+	                const float diff = query[axis] - coords[axis][mid];
+	                SearchRange far_range;
+	                if (diff < 0.0f)
+	                {
+	                    far_range = { mid + 1, range.end, 0.0f };
+	                    range.end = mid;
+	                }
+	                else
+	                {
+	                    far_range = { range.begin, mid, 0.0f };
+	                    range.begin = mid + 1;
+	                }
+
+	                far_range.distance_squared = std::max(range.distance_squared, diff * diff);
+	                if (far_range.begin < far_range.end && far_range.distance_squared <= radius_squared)
+	                {
+	                    assert(stack_size < STACK_SIZE);
+	                    stack[stack_size++] = far_range;
+	                }
+	            }
+
+	            for (uint32_t i = range.begin; i < range.end; i++)
+	                visit_point(i);
+	        }
+	    }
+
+	    size_t GetChunkSize(const size_t count, const KDTreeBuildSettings &settings)
+	    {
+	        const uint32_t threads = settings.thread_count ? settings.thread_count : std::max(std::thread::hardware_concurrency(), 1u);
+	        if (threads <= 1 || count < settings.parallel_threshold)
+	            return std::max<size_t>(count, 1);
+	        return (count + threads - 1) / threads;
+	    }
+	}
+
+	void KDTree::Build(const Vec3 *points, const size_t count, const KDTreeBuildSettings &settings)
+	{
+	    assert(points != nullptr || count == 0);
+	    assert(count < INVALID_INDEX);
+
+	    m_Settings = settings;
+	    m_Settings.leaf_size = std::max(m_Settings.leaf_size, 1u);
+
+	    m_Indices.resize(count);
+	    std::iota(m_Indices.begin(), m_Indices.end(), 0u);
+	    m_Axis.assign(count, 0);
+
+	    Builder builder(points, m_Indices.data(), m_Axis.data(), m_Settings);
+	    builder.Build(0, static_cast<uint32_t>(count), 0);
+
+	    // Gather the positions in tree order so searches read them contiguously
+	    m_X.resize(count);
+	    m_Y.resize(count);
+	    m_Z.resize(count);
+	    for (size_t i = 0; i < count; i++)
+	    {
+	        const Vec3 &point = points[m_Indices[i]];
+	        m_X[i] = point.x;
+	        m_Y[i] = point.y;
+	        m_Z[i] = point.z;
+	    }
+	}
+
+	void KDTree::Clear()
+	{
+	    m_Indices.clear();
+	    m_X.clear();
+	    m_Y.clear();
+	    m_Z.clear();
+	    m_Axis.clear();
+	}
+
+	uint32_t KDTree::QueryNearest(const Vec3 &point, float *distance) const
+	{
+	    uint32_t index = INVALID_INDEX;
+	    float nearest = FLT_MAX;
+	    if (QueryKNearest(point, 1, &index, &nearest) == 0)
+	        return INVALID_INDEX;
+
+	    if (distance != nullptr)
+	        *distance = nearest;
+	    return index;
+	}
+
+	uint32_t KDTree::QueryKNearest(const Vec3 &point, uint32_t k, uint32_t *indices, float *distances) const
+	{
+	    k = static_cast<uint32_t>(std::min<size_t>(k, m_Indices.size()));
+	    if (k == 0)
+	        return 0;
+
+	    assert(indices != nullptr && distances != nullptr);
+
+	    // distances holds squared distances, sorted ascending, until the end
+	    uint32_t found = 0;
+	    float radius_squared = FLT_MAX;
+	    Search(m_X.data(), m_Y.data(), m_Z.data(), m_Axis.data(), static_cast<uint32_t>(m_Indices.size()), m_Settings.leaf_size, point, radius_squared,
+	           [&](const uint32_t i, const float distance_squared)
+	    {
+	        if (found == k && distance_squared >= distances[k - 1])
+	            return;
+
+	        uint32_t slot = found < k ? found++ : k - 1;
+	        for (; slot > 0 && distances[slot - 1] > distance_squared; slot--)
+	        {
+	            distances[slot] = distances[slot - 1];
+	            indices[slot] = indices[slot - 1];
+	        }
+	        distances[slot] = distance_squared;
+	        indices[slot] = m_Indices[i];
+
+	        if (found == k)
+	            radius_squared = distances[k - 1];
+	    });
+
+	    for (uint32_t i = 0; i < found; i++)
+	        distances[i] = std::sqrt(distances[i]);
+	    return found;
+	}
+
+	void KDTree::QueryRadius(const Vec3 &center, const float radius, std::vector<uint32_t> &results) const
+	{
+	    if (m_Indices.empty() || radius < 0.0f)
+	        return;
+
+	    const float radius_squared = radius * radius;
+	    Search(m_X.data(), m_Y.data(), m_Z.data(), m_Axis.data(), static_cast<uint32_t>(m_Indices.size()), m_Settings.leaf_size, center, radius_squared,
+	           [&](const uint32_t i, float) { results.push_back(m_Indices[i]); });
+	}
+
+	void KDTree::QueryNearestBatch(const Vec3 *points, const size_t count, uint32_t *indices, float *distances) const
+	{
+	    assert(points != nullptr || count == 0);
+	    assert(indices != nullptr || count == 0);
+
+	    detail::ParallelFor(count, GetChunkSize(count, m_Settings), [&](size_t, const size_t begin, const size_t end)
+	    {
+	        for (size_t i = begin; i < end; i++)
+	            indices[i] = QueryNearest(points[i], distances != nullptr ? distances + i : nullptr);
+	    });
+	}
+
+	void KDTree::QueryKNearestBatch(const Vec3 *points, const size_t count, const uint32_t k, uint32_t *indices, float *distances, uint32_t *found) const
+	{
+	    assert(points != nullptr || count == 0);
+
+	    detail::ParallelFor(count, GetChunkSize(count, m_Settings), [&](size_t, const size_t begin, const size_t end)
+	    {
+	        for (size_t i = begin; i < end; i++)
+	        {
+	            const uint32_t result = QueryKNearest(points[i], k, indices + i * k, distances + i * k);
+	            if (found != nullptr)
+	                found[i] = result;
+	        }
+	    });
+	}
+
+	size_t KDTree::QueryRadiusBatch(const Vec3 *centers, const size_t count, const float radius, std::vector<uint32_t> &neighbors, std::vector<uint32_t> &offsets) const
+	{
+	    assert(centers != nullptr || count == 0);
+
+	    // Each chunk collects its neighbors separately; offsets first hold per-query counts
+	    const size_t chunk_size = GetChunkSize(count, m_Settings);
+	    std::vector<std::vector<uint32_t>> chunk_neighbors((count + chunk_size - 1) / chunk_size);
+	    offsets.assign(count + 1, 0);
+
+	    detail::ParallelFor(count, chunk_size, [&](const size_t chunk, const size_t begin, const size_t end)
+	    {
+	        std::vector<uint32_t> &results = chunk_neighbors[chunk];
+	        for (size_t i = begin; i < end; i++)
+	        {
+	            const size_t before = results.size();
+	            QueryRadius(centers[i], radius, results);
+	            offsets[i + 1] = static_cast<uint32_t>(results.size() - before);
+	        }
+	    });
+
+	    for (size_t i = 0; i < count; i++)
+	        offsets[i + 1] += offsets[i];
+
+	    neighbors.clear();
+	    neighbors.reserve(offsets[count]);
+	    for (const std::vector<uint32_t> &results : chunk_neighbors)
+	        neighbors.insert(neighbors.end(), results.begin(), results.end());
+	    return neighbors.size();
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -32,153 +32,6 @@
 
 namespace xMath
 {
-	
-	constexpr Mat3::Mat3() noexcept: m00(1), m01(0), m02(0),
-									 m10(0), m11(1), m12(0),
-									 m20(0), m21(0), m22(1)
-	{}
-
-	constexpr Mat3::Mat3(float s) noexcept: m00(s), m01(0), m02(0),
-											m10(0), m11(s), m12(0),
-											m20(0), m21(0), m22(s)
-	{}
-
-	constexpr Mat3::Mat3(float _m00, float _m01, float _m02, float _m10, float _m11, float _m12, float _m20, float _m21, float _m22) noexcept:
-		m00(_m00), m01(_m01), m02(_m02),
-		m10(_m10), m11(_m11), m12(_m12),
-		m20(_m20), m21(_m21), m22(_m22)
-	{}
-
-	constexpr Mat3 Mat3::FromRows(const Vec3f &r0, const Vec3f &r1, const Vec3f &r2) noexcept
-	{
-		return {r0.x, r0.y, r0.z, r1.x, r1.y, r1.z, r2.x, r2.y, r2.z};
-	}
-
-	constexpr Mat3 Mat3::FromColumns(const Vec3f &c0, const Vec3f &c1, const Vec3f &c2) noexcept
-	{
-		return {c0.x, c1.x, c2.x, c0.y, c1.y, c2.y, c0.z, c1.z, c2.z};
-	}
-
-	constexpr Mat3 Mat3::Identity() noexcept
-	{
-		return {};
-	}
-
-	constexpr Mat3 Mat3::Zero() noexcept
-	{
-		return {0,0,0, 0,0,0, 0,0,0};
-	}
-
-	constexpr Mat3 Mat3::Scale(float sx, float sy, float sz) noexcept
-	{
-		return {sx,0,0, 0,sy,0, 0,0,sz};
-	}
-
-	constexpr Mat3 Mat3::Scale(const Vec3f &s) noexcept
-	{
-		return Scale(s.x, s.y, s.z);
-	}
-
-	constexpr Mat3::Vec3f Mat3::Row(int r) const noexcept
-	{
-		return r == 0 ? Vec3f{m00,m01,m02} : (r == 1 ? Vec3f{m10,m11,m12} : Vec3f{m20,m21,m22});
-	}
-
-	constexpr Mat3::Vec3f Mat3::Column(int c) const noexcept
-	{ return c == 0 ? Vec3f{m00,m10,m20} : (c == 1 ? Vec3f{m01,m11,m21} : Vec3f{m02,m12,m22}); }
-
-	constexpr float & Mat3::operator()(int r, int c) noexcept
-	{
-		switch (r*3 + c)
-		{
-		case 0: return m00; case 1: return m01; case 2: return m02;
-		case 3: return m10; case 4: return m11; case 5: return m12;
-		case 6: return m20; case 7: return m21; default: return m22;
-		}
-	}
-
-	constexpr const float & Mat3::operator()(int r, int c) const noexcept
-	{
-		switch (r*3 + c)
-		{
-		case 0: return m00; case 1: return m01; case 2: return m02;
-		case 3: return m10; case 4: return m11; case 5: return m12;
-		case 6: return m20; case 7: return m21; default: return m22;
-		}
-	}
-
-	constexpr Mat3 Mat3::operator+(const Mat3 &r) const noexcept
-	{
-		return {m00+r.m00, m01+r.m01, m02+r.m02, m10+r.m10, m11+r.m11, m12+r.m12, m20+r.m20, m21+r.m21, m22+r.m22};
-	}
-
-	constexpr Mat3 Mat3::operator-(const Mat3 &r) const noexcept
-	{
-		return {m00-r.m00, m01-r.m01, m02-r.m02, m10-r.m10, m11-r.m11, m12-r.m12, m20-r.m20, m21-r.m21, m22-r.m22};
-	}
-
-	constexpr Mat3 Mat3::operator*(float s) const noexcept
-	{
-		return {m00*s, m01*s, m02*s, m10*s, m11*s, m12*s, m20*s, m21*s, m22*s};
-	}
-
-	constexpr Mat3 & Mat3::operator+=(const Mat3 &r) noexcept
-	{
-		m00+=r.m00; m01+=r.m01; m02+=r.m02; m10+=r.m10; m11+=r.m11; m12+=r.m12; m20+=r.m20; m21+=r.m21; m22+=r.m22; return *this;
-	}
-
-	constexpr Mat3 & Mat3::operator-=(const Mat3 &r) noexcept
-	{
-		m00-=r.m00; m01-=r.m01; m02-=r.m02; m10-=r.m10; m11-=r.m11; m12-=r.m12; m20-=r.m20; m21-=r.m21; m22-=r.m22; return *this;
-	}
-
-	constexpr Mat3 & Mat3::operator*=(float s) noexcept
-	{
-		m00*=s; m01*=s; m02*=s; m10*=s; m11*=s; m12*=s; m20*=s; m21*=s; m22*=s; return *this;
-	}
-
-	constexpr Mat3 Mat3::operator*(const Mat3 &r) const noexcept
-	{
-		return {m00*r.m00 + m01*r.m10 + m02*r.m20,  m00*r.m01 + m01*r.m11 + m02*r.m21,  m00*r.m02 + m01*r.m12 + m02*r.m22,
-				m10*r.m00 + m11*r.m10 + m12*r.m20,  m10*r.m01 + m11*r.m11 + m12*r.m21,  m10*r.m02 + m11*r.m12 + m12*r.m22,
-				m20*r.m00 + m21*r.m10 + m22*r.m20,  m20*r.m01 + m21*r.m11 + m22*r.m21,  m20*r.m02 + m21*r.m12 + m22*r.m22};
-	}
-
-	constexpr Mat3 & Mat3::operator*=(const Mat3 &r) noexcept
-	{
-		*this = (*this) * r; return *this;
-	}
-
-	constexpr Mat3::Vec3f Mat3::operator*(const Vec3f &v) const noexcept
-	{
-		return Vec3f{ m00*v.x + m01*v.y + m02*v.z, m10*v.x + m11*v.y + m12*v.z, m20*v.x + m21*v.y + m22*v.z };
-	}
-
-	constexpr float Mat3::Trace() const noexcept
-	{
-		return m00 + m11 + m22;
-	}
-
-	constexpr float Mat3::Determinant() const noexcept
-	{
-		return m00*(m11*m22 - m12*m21) - m01*(m10*m22 - m12*m20) + m02*(m10*m21 - m11*m20);
-	}
-
-	constexpr Mat3 Mat3::Transposed() const noexcept
-	{
-		return {m00,m10,m20, m01,m11,m21, m02,m12,m22};
-	}
-
-	constexpr bool Mat3::operator==(const Mat3 &r) const noexcept
-	{
-		return m00==r.m00 && m01==r.m01 && m02==r.m02 &&  m10==r.m10 && m11==r.m11 && m12==r.m12 && m20==r.m20 && m21==r.m21 && m22==r.m22;
-	}
-
-	constexpr bool Mat3::operator!=(const Mat3 &r) const noexcept
-	{
-		return !(*this == r);
-	}
-
 	Mat3 Mat3::RotationX(float r) noexcept
 	{
 		const float c = std::cos(r), s = std::sin(r);
@@ -192,6 +192,23 @@ namespace xMath
 		};
 	}
 
+	/**
+	 * @brief Transforms a point by a 4x4 matrix, including the perspective divide.
+	 *
+	 * Affine matrices leave w at one, so the divide is a no-op for them; for
+	 * projection matrices this maps the point into normalized device space.
+	 *
+	 * @param m The transformation matrix.
+	 * @param point The point to transform (w = 1).
+	 * @return The transformed point divided by w, or zero if w is zero.
+	 */
+	Vec3 TransformPoint(const Mat4 &m, const Vec3 &point)
+	{
+		const Vec4 p = m * Vec4(point.x, point.y, point.z, 1.0f);
+		const float inv_w = p.w != 0.0f ? 1.0f / p.w : 0.0f;
+		return {p.x * inv_w, p.y * inv_w, p.z * inv_w};
+	}
+
 	/// ---------------------------------------------------------------------
 	/// Compatibility wrappers (glm::quat <-> native Quat)
 	/// ---------------------------------------------------------------------
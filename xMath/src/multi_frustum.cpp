@@ -0,0 +1,107 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* multi_frustum.cpp
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#include <cassert>
+#include <cmath>
+#include <xmath.hpp>
+#include <xMath/includes/multi_frustum.h>
+
+/// -------------------------------------------------------
+
+namespace xMath
+{
+	uint32_t MultiFrustum::Add(const Frustum &frustum)
+	{
+	    assert(m_Count < MAX_FRUSTA);
+
+	    const uint32_t index = m_Count++;
+	    Set(index, frustum);
+	    return index;
+	}
+
+	void MultiFrustum::Set(const uint32_t index, const Frustum &frustum)
+	{
+	    assert(index < m_Count);
+
+	    for (uint32_t p = 0; p < 6; p++)
+	    {
+	        const Plane &plane = frustum.GetPlane(p);
+	        m_NormalX[p][index] = plane.normal.x;
+	        m_NormalY[p][index] = plane.normal.y;
+	        m_NormalZ[p][index] = plane.normal.z;
+	        m_AbsNormalX[p][index] = std::fabs(plane.normal.x);
+	        m_AbsNormalY[p][index] = std::fabs(plane.normal.y);
+	        m_AbsNormalZ[p][index] = std::fabs(plane.normal.z);
+	        m_Distance[p][index] = plane.d;
+	    }
+	}
+
+	uint32_t MultiFrustum::Cull(const Vec3 &center, const Vec3 &extent) const
+	{
+	    // Planes outer, frusta inner: each inner loop reads consecutive floats of the plane-major
+	    // arrays and has no early outs, so the compiler can vectorize it across the frusta
+	    uint32_t outside = 0;
+	    for (uint32_t p = 0; p < 6; p++)
+	    {
+	        const float *nx = m_NormalX[p], *ny = m_NormalY[p], *nz = m_NormalZ[p];
+	        const float *ax = m_AbsNormalX[p], *ay = m_AbsNormalY[p], *az = m_AbsNormalZ[p];
+	        const float *dist = m_Distance[p];
+	        for (uint32_t f = 0; f < m_Count; f++)
+	        {
+	            const float d = nx[f] * center.x + ny[f] * center.y + nz[f] * center.z + dist[f];
+	            const float r = ax[f] * extent.x + ay[f] * extent.y + az[f] * extent.z;
+	            outside |= static_cast<uint32_t>(d + r < 0.0f) << f;
+	        }
+	    }
+
+	    return ~outside & GetAllMask();
+	}
+
+	size_t MultiFrustum::CullBatch(const BoundingBoxSoA &bounds, uint32_t *view_masks) const
+	{
+	    assert(view_masks != nullptr);
+
+	    const float *cx = bounds.center_x.data();
+	    const float *cy = bounds.center_y.data();
+	    const float *cz = bounds.center_z.data();
+	    const float *ex = bounds.extent_x.data();
+	    const float *ey = bounds.extent_y.data();
+	    const float *ez = bounds.extent_z.data();
+
+	    // Each box is read once and tested against every view while it is in registers
+	    size_t visible_count = 0;
+	    for (size_t i = 0; i < bounds.Size(); i++)
+	    {
+	        view_masks[i] = Cull(Vec3(cx[i], cy[i], cz[i]), Vec3(ex[i], ey[i], ez[i]));
+	        visible_count += view_masks[i] != 0;
+	    }
+
+	    return visible_count;
+	}
+
+}
+
+/// -------------------------------------------------------
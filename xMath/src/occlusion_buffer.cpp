@@ -0,0 +1,302 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* occlusion_buffer.cpp
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <xmath.hpp>
+#include <xMath/includes/occlusion_buffer.h>
+
+/// -------------------------------------------------------
+
+namespace xMath
+{
+	namespace
+	{
+	    constexpr uint32_t TILE_SIZE = OcclusionBuffer::TILE_WIDTH * OcclusionBuffer::TILE_HEIGHT;
+
+	    float EdgeFunction(const float ax, const float ay, const float bx, const float by, const float px, const float py)
+	    {
+	        return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+	    }
+	}
+
+	OcclusionBuffer::OcclusionBuffer(const uint32_t width, const uint32_t height, const uint8_t depth_flags) : m_DepthFlags(depth_flags)
+	{
+	    assert(width > 0 && height > 0);
+
+	    m_TilesX = (width + TILE_WIDTH - 1) / TILE_WIDTH;
+	    m_TilesY = (height + TILE_HEIGHT - 1) / TILE_HEIGHT;
+	    m_Width = m_TilesX * TILE_WIDTH;
+	    m_Height = m_TilesY * TILE_HEIGHT;
+
+	    m_Depth.resize(static_cast<size_t>(m_TilesX) * m_TilesY * TILE_SIZE);
+	    m_TileDepth.resize(static_cast<size_t>(m_TilesX) * m_TilesY);
+
+	    for (uint32_t i = 0; i < 4; i++)
+	        m_Rows[i][i] = 1.0f;
+
+	    Clear();
+	}
+
+	void OcclusionBuffer::Clear()
+	{
+	    std::fill(m_Depth.begin(), m_Depth.end(), 1.0f);
+	    std::fill(m_TileDepth.begin(), m_TileDepth.end(), 1.0f);
+	}
+
+	void OcclusionBuffer::SetViewProjection(const Mat4 &view_projection)
+	{
+	    const Mat4 &m = view_projection;
+	    const float rows[4][4] = {
+	        { m.m00, m.m01, m.m02, m.m03 },
+	        { m.m10, m.m11, m.m12, m.m13 },
+	        { m.m20, m.m21, m.m22, m.m23 },
+	        { m.m30, m.m31, m.m32, m.m33 }
+	    };
+	    std::copy(&rows[0][0], &rows[0][0] + 16, &m_Rows[0][0]);
+	}
+
+	OcclusionBuffer::ScreenVertex OcclusionBuffer::Project(const float x, const float y, const float z) const
+	{
+	    const float cx = m_Rows[0][0] * x + m_Rows[0][1] * y + m_Rows[0][2] * z + m_Rows[0][3];
+	    const float cy = m_Rows[1][0] * x + m_Rows[1][1] * y + m_Rows[1][2] * z + m_Rows[1][3];
+	    const float cz = m_Rows[2][0] * x + m_Rows[2][1] * y + m_Rows[2][2] * z + m_Rows[2][3];
+	    const float cw = m_Rows[3][0] * x + m_Rows[3][1] * y + m_Rows[3][2] * z + m_Rows[3][3];
+
+	    ScreenVertex v{};
+	    if (cw <= 1e-6f)
+	        return v;
+
+	    const float inv_w = 1.0f / cw;
+	    float depth = cz * inv_w;
+	    if (m_DepthFlags & Frustum::DEPTH_NEGATIVE_ONE_TO_ONE)
+	        depth = depth * 0.5f + 0.5f;
+	    if (m_DepthFlags & Frustum::DEPTH_REVERSED)
+	        depth = 1.0f - depth;
+
+	    // Screen y grows downwards
+	    v.x = (cx * inv_w * 0.5f + 0.5f) * static_cast<float>(m_Width);
+	    v.y = (0.5f - cy * inv_w * 0.5f) * static_cast<float>(m_Height);
+	    v.depth = depth;
+	    v.valid = depth >= 0.0f;
+	    return v;
+	}
+
+	void OcclusionBuffer::RasterizeTriangles(const Vec3 *vertices, const uint32_t *indices, const size_t triangle_count)
+	{
+	    assert(vertices != nullptr && indices != nullptr);
+
+	    for (size_t t = 0; t < triangle_count; t++)
+	    {
+	        const Vec3 &a = vertices[indices[t * 3 + 0]];
+	        const Vec3 &b = vertices[indices[t * 3 + 1]];
+	        const Vec3 &c = vertices[indices[t * 3 + 2]];
+
+	        const ScreenVertex v0 = Project(a.x, a.y, a.z);
+	        const ScreenVertex v1 = Project(b.x, b.y, b.z);
+	        const ScreenVertex v2 = Project(c.x, c.y, c.z);
+
+	        // Clipping against the near plane would add depth in front of the viewer; dropping the triangle stays conservative
+	        if (!v0.valid || !v1.valid || !v2.valid)
+	            continue;
+
+	        RasterizeTriangle(v0, v1, v2);
+	    }
+	}
+
+	void OcclusionBuffer::RasterizeTriangle(const ScreenVertex &v0, const ScreenVertex &in_v1, const ScreenVertex &in_v2)
+	{
+	    float area = EdgeFunction(v0.x, v0.y, in_v1.x, in_v1.y, in_v2.x, in_v2.y);
+	    if (std::fabs(area) < 1e-8f)
+	        return;
+
+	    // Make the winding consistent so every edge function is positive inside
+	    const bool flip = area < 0.0f;
+	    const ScreenVertex &v1 = flip ? in_v2 : in_v1;
+	    const ScreenVertex &v2 = flip ? in_v1 : in_v2;
+	    area = std::fabs(area);
+
+	    const float min_x = std::min({v0.x, v1.x, v2.x});
+	    const float max_x = std::max({v0.x, v1.x, v2.x});
+	    const float min_y = std::min({v0.y, v1.y, v2.y});
+	    const float max_y = std::max({v0.y, v1.y, v2.y});
+
+	    // Vertices close to w = 0 can project to huge or non-finite coordinates; skipping an occluder stays conservative
+	    if (!std::isfinite(min_x) || !std::isfinite(max_x) || !std::isfinite(min_y) || !std::isfinite(max_y))
+	        return;
+	    if (max_x < 0.0f || max_y < 0.0f || min_x >= static_cast<float>(m_Width) || min_y >= static_cast<float>(m_Height))
+	        return;
+
+	    // Clamp in float before converting so out-of-range coordinates never reach the integer cast
+	    const uint32_t x0 = static_cast<uint32_t>(std::max(min_x, 0.0f));
+	    const uint32_t y0 = static_cast<uint32_t>(std::max(min_y, 0.0f));
+	    const uint32_t x1 = static_cast<uint32_t>(std::min(max_x, static_cast<float>(m_Width - 1)));
+	    const uint32_t y1 = static_cast<uint32_t>(std::min(max_y, static_cast<float>(m_Height - 1)));
+
+	    const float inv_area = 1.0f / area;
+	    const float tri_depth = std::min({v0.depth, v1.depth, v2.depth});
+
+	    for (uint32_t ty = y0 / TILE_HEIGHT; ty <= y1 / TILE_HEIGHT; ty++)
+	    {
+	        for (uint32_t tx = x0 / TILE_WIDTH; tx <= x1 / TILE_WIDTH; tx++)
+	        {
+	            const uint32_t tile = ty * m_TilesX + tx;
+
+	            // Hierarchical Z: nothing in this tile is farther than the triangle's nearest point
+	            if (tri_depth >= m_TileDepth[tile])
+	                continue;
+
+	            float *depth = &m_Depth[static_cast<size_t>(tile) * TILE_SIZE];
+	            for (uint32_t row = 0; row < TILE_HEIGHT; row++)
+	            {
+	                const float py = static_cast<float>(ty * TILE_HEIGHT + row) + 0.5f;
+	                float *depth_row = depth + row * TILE_WIDTH;
+
+	                // Fixed-width, branch-free row so the compiler can vectorize it
+	                for (uint32_t col = 0; col < TILE_WIDTH; col++)
+	                {
+	                    const float px = static_cast<float>(tx * TILE_WIDTH + col) + 0.5f;
+	                    const float w0 = EdgeFunction(v1.x, v1.y, v2.x, v2.y, px, py);
+	                    const float w1 = EdgeFunction(v2.x, v2.y, v0.x, v0.y, px, py);
+	                    const float w2 = EdgeFunction(v0.x, v0.y, v1.x, v1.y, px, py);
+	                    const float z = (w0 * v0.depth + w1 * v1.depth + w2 * v2.depth) * inv_area;
+	                    const bool write = w0 >= 0.0f && w1 >= 0.0f && w2 >= 0.0f && z < depth_row[col];
+	                    depth_row[col] = write ? z : depth_row[col];
+	                }
+	            }
+
+	            UpdateTileDepth(tile);
+	        }
+	    }
+	}
+
+	void OcclusionBuffer::UpdateTileDepth(const uint32_t tile)
+	{
+	    const float *depth = &m_Depth[static_cast<size_t>(tile) * TILE_SIZE];
+	    float farthest = 0.0f;
+	    for (uint32_t i = 0; i < TILE_SIZE; i++)
+	        farthest = std::max(farthest, depth[i]);
+
+	    m_TileDepth[tile] = farthest;
+	}
+
+	bool OcclusionBuffer::IsVisible(const BoundingBox &box) const
+	{
+	    return IsVisible(box.GetCenter(), box.GetExtents());
+	}
+
+	bool OcclusionBuffer::IsVisible(const Vec3 &center, const Vec3 &extent) const
+	{
+	    float min_x = static_cast<float>(m_Width), min_y = static_cast<float>(m_Height);
+	    float max_x = 0.0f, max_y = 0.0f;
+	    float box_depth = 1.0f;
+
+	    for (uint32_t i = 0; i < 8; i++)
+	    {
+	        const ScreenVertex v = Project(center.x + ((i & 1) ? extent.x : -extent.x),
+	                                       center.y + ((i & 2) ? extent.y : -extent.y),
+	                                       center.z + ((i & 4) ? extent.z : -extent.z));
+
+	        // A box that reaches the near plane covers the viewer and cannot be proven hidden
+	        if (!v.valid)
+	            return true;
+
+	        min_x = std::min(min_x, v.x);
+	        max_x = std::max(max_x, v.x);
+	        min_y = std::min(min_y, v.y);
+	        max_y = std::max(max_y, v.y);
+	        box_depth = std::min(box_depth, v.depth);
+	    }
+
+	    // Off-screen boxes are for the frustum test to reject, and non-finite bounds cannot be proven hidden
+	    if (!std::isfinite(min_x) || !std::isfinite(max_x) || !std::isfinite(min_y) || !std::isfinite(max_y))
+	        return true;
+	    if (max_x < 0.0f || max_y < 0.0f || min_x >= static_cast<float>(m_Width) || min_y >= static_cast<float>(m_Height))
+	        return true;
+
+	    const uint32_t x0 = static_cast<uint32_t>(std::max(min_x, 0.0f));
+	    const uint32_t y0 = static_cast<uint32_t>(std::max(min_y, 0.0f));
+	    const uint32_t x1 = static_cast<uint32_t>(std::min(max_x, static_cast<float>(m_Width - 1)));
+	    const uint32_t y1 = static_cast<uint32_t>(std::min(max_y, static_cast<float>(m_Height - 1)));
+
+	    for (uint32_t ty = y0 / TILE_HEIGHT; ty <= y1 / TILE_HEIGHT; ty++)
+	    {
+	        for (uint32_t tx = x0 / TILE_WIDTH; tx <= x1 / TILE_WIDTH; tx++)
+	        {
+	            const uint32_t tile = ty * m_TilesX + tx;
+	            if (box_depth >= m_TileDepth[tile])
+	                continue;
+
+	            // The tile has a pixel behind the box; check whether it falls inside the box rectangle
+	            const float *depth = &m_Depth[static_cast<size_t>(tile) * TILE_SIZE];
+	            const uint32_t row_begin = std::max(y0, ty * TILE_HEIGHT) - ty * TILE_HEIGHT;
+	            const uint32_t row_end = std::min(y1, ty * TILE_HEIGHT + TILE_HEIGHT - 1) - ty * TILE_HEIGHT;
+	            const uint32_t col_begin = std::max(x0, tx * TILE_WIDTH) - tx * TILE_WIDTH;
+	            const uint32_t col_end = std::min(x1, tx * TILE_WIDTH + TILE_WIDTH - 1) - tx * TILE_WIDTH;
+
+	            for (uint32_t row = row_begin; row <= row_end; row++)
+	                for (uint32_t col = col_begin; col <= col_end; col++)
+	                    if (box_depth < depth[row * TILE_WIDTH + col])
+	                        return true;
+	        }
+	    }
+
+	    return false;
+	}
+
+	size_t OcclusionBuffer::TestBatch(const BoundingBoxSoA &bounds, uint8_t *visible) const
+	{
+	    assert(visible != nullptr);
+
+	    size_t visible_count = 0;
+	    for (size_t i = 0; i < bounds.Size(); i++)
+	    {
+	        const Vec3 center(bounds.center_x[i], bounds.center_y[i], bounds.center_z[i]);
+	        const Vec3 extent(bounds.extent_x[i], bounds.extent_y[i], bounds.extent_z[i]);
+	        visible[i] = IsVisible(center, extent) ? 1 : 0;
+	        visible_count += visible[i];
+	    }
+
+	    return visible_count;
+	}
+
+	float OcclusionBuffer::GetDepth(const uint32_t x, const uint32_t y) const
+	{
+	    assert(x < m_Width && y < m_Height);
+	    const uint32_t tile = (y / TILE_HEIGHT) * m_TilesX + x / TILE_WIDTH;
+	    return m_Depth[static_cast<size_t>(tile) * TILE_SIZE + (y % TILE_HEIGHT) * TILE_WIDTH + x % TILE_WIDTH];
+	}
+
+	float OcclusionBuffer::GetTileDepth(const uint32_t x, const uint32_t y) const
+	{
+	    assert(x < m_Width && y < m_Height);
+	    return m_TileDepth[(y / TILE_HEIGHT) * m_TilesX + x / TILE_WIDTH];
+	}
+
+}
+
+/// -------------------------------------------------------
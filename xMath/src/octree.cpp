@@ -0,0 +1,363 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* octree.cpp
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <xmath.hpp>
+#include <xMath/includes/octree.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	namespace
+	{
+	    constexpr uint32_t STACK_SIZE = 8 * LooseOctree::MAX_DEPTH + 8;
+
+	    float BoxDistanceSquared(const Vec3 &center, const Vec3 &extent, const Vec3 &point)
+	    {
+	        const float dx = std::max(std::abs(point.x - center.x) - extent.x, 0.0f);
+	        const float dy = std::max(std::abs(point.y - center.y) - extent.y, 0.0f);
+	        const float dz = std::max(std::abs(point.z - center.z) - extent.z, 0.0f);
+	        return dx * dx + dy * dy + dz * dz;
+	    }
+
+	    bool BoxesOverlap(const Vec3 &center_a, const Vec3 &extent_a, const Vec3 &center_b, const Vec3 &extent_b)
+	    {
+	        return std::abs(center_a.x - center_b.x) <= extent_a.x + extent_b.x &&
+	               std::abs(center_a.y - center_b.y) <= extent_a.y + extent_b.y &&
+	               std::abs(center_a.z - center_b.z) <= extent_a.z + extent_b.z;
+	    }
+	}
+
+	LooseOctree::LooseOctree(const BoundingBox &world_bounds, const uint32_t max_depth) : m_MaxDepth(std::min(max_depth, MAX_DEPTH))
+	{
+	    const Vec3 center = world_bounds.GetCenter();
+	    const Vec3 extent = world_bounds.GetExtents();
+	    const float half_size = std::max({ extent.x, extent.y, extent.z });
+	    assert(half_size > 0.0f);
+
+	    m_WorldMin = center - Vec3(half_size);
+	    m_WorldSize = half_size * 2.0f;
+	    AllocateNode(INVALID_INDEX, 0, center, half_size, 0);
+	}
+
+	uint32_t LooseOctree::SelectDepth(const Vec3 &center, const Vec3 &extent) const
+	{
+	    // Objects centered outside the world have no cell below the root
+	    const Vec3 offset = center - m_WorldMin;
+	    if (offset.x < 0.0f || offset.y < 0.0f || offset.z < 0.0f || offset.x > m_WorldSize || offset.y > m_WorldSize || offset.z > m_WorldSize)
+	        return 0;
+
+	    const float radius = std::max({ extent.x, extent.y, extent.z });
+	    if (radius <= 0.0f)
+	        return m_MaxDepth;
+
+	    // Loose bounds reach one cell half size past the cell, so an object fits at depth d
+	    // when its extent is at most (world_size / 2) / 2^d: d = floor(log2(world_size / 2 / extent))
+	    const int depth = std::ilogb(m_WorldSize * 0.5f / radius);
+	    return static_cast<uint32_t>(std::clamp(depth, 0, static_cast<int>(m_MaxDepth)));
+	}
+
+	bool LooseOctree::InCell(const Node &node, const Vec3 &point) const
+	{
+	    return std::abs(point.x - node.center.x) <= node.half_size &&
+	           std::abs(point.y - node.center.y) <= node.half_size &&
+	           std::abs(point.z - node.center.z) <= node.half_size;
+	}
+
+	uint32_t LooseOctree::AllocateNode(const uint32_t parent, const uint8_t octant, const Vec3 &center, const float half_size, const uint8_t depth)
+	{
+	    uint32_t index;
+	    if (!m_FreeNodes.empty())
+	    {
+	        index = m_FreeNodes.back();
+	        m_FreeNodes.pop_back();
+	    }
+	    else
+	    {
+	        index = static_cast<uint32_t>(m_Nodes.size());
+	        m_Nodes.emplace_back();
+	    }
+
+	    Node &node = m_Nodes[index];
+	    node.center = center;
+	    node.half_size = half_size;
+	    node.parent = parent;
+	    std::fill(std::begin(node.children), std::end(node.children), INVALID_INDEX);
+	    node.first_object = INVALID_INDEX;
+	    node.subtree_count = 0;
+	    node.depth = depth;
+	    node.octant = octant;
+	    return index;
+	}
+
+	uint32_t LooseOctree::FindOrCreateNode(const Vec3 &center, const uint32_t depth)
+	{
+	    if (depth == 0)
+	        return 0;
+
+	    const int cells = 1 << depth;
+	    const float scale = static_cast<float>(cells) / m_WorldSize;
+	    const int cx = std::clamp(static_cast<int>(std::floor((center.x - m_WorldMin.x) * scale)), 0, cells - 1);
+	    const int cy = std::clamp(static_cast<int>(std::floor((center.y - m_WorldMin.y) * scale)), 0, cells - 1);
+	    const int cz = std::clamp(static_cast<int>(std::floor((center.z - m_WorldMin.z) * scale)), 0, cells - 1);
+
+	    // The cell coordinates hold the octant path from the root, most significant bit first
+	    uint32_t node_index = 0;
+	    for (uint32_t level = depth; level > 0; level--)
+	    {
+	        const uint32_t shift = level - 1;
+	        const uint32_t bx = (cx >> shift) & 1, by = (cy >> shift) & 1, bz = (cz >> shift) & 1;
+	        const uint8_t octant = static_cast<uint8_t>(bx | (by << 1) | (bz << 2));
+
+	        uint32_t child = m_Nodes[node_index].children[octant];
+	        if (child == INVALID_INDEX)
+	        {
+	            const Node &parent = m_Nodes[node_index];
+	            const float half_size = parent.half_size * 0.5f;
+	            const Vec3 child_center(parent.center.x + (bx ? half_size : -half_size),
+	                                    parent.center.y + (by ? half_size : -half_size),
+	                                    parent.center.z + (bz ? half_size : -half_size));
+	            const uint8_t child_depth = static_cast<uint8_t>(parent.depth + 1);
+
+	            // Allocation may grow the pool, so the parent is looked up again afterwards
+	            child = AllocateNode(node_index, octant, child_center, half_size, child_depth);
+	            m_Nodes[node_index].children[octant] = child;
+	        }
+	        node_index = child;
+	    }
+	    return node_index;
+	}
+
+	void LooseOctree::Link(const uint32_t id, const uint32_t node_index)
+	{
+	    Object &object = m_Objects[id];
+	    Node &node = m_Nodes[node_index];
+	    object.node = node_index;
+	    object.prev = INVALID_INDEX;
+	    object.next = node.first_object;
+	    if (node.first_object != INVALID_INDEX)
+	        m_Objects[node.first_object].prev = id;
+	    node.first_object = id;
+
+	    for (uint32_t n = node_index; n != INVALID_INDEX; n = m_Nodes[n].parent)
+	        m_Nodes[n].subtree_count++;
+	}
+
+	void LooseOctree::Unlink(const uint32_t id)
+	{
+	    Object &object = m_Objects[id];
+	    if (object.prev != INVALID_INDEX)
+	        m_Objects[object.prev].next = object.next;
+	    else
+	        m_Nodes[object.node].first_object = object.next;
+	    if (object.next != INVALID_INDEX)
+	        m_Objects[object.next].prev = object.prev;
+
+	    for (uint32_t n = object.node; n != INVALID_INDEX; n = m_Nodes[n].parent)
+	        m_Nodes[n].subtree_count--;
+
+	    // Release the chain of nodes left without objects; the root always stays
+	    uint32_t node_index = object.node;
+	    while (node_index != 0 && m_Nodes[node_index].subtree_count == 0)
+	    {
+	        const Node &node = m_Nodes[node_index];
+	        const uint32_t parent = node.parent;
+	        m_Nodes[parent].children[node.octant] = INVALID_INDEX;
+	        m_FreeNodes.push_back(node_index);
+	        node_index = parent;
+	    }
+
+	    object.node = INVALID_INDEX;
+	    object.prev = INVALID_INDEX;
+	    object.next = INVALID_INDEX;
+	}
+
+	void LooseOctree::Insert(const uint32_t id, const BoundingBox &box)
+	{
+	    assert(!Contains(id));
+	    if (id >= m_Objects.size())
+	        m_Objects.resize(static_cast<size_t>(id) + 1);
+
+	    Object &object = m_Objects[id];
+	    object.center = box.GetCenter();
+	    object.extent = box.GetExtents();
+	    Link(id, FindOrCreateNode(object.center, SelectDepth(object.center, object.extent)));
+	    m_ObjectCount++;
+	}
+
+	void LooseOctree::Update(const uint32_t id, const BoundingBox &box)
+	{
+	    assert(Contains(id));
+
+	    Object &object = m_Objects[id];
+	    object.center = box.GetCenter();
+	    object.extent = box.GetExtents();
+
+	    // Most moves stay inside the same cell at the same size
+	    const uint32_t depth = SelectDepth(object.center, object.extent);
+	    const Node &node = m_Nodes[object.node];
+	    if (depth == node.depth && (depth == 0 || InCell(node, object.center)))
+	        return;
+
+	    Unlink(id);
+	    Link(id, FindOrCreateNode(object.center, depth));
+	}
+
+	void LooseOctree::Remove(const uint32_t id)
+	{
+	    assert(Contains(id));
+	    Unlink(id);
+	    m_ObjectCount--;
+	}
+
+	void LooseOctree::Clear()
+	{
+	    const Node root = m_Nodes[0];
+	    m_Nodes.clear();
+	    m_FreeNodes.clear();
+	    m_Objects.clear();
+	    m_ObjectCount = 0;
+	    AllocateNode(INVALID_INDEX, 0, root.center, root.half_size, 0);
+	}
+
+	uint32_t LooseOctree::GetObjectDepth(const uint32_t id) const
+	{
+	    assert(Contains(id));
+	    return m_Nodes[m_Objects[id].node].depth;
+	}
+
+	void LooseOctree::QueryFrustum(const Frustum &frustum, std::vector<uint32_t> &results) const
+	{
+	    uint32_t stack[STACK_SIZE];
+	    uint8_t mask_stack[STACK_SIZE];
+	    uint32_t stack_size = 0;
+	    stack[stack_size] = 0;
+	    mask_stack[stack_size++] = Frustum::PLANE_MASK_ALL;
+
+	    while (stack_size > 0)
+	    {
+	        --stack_size;
+	        const uint32_t node_index = stack[stack_size];
+	        const Node &node = m_Nodes[node_index];
+
+	        // The root also holds objects outside the world, so it is never culled
+	        uint8_t mask = mask_stack[stack_size];
+	        if (node_index != 0 && mask != 0 && frustum.CheckCubeMasked(node.center, Vec3(node.half_size * 2.0f), mask) == Intersection::Outside)
+	            continue;
+
+	        for (uint32_t id = node.first_object; id != INVALID_INDEX; id = m_Objects[id].next)
+	        {
+	            const Object &object = m_Objects[id];
+	            uint8_t object_mask = mask;
+	            if (object_mask == 0 || frustum.CheckCubeMasked(object.center, object.extent, object_mask) != Intersection::Outside)
+	                results.push_back(id);
+	        }
+
+	        for (const uint32_t child : node.children)
+	        {
+	            if (child == INVALID_INDEX)
+	                continue;
+
+	            assert(stack_size < STACK_SIZE);
+	            stack[stack_size] = child;
+	            mask_stack[stack_size++] = mask;
+	        }
+	    }
+	}
+
+	void LooseOctree::QuerySphere(const Sphere &sphere, std::vector<uint32_t> &results) const
+	{
+	    const float radius_squared = sphere.radius * sphere.radius;
+
+	    uint32_t stack[STACK_SIZE];
+	    uint32_t stack_size = 0;
+	    stack[stack_size++] = 0;
+
+	    while (stack_size > 0)
+	    {
+	        const uint32_t node_index = stack[--stack_size];
+	        const Node &node = m_Nodes[node_index];
+	        if (node_index != 0 && BoxDistanceSquared(node.center, Vec3(node.half_size * 2.0f), sphere.center) > radius_squared)
+	            continue;
+
+	        for (uint32_t id = node.first_object; id != INVALID_INDEX; id = m_Objects[id].next)
+	        {
+	            const Object &object = m_Objects[id];
+	            if (BoxDistanceSquared(object.center, object.extent, sphere.center) <= radius_squared)
+	                results.push_back(id);
+	        }
+
+	        for (const uint32_t child : node.children)
+	        {
+	            if (child == INVALID_INDEX)
+	                continue;
+
+	            assert(stack_size < STACK_SIZE);
+	            stack[stack_size++] = child;
+	        }
+	    }
+	}
+
+	void LooseOctree::QueryOverlap(const BoundingBox &box, std::vector<uint32_t> &results) const
+	{
+	    const Vec3 center = box.GetCenter();
+	    const Vec3 extent = box.GetExtents();
+
+	    uint32_t stack[STACK_SIZE];
+	    uint32_t stack_size = 0;
+	    stack[stack_size++] = 0;
+
+	    while (stack_size > 0)
+	    {
+	        const uint32_t node_index = stack[--stack_size];
+	        const Node &node = m_Nodes[node_index];
+	        if (node_index != 0 && !BoxesOverlap(node.center, Vec3(node.half_size * 2.0f), center, extent))
+	            continue;
+
+	        for (uint32_t id = node.first_object; id != INVALID_INDEX; id = m_Objects[id].next)
+	        {
+	            const Object &object = m_Objects[id];
+	            if (BoxesOverlap(object.center, object.extent, center, extent))
+	                results.push_back(id);
+	        }
+
+	        for (const uint32_t child : node.children)
+	        {
+	            if (child == INVALID_INDEX)
+	                continue;
+
+	            assert(stack_size < STACK_SIZE);
+	            stack[stack_size++] = child;
+	        }
+	    }
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,404 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* oriented_bounding_box.cpp
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <xmath.hpp>
+#include <xMath/includes/oriented_bounding_box.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	namespace
+	{
+	    // Added to the absolute rotation terms so near-parallel edges do not produce a false separating axis
+	    constexpr float SAT_EPSILON = 1e-6f;
+
+	    // Separating axis test (Ericson, Real-Time Collision Detection 4.4.1). With EARLY_OUT
+	    // disabled, all 15 axes are evaluated and combined, so batch loops have no branches.
+	    template <bool EARLY_OUT>
+	    bool Overlap(const Vec3 &center_a, const Vec3 axes_a[3], const float extents_a[3],
+	                 const Vec3 &center_b, const Vec3 axes_b[3], const float extents_b[3])
+	    {
+	        float r[3][3], abs_r[3][3];
+	        for (int i = 0; i < 3; i++)
+	        {
+	            for (int j = 0; j < 3; j++)
+	            {
+	                r[i][j] = Dot(axes_a[i], axes_b[j]);
+	                abs_r[i][j] = std::abs(r[i][j]) + SAT_EPSILON;
+	            }
+	        }
+
+	        // Center offset in the frame of a
+	        const Vec3 offset = center_b - center_a;
+	        const float t[3] = { Dot(offset, axes_a[0]), Dot(offset, axes_a[1]), Dot(offset, axes_a[2]) };
+
+	        bool separated = false;
+	        const auto test = [&separated](const float distance, const float radius)
+	        {
+	            separated |= std::abs(distance) > radius;
+	            return EARLY_OUT && separated;
+	        };
+
+	        // Face axes of a
+	        for (int i = 0; i < 3; i++)
+	        {
+	            if (test(t[i], extents_a[i] + extents_b[0] * abs_r[i][0] + extents_b[1] * abs_r[i][1] + extents_b[2] * abs_r[i][2]))
+	                return false;
+	        }
+
+	        // Face axes of b
+	        for (int j = 0; j < 3; j++)
+	        {
+	            const float distance = t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j];
+	            if (test(distance, extents_a[0] * abs_r[0][j] + extents_a[1] * abs_r[1][j] + extents_a[2] * abs_r[2][j] + extents_b[j]))
+	                return false;
+	        }
+
+	        // Edge cross products a_i x b_j
+	        for (int i = 0; i < 3; i++)
+	        {
+	            const int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+	            for (int j = 0; j < 3; j++)
+	            {
+	                const int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+	                const float distance = t[i2] * r[i1][j] - t[i1] * r[i2][j];
+	                const float radius_a = extents_a[i1] * abs_r[i2][j] + extents_a[i2] * abs_r[i1][j];
+	                const float radius_b = extents_b[j1] * abs_r[i][j2] + extents_b[j2] * abs_r[i][j1];
+	                if (test(distance, radius_a + radius_b))
+	                    return false;
+	            }
+	        }
+
+	        return !separated;
+	    }
+
+	    // Cyclic Jacobi iteration for a symmetric 3x3 matrix; the columns of vectors become the eigenvectors
+	    void JacobiEigenvectors(float a[3][3], float vectors[3][3])
+	    {
+	        for (int i = 0; i < 3; i++)
+	            for (int j = 0; j < 3; j++)
+	                vectors[i][j] = i == j ? 1.0f : 0.0f;
+
+	        for (int sweep = 0; sweep < 32; sweep++)
+	        {
+	            const float off_diagonal = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+	            const float diagonal = a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2];
+	            if (off_diagonal <= 1e-12f * diagonal || off_diagonal == 0.0f)
+	                return;
+
+	            for (int p = 0; p < 2; p++)
+	            {
+	                for (int q = p + 1; q < 3; q++)
+	                {
+	                    if (a[p][q] == 0.0f)
+	                        continue;
+
+	                    // Rotation that zeroes a[p][q]
+	                    const float theta = (a[q][q] - a[p][p]) / (2.0f * a[p][q]);
+	                    const float t = (theta >= 0.0f ? 1.0f : -1.0f) / (std::abs(theta) + std::sqrt(theta * theta + 1.0f));
+	                    const float c = 1.0f / std::sqrt(t * t + 1.0f), s = t * c;
+
+	                    for (int k = 0; k < 3; k++)
+	                    {
+	                        const float kp = a[k][p], kq = a[k][q];
+	                        a[k][p] = c * kp - s * kq;
+	                        a[k][q] = s * kp + c * kq;
+	                    }
+	                    for (int k = 0; k < 3; k++)
+	                    {
+	                        const float pk = a[p][k], qk = a[q][k];
+	                        a[p][k] = c * pk - s * qk;
+	                        a[q][k] = s * pk + c * qk;
+	                    }
+	                    for (int k = 0; k < 3; k++)
+	                    {
+	                        const float kp = vectors[k][p], kq = vectors[k][q];
+	                        vectors[k][p] = c * kp - s * kq;
+	                        vectors[k][q] = s * kp + c * kq;
+	                    }
+	                }
+	            }
+	        }
+	    }
+
+	    // Orthonormal basis spanned by the columns of a transform. Gram-Schmidt keeps the columns
+	    // that are not degenerate (zero scale or parallel to an earlier column), and the missing
+	    // axes are completed with cross products, so a flattened box keeps its other extents.
+	    Mat3 BasisFromColumns(const Vec3 columns[3])
+	    {
+	        const float scale = std::max({ Length2(columns[0]), Length2(columns[1]), Length2(columns[2]) });
+	        if (scale <= 0.0f)
+	            return Mat3::Identity();
+
+	        Vec3 axes[3];
+	        bool valid[3];
+	        int valid_count = 0;
+	        for (int a = 0; a < 3; a++)
+	        {
+	            Vec3 axis = columns[a];
+	            for (int b = 0; b < a; b++)
+	            {
+	                if (valid[b])
+	                    axis = axis - axes[b] * Dot(axis, axes[b]);
+	            }
+
+	            const float length_squared = Length2(axis);
+	            valid[a] = length_squared > 1e-12f * scale;
+	            if (valid[a])
+	            {
+	                axes[a] = axis * (1.0f / std::sqrt(length_squared));
+	                valid_count++;
+	            }
+	        }
+
+	        // One axis left: pair it with the coordinate axis it is least aligned with
+	        if (valid_count == 1)
+	        {
+	            const int a = valid[0] ? 0 : valid[1] ? 1 : 2;
+	            const Vec3 &u = axes[a];
+	            const Vec3 other = std::abs(u.x) <= std::abs(u.y) && std::abs(u.x) <= std::abs(u.z) ? Vec3(1.0f, 0.0f, 0.0f) :
+	                               std::abs(u.y) <= std::abs(u.z) ? Vec3(0.0f, 1.0f, 0.0f) : Vec3(0.0f, 0.0f, 1.0f);
+	            axes[(a + 1) % 3] = Normalize(Cross(u, other));
+	            valid[(a + 1) % 3] = true;
+	        }
+
+	        // Right-handed completion; with all three columns valid, z is replaced as in Mat3::Orthonormalize
+	        const int missing = !valid[0] ? 0 : !valid[1] ? 1 : 2;
+	        axes[missing] = Cross(axes[(missing + 1) % 3], axes[(missing + 2) % 3]);
+	        return Mat3::FromColumns(axes[0], axes[1], axes[2]);
+	    }
+	}
+
+	OrientedBoundingBox::OrientedBoundingBox() : m_Center(0.0f), m_Basis(Mat3::Identity()), m_Extents(0.0f)
+	{
+	}
+
+	OrientedBoundingBox::OrientedBoundingBox(const Vec3 &center, const Mat3 &basis, const Vec3 &extents)
+	    : m_Center(center), m_Basis(basis), m_Extents(extents)
+	{
+	    assert(extents.x >= 0.0f && extents.y >= 0.0f && extents.z >= 0.0f);
+	}
+
+	OrientedBoundingBox::OrientedBoundingBox(const BoundingBox &box, const Mat4 &transform)
+	{
+	    const Vec3 center = box.GetCenter();
+	    const Vec3 extents = box.GetExtents();
+	    m_Center = Vec3(transform * center);
+
+	    // Basis columns of the transform (m00..m22 are logical row/column elements)
+	    const Vec3 columns[3] = {
+	        Vec3(transform.m00, transform.m10, transform.m20),
+	        Vec3(transform.m01, transform.m11, transform.m21),
+	        Vec3(transform.m02, transform.m12, transform.m22)
+	    };
+
+	    // Transformed half-size vectors of the box
+	    const Vec3 edges[3] = {columns[0] * extents.x, columns[1] * extents.y, columns[2] * extents.z};
+
+	    m_Basis = BasisFromColumns(columns);
+
+	    // Support of the transformed box along each axis; equals the scaled extents unless the transform shears
+	    for (int a = 0; a < 3; a++)
+	    {
+	        const Vec3 axis = m_Basis.Column(a);
+	        m_Extents[a] = std::abs(Dot(axis, edges[0])) + std::abs(Dot(axis, edges[1])) + std::abs(Dot(axis, edges[2]));
+	    }
+	}
+
+	OrientedBoundingBox OrientedBoundingBox::FromPoints(const Vec3 *points, const size_t count)
+	{
+	    if (count == 0)
+	        return {};
+
+	    assert(points != nullptr);
+
+	    Vec3 mean(0.0f);
+	    for (size_t i = 0; i < count; i++)
+	        mean = mean + points[i];
+	    mean = mean * (1.0f / static_cast<float>(count));
+
+	    float covariance[3][3] = {};
+	    for (size_t i = 0; i < count; i++)
+	    {
+	        const Vec3 d = points[i] - mean;
+	        covariance[0][0] += d.x * d.x; covariance[0][1] += d.x * d.y; covariance[0][2] += d.x * d.z;
+	        covariance[1][1] += d.y * d.y; covariance[1][2] += d.y * d.z; covariance[2][2] += d.z * d.z;
+	    }
+	    covariance[1][0] = covariance[0][1];
+	    covariance[2][0] = covariance[0][2];
+	    covariance[2][1] = covariance[1][2];
+
+	    float vectors[3][3];
+	    JacobiEigenvectors(covariance, vectors);
+
+	    // Right-handed orthonormal axes
+	    const Mat3 basis = Mat3::Orthonormalize(Mat3(vectors[0][0], vectors[0][1], vectors[0][2],
+	                                                 vectors[1][0], vectors[1][1], vectors[1][2],
+	                                                 vectors[2][0], vectors[2][1], vectors[2][2]));
+	    const Vec3 axes[3] = { basis.Column(0), basis.Column(1), basis.Column(2) };
+
+	    float min[3] = { FLT_MAX, FLT_MAX, FLT_MAX }, max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+	    for (size_t i = 0; i < count; i++)
+	    {
+	        for (int a = 0; a < 3; a++)
+	        {
+	            const float projection = Dot(points[i], axes[a]);
+	            min[a] = std::min(min[a], projection);
+	            max[a] = std::max(max[a], projection);
+	        }
+	    }
+
+	    Vec3 center(0.0f), extents;
+	    for (int a = 0; a < 3; a++)
+	    {
+	        center = center + axes[a] * ((min[a] + max[a]) * 0.5f);
+	        extents[a] = (max[a] - min[a]) * 0.5f;
+	    }
+	    return {center, basis, extents};
+	}
+
+	Vec3 OrientedBoundingBox::GetAxis(const int index) const
+	{
+	    assert(index >= 0 && index < 3);
+	    return m_Basis.Column(index);
+	}
+
+	void OrientedBoundingBox::GetCorners(std::array<Vec3, 8> *corners) const
+	{
+	    const Vec3 x = m_Basis.Column(0) * m_Extents.x;
+	    const Vec3 y = m_Basis.Column(1) * m_Extents.y;
+	    const Vec3 z = m_Basis.Column(2) * m_Extents.z;
+	    for (int i = 0; i < 8; i++)
+	        (*corners)[i] = m_Center + (i & 1 ? x : -x) + (i & 2 ? y : -y) + (i & 4 ? z : -z);
+	}
+
+	BoundingBox OrientedBoundingBox::GetBoundingBox() const
+	{
+	    const Vec3 extents(
+	        std::abs(m_Basis.m00) * m_Extents.x + std::abs(m_Basis.m01) * m_Extents.y + std::abs(m_Basis.m02) * m_Extents.z,
+	        std::abs(m_Basis.m10) * m_Extents.x + std::abs(m_Basis.m11) * m_Extents.y + std::abs(m_Basis.m12) * m_Extents.z,
+	        std::abs(m_Basis.m20) * m_Extents.x + std::abs(m_Basis.m21) * m_Extents.y + std::abs(m_Basis.m22) * m_Extents.z);
+	    return {m_Center - extents, m_Center + extents};
+	}
+
+	Vec3 OrientedBoundingBox::GetClosestPoint(const Vec3 &point) const
+	{
+	    const Vec3 offset = point - m_Center;
+	    Vec3 result = m_Center;
+	    for (int a = 0; a < 3; a++)
+	    {
+	        const Vec3 axis = m_Basis.Column(a);
+	        result = result + axis * std::clamp(Dot(offset, axis), -m_Extents[a], m_Extents[a]);
+	    }
+	    return result;
+	}
+
+	bool OrientedBoundingBox::Contains(const Vec3 &point) const
+	{
+	    const Vec3 offset = point - m_Center;
+	    for (int a = 0; a < 3; a++)
+	    {
+	        if (std::abs(Dot(offset, m_Basis.Column(a))) > m_Extents[a])
+	            return false;
+	    }
+	    return true;
+	}
+
+	bool OrientedBoundingBox::Intersects(const OrientedBoundingBox &box) const
+	{
+	    const Vec3 axes_a[3] = { m_Basis.Column(0), m_Basis.Column(1), m_Basis.Column(2) };
+	    const Vec3 axes_b[3] = { box.m_Basis.Column(0), box.m_Basis.Column(1), box.m_Basis.Column(2) };
+	    const float extents_a[3] = { m_Extents.x, m_Extents.y, m_Extents.z };
+	    const float extents_b[3] = { box.m_Extents.x, box.m_Extents.y, box.m_Extents.z };
+	    return Overlap<true>(m_Center, axes_a, extents_a, box.m_Center, axes_b, extents_b);
+	}
+
+	bool OrientedBoundingBox::Intersects(const BoundingBox &box) const
+	{
+	    return Intersects(OrientedBoundingBox(box.GetCenter(), Mat3::Identity(), box.GetExtents()));
+	}
+
+	Intersection OrientedBoundingBox::Intersects(const Frustum &frustum, uint8_t &plane_mask) const
+	{
+	    const Vec3 axes[3] = { m_Basis.Column(0) * m_Extents.x, m_Basis.Column(1) * m_Extents.y, m_Basis.Column(2) * m_Extents.z };
+	    uint8_t mask = plane_mask;
+
+	    for (uint32_t i = 0; i < 6; i++)
+	    {
+	        const uint8_t bit = static_cast<uint8_t>(1u << i);
+	        if (!(mask & bit))
+	            continue;
+
+	        // Projected radius of the box on the plane normal
+	        const Plane &plane = frustum.GetPlane(i);
+	        const float d = Dot(plane.normal, m_Center) + plane.d;
+	        const float r = std::abs(Dot(plane.normal, axes[0])) + std::abs(Dot(plane.normal, axes[1])) + std::abs(Dot(plane.normal, axes[2]));
+
+	        if (d + r < 0.0f)
+	            return Intersection::Outside;
+
+	        if (d - r >= 0.0f)
+	            mask &= static_cast<uint8_t>(~bit);
+	    }
+
+	    plane_mask = mask;
+	    return mask ? Intersection::Intersects : Intersection::Inside;
+	}
+
+	Intersection OrientedBoundingBox::Intersects(const Frustum &frustum) const
+	{
+	    uint8_t mask = Frustum::PLANE_MASK_ALL;
+	    return Intersects(frustum, mask);
+	}
+
+	size_t IntersectOrientedBoxes(const OrientedBoundingBox &box, const OrientedBoundingBox *boxes, const size_t count, uint8_t *results)
+	{
+	    assert((boxes != nullptr && results != nullptr) || count == 0);
+
+	    const Vec3 axes_a[3] = { box.GetAxis(0), box.GetAxis(1), box.GetAxis(2) };
+	    const float extents_a[3] = { box.GetExtents().x, box.GetExtents().y, box.GetExtents().z };
+
+	    size_t hits = 0;
+	    for (size_t i = 0; i < count; i++)
+	    {
+	        const Mat3 &basis = boxes[i].GetBasis();
+	        const Vec3 axes_b[3] = { basis.Column(0), basis.Column(1), basis.Column(2) };
+	        const float extents_b[3] = { boxes[i].GetExtents().x, boxes[i].GetExtents().y, boxes[i].GetExtents().z };
+	        const uint8_t hit = Overlap<false>(box.GetCenter(), axes_a, extents_a, boxes[i].GetCenter(), axes_b, extents_b) ? 1 : 0;
+	        results[i] = hit;
+	        hits += hit;
+	    }
+	    return hits;
+	}
+
+}
+
+/// -------------------------------------------------------
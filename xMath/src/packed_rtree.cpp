@@ -0,0 +1,214 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* packed_rtree.cpp
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+#include <xmath.hpp>
+#include <xMath/includes/packed_rtree.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	namespace
+	{
+	    constexpr uint32_t MAX_NODE_SIZE = 64;
+	    constexpr uint32_t STACK_SIZE = 1024;
+
+	    bool Intersects(const float min_x, const float min_y, const float max_x, const float max_y, const Rectangle &rect)
+	    {
+	        return !(max_x < rect.x || rect.x + rect.width < min_x || max_y < rect.y || rect.y + rect.height < min_y);
+	    }
+	}
+
+	void PackedRTree::Build(const Rectangle *rects, const size_t count, const uint32_t node_size)
+	{
+	    assert(rects != nullptr || count == 0);
+
+	    Clear();
+	    if (count == 0)
+	        return;
+
+	    m_NodeSize = std::clamp(node_size, 2u, MAX_NODE_SIZE);
+	    m_ItemCount = count;
+	    m_Boxes.resize(count);
+	    m_Links.resize(count);
+	    for (size_t i = 0; i < count; i++)
+	    {
+	        const Rectangle &rect = rects[i];
+	        m_Boxes[i] = { rect.x, rect.y, rect.x + rect.width, rect.y + rect.height };
+	        m_Links[i] = static_cast<uint32_t>(i);
+	    }
+
+	    std::vector<uint32_t> order;
+	    std::vector<Box> sorted_boxes;
+	    std::vector<uint32_t> sorted_links;
+
+	    size_t level_start = 0;
+	    size_t level_end = count;
+	    while (true)
+	    {
+	        // Sort-Tile-Recursive: slices by center x, then center y within each slice
+	        const size_t level_count = level_end - level_start;
+	        const size_t parent_count = (level_count + m_NodeSize - 1) / m_NodeSize;
+	        const size_t slice_count = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(parent_count))));
+	        const size_t slice_size = slice_count * m_NodeSize;
+
+	        order.resize(level_count);
+	        std::iota(order.begin(), order.end(), static_cast<uint32_t>(level_start));
+	        const auto center_x = [this](const uint32_t i) { return m_Boxes[i].min_x + m_Boxes[i].max_x; };
+	        const auto center_y = [this](const uint32_t i) { return m_Boxes[i].min_y + m_Boxes[i].max_y; };
+	        std::sort(order.begin(), order.end(), [&](const uint32_t a, const uint32_t b) { return center_x(a) < center_x(b); });
+	        for (size_t s = 0; s < level_count; s += slice_size)
+	        {
+	            const auto end = order.begin() + static_cast<std::ptrdiff_t>(std::min(s + slice_size, level_count));
+	            std::sort(order.begin() + static_cast<std::ptrdiff_t>(s), end, [&](const uint32_t a, const uint32_t b) { return center_y(a) < center_y(b); });
+	        }
+
+	        sorted_boxes.resize(level_count);
+	        sorted_links.resize(level_count);
+	        for (size_t i = 0; i < level_count; i++)
+	        {
+	            sorted_boxes[i] = m_Boxes[order[i]];
+	            sorted_links[i] = m_Links[order[i]];
+	        }
+	        std::copy(sorted_boxes.begin(), sorted_boxes.end(), m_Boxes.begin() + static_cast<std::ptrdiff_t>(level_start));
+	        std::copy(sorted_links.begin(), sorted_links.end(), m_Links.begin() + static_cast<std::ptrdiff_t>(level_start));
+	        m_LevelEnds.push_back(static_cast<uint32_t>(level_end));
+
+	        if (level_count == 1)
+	            break;
+
+	        // Pack consecutive runs of node_size entries into parents
+	        for (size_t first = level_start; first < level_end; first += m_NodeSize)
+	        {
+	            const size_t last = std::min(first + m_NodeSize, level_end);
+	            Box box = m_Boxes[first];
+	            for (size_t i = first + 1; i < last; i++)
+	            {
+	                box.min_x = std::min(box.min_x, m_Boxes[i].min_x);
+	                box.min_y = std::min(box.min_y, m_Boxes[i].min_y);
+	                box.max_x = std::max(box.max_x, m_Boxes[i].max_x);
+	                box.max_y = std::max(box.max_y, m_Boxes[i].max_y);
+	            }
+	            m_Boxes.push_back(box);
+	            m_Links.push_back(static_cast<uint32_t>(first));
+	        }
+
+	        level_start = level_end;
+	        level_end = m_Boxes.size();
+	    }
+	}
+
+	void PackedRTree::Clear()
+	{
+	    m_ItemCount = 0;
+	    m_Boxes.clear();
+	    m_Links.clear();
+	    m_LevelEnds.clear();
+	}
+
+	Rectangle PackedRTree::GetBounds() const
+	{
+	    if (m_Boxes.empty())
+	        return Rectangle::ZERO;
+
+	    const Box &root = m_Boxes.back();
+	    return {root.min_x, root.min_y, root.max_x - root.min_x, root.max_y - root.min_y};
+	}
+
+	template <typename Test>
+	void PackedRTree::Query(const Test &test, std::vector<uint32_t> &results) const
+	{
+	    if (m_Boxes.empty())
+	        return;
+
+	    uint32_t stack[STACK_SIZE];
+	    uint32_t stack_size = 0;
+	    stack[stack_size++] = static_cast<uint32_t>(m_Boxes.size() - 1);
+
+	    while (stack_size > 0)
+	    {
+	        const uint32_t index = stack[--stack_size];
+	        const Box &box = m_Boxes[index];
+	        if (!test(box.min_x, box.min_y, box.max_x, box.max_y))
+	            continue;
+
+	        if (index < m_ItemCount)
+	        {
+	            results.push_back(m_Links[index]);
+	            continue;
+	        }
+
+	        // The children of a node are in the level below it
+	        size_t level = 1;
+	        while (index >= m_LevelEnds[level])
+	            level++;
+
+	        const uint32_t first = m_Links[index];
+	        const uint32_t end = std::min(first + m_NodeSize, m_LevelEnds[level - 1]);
+	        for (uint32_t child = first; child < end; child++)
+	        {
+	            assert(stack_size < STACK_SIZE);
+	            stack[stack_size++] = child;
+	        }
+	    }
+	}
+
+	void PackedRTree::QueryPoint(const Vec2 &point, std::vector<uint32_t> &results) const
+	{
+	    Query([&point](const float min_x, const float min_y, const float max_x, const float max_y)
+	    {
+	        return point.x >= min_x && point.x <= max_x && point.y >= min_y && point.y <= max_y;
+	    }, results);
+	}
+
+	void PackedRTree::QueryRect(const Rectangle &rect, std::vector<uint32_t> &results) const
+	{
+	    Query([&rect](const float min_x, const float min_y, const float max_x, const float max_y)
+	    {
+	        return Intersects(min_x, min_y, max_x, max_y, rect);
+	    }, results);
+	}
+
+	void PackedRTree::QueryRegion(const Rectangle *region, const size_t region_count, std::vector<uint32_t> &results) const
+	{
+	    assert(region != nullptr || region_count == 0);
+
+	    Query([region, region_count](const float min_x, const float min_y, const float max_x, const float max_y)
+	    {
+	        for (size_t r = 0; r < region_count; r++)
+	            if (Intersects(min_x, min_y, max_x, max_y, region[r]))
+	                return true;
+	        return false;
+	    }, results);
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,68 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* parallel_for.h
+* -------------------------------------------------------
+* Created: 10/17/2026
+* -------------------------------------------------------
+*/
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <vector>
+
+// -------------------------------------------------------
+
+// Internal to the library: shared by the builders and batch queries that split work into chunks
+namespace xMath::detail
+{
+	/**
+	 * @brief Calls function(chunk, begin, end) for each chunk of [0, count).
+	 *
+	 * The first chunk runs on the calling thread and the others on std::async tasks; returns
+	 * once all of them are done.
+	 *
+	 * @param count The number of items.
+	 * @param chunk_size The items per chunk (at least 1).
+	 * @param function The work for one chunk.
+	 */
+	template <typename Function>
+	void ParallelFor(const size_t count, const size_t chunk_size, const Function &function)
+	{
+	    if (count == 0)
+	        return;
+
+	    std::vector<std::future<void>> tasks;
+	    for (size_t begin = chunk_size; begin < count; begin += chunk_size)
+	    {
+	        const size_t end = std::min(begin + chunk_size, count);
+	        tasks.push_back(std::async(std::launch::async, [&function, chunk_size, begin, end] { function(begin / chunk_size, begin, end); }));
+	    }
+
+	    function(0, 0, std::min(chunk_size, count));
+	    for (std::future<void> &task : tasks)
+	        task.get();
+	}
+
+}
+
+/// -------------------------------------------------------
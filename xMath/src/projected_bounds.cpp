@@ -0,0 +1,259 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* projected_bounds.cpp
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <xmath.hpp>
+#include <xMath/includes/projected_bounds.h>
+
+/// -------------------------------------------------------
+
+namespace xMath
+{
+	namespace
+	{
+	    // Signed distance to the near plane in clip space; >= 0 in front of it
+	    float NearDistance(const Vec4 &p, const uint8_t depth_flags)
+	    {
+	        if (depth_flags & Frustum::DEPTH_REVERSED)
+	            return p.w - p.z;
+	        return (depth_flags & Frustum::DEPTH_NEGATIVE_ONE_TO_ONE) ? p.z + p.w : p.z;
+	    }
+
+	    // Depth mapped to 0 at the near plane and 1 at the far plane
+	    float NormalizedDepth(const Vec4 &p, const uint8_t depth_flags)
+	    {
+	        float depth = p.z / p.w;
+	        if (depth_flags & Frustum::DEPTH_NEGATIVE_ONE_TO_ONE)
+	            depth = depth * 0.5f + 0.5f;
+	        if (depth_flags & Frustum::DEPTH_REVERSED)
+	            depth = 1.0f - depth;
+	        return std::clamp(depth, 0.0f, 1.0f);
+	    }
+
+	    // Maps an NDC rectangle to viewport pixels (y down) and clamps it; returns false when empty
+	    bool ToViewport(const float min_x, const float min_y, const float max_x, const float max_y, const Rectangle &viewport, Rectangle &rect)
+	    {
+	        const float left = std::max(viewport.x + (min_x * 0.5f + 0.5f) * viewport.width, viewport.x);
+	        const float right = std::min(viewport.x + (max_x * 0.5f + 0.5f) * viewport.width, viewport.x + viewport.width);
+	        const float top = std::max(viewport.y + (0.5f - max_y * 0.5f) * viewport.height, viewport.y);
+	        const float bottom = std::min(viewport.y + (0.5f - min_y * 0.5f) * viewport.height, viewport.y + viewport.height);
+
+	        if (left >= right || top >= bottom)
+	        {
+	            rect = Rectangle(viewport.x, viewport.y, 0.0f, 0.0f);
+	            return false;
+	        }
+
+	        rect = Rectangle(left, top, right - left, bottom - top);
+	        return true;
+	    }
+
+	    // One axis of the Mara-McGuire construction; a is the view-space axis (x or y)
+	    void GetSphereBoundsForAxis(const Vec3 &a, const Vec3 &center, const float radius, const float near_z, Vec3 &lower, Vec3 &upper)
+	    {
+	        // Sphere center in the (a, z) plane
+	        const float cx = Dot(a, center);
+	        const float cy = center.z;
+
+	        const float c_length2 = cx * cx + cy * cy;
+	        const float t_squared = c_length2 - radius * radius;
+	        const bool camera_inside = t_squared <= 0.0f;
+
+	        // (cos, sin) of the angle between the center direction and a tangent
+	        float vx = 0.0f, vy = 0.0f;
+	        if (!camera_inside)
+	        {
+	            const float inv_length = 1.0f / std::sqrt(c_length2);
+	            vx = std::sqrt(t_squared) * inv_length;
+	            vy = radius * inv_length;
+	        }
+
+	        // Half-width of the circle where the near plane cuts the sphere. With z pointing away from
+	        // the view direction the first tangent (positive sin) is the lower one, so start on -k.
+	        const bool clip_sphere = cy + radius >= near_z;
+	        float k = -std::sqrt(std::max(radius * radius - (cy - near_z) * (cy - near_z), 0.0f));
+
+	        float bounds_x[2] = {}, bounds_y[2] = {};
+	        for (int i = 0; i < 2; i++)
+	        {
+	            if (!camera_inside)
+	            {
+	                bounds_x[i] = (vx * cx + vy * cy) * vx;
+	                bounds_y[i] = (-vy * cx + vx * cy) * vx;
+	            }
+
+	            const bool clip_bound = camera_inside || bounds_y[i] > near_z;
+	            if (clip_sphere && clip_bound)
+	            {
+	                bounds_x[i] = cx + k;
+	                bounds_y[i] = near_z;
+	            }
+
+	            // The second pass gives the other tangent
+	            vy = -vy;
+	            k = -k;
+	        }
+
+	        lower = a * bounds_x[0];
+	        lower.z = bounds_y[0];
+	        upper = a * bounds_x[1];
+	        upper.z = bounds_y[1];
+	    }
+	}
+
+	bool ProjectBoundingBox(const Mat4 &view_projection, const Vec3 &center, const Vec3 &extent, const Rectangle &viewport,
+	                        const uint8_t depth_flags, Rectangle &rect, float &min_depth)
+	{
+	    Vec4 corners[8];
+	    float near_distance[8];
+	    for (uint32_t i = 0; i < 8; i++)
+	    {
+	        // Clip-space corners keep w so the edges can be clipped against the near plane before the divide
+	        corners[i] = view_projection * Vec3(center.x + ((i & 1) ? extent.x : -extent.x),
+	                                            center.y + ((i & 2) ? extent.y : -extent.y),
+	                                            center.z + ((i & 4) ? extent.z : -extent.z));
+	        near_distance[i] = NearDistance(corners[i], depth_flags);
+	    }
+
+	    float min_x = std::numeric_limits<float>::max(), min_y = std::numeric_limits<float>::max();
+	    float max_x = -std::numeric_limits<float>::max(), max_y = -std::numeric_limits<float>::max();
+	    min_depth = 1.0f;
+	    bool any_in_front = false;
+
+	    const auto include = [&](const Vec4 &p, const float depth)
+	    {
+	        const float inv_w = 1.0f / p.w;
+	        min_x = std::min(min_x, p.x * inv_w);
+	        max_x = std::max(max_x, p.x * inv_w);
+	        min_y = std::min(min_y, p.y * inv_w);
+	        max_y = std::max(max_y, p.y * inv_w);
+	        min_depth = std::min(min_depth, depth);
+	        any_in_front = true;
+	    };
+
+	    for (uint32_t i = 0; i < 8; i++)
+	    {
+	        if (near_distance[i] >= 0.0f && corners[i].w > 0.0f)
+	            include(corners[i], NormalizedDepth(corners[i], depth_flags));
+	    }
+
+	    // Clip the 12 edges against the near plane; the crossing points bound the visible part of the box
+	    for (uint32_t i = 0; i < 8; i++)
+	    {
+	        for (uint32_t axis = 1; axis <= 4; axis <<= 1)
+	        {
+	            const uint32_t j = i | axis;
+	            if ((i & axis) || (near_distance[i] >= 0.0f) == (near_distance[j] >= 0.0f))
+	                continue;
+
+	            const float t = near_distance[i] / (near_distance[i] - near_distance[j]);
+	            const Vec4 p = corners[i] + (corners[j] - corners[i]) * t;
+	            if (p.w > 0.0f)
+	                include(p, 0.0f);
+	        }
+	    }
+
+	    if (!any_in_front)
+	    {
+	        rect = Rectangle(viewport.x, viewport.y, 0.0f, 0.0f);
+	        min_depth = 1.0f;
+	        return false;
+	    }
+
+	    return ToViewport(min_x, min_y, max_x, max_y, viewport, rect);
+	}
+
+	bool ProjectSphere(const Mat4 &view, const Mat4 &projection, const Sphere &sphere, const Rectangle &viewport,
+	                   const uint8_t depth_flags, Rectangle &rect, float &min_depth)
+	{
+	    // Every matrix product below goes through Mat4 * Vec3; the view matrix is affine so w stays one
+	    const Vec3 center(view * sphere.center);
+	    const float radius = sphere.radius;
+
+	    // View-space z of the near plane (negative, right-handed), from the depth row (m22, m23) of the projection
+	    const float near_ndc = (depth_flags & Frustum::DEPTH_REVERSED) ? 1.0f : ((depth_flags & Frustum::DEPTH_NEGATIVE_ONE_TO_ONE) ? -1.0f : 0.0f);
+	    const float near_z = -projection.m23 / (projection.m22 + near_ndc);
+
+	    if (center.z - radius >= near_z)
+	    {
+	        rect = Rectangle(viewport.x, viewport.y, 0.0f, 0.0f);
+	        min_depth = 1.0f;
+	        return false;
+	    }
+
+	    Vec3 lower, upper;
+	    GetSphereBoundsForAxis(Vec3(1.0f, 0.0f, 0.0f), center, radius, near_z, lower, upper);
+	    const Vec4 left = projection * lower;
+	    const Vec4 right = projection * upper;
+
+	    GetSphereBoundsForAxis(Vec3(0.0f, 1.0f, 0.0f), center, radius, near_z, lower, upper);
+	    const Vec4 bottom = projection * lower;
+	    const Vec4 top = projection * upper;
+
+	    const float x0 = left.x / left.w, x1 = right.x / right.w;
+	    const float y0 = bottom.y / bottom.w, y1 = top.y / top.w;
+
+	    // Nearest point along the view axis, clamped to the near plane
+	    const float nearest_z = center.z + radius;
+	    min_depth = nearest_z >= near_z ? 0.0f : NormalizedDepth(projection * Vec3(0.0f, 0.0f, nearest_z), depth_flags);
+
+	    return ToViewport(std::min(x0, x1), std::min(y0, y1), std::max(x0, x1), std::max(y0, y1), viewport, rect);
+	}
+
+	size_t ProjectBoundingBoxes(const Mat4 &view_projection, const BoundingBoxSoA &bounds, const Rectangle &viewport,
+	                            const uint8_t depth_flags, Rectangle *rects, float *min_depths)
+	{
+	    assert(rects != nullptr && min_depths != nullptr);
+
+	    size_t projected = 0;
+	    for (size_t i = 0; i < bounds.Size(); i++)
+	    {
+	        const Vec3 center(bounds.center_x[i], bounds.center_y[i], bounds.center_z[i]);
+	        const Vec3 extent(bounds.extent_x[i], bounds.extent_y[i], bounds.extent_z[i]);
+	        projected += ProjectBoundingBox(view_projection, center, extent, viewport, depth_flags, rects[i], min_depths[i]) ? 1 : 0;
+	    }
+
+	    return projected;
+	}
+
+	size_t ProjectSpheres(const Mat4 &view, const Mat4 &projection, const Sphere *spheres, const size_t count, const Rectangle &viewport,
+	                      const uint8_t depth_flags, Rectangle *rects, float *min_depths)
+	{
+	    assert(spheres != nullptr && rects != nullptr && min_depths != nullptr);
+
+	    size_t projected = 0;
+	    for (size_t i = 0; i < count; i++)
+	        projected += ProjectSphere(view, projection, spheres[i], viewport, depth_flags, rects[i], min_depths[i]) ? 1 : 0;
+
+	    return projected;
+	}
+
+}
+
+/// -------------------------------------------------------
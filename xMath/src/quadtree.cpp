@@ -0,0 +1,344 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* quadtree.cpp
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <cassert>
+#include <xmath.hpp>
+#include <xMath/includes/quadtree.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	namespace
+	{
+	    constexpr uint32_t STACK_SIZE = 4 * Quadtree::MAX_DEPTH + 4;
+
+	    bool Intersects(const float min_x, const float min_y, const float max_x, const float max_y, const Rectangle &rect)
+	    {
+	        return !(max_x < rect.x || rect.x + rect.width < min_x || max_y < rect.y || rect.y + rect.height < min_y);
+	    }
+	}
+
+	Quadtree::Quadtree(const Rectangle &world_bounds, const uint32_t max_depth, const uint32_t split_threshold) :
+	    m_MaxDepth(std::min(max_depth, MAX_DEPTH)), m_SplitThreshold(std::max(split_threshold, 1u))
+	{
+	    assert(world_bounds.IsDefined());
+
+	    Node root{};
+	    root.min_x = world_bounds.x;
+	    root.min_y = world_bounds.y;
+	    root.max_x = world_bounds.x + world_bounds.width;
+	    root.max_y = world_bounds.y + world_bounds.height;
+	    root.parent = INVALID_INDEX;
+	    root.first_child = INVALID_INDEX;
+	    root.first_item = INVALID_INDEX;
+	    m_Nodes.push_back(root);
+	}
+
+	uint32_t Quadtree::FindChild(const Node &node, const Item &item) const
+	{
+	    if (node.first_child == INVALID_INDEX)
+	        return INVALID_INDEX;
+
+	    // Quadrant index: bit 0 set for the right half, bit 1 for the bottom half
+	    const float mid_x = (node.min_x + node.max_x) * 0.5f;
+	    const float mid_y = (node.min_y + node.max_y) * 0.5f;
+
+	    uint32_t quadrant = 0;
+	    if (item.min_x >= node.min_x && item.max_x <= mid_x)
+	        quadrant = 0;
+	    else if (item.min_x >= mid_x && item.max_x <= node.max_x)
+	        quadrant = 1;
+	    else
+	        return INVALID_INDEX;
+
+	    if (item.min_y >= node.min_y && item.max_y <= mid_y)
+	        return node.first_child + quadrant;
+	    if (item.min_y >= mid_y && item.max_y <= node.max_y)
+	        return node.first_child + quadrant + 2;
+	    return INVALID_INDEX;
+	}
+
+	uint32_t Quadtree::FindNode(const Item &item)
+	{
+	    uint32_t node = 0;
+	    for (uint32_t child = FindChild(m_Nodes[0], item); child != INVALID_INDEX; child = FindChild(m_Nodes[node], item))
+	        node = child;
+	    return node;
+	}
+
+	void Quadtree::Link(const uint32_t id, const uint32_t node_index)
+	{
+	    Item &item = m_Items[id];
+	    Node &node = m_Nodes[node_index];
+	    item.node = node_index;
+	    item.prev = INVALID_INDEX;
+	    item.next = node.first_item;
+	    if (node.first_item != INVALID_INDEX)
+	        m_Items[node.first_item].prev = id;
+	    node.first_item = id;
+	    node.item_count++;
+
+	    for (uint32_t n = node_index; n != INVALID_INDEX; n = m_Nodes[n].parent)
+	        m_Nodes[n].subtree_count++;
+	}
+
+	void Quadtree::Unlink(const uint32_t id)
+	{
+	    Item &item = m_Items[id];
+	    Node &node = m_Nodes[item.node];
+	    if (item.prev != INVALID_INDEX)
+	        m_Items[item.prev].next = item.next;
+	    else
+	        node.first_item = item.next;
+	    if (item.next != INVALID_INDEX)
+	        m_Items[item.next].prev = item.prev;
+	    node.item_count--;
+
+	    for (uint32_t n = item.node; n != INVALID_INDEX; n = m_Nodes[n].parent)
+	        m_Nodes[n].subtree_count--;
+
+	    item.node = INVALID_INDEX;
+	    item.prev = INVALID_INDEX;
+	    item.next = INVALID_INDEX;
+	}
+
+	void Quadtree::Split(const uint32_t node_index)
+	{
+	    uint32_t first_child;
+	    if (!m_FreeBlocks.empty())
+	    {
+	        first_child = m_FreeBlocks.back();
+	        m_FreeBlocks.pop_back();
+	    }
+	    else
+	    {
+	        first_child = static_cast<uint32_t>(m_Nodes.size());
+	        m_Nodes.resize(m_Nodes.size() + 4);
+	    }
+
+	    const Node parent = m_Nodes[node_index];
+	    const float mid_x = (parent.min_x + parent.max_x) * 0.5f;
+	    const float mid_y = (parent.min_y + parent.max_y) * 0.5f;
+	    for (uint32_t q = 0; q < 4; q++)
+	    {
+	        Node &child = m_Nodes[first_child + q];
+	        child.min_x = (q & 1) ? mid_x : parent.min_x;
+	        child.max_x = (q & 1) ? parent.max_x : mid_x;
+	        child.min_y = (q & 2) ? mid_y : parent.min_y;
+	        child.max_y = (q & 2) ? parent.max_y : mid_y;
+	        child.parent = node_index;
+	        child.first_child = INVALID_INDEX;
+	        child.first_item = INVALID_INDEX;
+	        child.item_count = 0;
+	        child.subtree_count = 0;
+	        child.depth = parent.depth + 1;
+	    }
+	    m_Nodes[node_index].first_child = first_child;
+
+	    // Push down every item that fits a child; the counts above this node do not change
+	    uint32_t id = m_Nodes[node_index].first_item;
+	    while (id != INVALID_INDEX)
+	    {
+	        const uint32_t next = m_Items[id].next;
+	        const uint32_t child = FindChild(m_Nodes[node_index], m_Items[id]);
+	        if (child != INVALID_INDEX)
+	        {
+	            Unlink(id);
+	            Link(id, child);
+	        }
+	        id = next;
+	    }
+
+	    for (uint32_t q = 0; q < 4; q++)
+	    {
+	        const Node &child = m_Nodes[first_child + q];
+	        if (child.item_count > m_SplitThreshold && child.depth < m_MaxDepth)
+	            Split(first_child + q);
+	    }
+	}
+
+	void Quadtree::Collapse(const uint32_t node_index)
+	{
+	    const uint32_t first_child = m_Nodes[node_index].first_child;
+	    if (first_child == INVALID_INDEX)
+	        return;
+
+	    for (uint32_t q = 0; q < 4; q++)
+	    {
+	        const uint32_t child = first_child + q;
+	        Collapse(child);
+	        while (m_Nodes[child].first_item != INVALID_INDEX)
+	        {
+	            const uint32_t id = m_Nodes[child].first_item;
+	            Unlink(id);
+	            Link(id, node_index);
+	        }
+	    }
+
+	    m_Nodes[node_index].first_child = INVALID_INDEX;
+	    m_FreeBlocks.push_back(first_child);
+	}
+
+	void Quadtree::Insert(const uint32_t id, const Rectangle &rect)
+	{
+	    assert(!Contains(id));
+	    if (id >= m_Items.size())
+	        m_Items.resize(static_cast<size_t>(id) + 1);
+
+	    Item &item = m_Items[id];
+	    item.min_x = rect.x;
+	    item.min_y = rect.y;
+	    item.max_x = rect.x + rect.width;
+	    item.max_y = rect.y + rect.height;
+
+	    const uint32_t node = FindNode(item);
+	    Link(id, node);
+	    m_ItemCount++;
+
+	    if (m_Nodes[node].first_child == INVALID_INDEX && m_Nodes[node].item_count > m_SplitThreshold && m_Nodes[node].depth < m_MaxDepth)
+	        Split(node);
+	}
+
+	void Quadtree::Update(const uint32_t id, const Rectangle &rect)
+	{
+	    assert(Contains(id));
+
+	    Item &item = m_Items[id];
+	    item.min_x = rect.x;
+	    item.min_y = rect.y;
+	    item.max_x = rect.x + rect.width;
+	    item.max_y = rect.y + rect.height;
+
+	    // Stay in place while the item still fits its node and no child
+	    const Node &node = m_Nodes[item.node];
+	    const bool fits = item.node == 0 || (item.min_x >= node.min_x && item.max_x <= node.max_x && item.min_y >= node.min_y && item.max_y <= node.max_y);
+	    if (fits && FindChild(node, item) == INVALID_INDEX)
+	        return;
+
+	    Remove(id);
+	    Insert(id, rect);
+	}
+
+	void Quadtree::Remove(const uint32_t id)
+	{
+	    assert(Contains(id));
+
+	    const uint32_t node = m_Items[id].node;
+	    Unlink(id);
+	    m_ItemCount--;
+
+	    // Collapse the highest ancestor whose subtree fits in a single node again
+	    uint32_t collapse = INVALID_INDEX;
+	    for (uint32_t n = node; n != INVALID_INDEX; n = m_Nodes[n].parent)
+	        if (m_Nodes[n].first_child != INVALID_INDEX && m_Nodes[n].subtree_count <= m_SplitThreshold)
+	            collapse = n;
+	    if (collapse != INVALID_INDEX)
+	        Collapse(collapse);
+	}
+
+	void Quadtree::Clear()
+	{
+	    Node root = m_Nodes[0];
+	    root.first_child = INVALID_INDEX;
+	    root.first_item = INVALID_INDEX;
+	    root.item_count = 0;
+	    root.subtree_count = 0;
+
+	    m_Nodes.clear();
+	    m_Nodes.push_back(root);
+	    m_FreeBlocks.clear();
+	    m_Items.clear();
+	    m_ItemCount = 0;
+	}
+
+	template <typename Test>
+	void Quadtree::Query(const Test &test, std::vector<uint32_t> &results) const
+	{
+	    uint32_t stack[STACK_SIZE];
+	    uint32_t stack_size = 0;
+	    stack[stack_size++] = 0;
+
+	    while (stack_size > 0)
+	    {
+	        const uint32_t node_index = stack[--stack_size];
+	        const Node &node = m_Nodes[node_index];
+
+	        // The root also holds items outside the world, so it is never culled
+	        if (node.subtree_count == 0 || (node_index != 0 && !test(node.min_x, node.min_y, node.max_x, node.max_y)))
+	            continue;
+
+	        for (uint32_t id = node.first_item; id != INVALID_INDEX; id = m_Items[id].next)
+	        {
+	            const Item &item = m_Items[id];
+	            if (test(item.min_x, item.min_y, item.max_x, item.max_y))
+	                results.push_back(id);
+	        }
+
+	        if (node.first_child == INVALID_INDEX)
+	            continue;
+
+	        for (uint32_t q = 0; q < 4; q++)
+	        {
+	            assert(stack_size < STACK_SIZE);
+	            stack[stack_size++] = node.first_child + q;
+	        }
+	    }
+	}
+
+	void Quadtree::QueryPoint(const Vec2 &point, std::vector<uint32_t> &results) const
+	{
+	    Query([&point](const float min_x, const float min_y, const float max_x, const float max_y)
+	    {
+	        return point.x >= min_x && point.x <= max_x && point.y >= min_y && point.y <= max_y;
+	    }, results);
+	}
+
+	void Quadtree::QueryRect(const Rectangle &rect, std::vector<uint32_t> &results) const
+	{
+	    Query([&rect](const float min_x, const float min_y, const float max_x, const float max_y)
+	    {
+	        return Intersects(min_x, min_y, max_x, max_y, rect);
+	    }, results);
+	}
+
+	void Quadtree::QueryRegion(const Rectangle *region, const size_t region_count, std::vector<uint32_t> &results) const
+	{
+	    assert(region != nullptr || region_count == 0);
+
+	    Query([region, region_count](const float min_x, const float min_y, const float max_x, const float max_y)
+	    {
+	        for (size_t r = 0; r < region_count; r++)
+	            if (Intersects(min_x, min_y, max_x, max_y, region[r]))
+	                return true;
+	        return false;
+	    }, results);
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,204 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* ray.cpp
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <cassert>
+#include <xmath.hpp>
+#include <xMath/includes/ray.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	namespace
+	{
+	    // Branch-free slab test along one axis; the segment is empty (t_enter > t_exit) on a miss
+	    inline void Slab(const float origin, const float inv_dir, const float min, const float max, float &t_enter, float &t_exit)
+	    {
+	        const float t0 = (min - origin) * inv_dir;
+	        const float t1 = (max - origin) * inv_dir;
+	        t_enter = std::max(t_enter, std::min(t0, t1));
+	        t_exit = std::min(t_exit, std::max(t0, t1));
+	    }
+	}
+
+	Ray::Ray() : Ray(Vec3(0.0f), Vec3(0.0f, 0.0f, -1.0f)) {}
+
+	Ray::Ray(const Vec3 &origin, const Vec3 &direction, const float max_distance) :
+	    origin(origin), direction(direction), inv_direction(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z), max_distance(max_distance)
+	{
+	}
+
+	Vec3 Ray::GetPoint(const float t) const
+	{
+	    return origin + direction * t;
+	}
+
+	Ray Ray::FromScreen(const Mat4 &inverse_view_projection, const Vec2 &screen_point, const Rectangle &viewport, const uint8_t depth_flags)
+	{
+	    assert(viewport.width > 0.0f && viewport.height > 0.0f);
+
+	    const float ndc_x = (screen_point.x - viewport.x) / viewport.width * 2.0f - 1.0f;
+	    const float ndc_y = 1.0f - (screen_point.y - viewport.y) / viewport.height * 2.0f;
+
+	    const bool reversed = (depth_flags & Frustum::DEPTH_REVERSED) != 0;
+	    const bool infinite = (depth_flags & Frustum::DEPTH_INFINITE_FAR) != 0;
+	    const float depth_low = (depth_flags & Frustum::DEPTH_NEGATIVE_ONE_TO_ONE) != 0 ? -1.0f : 0.0f;
+	    const float near_ndc = reversed ? 1.0f : depth_low;
+	    const float far_ndc = reversed ? depth_low : 1.0f;
+
+	    // The midpoint stays finite with an infinite far plane and gives the direction
+	    const Vec3 near_point = TransformPoint(inverse_view_projection, Vec3(ndc_x, ndc_y, near_ndc));
+	    const Vec3 mid_point = TransformPoint(inverse_view_projection, Vec3(ndc_x, ndc_y, (near_ndc + far_ndc) * 0.5f));
+	    const Vec3 direction = Normalize(mid_point - near_point);
+
+	    float max_distance = FLT_MAX;
+	    if (!infinite)
+	        max_distance = Distance(near_point, TransformPoint(inverse_view_projection, Vec3(ndc_x, ndc_y, far_ndc)));
+
+	    return {near_point, direction, max_distance};
+	}
+
+	RayPacket8::RayPacket8() : origin_x(), origin_y(), origin_z(), inv_dir_x(), inv_dir_y(), inv_dir_z(), max_distance(), active(0) {}
+
+	RayPacket8::RayPacket8(const Ray *rays, const size_t count) : RayPacket8()
+	{
+	    assert(count <= LANES);
+	    for (uint32_t lane = 0; lane < count; lane++)
+	        Set(lane, rays[lane]);
+	}
+
+	void RayPacket8::Set(const uint32_t lane, const Ray &ray)
+	{
+	    assert(lane < LANES);
+	    origin_x[lane] = ray.origin.x;
+	    origin_y[lane] = ray.origin.y;
+	    origin_z[lane] = ray.origin.z;
+	    inv_dir_x[lane] = ray.inv_direction.x;
+	    inv_dir_y[lane] = ray.inv_direction.y;
+	    inv_dir_z[lane] = ray.inv_direction.z;
+	    max_distance[lane] = ray.max_distance;
+	    active |= static_cast<uint8_t>(1u << lane);
+	}
+
+	Ray RayPacket8::Get(const uint32_t lane) const
+	{
+	    assert(lane < LANES);
+	    const Vec3 direction(1.0f / inv_dir_x[lane], 1.0f / inv_dir_y[lane], 1.0f / inv_dir_z[lane]);
+	    return {Vec3(origin_x[lane], origin_y[lane], origin_z[lane]), direction, max_distance[lane]};
+	}
+
+	uint8_t RayPacket8::IntersectBox(const float min_x, const float min_y, const float min_z, const float max_x, const float max_y, const float max_z, float *t_enter) const
+	{
+	    assert(t_enter != nullptr);
+
+	    uint8_t mask = 0;
+	    for (uint32_t lane = 0; lane < LANES; lane++)
+	    {
+	        float t_near = 0.0f, t_far = max_distance[lane];
+	        Slab(origin_x[lane], inv_dir_x[lane], min_x, max_x, t_near, t_far);
+	        Slab(origin_y[lane], inv_dir_y[lane], min_y, max_y, t_near, t_far);
+	        Slab(origin_z[lane], inv_dir_z[lane], min_z, max_z, t_near, t_far);
+	        t_enter[lane] = t_near;
+	        mask |= static_cast<uint8_t>((t_near <= t_far) << lane);
+	    }
+	    return mask & active;
+	}
+
+	bool IntersectRayBounds(const Ray &ray, const Vec3 &min, const Vec3 &max, float &distance)
+	{
+	    float t_near = 0.0f, t_far = ray.max_distance;
+	    Slab(ray.origin.x, ray.inv_direction.x, min.x, max.x, t_near, t_far);
+	    Slab(ray.origin.y, ray.inv_direction.y, min.y, max.y, t_near, t_far);
+	    Slab(ray.origin.z, ray.inv_direction.z, min.z, max.z, t_near, t_far);
+	    distance = t_near;
+	    return t_near <= t_far;
+	}
+
+	bool IntersectRayBox(const Ray &ray, const Vec3 &center, const Vec3 &extent, float &distance)
+	{
+	    return IntersectRayBounds(ray, center - extent, center + extent, distance);
+	}
+
+	size_t IntersectRayBoxes(const Ray &ray, const BoundingBoxSoA &boxes, float *distances)
+	{
+	    const size_t count = boxes.Size();
+	    assert(distances != nullptr || count == 0);
+
+	    const float ox = ray.origin.x, oy = ray.origin.y, oz = ray.origin.z;
+	    const float ix = ray.inv_direction.x, iy = ray.inv_direction.y, iz = ray.inv_direction.z;
+	    const float *cx = boxes.center_x.data(), *cy = boxes.center_y.data(), *cz = boxes.center_z.data();
+	    const float *ex = boxes.extent_x.data(), *ey = boxes.extent_y.data(), *ez = boxes.extent_z.data();
+
+	    size_t hits = 0;
+	    for (size_t i = 0; i < count; i++)
+	    {
+	        float t_near = 0.0f, t_far = ray.max_distance;
+	        Slab(ox, ix, cx[i] - ex[i], cx[i] + ex[i], t_near, t_far);
+	        Slab(oy, iy, cy[i] - ey[i], cy[i] + ey[i], t_near, t_far);
+	        Slab(oz, iz, cz[i] - ez[i], cz[i] + ez[i], t_near, t_far);
+
+	        const bool hit = t_near <= t_far;
+	        distances[i] = hit ? t_near : -1.0f;
+	        hits += hit;
+	    }
+	    return hits;
+	}
+
+	bool RaycastBoxes(const Ray &ray, const BoundingBoxSoA &boxes, uint32_t &index, float &distance)
+	{
+	    const size_t count = boxes.Size();
+	    const float ox = ray.origin.x, oy = ray.origin.y, oz = ray.origin.z;
+	    const float ix = ray.inv_direction.x, iy = ray.inv_direction.y, iz = ray.inv_direction.z;
+	    const float *cx = boxes.center_x.data(), *cy = boxes.center_y.data(), *cz = boxes.center_z.data();
+	    const float *ex = boxes.extent_x.data(), *ey = boxes.extent_y.data(), *ez = boxes.extent_z.data();
+
+	    // Shrinking the segment to the nearest hit rejects farther boxes early
+	    float nearest = ray.max_distance;
+	    bool found = false;
+	    for (size_t i = 0; i < count; i++)
+	    {
+	        float t_near = 0.0f, t_far = nearest;
+	        Slab(ox, ix, cx[i] - ex[i], cx[i] + ex[i], t_near, t_far);
+	        Slab(oy, iy, cy[i] - ey[i], cy[i] + ey[i], t_near, t_far);
+	        Slab(oz, iz, cz[i] - ez[i], cz[i] + ez[i], t_near, t_far);
+
+	        if (t_near <= t_far && (!found || t_near < nearest))
+	        {
+	            found = true;
+	            nearest = t_near;
+	            index = static_cast<uint32_t>(i);
+	        }
+	    }
+
+	    if (found)
+	        distance = nearest;
+	    return found;
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,154 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* shadow_cascades.cpp
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <xmath.hpp>
+#include <xMath/includes/projection.h>
+#include <xMath/includes/shadow_cascades.h>
+
+/// -------------------------------------------------------
+
+namespace xMath
+{
+	void ComputeCascadeSplits(const float z_near, const float z_far, const uint32_t cascade_count, const CascadeSplitScheme scheme, const float lambda, float *splits)
+	{
+	    assert(splits != nullptr && cascade_count > 0);
+	    assert(z_near > 0.0f && z_far > z_near);
+
+	    const float weight = scheme == CascadeSplitScheme::Uniform ? 0.0f : scheme == CascadeSplitScheme::Logarithmic ? 1.0f : std::clamp(lambda, 0.0f, 1.0f);
+	    const float ratio = z_far / z_near;
+
+	    splits[0] = z_near;
+	    for (uint32_t i = 1; i < cascade_count; i++)
+	    {
+	        const float t = static_cast<float>(i) / static_cast<float>(cascade_count);
+	        const float uniform = z_near + (z_far - z_near) * t;
+	        const float logarithmic = z_near * std::pow(ratio, t);
+	        splits[i] = weight * logarithmic + (1.0f - weight) * uniform;
+	    }
+	    splits[cascade_count] = z_far;
+	}
+
+	uint32_t BuildShadowCascades(const Mat4 &projection, const Mat4 &view, const Vec3 &light_direction, const CascadeSettings &settings, ShadowCascade *cascades)
+	{
+	    assert(cascades != nullptr && settings.resolution > 0);
+
+	    const uint32_t count = std::min(std::max(settings.cascade_count, 1u), MAX_SHADOW_CASCADES);
+	    const uint8_t flags = settings.depth_flags;
+	    const bool infinite = (flags & Frustum::DEPTH_INFINITE_FAR) != 0;
+	    assert(!infinite || settings.shadow_distance > 0.0f);
+
+	    // NDC depth of the near and far planes for this convention
+	    const float depth_low = (flags & Frustum::DEPTH_NEGATIVE_ONE_TO_ONE) ? -1.0f : 0.0f;
+	    const float near_ndc = (flags & Frustum::DEPTH_REVERSED) ? 1.0f : depth_low;
+	    float far_ndc = (flags & Frustum::DEPTH_REVERSED) ? depth_low : 1.0f;
+
+	    // Far plane at infinity cannot be unprojected; any finite depth gives the same corner rays
+	    if (infinite)
+	        far_ndc = (near_ndc + far_ndc) * 0.5f;
+
+	    const Mat4 inv_view_projection = (projection * view).GetInverse();
+	    const Vec3 eye = TransformPoint(view.GetInverse(), Vec3(0.0f, 0.0f, 0.0f));
+
+	    constexpr float ndc_x[4] = { -1.0f, 1.0f, 1.0f, -1.0f };
+	    constexpr float ndc_y[4] = { -1.0f, -1.0f, 1.0f, 1.0f };
+
+	    Vec3 near_corners[4], far_corners[4];
+	    Vec3 near_center(0.0f), far_center(0.0f);
+	    for (uint32_t i = 0; i < 4; i++)
+	    {
+	        near_corners[i] = TransformPoint(inv_view_projection, Vec3(ndc_x[i], ndc_y[i], near_ndc));
+	        far_corners[i] = TransformPoint(inv_view_projection, Vec3(ndc_x[i], ndc_y[i], far_ndc));
+	        near_center += near_corners[i] * 0.25f;
+	        far_center += far_corners[i] * 0.25f;
+	    }
+
+	    // View depth is linear along each corner edge, so a slice is a lerp between the two corner sets
+	    const Vec3 forward = Normalize(far_center - near_center);
+	    const float z_near = Dot(near_center - eye, forward);
+	    const float edge_far = Dot(far_center - eye, forward);
+	    float z_far = infinite ? settings.shadow_distance : edge_far;
+	    if (!infinite && settings.shadow_distance > 0.0f)
+	        z_far = std::min(z_far, settings.shadow_distance);
+
+	    float splits[MAX_SHADOW_CASCADES + 1];
+	    ComputeCascadeSplits(z_near, z_far, count, settings.scheme, settings.lambda, splits);
+
+	    // Rotation-only light view; the cascade position lives in the ortho bounds so it can be snapped
+	    const Vec3 light_dir = Normalize(light_direction);
+	    const Vec3 up = std::fabs(light_dir.y) > 0.99f ? Vec3(0.0f, 0.0f, 1.0f) : Vec3(0.0f, 1.0f, 0.0f);
+	    const Mat4 light_view = LookAt(Vec3(0.0f, 0.0f, 0.0f), light_dir, up);
+
+	    for (uint32_t c = 0; c < count; c++)
+	    {
+	        ShadowCascade &cascade = cascades[c];
+	        cascade.split_near = splits[c];
+	        cascade.split_far = splits[c + 1];
+
+	        const float t_near = (splits[c] - z_near) / (edge_far - z_near);
+	        const float t_far = (splits[c + 1] - z_near) / (edge_far - z_near);
+
+	        Vec3 center(0.0f);
+	        for (uint32_t i = 0; i < 4; i++)
+	        {
+	            const Vec3 edge = far_corners[i] - near_corners[i];
+	            cascade.corners[i] = near_corners[i] + edge * t_near;
+	            cascade.corners[i + 4] = near_corners[i] + edge * t_far;
+	            center += (cascade.corners[i] + cascade.corners[i + 4]) * 0.125f;
+	        }
+
+	        float radius = 0.0f;
+	        for (const Vec3 &corner : cascade.corners)
+	            radius = std::max(radius, Distance(corner, center));
+
+	        // Quantize the radius so float noise does not change the projection size between frames
+	        radius = std::ceil(radius * 16.0f) / 16.0f;
+	        cascade.bounds = Sphere(center, radius);
+
+	        // Snap the light-space center to whole texels
+	        const Vec3 light_center = TransformPoint(light_view, center);
+	        const float texel = (2.0f * radius) / static_cast<float>(settings.resolution);
+	        const float snapped_x = std::floor(light_center.x / texel) * texel;
+	        const float snapped_y = std::floor(light_center.y / texel) * texel;
+
+	        // The light view looks down -Z, so depth along the light is -z
+	        const float depth_near = -light_center.z - radius - settings.caster_padding;
+	        const float depth_far = -light_center.z + radius;
+
+	        cascade.light_view = light_view;
+	        cascade.light_projection = Ortho(snapped_x - radius, snapped_x + radius, snapped_y - radius, snapped_y + radius, depth_near, depth_far);
+	        cascade.light_view_projection = cascade.light_projection * light_view;
+	        cascade.frustum = Frustum(cascade.light_view_projection, Frustum::DEPTH_NEGATIVE_ONE_TO_ONE);
+	    }
+
+	    return count;
+	}
+
+}
+
+/// -------------------------------------------------------
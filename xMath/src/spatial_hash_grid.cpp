@@ -0,0 +1,322 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* spatial_hash_grid.cpp
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+#include <vector>
+#include <xmath.hpp>
+#include <xMath/includes/spatial_hash_grid.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	namespace
+	{
+	    constexpr int32_t CELL_LIMIT = 1 << 30;
+
+	    uint32_t NextPowerOfTwo(uint32_t value)
+	    {
+	        uint32_t result = 1;
+	        while (result < value)
+	            result <<= 1;
+	        return result;
+	    }
+	}
+
+	SpatialHashGrid::SpatialHashGrid(const float cell_size) : m_CellSize(cell_size), m_InverseCellSize(1.0f / cell_size)
+	{
+	    assert(cell_size > 0.0f);
+	}
+
+	int32_t SpatialHashGrid::CellCoord(const float value) const
+	{
+	    const float cell = std::floor(value * m_InverseCellSize);
+	    return static_cast<int32_t>(std::clamp(cell, static_cast<float>(-CELL_LIMIT), static_cast<float>(CELL_LIMIT)));
+	}
+
+	uint32_t SpatialHashGrid::Hash(const int32_t x, const int32_t y, const int32_t z) const
+	{
+	    // Teschner et al., "Optimized Spatial Hashing for Collision Detection of Deformable Objects"
+	    return ((static_cast<uint32_t>(x) * 73856093u) ^ (static_cast<uint32_t>(y) * 19349663u) ^ (static_cast<uint32_t>(z) * 83492791u)) & m_TableMask;
+	}
+
+	void SpatialHashGrid::Build(const Vec3 *points, const size_t count, const uint32_t table_size)
+	{
+	    assert(points != nullptr || count == 0);
+
+	    const uint32_t buckets = NextPowerOfTwo(table_size > 0 ? table_size : std::max(static_cast<uint32_t>(count * 2), 1u));
+	    m_TableMask = buckets - 1;
+	    m_CellStart.assign(buckets, 0);
+	    m_CellCount.assign(buckets, 0);
+
+	    for (int a = 0; a < 3; a++)
+	    {
+	        m_MinCell[a] = CELL_LIMIT;
+	        m_MaxCell[a] = -CELL_LIMIT;
+	    }
+
+	    // Counting sort by bucket: count, prefix sum, scatter
+	    std::vector<uint32_t> hashes(count);
+	    for (size_t i = 0; i < count; i++)
+	    {
+	        const int32_t cell[3] = { CellCoord(points[i].x), CellCoord(points[i].y), CellCoord(points[i].z) };
+	        for (int a = 0; a < 3; a++)
+	        {
+	            m_MinCell[a] = std::min(m_MinCell[a], cell[a]);
+	            m_MaxCell[a] = std::max(m_MaxCell[a], cell[a]);
+	        }
+
+	        hashes[i] = Hash(cell[0], cell[1], cell[2]);
+	        m_CellCount[hashes[i]]++;
+	    }
+
+	    uint32_t offset = 0;
+	    for (uint32_t b = 0; b < buckets; b++)
+	    {
+	        m_CellStart[b] = offset;
+	        offset += m_CellCount[b];
+	        m_CellCount[b] = 0;
+	    }
+
+	    m_Indices.resize(count);
+	    m_X.resize(count);
+	    m_Y.resize(count);
+	    m_Z.resize(count);
+	    for (size_t i = 0; i < count; i++)
+	    {
+	        const uint32_t position = m_CellStart[hashes[i]] + m_CellCount[hashes[i]]++;
+	        m_Indices[position] = static_cast<uint32_t>(i);
+	        m_X[position] = points[i].x;
+	        m_Y[position] = points[i].y;
+	        m_Z[position] = points[i].z;
+	    }
+	}
+
+	void SpatialHashGrid::Clear()
+	{
+	    std::fill(m_CellStart.begin(), m_CellStart.end(), 0u);
+	    std::fill(m_CellCount.begin(), m_CellCount.end(), 0u);
+	    m_Indices.clear();
+	    m_X.clear();
+	    m_Y.clear();
+	    m_Z.clear();
+	    for (int a = 0; a < 3; a++)
+	    {
+	        m_MinCell[a] = 0;
+	        m_MaxCell[a] = -1;
+	    }
+	}
+
+	void SpatialHashGrid::QueryRadius(const Vec3 &center, const float radius, std::vector<uint32_t> &results) const
+	{
+	    if (m_Indices.empty())
+	        return;
+
+	    const float radius_squared = radius * radius;
+	    const int32_t lo[3] = { std::max(CellCoord(center.x - radius), m_MinCell[0]), std::max(CellCoord(center.y - radius), m_MinCell[1]), std::max(CellCoord(center.z - radius), m_MinCell[2]) };
+	    const int32_t hi[3] = { std::min(CellCoord(center.x + radius), m_MaxCell[0]), std::min(CellCoord(center.y + radius), m_MaxCell[1]), std::min(CellCoord(center.z + radius), m_MaxCell[2]) };
+	    if (lo[0] > hi[0] || lo[1] > hi[1] || lo[2] > hi[2])
+	        return;
+
+	    // A radius spanning more cells than there are points is cheaper as a linear scan. Cells are
+	    // clamped to +-(1 << 30), so a span can exceed int32 and is computed in 64 bits; stopping once
+	    // the count passes the point count keeps the product from overflowing
+	    uint64_t cells = 1;
+	    for (int a = 0; a < 3 && cells <= m_Indices.size(); a++)
+	        cells *= static_cast<uint64_t>(static_cast<int64_t>(hi[a]) - static_cast<int64_t>(lo[a]) + 1);
+	    if (cells > m_Indices.size())
+	    {
+	        for (size_t i = 0; i < m_Indices.size(); i++)
+	        {
+	            const float dx = m_X[i] - center.x, dy = m_Y[i] - center.y, dz = m_Z[i] - center.z;
+	            if (dx * dx + dy * dy + dz * dz <= radius_squared)
+	                results.push_back(m_Indices[i]);
+	        }
+	        return;
+	    }
+
+	    for (int32_t z = lo[2]; z <= hi[2]; z++)
+	        for (int32_t y = lo[1]; y <= hi[1]; y++)
+	            for (int32_t x = lo[0]; x <= hi[0]; x++)
+	            {
+	                const uint32_t bucket = Hash(x, y, z);
+	                const uint32_t end = m_CellStart[bucket] + m_CellCount[bucket];
+	                for (uint32_t i = m_CellStart[bucket]; i < end; i++)
+	                {
+	                    const float dx = m_X[i] - center.x, dy = m_Y[i] - center.y, dz = m_Z[i] - center.z;
+	                    if (dx * dx + dy * dy + dz * dz > radius_squared)
+	                        continue;
+
+	                    // Buckets are shared by colliding cells; count a point only from its own cell
+	                    if (CellCoord(m_X[i]) == x && CellCoord(m_Y[i]) == y && CellCoord(m_Z[i]) == z)
+	                        results.push_back(m_Indices[i]);
+	                }
+	            }
+	}
+
+	size_t SpatialHashGrid::QueryRadiusBatch(const Vec3 *centers, const size_t count, const float radius, std::vector<uint32_t> &neighbors, std::vector<uint32_t> &offsets) const
+	{
+	    assert(centers != nullptr || count == 0);
+
+	    neighbors.clear();
+	    offsets.resize(count + 1);
+	    for (size_t i = 0; i < count; i++)
+	    {
+	        offsets[i] = static_cast<uint32_t>(neighbors.size());
+	        QueryRadius(centers[i], radius, neighbors);
+	    }
+	    offsets[count] = static_cast<uint32_t>(neighbors.size());
+	    return neighbors.size();
+	}
+
+	uint32_t SpatialHashGrid::QueryKNearest(const Vec3 &point, uint32_t k, uint32_t *indices, float *distances) const
+	{
+	    k = static_cast<uint32_t>(std::min<size_t>(k, m_Indices.size()));
+	    if (k == 0)
+	        return 0;
+
+	    assert(indices != nullptr && distances != nullptr);
+
+	    // distances holds squared distances, sorted ascending, until the end
+	    uint32_t found = 0;
+
+	    // Sparse points can leave many empty cells between the query and its neighbors. As in
+	    // QueryRadius, once more cells have been visited than there are points a linear scan is cheaper.
+	    const uint64_t cell_limit = m_Indices.size();
+	    uint64_t cells_visited = 0;
+
+	    const auto visit_cell = [&](const int32_t x, const int32_t y, const int32_t z)
+	    {
+	        cells_visited++;
+	        const uint32_t bucket = Hash(x, y, z);
+	        const uint32_t end = m_CellStart[bucket] + m_CellCount[bucket];
+	        for (uint32_t i = m_CellStart[bucket]; i < end; i++)
+	        {
+	            const float dx = m_X[i] - point.x, dy = m_Y[i] - point.y, dz = m_Z[i] - point.z;
+	            const float distance_squared = dx * dx + dy * dy + dz * dz;
+	            if (found == k && distance_squared >= distances[k - 1])
+	                continue;
+	            if (CellCoord(m_X[i]) != x || CellCoord(m_Y[i]) != y || CellCoord(m_Z[i]) != z)
+	                continue;
+
+	            uint32_t slot = found < k ? found++ : k - 1;
+	            for (; slot > 0 && distances[slot - 1] > distance_squared; slot--)
+	            {
+	                distances[slot] = distances[slot - 1];
+	                indices[slot] = indices[slot - 1];
+	            }
+	            distances[slot] = distance_squared;
+	            indices[slot] = m_Indices[i];
+	        }
+	    };
+
+	    // Start from the occupied cell nearest to the query. Cells of a point outside the occupied range
+	    // are only farther from it, so the ring bound below stays a lower bound. Cells reach
+	    // +-CELL_LIMIT, so ring arithmetic is done in 64 bits.
+	    const int64_t cell[3] = {
+	        std::clamp(CellCoord(point.x), m_MinCell[0], m_MaxCell[0]),
+	        std::clamp(CellCoord(point.y), m_MinCell[1], m_MaxCell[1]),
+	        std::clamp(CellCoord(point.z), m_MinCell[2], m_MaxCell[2])
+	    };
+	    int64_t max_ring = 0;
+	    for (int a = 0; a < 3; a++)
+	        max_ring = std::max({ max_ring, cell[a] - m_MinCell[a], m_MaxCell[a] - cell[a] });
+
+	    for (int64_t ring = 0; ring <= max_ring && cells_visited <= cell_limit; ring++)
+	    {
+	        // Cells in this ring are at least ring - 1 whole cells away
+	        if (found == k && ring > 0)
+	        {
+	            const float bound = static_cast<float>(ring - 1) * m_CellSize;
+	            if (bound * bound >= distances[k - 1])
+	                break;
+	        }
+
+	        // Visit only the shell of the cube of radius ring, clipped to the occupied cells
+	        const int32_t z0 = static_cast<int32_t>(std::max<int64_t>(cell[2] - ring, m_MinCell[2])), z1 = static_cast<int32_t>(std::min<int64_t>(cell[2] + ring, m_MaxCell[2]));
+	        const int32_t y0 = static_cast<int32_t>(std::max<int64_t>(cell[1] - ring, m_MinCell[1])), y1 = static_cast<int32_t>(std::min<int64_t>(cell[1] + ring, m_MaxCell[1]));
+	        const int32_t x0 = static_cast<int32_t>(std::max<int64_t>(cell[0] - ring, m_MinCell[0])), x1 = static_cast<int32_t>(std::min<int64_t>(cell[0] + ring, m_MaxCell[0]));
+	        for (int32_t z = z0; z <= z1 && cells_visited <= cell_limit; z++)
+	        {
+	            for (int32_t y = y0; y <= y1 && cells_visited <= cell_limit; y++)
+	            {
+	                if (std::abs(z - cell[2]) == ring || std::abs(y - cell[1]) == ring)
+	                {
+	                    for (int32_t x = x0; x <= x1 && cells_visited <= cell_limit; x++)
+	                        visit_cell(x, y, z);
+	                }
+	                else
+	                {
+	                    if (cell[0] - ring >= x0 && cell[0] - ring <= x1)
+	                        visit_cell(static_cast<int32_t>(cell[0] - ring), y, z);
+	                    if (ring > 0 && cell[0] + ring >= x0 && cell[0] + ring <= x1)
+	                        visit_cell(static_cast<int32_t>(cell[0] + ring), y, z);
+	                }
+	            }
+	        }
+	    }
+
+	    if (cells_visited > cell_limit)
+	    {
+	        std::vector<std::pair<float, uint32_t>> candidates(m_Indices.size());
+	        for (size_t i = 0; i < m_Indices.size(); i++)
+	        {
+	            const float dx = m_X[i] - point.x, dy = m_Y[i] - point.y, dz = m_Z[i] - point.z;
+	            candidates[i] = { dx * dx + dy * dy + dz * dz, m_Indices[i] };
+	        }
+
+	        std::partial_sort(candidates.begin(), candidates.begin() + k, candidates.end());
+	        for (uint32_t i = 0; i < k; i++)
+	        {
+	            distances[i] = candidates[i].first;
+	            indices[i] = candidates[i].second;
+	        }
+	        found = k;
+	    }
+
+	    for (uint32_t i = 0; i < found; i++)
+	        distances[i] = std::sqrt(distances[i]);
+	    return found;
+	}
+
+	void SpatialHashGrid::QueryKNearestBatch(const Vec3 *points, const size_t count, const uint32_t k, uint32_t *indices, float *distances, uint32_t *found) const
+	{
+	    assert(points != nullptr || count == 0);
+
+	    for (size_t i = 0; i < count; i++)
+	    {
+	        const uint32_t result = QueryKNearest(points[i], k, indices + i * k, distances + i * k);
+	        if (found != nullptr)
+	            found[i] = result;
+	    }
+	}
+
+}
+
+/// -------------------------------------------------------
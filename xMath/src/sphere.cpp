@@ -24,18 +24,348 @@
 * Created: 7/9/2025
 * -------------------------------------------------------
 */
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include <xMath/includes/mat4.h>
+#include <xMath/includes/math_utils.h>
 #include <xMath/includes/sphere.h>
 
 /// -------------------------------------------------------
 
 namespace xMath
 {
+    namespace
+    {
+        // Relative slack for containment tests, so points on the surface are not re-added forever
+        constexpr float CONTAIN_EPSILON = 1e-5f;
+
+        bool Encloses(const Sphere& sphere, const Vec3& point)
+        {
+            const float limit = sphere.radius * (1.0f + CONTAIN_EPSILON) + CONTAIN_EPSILON;
+            return Length2(point - sphere.center) <= limit * limit;
+        }
+
+        Sphere SphereFrom2(const Vec3& a, const Vec3& b)
+        {
+            return {(a + b) * 0.5f, std::sqrt(Length2(b - a)) * 0.5f};
+        }
+
+        // Circumsphere of a triangle (center in its plane); the widest pair when the points are collinear
+        Sphere SphereFrom3(const Vec3& a, const Vec3& b, const Vec3& c)
+        {
+            const Vec3 ab = b - a, ac = c - a;
+            const Vec3 normal = Cross(ab, ac);
+            const float denominator = 2.0f * Length2(normal);
+            if (denominator <= 1e-12f * Length2(ab) * Length2(ac))
+            {
+                const Sphere candidates[3] = {SphereFrom2(a, b), SphereFrom2(a, c), SphereFrom2(b, c)};
+                return *std::max_element(candidates, candidates + 3, [](const Sphere& x, const Sphere& y) { return x.radius < y.radius; });
+            }
+
+            const Vec3 offset = (Cross(normal, ab) * Length2(ac) + Cross(ac, normal) * Length2(ab)) * (1.0f / denominator);
+            return {a + offset, std::sqrt(Length2(offset))};
+        }
+
+        // Circumsphere of a tetrahedron; the smallest enclosing sphere of a subset when the points are coplanar
+        Sphere SphereFrom4(const Vec3& a, const Vec3& b, const Vec3& c, const Vec3& d)
+        {
+            const Vec3 u = b - a, v = c - a, w = d - a;
+            const float determinant = 2.0f * Dot(u, Cross(v, w));
+            const float scale = Length2(u) + Length2(v) + Length2(w);
+            if (std::abs(determinant) > 1e-6f * scale * std::sqrt(scale))
+            {
+                const Vec3 offset = (Cross(v, w) * Length2(u) + Cross(w, u) * Length2(v) + Cross(u, v) * Length2(w)) * (1.0f / determinant);
+                return {a + offset, std::sqrt(Length2(offset))};
+            }
+
+            const Vec3 points[4] = {a, b, c, d};
+            const Sphere candidates[10] = {
+                SphereFrom3(a, b, c), SphereFrom3(a, b, d), SphereFrom3(a, c, d), SphereFrom3(b, c, d),
+                SphereFrom2(a, b), SphereFrom2(a, c), SphereFrom2(a, d), SphereFrom2(b, c), SphereFrom2(b, d), SphereFrom2(c, d)
+            };
+
+            Sphere best(a, INFINITY);
+            for (const Sphere& candidate : candidates)
+            {
+                if (candidate.radius < best.radius && std::all_of(points, points + 4, [&](const Vec3& p) { return Encloses(candidate, p); }))
+                    best = candidate;
+            }
+            return best;
+        }
+
+        // Iterative Welzl over shuffled points: each level fixes one more boundary point and rescans the points before it
+        Sphere Welzl(const Vec3* points, const size_t count)
+        {
+            Sphere sphere(points[0], 0.0f);
+            for (size_t i = 1; i < count; i++)
+            {
+                if (Encloses(sphere, points[i]))
+                    continue;
+
+                sphere = Sphere(points[i], 0.0f);
+                for (size_t j = 0; j < i; j++)
+                {
+                    if (Encloses(sphere, points[j]))
+                        continue;
+
+                    sphere = SphereFrom2(points[i], points[j]);
+                    for (size_t k = 0; k < j; k++)
+                    {
+                        if (Encloses(sphere, points[k]))
+                            continue;
+
+                        sphere = SphereFrom3(points[i], points[j], points[k]);
+                        for (size_t l = 0; l < k; l++)
+                        {
+                            if (!Encloses(sphere, points[l]))
+                                sphere = SphereFrom4(points[i], points[j], points[k], points[l]);
+                        }
+                    }
+                }
+            }
+            return sphere;
+        }
+
+        // Ritter's growing pass: every outside point moves the near side of the sphere out to it
+        void GrowToInclude(Sphere& sphere, const Vec3* points, const size_t count)
+        {
+            for (size_t i = 0; i < count; i++)
+                sphere.Merge(points[i]);
+        }
+    }
+
+    Sphere::Sphere() : center(0.0f), radius(0.0f)
+    {
+    }
+
     Sphere::Sphere(const Vec3& center, const float radius)
     {
         this->center = center;
         this->radius = radius;
     }
 
+    Sphere Sphere::FromPointsRitter(const Vec3* points, const size_t count)
+    {
+        if (count == 0)
+            return {};
+
+        assert(points != nullptr);
+
+        // The most distant pair among the extreme points along x, y and z
+        size_t min_index[3] = {0, 0, 0}, max_index[3] = {0, 0, 0};
+        for (size_t i = 1; i < count; i++)
+        {
+            for (int a = 0; a < 3; a++)
+            {
+                if (points[i][a] < points[min_index[a]][a])
+                    min_index[a] = i;
+                if (points[i][a] > points[max_index[a]][a])
+                    max_index[a] = i;
+            }
+        }
+
+        int axis = 0;
+        for (int a = 1; a < 3; a++)
+        {
+            if (Length2(points[max_index[a]] - points[min_index[a]]) > Length2(points[max_index[axis]] - points[min_index[axis]]))
+                axis = a;
+        }
+
+        Sphere sphere = SphereFrom2(points[min_index[axis]], points[max_index[axis]]);
+        GrowToInclude(sphere, points, count);
+        return sphere;
+    }
+
+    Sphere Sphere::FromPointsEPOS(const Vec3* points, const size_t count)
+    {
+        constexpr size_t DIRECTION_COUNT = 13;
+        if (count <= DIRECTION_COUNT * 2)
+            return FromPointsExact(points, count);
+
+        static const Vec3 directions[DIRECTION_COUNT] = {
+            Vec3(1.0f, 0.0f, 0.0f), Vec3(0.0f, 1.0f, 0.0f), Vec3(0.0f, 0.0f, 1.0f),
+            Vec3(1.0f, 1.0f, 1.0f), Vec3(1.0f, 1.0f, -1.0f), Vec3(1.0f, -1.0f, 1.0f), Vec3(1.0f, -1.0f, -1.0f),
+            Vec3(1.0f, 1.0f, 0.0f), Vec3(1.0f, -1.0f, 0.0f), Vec3(1.0f, 0.0f, 1.0f), Vec3(1.0f, 0.0f, -1.0f),
+            Vec3(0.0f, 1.0f, 1.0f), Vec3(0.0f, 1.0f, -1.0f)
+        };
+
+        // Extreme points along each direction; the directions need not be normalized to compare projections
+        size_t min_index[DIRECTION_COUNT] = {}, max_index[DIRECTION_COUNT] = {};
+        float min_projection[DIRECTION_COUNT], max_projection[DIRECTION_COUNT];
+        for (size_t d = 0; d < DIRECTION_COUNT; d++)
+            min_projection[d] = max_projection[d] = Dot(points[0], directions[d]);
+
+        for (size_t i = 1; i < count; i++)
+        {
+            for (size_t d = 0; d < DIRECTION_COUNT; d++)
+            {
+                const float projection = Dot(points[i], directions[d]);
+                if (projection < min_projection[d])
+                {
+                    min_projection[d] = projection;
+                    min_index[d] = i;
+                }
+                if (projection > max_projection[d])
+                {
+                    max_projection[d] = projection;
+                    max_index[d] = i;
+                }
+            }
+        }
+
+        Vec3 extremes[DIRECTION_COUNT * 2];
+        for (size_t d = 0; d < DIRECTION_COUNT; d++)
+        {
+            extremes[d * 2] = points[min_index[d]];
+            extremes[d * 2 + 1] = points[max_index[d]];
+        }
+
+        Sphere sphere = FromPointsExact(extremes, DIRECTION_COUNT * 2);
+        GrowToInclude(sphere, points, count);
+        return sphere;
+    }
+
+    Sphere Sphere::FromPointsExact(const Vec3* points, const size_t count)
+    {
+        if (count == 0)
+            return {};
+
+        assert(points != nullptr);
+
+        // Welzl runs in expected linear time only for a random order; a fixed seed keeps results reproducible
+        std::vector<Vec3> shuffled(points, points + count);
+        uint32_t state = 0x9E3779B9u;
+        for (size_t i = count - 1; i > 0; i--)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            std::swap(shuffled[i], shuffled[state % (i + 1)]);
+        }
+
+        Sphere sphere = Welzl(shuffled.data(), count);
+
+        // Cover float rounding in the circumsphere solutions
+        float radius_squared = sphere.radius * sphere.radius;
+        for (const Vec3& point : shuffled)
+            radius_squared = std::max(radius_squared, Length2(point - sphere.center));
+        sphere.radius = std::sqrt(radius_squared);
+        return sphere;
+    }
+
+    Sphere Sphere::operator*(const Mat4& transform) const
+    {
+        const Vec3 center_new(transform * center);
+
+        // The columns are the transformed axes; without shear the longest one is the largest stretch in any direction
+        const float scale_squared = std::max({
+            transform.m00 * transform.m00 + transform.m10 * transform.m10 + transform.m20 * transform.m20,
+            transform.m01 * transform.m01 + transform.m11 * transform.m11 + transform.m21 * transform.m21,
+            transform.m02 * transform.m02 + transform.m12 * transform.m12 + transform.m22 * transform.m22});
+
+        return {center_new, radius * std::sqrt(scale_squared)};
+    }
+
+    void Sphere::Merge(const Sphere& sphere)
+    {
+        const Vec3 offset = sphere.center - center;
+        const float distance = std::sqrt(Length2(offset));
+        if (distance + sphere.radius <= radius)
+            return;
+
+        if (distance + radius <= sphere.radius)
+        {
+            *this = sphere;
+            return;
+        }
+
+        const float new_radius = (distance + radius + sphere.radius) * 0.5f;
+        center = center + offset * ((new_radius - radius) / distance);
+        radius = new_radius;
+    }
+
+    void Sphere::Merge(const Vec3& point)
+    {
+        const Vec3 offset = point - center;
+        const float distance_squared = Length2(offset);
+        if (distance_squared <= radius * radius)
+            return;
+
+        const float distance = std::sqrt(distance_squared);
+        const float new_radius = (distance + radius) * 0.5f;
+        center = center + offset * ((new_radius - radius) / distance);
+        radius = new_radius;
+    }
+
+    bool Sphere::Contains(const Vec3& point) const
+    {
+        return Length2(point - center) <= radius * radius;
+    }
+
+    bool Sphere::Intersects(const Sphere& sphere) const
+    {
+        const float radius_sum = radius + sphere.radius;
+        return Length2(sphere.center - center) <= radius_sum * radius_sum;
+    }
+
+    bool Sphere::Intersects(const BoundingBox& box) const
+    {
+        return Length2(box.GetClosestPoint(center) - center) <= radius * radius;
+    }
+
+    size_t IntersectSpheres(const Sphere& sphere, const Sphere* spheres, const size_t count, uint8_t* results)
+    {
+        assert((spheres != nullptr && results != nullptr) || count == 0);
+
+        size_t hits = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            const float dx = spheres[i].center.x - sphere.center.x;
+            const float dy = spheres[i].center.y - sphere.center.y;
+            const float dz = spheres[i].center.z - sphere.center.z;
+            const float radius_sum = spheres[i].radius + sphere.radius;
+            const uint8_t hit = dx * dx + dy * dy + dz * dz <= radius_sum * radius_sum ? 1 : 0;
+            results[i] = hit;
+            hits += hit;
+        }
+        return hits;
+    }
+
+    size_t IntersectSphereBoxes(const Sphere& sphere, const BoundingBoxSoA& boxes, uint8_t* results)
+    {
+        const size_t count = boxes.Size();
+        assert(results != nullptr || count == 0);
+
+        const float* center_x = boxes.center_x.data();
+        const float* center_y = boxes.center_y.data();
+        const float* center_z = boxes.center_z.data();
+        const float* extent_x = boxes.extent_x.data();
+        const float* extent_y = boxes.extent_y.data();
+        const float* extent_z = boxes.extent_z.data();
+        const float sx = sphere.center.x, sy = sphere.center.y, sz = sphere.center.z;
+        const float radius_squared = sphere.radius * sphere.radius;
+
+        // Distance from the sphere center to each box along each axis, zero inside the slab. The
+        // clamp is written as (d + |d|) / 2, which is exact, instead of max(d, 0): GCC otherwise
+        // threads the zero case into a branch and gives up on vectorizing the loop.
+        size_t hits = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            const float ox = std::abs(sx - center_x[i]) - extent_x[i];
+            const float oy = std::abs(sy - center_y[i]) - extent_y[i];
+            const float oz = std::abs(sz - center_z[i]) - extent_z[i];
+            const float dx = (ox + std::abs(ox)) * 0.5f;
+            const float dy = (oy + std::abs(oy)) * 0.5f;
+            const float dz = (oz + std::abs(oz)) * 0.5f;
+            const bool hit = dx * dx + dy * dy + dz * dz <= radius_squared;
+            results[i] = hit;
+            hits += hit;
+        }
+        return hits;
+    }
+
 }
 
 /// -------------------------------------------------------
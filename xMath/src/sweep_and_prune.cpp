@@ -0,0 +1,314 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* sweep_and_prune.cpp
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <iterator>
+#include <xmath.hpp>
+#include <xMath/includes/sweep_and_prune.h>
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	namespace
+	{
+	    uint64_t PairKey(const uint32_t a, const uint32_t b)
+	    {
+	        return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+	    }
+
+	    OverlapPair PairFromKey(const uint64_t key)
+	    {
+	        return { static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key & 0xFFFFFFFFu) };
+	    }
+
+	    uint64_t KeyFromPair(const OverlapPair &pair)
+	    {
+	        return (static_cast<uint64_t>(pair.a) << 32) | pair.b;
+	    }
+	}
+
+	SweepAndPrune::SweepAndPrune(const uint32_t sweep_axis) :
+	    m_SweepAxis(sweep_axis), m_FirstAxis(sweep_axis == ALL_AXES ? 0 : sweep_axis), m_AxisCount(sweep_axis == ALL_AXES ? 3 : 1)
+	{
+	    assert(sweep_axis <= ALL_AXES);
+	}
+
+	void SweepAndPrune::Add(const uint32_t id, const BoundingBox &box)
+	{
+	    assert(!Contains(id));
+	    if (id >= m_Proxies.size())
+	        m_Proxies.resize(static_cast<size_t>(id) + 1);
+
+	    Proxy &proxy = m_Proxies[id];
+	    proxy.state = ProxyState::Active;
+	    m_ObjectCount++;
+
+	    // New endpoints start at the end; UpdatePairs sorts them into place
+	    for (uint32_t axis = m_FirstAxis; axis < m_FirstAxis + m_AxisCount; axis++)
+	    {
+	        std::vector<Endpoint> &endpoints = m_Endpoints[axis];
+	        proxy.endpoint[axis][0] = static_cast<uint32_t>(endpoints.size());
+	        endpoints.push_back({ 0.0f, id << 1 });
+	        proxy.endpoint[axis][1] = static_cast<uint32_t>(endpoints.size());
+	        endpoints.push_back({ 0.0f, (id << 1) | 1 });
+	    }
+	    Update(id, box);
+	}
+
+	void SweepAndPrune::Update(const uint32_t id, const BoundingBox &box)
+	{
+	    assert(Contains(id) && m_Proxies[id].state == ProxyState::Active);
+
+	    const Vec3 min = box.GetMin();
+	    const Vec3 max = box.GetMax();
+	    assert(std::isfinite(min.x) && std::isfinite(min.y) && std::isfinite(min.z));
+	    assert(std::isfinite(max.x) && std::isfinite(max.y) && std::isfinite(max.z));
+
+	    Proxy &proxy = m_Proxies[id];
+	    proxy.min[0] = min.x; proxy.min[1] = min.y; proxy.min[2] = min.z;
+	    proxy.max[0] = max.x; proxy.max[1] = max.y; proxy.max[2] = max.z;
+	    for (uint32_t axis = m_FirstAxis; axis < m_FirstAxis + m_AxisCount; axis++)
+	    {
+	        m_Endpoints[axis][proxy.endpoint[axis][0]].value = proxy.min[axis];
+	        m_Endpoints[axis][proxy.endpoint[axis][1]].value = proxy.max[axis];
+	    }
+	}
+
+	void SweepAndPrune::Remove(const uint32_t id)
+	{
+	    assert(Contains(id) && m_Proxies[id].state == ProxyState::Active);
+
+	    // Moving the object past every other endpoint lets the sort report its pairs as removed
+	    Proxy &proxy = m_Proxies[id];
+	    proxy.state = ProxyState::Removing;
+	    for (uint32_t a = 0; a < 3; a++)
+	        proxy.min[a] = proxy.max[a] = FLT_MAX;
+	    for (uint32_t axis = m_FirstAxis; axis < m_FirstAxis + m_AxisCount; axis++)
+	    {
+	        m_Endpoints[axis][proxy.endpoint[axis][0]].value = FLT_MAX;
+	        m_Endpoints[axis][proxy.endpoint[axis][1]].value = FLT_MAX;
+	    }
+
+	    m_PendingRemovals.push_back(id);
+	    m_ObjectCount--;
+	}
+
+	void SweepAndPrune::Clear()
+	{
+	    m_ObjectCount = 0;
+	    m_Proxies.clear();
+	    for (std::vector<Endpoint> &endpoints : m_Endpoints)
+	        endpoints.clear();
+	    m_PendingRemovals.clear();
+	    m_PairSet.clear();
+	    m_PairList.clear();
+	    m_Added.clear();
+	    m_Removed.clear();
+	}
+
+	bool SweepAndPrune::Overlaps(const uint32_t a, const uint32_t b) const
+	{
+	    const Proxy &pa = m_Proxies[a];
+	    const Proxy &pb = m_Proxies[b];
+	    return pa.state == ProxyState::Active && pb.state == ProxyState::Active &&
+	           pa.min[0] <= pb.max[0] && pb.min[0] <= pa.max[0] &&
+	           pa.min[1] <= pb.max[1] && pb.min[1] <= pa.max[1] &&
+	           pa.min[2] <= pb.max[2] && pb.min[2] <= pa.max[2];
+	}
+
+	void SweepAndPrune::AddPair(const uint32_t a, const uint32_t b)
+	{
+	    const uint64_t key = PairKey(a, b);
+	    if (m_PairSet.insert(key).second)
+	        m_Added.push_back(PairFromKey(key));
+	}
+
+	void SweepAndPrune::RemovePair(const uint32_t a, const uint32_t b)
+	{
+	    const uint64_t key = PairKey(a, b);
+	    if (m_PairSet.erase(key) > 0)
+	        m_Removed.push_back(PairFromKey(key));
+	}
+
+	void SweepAndPrune::SortAxis(const uint32_t axis, const bool report)
+	{
+	    // Mins sort before maxes of equal value, so touching intervals overlap
+	    const auto less = [](const Endpoint &a, const Endpoint &b)
+	    {
+	        return a.value < b.value || (a.value == b.value && !a.IsMax() && b.IsMax());
+	    };
+
+	    std::vector<Endpoint> &endpoints = m_Endpoints[axis];
+	    for (uint32_t i = 1; i < endpoints.size(); i++)
+	    {
+	        const Endpoint endpoint = endpoints[i];
+	        uint32_t j = i;
+	        for (; j > 0 && less(endpoint, endpoints[j - 1]); j--)
+	        {
+	            const Endpoint &previous = endpoints[j - 1];
+
+	            // Every swap of a min and a max starts or ends the overlap of two intervals on this axis
+	            if (report && endpoint.GetId() != previous.GetId())
+	            {
+	                if (!endpoint.IsMax() && previous.IsMax())
+	                {
+	                    if (Overlaps(endpoint.GetId(), previous.GetId()))
+	                        AddPair(endpoint.GetId(), previous.GetId());
+	                }
+	                else if (endpoint.IsMax() && !previous.IsMax())
+	                {
+	                    RemovePair(endpoint.GetId(), previous.GetId());
+	                }
+	            }
+
+	            endpoints[j] = previous;
+	            m_Proxies[previous.GetId()].endpoint[axis][previous.IsMax()] = j;
+	        }
+
+	        endpoints[j] = endpoint;
+	        m_Proxies[endpoint.GetId()].endpoint[axis][endpoint.IsMax()] = j;
+	    }
+	}
+
+	void SweepAndPrune::SweepAxis()
+	{
+	    m_SweepScratch.clear();
+	    m_Active.clear();
+
+	    for (const Endpoint &endpoint : m_Endpoints[m_SweepAxis])
+	    {
+	        const uint32_t id = endpoint.GetId();
+	        if (endpoint.IsMax())
+	        {
+	            const auto it = std::find(m_Active.begin(), m_Active.end(), id);
+	            *it = m_Active.back();
+	            m_Active.pop_back();
+	            continue;
+	        }
+
+	        // Every open interval overlaps this one on the sweep axis; test the other two
+	        for (const uint32_t other : m_Active)
+	            if (Overlaps(id, other))
+	                m_SweepScratch.push_back(PairKey(id, other));
+	        m_Active.push_back(id);
+	    }
+
+	    std::sort(m_SweepScratch.begin(), m_SweepScratch.end());
+
+	    std::vector<uint64_t> keys;
+	    std::set_difference(m_SweepScratch.begin(), m_SweepScratch.end(), m_PairList.begin(), m_PairList.end(), std::back_inserter(keys));
+	    for (const uint64_t key : keys)
+	        m_Added.push_back(PairFromKey(key));
+
+	    keys.clear();
+	    std::set_difference(m_PairList.begin(), m_PairList.end(), m_SweepScratch.begin(), m_SweepScratch.end(), std::back_inserter(keys));
+	    for (const uint64_t key : keys)
+	        m_Removed.push_back(PairFromKey(key));
+
+	    m_PairList.swap(m_SweepScratch);
+	}
+
+	void SweepAndPrune::FinishEvents()
+	{
+	    // A pair can be added and removed again by swaps on different axes; report only the net change
+	    const auto by_key = [](const OverlapPair &x, const OverlapPair &y) { return KeyFromPair(x) < KeyFromPair(y); };
+	    std::sort(m_Added.begin(), m_Added.end(), by_key);
+	    std::sort(m_Removed.begin(), m_Removed.end(), by_key);
+
+	    std::vector<OverlapPair> added, removed;
+	    std::set_difference(m_Added.begin(), m_Added.end(), m_Removed.begin(), m_Removed.end(), std::back_inserter(added), by_key);
+	    std::set_difference(m_Removed.begin(), m_Removed.end(), m_Added.begin(), m_Added.end(), std::back_inserter(removed), by_key);
+	    m_Added.swap(added);
+	    m_Removed.swap(removed);
+	}
+
+	void SweepAndPrune::UpdatePairs()
+	{
+	    m_Added.clear();
+	    m_Removed.clear();
+
+	    const bool incremental = m_SweepAxis == ALL_AXES;
+	    for (uint32_t axis = m_FirstAxis; axis < m_FirstAxis + m_AxisCount; axis++)
+	        SortAxis(axis, incremental);
+
+	    // Removed objects have been sorted to the end of every axis
+	    if (!m_PendingRemovals.empty())
+	    {
+	        for (uint32_t axis = m_FirstAxis; axis < m_FirstAxis + m_AxisCount; axis++)
+	        {
+	            std::vector<Endpoint> &endpoints = m_Endpoints[axis];
+	            while (!endpoints.empty() && m_Proxies[endpoints.back().GetId()].state == ProxyState::Removing)
+	                endpoints.pop_back();
+	        }
+
+	        for (const uint32_t id : m_PendingRemovals)
+	            m_Proxies[id].state = ProxyState::Free;
+	        m_PendingRemovals.clear();
+	    }
+
+	    if (incremental)
+	        FinishEvents();
+	    else
+	        SweepAxis();
+	}
+
+	void SweepAndPrune::GetPairs(std::vector<OverlapPair> &pairs) const
+	{
+	    pairs.clear();
+	    if (m_SweepAxis == ALL_AXES)
+	    {
+	        std::vector<uint64_t> keys(m_PairSet.begin(), m_PairSet.end());
+	        std::sort(keys.begin(), keys.end());
+	        for (const uint64_t key : keys)
+	            pairs.push_back(PairFromKey(key));
+	    }
+	    else
+	    {
+	        for (const uint64_t key : m_PairList)
+	            pairs.push_back(PairFromKey(key));
+	    }
+	}
+
+	size_t SweepAndPrune::GetPairCount() const
+	{
+	    return m_SweepAxis == ALL_AXES ? m_PairSet.size() : m_PairList.size();
+	}
+
+	bool SweepAndPrune::IsOverlapping(const uint32_t a, const uint32_t b) const
+	{
+	    const uint64_t key = PairKey(a, b);
+	    if (m_SweepAxis == ALL_AXES)
+	        return m_PairSet.count(key) > 0;
+	    return std::binary_search(m_PairList.begin(), m_PairList.end(), key);
+	}
+
+}
+
+/// -------------------------------------------------------
@@ -0,0 +1,679 @@
+﻿/**
+* -------------------------------------------------------
+* Copyright (c) 2025 Thomas Ray
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+* copies of the Software, and to permit persons to whom the Software is furnished
+* to do so, subject to the following conditions :
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+* FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR
+* COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+* IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+* CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+* -------------------------------------------------------
+* voxelizer.cpp
+* -------------------------------------------------------
+* Created: 10/16/2026
+* -------------------------------------------------------
+*/
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <thread>
+#include <utility>
+#include <xmath.hpp>
+#include <xMath/includes/voxelizer.h>
+#include "parallel_for.h"
+
+// -------------------------------------------------------
+
+namespace xMath
+{
+	namespace
+	{
+	    // Separating axis test of a triangle against a box given by its center and half size
+	    // (Akenine-Möller). With EARLY_OUT disabled, all 13 axes are evaluated and combined, so
+	    // batch loops have no branches.
+	    template <bool EARLY_OUT>
+	    bool Overlap(const Vec3 &center, const Vec3 &half, const Vec3 &a, const Vec3 &b, const Vec3 &c)
+	    {
+	        const Vec3 v0 = a - center;
+	        const Vec3 v1 = b - center;
+	        const Vec3 v2 = c - center;
+	        const Vec3 edges[3] = { v1 - v0, v2 - v1, v0 - v2 };
+
+	        bool separated = false;
+	        const auto test = [&separated](const float p0, const float p1, const float p2, const float radius)
+	        {
+	            separated |= std::min(std::min(p0, p1), p2) > radius || std::max(std::max(p0, p1), p2) < -radius;
+	            return EARLY_OUT && separated;
+	        };
+
+	        // Box axes: the bounds of the triangle against the box
+	        if (test(v0.x, v1.x, v2.x, half.x) || test(v0.y, v1.y, v2.y, half.y) || test(v0.z, v1.z, v2.z, half.z))
+	            return false;
+
+	        // Cross products of the box axes with the triangle edges
+	        for (const Vec3 &e : edges)
+	        {
+	            const float ax = std::abs(e.x), ay = std::abs(e.y), az = std::abs(e.z);
+	            if (test(e.y * v0.z - e.z * v0.y, e.y * v1.z - e.z * v1.y, e.y * v2.z - e.z * v2.y, half.y * az + half.z * ay))
+	                return false;
+	            if (test(e.z * v0.x - e.x * v0.z, e.z * v1.x - e.x * v1.z, e.z * v2.x - e.x * v2.z, half.x * az + half.z * ax))
+	                return false;
+	            if (test(e.x * v0.y - e.y * v0.x, e.x * v1.y - e.y * v1.x, e.x * v2.y - e.y * v2.x, half.x * ay + half.y * ax))
+	                return false;
+	        }
+
+	        // Triangle plane
+	        const Vec3 normal = Cross(edges[0], edges[1]);
+	        const float distance = normal.x * v0.x + normal.y * v0.y + normal.z * v0.z;
+	        test(distance, distance, distance, half.x * std::abs(normal.x) + half.y * std::abs(normal.y) + half.z * std::abs(normal.z));
+	        return !separated;
+	    }
+
+	    struct GridShape
+	    {
+	        Vec3 origin;
+	        float voxel_size;
+	        float inv_voxel_size;
+	        uint32_t size_x;
+	        uint32_t size_y;
+	        uint32_t size_z;
+	        uint32_t words_per_row;
+	    };
+
+	    struct MeshView
+	    {
+	        const Vec3 *vertices;
+	        const uint32_t *indices;
+
+	        void GetTriangle(const size_t triangle, Vec3 &a, Vec3 &b, Vec3 &c) const
+	        {
+	            const size_t base = triangle * 3;
+	            a = vertices[indices != nullptr ? indices[base + 0] : base + 0];
+	            b = vertices[indices != nullptr ? indices[base + 1] : base + 1];
+	            c = vertices[indices != nullptr ? indices[base + 2] : base + 2];
+	        }
+	    };
+
+	    // Calls function(word, mask) for the words covering bits [begin, end) of a row
+	    template <typename Function>
+	    void ForEachWord(const uint32_t begin, const uint32_t end, const Function &function)
+	    {
+	        if (begin >= end)
+	            return;
+
+	        const uint32_t first = begin / 64;
+	        const uint32_t last = (end - 1) / 64;
+	        const uint64_t first_mask = ~0ull << (begin % 64);
+	        const uint64_t last_mask = ~0ull >> (63 - (end - 1) % 64);
+	        if (first == last)
+	        {
+	            function(first, first_mask & last_mask);
+	            return;
+	        }
+
+	        function(first, first_mask);
+	        for (uint32_t word = first + 1; word < last; word++)
+	            function(word, ~0ull);
+	        function(last, last_mask);
+	    }
+
+	    // Voxel index range [first, last] of the voxels whose closed cell touches [min, max], in voxel units
+	    bool GetVoxelRange(const float min, const float max, const uint32_t size, uint32_t &first, uint32_t &last)
+	    {
+	        if (!(max >= 0.0f) || !(min <= static_cast<float>(size)))
+	            return false;
+	        first = static_cast<uint32_t>(std::max(std::ceil(min - 1.0f), 0.0f));
+	        last = static_cast<uint32_t>(std::min(std::floor(max), static_cast<float>(size - 1)));
+	        return first <= last;
+	    }
+
+	    // Narrows [lo, hi] to the x for which k * x + m >= 0
+	    void ClipSpan(const float k, const float m, float &lo, float &hi)
+	    {
+	        if (k > 0.0f)
+	            lo = std::max(lo, -m / k);
+	        else if (k < 0.0f)
+	            hi = std::min(hi, -m / k);
+	        else if (m < 0.0f)
+	            hi = -1.0f;
+	    }
+
+	    // Sets the voxels of rows [z_begin, z_end) that overlap a triangle. The conservative
+	    // overlap test (Schwarz and Seidel, "Fast Parallel Surface and Solid Voxelization on GPUs")
+	    // is equivalent to the 13-axis SAT; each of its terms is linear in x, so every row is one
+	    // span of voxels that is set a word at a time.
+	    void FillSurface(const GridShape &grid, const Vec3 &a, const Vec3 &b, const Vec3 &c, const uint32_t z_begin, const uint32_t z_end, uint64_t *words)
+	    {
+	        const Vec3 local[3] = { (a - grid.origin) * grid.inv_voxel_size, (b - grid.origin) * grid.inv_voxel_size, (c - grid.origin) * grid.inv_voxel_size };
+	        uint32_t x_first, x_last, y_first, y_last, z_first, z_last;
+	        if (!GetVoxelRange(std::min({ local[0].x, local[1].x, local[2].x }), std::max({ local[0].x, local[1].x, local[2].x }), grid.size_x, x_first, x_last) ||
+	            !GetVoxelRange(std::min({ local[0].y, local[1].y, local[2].y }), std::max({ local[0].y, local[1].y, local[2].y }), grid.size_y, y_first, y_last) ||
+	            !GetVoxelRange(std::min({ local[0].z, local[1].z, local[2].z }), std::max({ local[0].z, local[1].z, local[2].z }), grid.size_z, z_first, z_last))
+	            return;
+	        z_first = std::max(z_first, z_begin);
+	        z_last = std::min(z_last, z_end - 1);
+
+	        // Everything below is in voxel units, so a voxel is the unit cube at its minimum corner p
+	        const Vec3 edges[3] = { local[1] - local[0], local[2] - local[1], local[0] - local[2] };
+	        const Vec3 normal = Cross(edges[0], edges[1]);
+
+	        // Plane: n.p + plane_min <= 0 <= n.p + plane_max
+	        const Vec3 critical(normal.x > 0.0f ? 1.0f : 0.0f, normal.y > 0.0f ? 1.0f : 0.0f, normal.z > 0.0f ? 1.0f : 0.0f);
+	        const float plane_max = Dot(normal, critical - local[0]);
+	        const float plane_min = Dot(normal, Vec3(1.0f) - critical - local[0]);
+
+	        // Edge functions of the projections on the xy, yz and zx planes: n.(u, v) + d >= 0
+	        float xy_n[3][2], xy_d[3], yz_n[3][2], yz_d[3], zx_n[3][2], zx_d[3];
+	        const float xy_sign = normal.z < 0.0f ? -1.0f : 1.0f;
+	        const float yz_sign = normal.x < 0.0f ? -1.0f : 1.0f;
+	        const float zx_sign = normal.y < 0.0f ? -1.0f : 1.0f;
+	        for (int i = 0; i < 3; i++)
+	        {
+	            const Vec3 &e = edges[i];
+	            const Vec3 &v = local[i];
+
+	            xy_n[i][0] = -e.y * xy_sign;
+	            xy_n[i][1] = e.x * xy_sign;
+	            xy_d[i] = -(xy_n[i][0] * v.x + xy_n[i][1] * v.y) + std::max(0.0f, xy_n[i][0]) + std::max(0.0f, xy_n[i][1]);
+
+	            yz_n[i][0] = -e.z * yz_sign;
+	            yz_n[i][1] = e.y * yz_sign;
+	            yz_d[i] = -(yz_n[i][0] * v.y + yz_n[i][1] * v.z) + std::max(0.0f, yz_n[i][0]) + std::max(0.0f, yz_n[i][1]);
+
+	            zx_n[i][0] = -e.x * zx_sign;
+	            zx_n[i][1] = e.z * zx_sign;
+	            zx_d[i] = -(zx_n[i][0] * v.z + zx_n[i][1] * v.x) + std::max(0.0f, zx_n[i][0]) + std::max(0.0f, zx_n[i][1]);
+	        }
+
+	        for (uint32_t z = z_first; z <= z_last; z++)
+	        {
+	            const float pz = static_cast<float>(z);
+	            for (uint32_t y = y_first; y <= y_last; y++)
+	            {
+	                const float py = static_cast<float>(y);
+	                if (yz_n[0][0] * py + yz_n[0][1] * pz + yz_d[0] < 0.0f ||
+	                    yz_n[1][0] * py + yz_n[1][1] * pz + yz_d[1] < 0.0f ||
+	                    yz_n[2][0] * py + yz_n[2][1] * pz + yz_d[2] < 0.0f)
+	                    continue;
+
+	                float lo = static_cast<float>(x_first);
+	                float hi = static_cast<float>(x_last);
+	                for (int i = 0; i < 3; i++)
+	                {
+	                    ClipSpan(xy_n[i][0], xy_n[i][1] * py + xy_d[i], lo, hi);
+	                    ClipSpan(zx_n[i][1], zx_n[i][0] * pz + zx_d[i], lo, hi);
+	                }
+	                const float yz_dot = normal.y * py + normal.z * pz;
+	                ClipSpan(normal.x, yz_dot + plane_max, lo, hi);
+	                ClipSpan(-normal.x, -(yz_dot + plane_min), lo, hi);
+
+	                lo = std::ceil(lo);
+	                hi = std::floor(hi);
+	                if (lo > hi)
+	                    continue;
+
+	                uint64_t *row = words + (static_cast<size_t>(z - z_begin) * grid.size_y + y) * grid.words_per_row;
+	                ForEachWord(static_cast<uint32_t>(lo), static_cast<uint32_t>(hi) + 1, [row](const uint32_t word, const uint64_t mask) { row[word] |= mask; });
+	            }
+	        }
+	    }
+
+	    // Edge function of q against the edge p0 -> p1 in the yz plane. It is evaluated with the
+	    // endpoints in a fixed order, so two triangles sharing an edge get exactly opposite values.
+	    float EdgeFunction(Vec2 p0, Vec2 p1, const Vec2 &q)
+	    {
+	        const bool swapped = p1.x < p0.x || (p1.x == p0.x && p1.y < p0.y);
+	        if (swapped)
+	            std::swap(p0, p1);
+	        const float value = (p1.x - p0.x) * (q.y - p0.y) - (p1.y - p0.y) * (q.x - p0.x);
+	        return swapped ? -value : value;
+	    }
+
+	    // Top-left style tie rule: of two opposite edges exactly one owns the points on it
+	    bool IsInside(const float edge_function, const Vec2 &p0, const Vec2 &p1)
+	    {
+	        const float du = p1.x - p0.x;
+	        const float dw = p1.y - p0.y;
+	        return edge_function > 0.0f || (edge_function == 0.0f && (dw > 0.0f || (dw == 0.0f && du < 0.0f)));
+	    }
+
+	    // Toggles, in rows [z_begin, z_end), every voxel whose center lies beyond the triangle
+	    // along +x. After all triangles of a closed mesh, the voxels toggled an odd number of times
+	    // are the ones whose center is inside.
+	    void ToggleInterior(const GridShape &grid, Vec3 a, Vec3 b, Vec3 c, const uint32_t z_begin, const uint32_t z_end, uint64_t *words)
+	    {
+	        Vec2 pa(a.y, a.z), pb(b.y, b.z), pc(c.y, c.z);
+	        const float area = (pb.x - pa.x) * (pc.y - pa.y) - (pb.y - pa.y) * (pc.x - pa.x);
+	        if (area == 0.0f)
+	            return;
+	        if (area < 0.0f)
+	        {
+	            std::swap(pb, pc);
+	            std::swap(b, c);
+	        }
+
+	        // Rows whose center lies within the projected bounds
+	        const float y_min = (std::min({ pa.x, pb.x, pc.x }) - grid.origin.y) * grid.inv_voxel_size - 0.5f;
+	        const float y_max = (std::max({ pa.x, pb.x, pc.x }) - grid.origin.y) * grid.inv_voxel_size - 0.5f;
+	        const float z_min = (std::min({ pa.y, pb.y, pc.y }) - grid.origin.z) * grid.inv_voxel_size - 0.5f;
+	        const float z_max = (std::max({ pa.y, pb.y, pc.y }) - grid.origin.z) * grid.inv_voxel_size - 0.5f;
+	        const float y_first = std::max(std::ceil(y_min), 0.0f);
+	        const float y_last = std::min(std::floor(y_max), static_cast<float>(grid.size_y) - 1.0f);
+	        const float z_first = std::max(std::ceil(z_min), static_cast<float>(z_begin));
+	        const float z_last = std::min(std::floor(z_max), static_cast<float>(z_end) - 1.0f);
+	        if (y_first > y_last || z_first > z_last)
+	            return;
+
+	        const float x_limit = static_cast<float>(grid.size_x);
+	        for (uint32_t z = static_cast<uint32_t>(z_first); z <= static_cast<uint32_t>(z_last); z++)
+	        {
+	            for (uint32_t y = static_cast<uint32_t>(y_first); y <= static_cast<uint32_t>(y_last); y++)
+	            {
+	                const Vec2 q(grid.origin.y + (static_cast<float>(y) + 0.5f) * grid.voxel_size, grid.origin.z + (static_cast<float>(z) + 0.5f) * grid.voxel_size);
+	                const float w_a = EdgeFunction(pb, pc, q);
+	                const float w_b = EdgeFunction(pc, pa, q);
+	                const float w_c = EdgeFunction(pa, pb, q);
+	                if (!IsInside(w_a, pb, pc) || !IsInside(w_b, pc, pa) || !IsInside(w_c, pa, pb))
+	                    continue;
+
+	                // Crossing along x, then the first voxel whose center is past it
+	                const float weight = w_a + w_b + w_c;
+	                const float x = weight > 0.0f ? (w_a * a.x + w_b * b.x + w_c * c.x) / weight : a.x;
+	                const float first = std::clamp(std::floor((x - grid.origin.x) * grid.inv_voxel_size - 0.5f) + 1.0f, 0.0f, x_limit);
+
+	                uint64_t *row = words + (static_cast<size_t>(z - z_begin) * grid.size_y + y) * grid.words_per_row;
+	                ForEachWord(static_cast<uint32_t>(first), grid.size_x, [row](const uint32_t word, const uint64_t mask) { row[word] ^= mask; });
+	            }
+	        }
+	    }
+
+	    constexpr uint32_t SLAB_SIZE = SparseVoxelGrid::BRICK_SIZE;
+	    constexpr uint32_t NO_SLAB = 0xFFFFFFFFu;
+
+	    uint32_t GetThreadCount(const size_t triangle_count, const VoxelizeSettings &settings)
+	    {
+	        if (triangle_count < settings.parallel_threshold)
+	            return 1;
+	        return settings.thread_count ? settings.thread_count : std::max(std::thread::hardware_concurrency(), 1u);
+	    }
+
+	    uint32_t GetSlabCount(const GridShape &grid)
+	    {
+	        return (grid.size_z + SLAB_SIZE - 1) / SLAB_SIZE;
+	    }
+
+	    // Slabs per chunk: one contiguous chunk per thread
+	    size_t GetSlabChunkSize(const GridShape &grid, const size_t triangle_count, const VoxelizeSettings &settings)
+	    {
+	        const uint32_t threads = GetThreadCount(triangle_count, settings);
+	        return std::max<size_t>((GetSlabCount(grid) + threads - 1) / threads, 1);
+	    }
+
+	    // Voxelizes a mesh one slab of SLAB_SIZE voxel layers along z at a time. Slabs are split
+	    // across threads in contiguous chunks, so no two threads write the same row. A dense grid
+	    // is written in place; otherwise each slab is filled in a scratch buffer that is handed to
+	    // emit(chunk, slab, words) and cleared for the next slab.
+	    template <typename Emit>
+	    void VoxelizeSlabs(const GridShape &grid, const MeshView &mesh, const size_t triangle_count, const VoxelizeSettings &settings, uint64_t *dense, const Emit &emit)
+	    {
+	        const uint32_t slab_count = GetSlabCount(grid);
+	        if (slab_count == 0 || grid.size_x == 0 || grid.size_y == 0 || triangle_count == 0)
+	            return;
+
+	        const uint32_t threads = GetThreadCount(triangle_count, settings);
+	        const size_t chunk_size = GetSlabChunkSize(grid, triangle_count, settings);
+	        const bool solid = settings.fill == VoxelFill::Solid;
+
+	        // Slab range of every triangle, NO_SLAB if it cannot touch the grid. Solid fill keeps
+	        // triangles before the grid along x, since their crossings still toggle whole rows.
+	        std::vector<uint32_t> slab_first(triangle_count), slab_last(triangle_count);
+	        const size_t triangle_chunk = (triangle_count + threads - 1) / threads;
+	        detail::ParallelFor(triangle_count, triangle_chunk, [&](size_t, const size_t begin, const size_t end)
+	        {
+	            for (size_t i = begin; i < end; i++)
+	            {
+	                Vec3 a, b, c;
+	                mesh.GetTriangle(i, a, b, c);
+	                const Vec3 min = (Vec3(std::min({ a.x, b.x, c.x }), std::min({ a.y, b.y, c.y }), std::min({ a.z, b.z, c.z })) - grid.origin) * grid.inv_voxel_size;
+	                const Vec3 max = (Vec3(std::max({ a.x, b.x, c.x }), std::max({ a.y, b.y, c.y }), std::max({ a.z, b.z, c.z })) - grid.origin) * grid.inv_voxel_size;
+	                uint32_t first, last, unused_first, unused_last;
+	                const bool in_x = solid ? min.x <= static_cast<float>(grid.size_x) : GetVoxelRange(min.x, max.x, grid.size_x, unused_first, unused_last);
+	                const bool in_y = GetVoxelRange(min.y, max.y, grid.size_y, unused_first, unused_last);
+	                if (in_x && in_y && GetVoxelRange(min.z, max.z, grid.size_z, first, last))
+	                {
+	                    slab_first[i] = first / SLAB_SIZE;
+	                    slab_last[i] = last / SLAB_SIZE;
+	                }
+	                else
+	                {
+	                    slab_first[i] = NO_SLAB;
+	                    slab_last[i] = NO_SLAB;
+	                }
+	            }
+	        });
+
+	        const size_t slab_words = static_cast<size_t>(SLAB_SIZE) * grid.size_y * grid.words_per_row;
+	        detail::ParallelFor(slab_count, chunk_size, [&](const size_t chunk, const size_t begin, const size_t end)
+	        {
+	            // Triangles of this chunk, in the order their first slab is reached
+	            std::vector<uint32_t> pending;
+	            for (size_t i = 0; i < triangle_count; i++)
+	            {
+	                if (slab_first[i] != NO_SLAB && slab_first[i] < end && slab_last[i] >= begin)
+	                    pending.push_back(static_cast<uint32_t>(i));
+	            }
+	            std::sort(pending.begin(), pending.end(), [&slab_first](const uint32_t l, const uint32_t r) { return slab_first[l] < slab_first[r]; });
+
+	            std::vector<uint64_t> scratch(dense == nullptr ? slab_words : 0);
+	            std::vector<uint64_t> parity(solid ? slab_words : 0);
+	            std::vector<uint32_t> active;
+	            size_t next = 0;
+	            for (size_t slab = begin; slab < end; slab++)
+	            {
+	                active.erase(std::remove_if(active.begin(), active.end(), [&slab_last, slab](const uint32_t i) { return slab_last[i] < slab; }), active.end());
+	                for (; next < pending.size() && slab_first[pending[next]] <= slab; next++)
+	                    active.push_back(pending[next]);
+	                if (active.empty())
+	                    continue;
+
+	                const uint32_t z_begin = static_cast<uint32_t>(slab) * SLAB_SIZE;
+	                const uint32_t z_end = std::min(z_begin + SLAB_SIZE, grid.size_z);
+	                uint64_t *words = dense != nullptr ? dense + static_cast<size_t>(z_begin) * grid.size_y * grid.words_per_row : scratch.data();
+	                for (const uint32_t i : active)
+	                {
+	                    Vec3 a, b, c;
+	                    mesh.GetTriangle(i, a, b, c);
+	                    FillSurface(grid, a, b, c, z_begin, z_end, words);
+	                    if (solid)
+	                        ToggleInterior(grid, a, b, c, z_begin, z_end, parity.data());
+	                }
+
+	                if (solid)
+	                {
+	                    const size_t used = static_cast<size_t>(z_end - z_begin) * grid.size_y * grid.words_per_row;
+	                    for (size_t w = 0; w < used; w++)
+	                        words[w] |= parity[w];
+	                    std::fill(parity.begin(), parity.end(), 0ull);
+	                }
+
+	                if (dense == nullptr)
+	                {
+	                    emit(chunk, static_cast<uint32_t>(slab), words);
+	                    std::fill(scratch.begin(), scratch.end(), 0ull);
+	                }
+	            }
+	        });
+	    }
+
+	    GridShape MakeShape(const Vec3 &origin, const float voxel_size, const uint32_t size_x, const uint32_t size_y, const uint32_t size_z)
+	    {
+	        assert(voxel_size > 0.0f);
+	        return { origin, voxel_size, 1.0f / voxel_size, size_x, size_y, size_z, (size_x + 63) / 64 };
+	    }
+
+	    uint32_t GetSizeForBounds(const float extent, const float voxel_size)
+	    {
+	        return std::max(static_cast<uint32_t>(std::ceil(extent / voxel_size)), 1u);
+	    }
+	}
+
+	bool IntersectTriangleBox(const Vec3 &a, const Vec3 &b, const Vec3 &c, const BoundingBox &box)
+	{
+	    return Overlap<true>(box.GetCenter(), box.GetExtents(), a, b, c);
+	}
+
+	size_t IntersectTriangleBoxes(const Vec3 &a, const Vec3 &b, const Vec3 &c, const BoundingBoxSoA &boxes, uint8_t *results)
+	{
+	    const size_t count = boxes.Size();
+	    assert(results != nullptr || count == 0);
+
+	    size_t hits = 0;
+	    for (size_t i = 0; i < count; i++)
+	    {
+	        const Vec3 center(boxes.center_x[i], boxes.center_y[i], boxes.center_z[i]);
+	        const Vec3 half(boxes.extent_x[i], boxes.extent_y[i], boxes.extent_z[i]);
+	        const uint8_t hit = Overlap<false>(center, half, a, b, c) ? 1 : 0;
+	        results[i] = hit;
+	        hits += hit;
+	    }
+	    return hits;
+	}
+
+	/// -------------------------------------------------------
+
+	VoxelGrid::VoxelGrid() : m_Origin(0.0f), m_VoxelSize(1.0f), m_SizeX(0), m_SizeY(0), m_SizeZ(0), m_WordsPerRow(0)
+	{
+	}
+
+	VoxelGrid::VoxelGrid(const Vec3 &origin, const float voxel_size, const uint32_t size_x, const uint32_t size_y, const uint32_t size_z)
+	    : m_Origin(origin), m_VoxelSize(voxel_size), m_SizeX(size_x), m_SizeY(size_y), m_SizeZ(size_z), m_WordsPerRow((size_x + 63) / 64)
+	{
+	    assert(voxel_size > 0.0f);
+	    m_Words.assign(static_cast<size_t>(m_WordsPerRow) * size_y * size_z, 0ull);
+	}
+
+	VoxelGrid::VoxelGrid(const BoundingBox &bounds, const float voxel_size)
+	    : VoxelGrid(bounds.GetMin(), voxel_size,
+	                GetSizeForBounds(bounds.GetMax().x - bounds.GetMin().x, voxel_size),
+	                GetSizeForBounds(bounds.GetMax().y - bounds.GetMin().y, voxel_size),
+	                GetSizeForBounds(bounds.GetMax().z - bounds.GetMin().z, voxel_size))
+	{
+	}
+
+	void VoxelGrid::Voxelize(const Vec3 *vertices, const uint32_t *indices, const size_t triangle_count, const VoxelizeSettings &settings)
+	{
+	    assert(vertices != nullptr || triangle_count == 0);
+
+	    const GridShape shape = MakeShape(m_Origin, m_VoxelSize, m_SizeX, m_SizeY, m_SizeZ);
+	    VoxelizeSlabs(shape, MeshView{ vertices, indices }, triangle_count, settings, m_Words.data(), [](size_t, uint32_t, const uint64_t *) {});
+	}
+
+	void VoxelGrid::Clear()
+	{
+	    std::fill(m_Words.begin(), m_Words.end(), 0ull);
+	}
+
+	bool VoxelGrid::Get(const uint32_t x, const uint32_t y, const uint32_t z) const
+	{
+	    assert(x < m_SizeX && y < m_SizeY && z < m_SizeZ);
+	    return (GetRow(y, z)[x / 64] >> (x % 64)) & 1ull;
+	}
+
+	void VoxelGrid::Set(const uint32_t x, const uint32_t y, const uint32_t z, const bool value)
+	{
+	    assert(x < m_SizeX && y < m_SizeY && z < m_SizeZ);
+	    uint64_t &word = m_Words[(static_cast<size_t>(z) * m_SizeY + y) * m_WordsPerRow + x / 64];
+	    const uint64_t bit = 1ull << (x % 64);
+	    word = value ? word | bit : word & ~bit;
+	}
+
+	size_t VoxelGrid::CountSet() const
+	{
+	    size_t count = 0;
+	    for (const uint64_t word : m_Words)
+	        count += std::popcount(word);
+	    return count;
+	}
+
+	const uint64_t *VoxelGrid::GetRow(const uint32_t y, const uint32_t z) const
+	{
+	    assert(y < m_SizeY && z < m_SizeZ);
+	    return m_Words.data() + (static_cast<size_t>(z) * m_SizeY + y) * m_WordsPerRow;
+	}
+
+	BoundingBox VoxelGrid::GetVoxelBounds(const uint32_t x, const uint32_t y, const uint32_t z) const
+	{
+	    const Vec3 min = m_Origin + Vec3(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)) * m_VoxelSize;
+	    return { min, min + Vec3(m_VoxelSize) };
+	}
+
+	BoundingBox VoxelGrid::GetBounds() const
+	{
+	    return { m_Origin, m_Origin + Vec3(static_cast<float>(m_SizeX), static_cast<float>(m_SizeY), static_cast<float>(m_SizeZ)) * m_VoxelSize };
+	}
+
+	/// -------------------------------------------------------
+
+	SparseVoxelGrid::SparseVoxelGrid() : m_Origin(0.0f), m_VoxelSize(1.0f), m_SizeX(0), m_SizeY(0), m_SizeZ(0)
+	{
+	}
+
+	SparseVoxelGrid::SparseVoxelGrid(const Vec3 &origin, const float voxel_size, const uint32_t size_x, const uint32_t size_y, const uint32_t size_z)
+	    : m_Origin(origin), m_VoxelSize(voxel_size), m_SizeX(size_x), m_SizeY(size_y), m_SizeZ(size_z)
+	{
+	    assert(voxel_size > 0.0f);
+	}
+
+	SparseVoxelGrid::SparseVoxelGrid(const BoundingBox &bounds, const float voxel_size)
+	    : SparseVoxelGrid(bounds.GetMin(), voxel_size,
+	                      GetSizeForBounds(bounds.GetMax().x - bounds.GetMin().x, voxel_size),
+	                      GetSizeForBounds(bounds.GetMax().y - bounds.GetMin().y, voxel_size),
+	                      GetSizeForBounds(bounds.GetMax().z - bounds.GetMin().z, voxel_size))
+	{
+	}
+
+	void SparseVoxelGrid::Voxelize(const Vec3 *vertices, const uint32_t *indices, const size_t triangle_count, const VoxelizeSettings &settings)
+	{
+	    assert(vertices != nullptr || triangle_count == 0);
+
+	    const GridShape shape = MakeShape(m_Origin, m_VoxelSize, m_SizeX, m_SizeY, m_SizeZ);
+	    const uint32_t bricks_y = (m_SizeY + BRICK_SIZE - 1) / BRICK_SIZE;
+	    const size_t chunk_size = GetSlabChunkSize(shape, triangle_count, settings);
+
+	    // Bricks found by each chunk; chunks cover increasing slabs, so their concatenation is sorted
+	    std::vector<std::vector<std::pair<uint64_t, uint64_t>>> found((GetSlabCount(shape) + chunk_size - 1) / chunk_size);
+	    const auto emit = [&](const size_t chunk, const uint32_t slab, const uint64_t *words)
+	    {
+	        std::vector<std::pair<uint64_t, uint64_t>> &bricks = found[chunk];
+	        const uint32_t layers = std::min(BRICK_SIZE, m_SizeZ - slab * BRICK_SIZE);
+	        for (uint32_t brick_y = 0; brick_y < bricks_y; brick_y++)
+	        {
+	            const uint32_t rows = std::min(BRICK_SIZE, m_SizeY - brick_y * BRICK_SIZE);
+	            for (uint32_t w = 0; w < shape.words_per_row; w++)
+	            {
+	                // Union of the brick rows, to find the non-empty bricks of this word
+	                uint64_t occupied = 0;
+	                for (uint32_t z = 0; z < layers; z++)
+	                {
+	                    for (uint32_t y = 0; y < rows; y++)
+	                        occupied |= words[(static_cast<size_t>(z) * m_SizeY + brick_y * BRICK_SIZE + y) * shape.words_per_row + w];
+	                }
+
+	                while (occupied != 0)
+	                {
+	                    const uint32_t shift = static_cast<uint32_t>(std::countr_zero(occupied)) & ~(BRICK_SIZE - 1);
+	                    occupied &= ~(0xFull << shift);
+
+	                    uint64_t mask = 0;
+	                    for (uint32_t z = 0; z < layers; z++)
+	                    {
+	                        for (uint32_t y = 0; y < rows; y++)
+	                        {
+	                            const uint64_t row = words[(static_cast<size_t>(z) * m_SizeY + brick_y * BRICK_SIZE + y) * shape.words_per_row + w];
+	                            mask |= ((row >> shift) & 0xFull) << ((z * BRICK_SIZE + y) * BRICK_SIZE);
+	                        }
+	                    }
+	                    bricks.emplace_back(GetKey(w * (64 / BRICK_SIZE) + shift / BRICK_SIZE, brick_y, slab), mask);
+	                }
+	            }
+	        }
+	    };
+	    VoxelizeSlabs(shape, MeshView{ vertices, indices }, triangle_count, settings, nullptr, emit);
+
+	    // Merge the new bricks into the stored ones
+	    std::vector<uint64_t> keys, masks;
+	    keys.reserve(m_Keys.size());
+	    masks.reserve(m_Masks.size());
+	    size_t stored = 0;
+	    const auto append = [&](const uint64_t key, const uint64_t mask)
+	    {
+	        for (; stored < m_Keys.size() && m_Keys[stored] < key; stored++)
+	        {
+	            keys.push_back(m_Keys[stored]);
+	            masks.push_back(m_Masks[stored]);
+	        }
+	        if (stored < m_Keys.size() && m_Keys[stored] == key)
+	        {
+	            keys.push_back(key);
+	            masks.push_back(mask | m_Masks[stored++]);
+	            return;
+	        }
+	        keys.push_back(key);
+	        masks.push_back(mask);
+	    };
+	    for (const std::vector<std::pair<uint64_t, uint64_t>> &bricks : found)
+	    {
+	        for (const auto &[key, mask] : bricks)
+	            append(key, mask);
+	    }
+	    for (; stored < m_Keys.size(); stored++)
+	    {
+	        keys.push_back(m_Keys[stored]);
+	        masks.push_back(m_Masks[stored]);
+	    }
+	    m_Keys = std::move(keys);
+	    m_Masks = std::move(masks);
+	}
+
+	void SparseVoxelGrid::Clear()
+	{
+	    m_Keys.clear();
+	    m_Masks.clear();
+	}
+
+	bool SparseVoxelGrid::Get(const uint32_t x, const uint32_t y, const uint32_t z) const
+	{
+	    assert(x < m_SizeX && y < m_SizeY && z < m_SizeZ);
+	    const uint64_t key = GetKey(x / BRICK_SIZE, y / BRICK_SIZE, z / BRICK_SIZE);
+	    const auto it = std::lower_bound(m_Keys.begin(), m_Keys.end(), key);
+	    if (it == m_Keys.end() || *it != key)
+	        return false;
+
+	    const uint32_t bit = ((z % BRICK_SIZE) * BRICK_SIZE + y % BRICK_SIZE) * BRICK_SIZE + x % BRICK_SIZE;
+	    return (m_Masks[it - m_Keys.begin()] >> bit) & 1ull;
+	}
+
+	size_t SparseVoxelGrid::CountSet() const
+	{
+	    size_t count = 0;
+	    for (const uint64_t mask : m_Masks)
+	        count += std::popcount(mask);
+	    return count;
+	}
+
+	SparseVoxelGrid::Brick SparseVoxelGrid::GetBrick(const size_t index) const
+	{
+	    assert(index < m_Keys.size());
+	    const uint64_t bricks_x = (m_SizeX + BRICK_SIZE - 1) / BRICK_SIZE;
+	    const uint64_t bricks_y = (m_SizeY + BRICK_SIZE - 1) / BRICK_SIZE;
+	    const uint64_t key = m_Keys[index];
+	    return { static_cast<uint32_t>(key % bricks_x), static_cast<uint32_t>(key / bricks_x % bricks_y), static_cast<uint32_t>(key / bricks_x / bricks_y), m_Masks[index] };
+	}
+
+	BoundingBox SparseVoxelGrid::GetVoxelBounds(const uint32_t x, const uint32_t y, const uint32_t z) const
+	{
+	    const Vec3 min = m_Origin + Vec3(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)) * m_VoxelSize;
+	    return { min, min + Vec3(m_VoxelSize) };
+	}
+
+	uint64_t SparseVoxelGrid::GetKey(const uint32_t brick_x, const uint32_t brick_y, const uint32_t brick_z) const
+	{
+	    const uint64_t bricks_x = (m_SizeX + BRICK_SIZE - 1) / BRICK_SIZE;
+	    const uint64_t bricks_y = (m_SizeY + BRICK_SIZE - 1) / BRICK_SIZE;
+	    return (static_cast<uint64_t>(brick_z) * bricks_y + brick_y) * bricks_x + brick_x;
+	}
+}
+
+/// -------------------------------------------------------